@@ -49,16 +49,20 @@ cayman_set_default_state(ScrnInfoPtr pScrn)
 {
     tex_resource_t tex_res;
     shader_config_t fs_conf;
-    int i;
+    int i, start;
     RADEONInfoPtr info = RADEONPTR(pScrn);
     struct radeon_accel_state *accel_state = info->accel_state;
 
     if (accel_state->XInited3D)
 	return;
 
+    if (radeon_default_state_replay(pScrn))
+	return;
+
     memset(&tex_res, 0, sizeof(tex_resource_t));
     memset(&fs_conf, 0, sizeof(shader_config_t));
 
+    start = radeon_default_state_begin(pScrn);
     accel_state->XInited3D = TRUE;
 
     evergreen_start_3d(pScrn);
@@ -300,5 +304,7 @@ cayman_set_default_state(ScrnInfoPtr pScrn)
     E32(0);
     E32(0);
     END_BATCH();
+
+    radeon_default_state_end(pScrn, start);
 }
 
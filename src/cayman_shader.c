@@ -34,14 +34,14 @@
 #include "cayman_reg.h"
 
 /* solid vs --------------------------------------- */
-int cayman_solid_vs(RADEONChipFamily ChipSet, uint32_t* shader)
+int cayman_solid_vs(RADEONChipFamily ChipSet, uint32_t *shader, uint32_t variant, int max)
 {
     int i = 0;
 
     /* 0 */
-    shader[i++] = CF_DWORD0(ADDR(4),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(4),
 			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
 			    CF_CONST(0),
 			    COND(SQ_CF_COND_ACTIVE),
 			    I_COUNT(1),
@@ -49,13 +49,13 @@ int cayman_solid_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 			    CF_INST(SQ_CF_INST_TC),
 			    BARRIER(1));
     /* 1 */
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(CF_POS0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(CF_POS0),
 					  TYPE(SQ_EXPORT_POS),
 					  RW_GPR(1),
 					  RW_REL(ABSOLUTE),
 					  INDEX_GPR(0),
 					  ELEM_SIZE(0));
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
 					       SRC_SEL_Y(SQ_SEL_Y),
 					       SRC_SEL_Z(SQ_SEL_Z),
 					       SRC_SEL_W(SQ_SEL_W),
@@ -65,13 +65,13 @@ int cayman_solid_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 					       MARK(0),
 					       BARRIER(1));
     /* 2 - always export a param whether it's used or not */
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(0),
 					  TYPE(SQ_EXPORT_PARAM),
 					  RW_GPR(0),
 					  RW_REL(ABSOLUTE),
 					  INDEX_GPR(0),
 					  ELEM_SIZE(0));
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
 					       SRC_SEL_Y(SQ_SEL_Y),
 					       SRC_SEL_Z(SQ_SEL_Z),
 					       SRC_SEL_W(SQ_SEL_W),
@@ -81,9 +81,9 @@ int cayman_solid_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 					       MARK(0),
 					       BARRIER(0));
     /* 3 - end */
-    shader[i++] = CF_DWORD0(ADDR(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(0),
 			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
 			    CF_CONST(0),
 			    COND(SQ_CF_COND_ACTIVE),
 			    I_COUNT(0),
@@ -91,7 +91,7 @@ int cayman_solid_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 			    CF_INST(SQ_CF_INST_END),
 			    BARRIER(1));
     /* 4/5 */
-    shader[i++] = VTX_DWORD0(VTX_INST(SQ_VTX_INST_FETCH),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD0(VTX_INST(SQ_VTX_INST_FETCH),
 			     FETCH_TYPE(SQ_VTX_FETCH_VERTEX_DATA),
 			     FETCH_WHOLE_QUAD(0),
 			     BUFFER_ID(0),
@@ -102,7 +102,7 @@ int cayman_solid_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 			     STRUCTURED_READ(SQ_VTX_STRU_READ_OFF),
 			     LDS_REQ(0),
 			     COALESCED_READ(0));
-    shader[i++] = VTX_DWORD1_GPR(DST_GPR(1),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD1_GPR(DST_GPR(1),
 				 DST_REL(0),
 				 DST_SEL_X(SQ_SEL_X),
 				 DST_SEL_Y(SQ_SEL_Y),
@@ -113,7 +113,7 @@ int cayman_solid_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 				 NUM_FORMAT_ALL(SQ_NUM_FORMAT_SCALED),
 				 FORMAT_COMP_ALL(SQ_FORMAT_COMP_SIGNED),
 				 SRF_MODE_ALL(SRF_MODE_ZERO_CLAMP_MINUS_ONE));
-    shader[i++] = VTX_DWORD2(OFFSET(0),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD2(OFFSET(0),
 #if X_BYTE_ORDER == X_BIG_ENDIAN
 			     ENDIAN_SWAP(SQ_ENDIAN_8IN32),
 #else
@@ -122,22 +122,22 @@ int cayman_solid_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 			     CONST_BUF_NO_STRIDE(0),
 			     ALT_CONST(0),
 			     BUFFER_INDEX_MODE(SQ_CF_INDEX_NONE));
-    shader[i++] = VTX_DWORD_PAD;
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD_PAD;
 
     return i;
 }
 
 /* solid ps --------------------------------------- */
-int cayman_solid_ps(RADEONChipFamily ChipSet, uint32_t* shader)
+int cayman_solid_ps(RADEONChipFamily ChipSet, uint32_t *shader, uint32_t variant, int max)
 {
     int i = 0;
 
     /* 0 */
-    shader[i++] = CF_ALU_DWORD0(ADDR(3),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD0(ADDR(3),
 				KCACHE_BANK0(0),
 				KCACHE_BANK1(0),
 				KCACHE_MODE0(SQ_CF_KCACHE_LOCK_1));
-    shader[i++] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
 				KCACHE_ADDR0(0),
 				KCACHE_ADDR1(0),
 				I_COUNT(4),
@@ -146,13 +146,13 @@ int cayman_solid_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 				WHOLE_QUAD_MODE(0),
 				BARRIER(1));
     /* 1 */
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(CF_PIXEL_MRT0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(CF_PIXEL_MRT0),
 					  TYPE(SQ_EXPORT_PIXEL),
 					  RW_GPR(0),
 					  RW_REL(ABSOLUTE),
 					  INDEX_GPR(0),
 					  ELEM_SIZE(1));
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
 					       SRC_SEL_Y(SQ_SEL_Y),
 					       SRC_SEL_Z(SQ_SEL_Z),
 					       SRC_SEL_W(SQ_SEL_W),
@@ -163,9 +163,9 @@ int cayman_solid_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 					       BARRIER(1));
 
     /* 2 - end */
-    shader[i++] = CF_DWORD0(ADDR(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(0),
 			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
 			    CF_CONST(0),
 			    COND(SQ_CF_COND_ACTIVE),
 			    I_COUNT(0),
@@ -173,7 +173,7 @@ int cayman_solid_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			    CF_INST(SQ_CF_INST_END),
 			    BARRIER(1));
     /* 3 */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 0),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_X),
 			     SRC0_NEG(0),
@@ -184,7 +184,7 @@ int cayman_solid_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     INDEX_MODE(SQ_INDEX_AR_X),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
 				 UPDATE_PRED(0),
@@ -197,7 +197,7 @@ int cayman_solid_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 				 DST_ELEM(ELEM_X),
 				 CLAMP(1));
     /* 4 */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 0),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_Y),
 			     SRC0_NEG(0),
@@ -208,7 +208,7 @@ int cayman_solid_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     INDEX_MODE(SQ_INDEX_AR_X),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
 				 UPDATE_PRED(0),
@@ -221,7 +221,7 @@ int cayman_solid_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 				 DST_ELEM(ELEM_Y),
 				 CLAMP(1));
     /* 5 */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 0),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_Z),
 			     SRC0_NEG(0),
@@ -232,7 +232,7 @@ int cayman_solid_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     INDEX_MODE(SQ_INDEX_AR_X),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
 				 UPDATE_PRED(0),
@@ -245,7 +245,7 @@ int cayman_solid_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 				 DST_ELEM(ELEM_Z),
 				 CLAMP(1));
     /* 6 */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 0),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_W),
 			     SRC0_NEG(0),
@@ -256,7 +256,7 @@ int cayman_solid_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     INDEX_MODE(SQ_INDEX_AR_X),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(1));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
 				 UPDATE_PRED(0),
@@ -273,14 +273,14 @@ int cayman_solid_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 }
 
 /* copy vs --------------------------------------- */
-int cayman_copy_vs(RADEONChipFamily ChipSet, uint32_t* shader)
+int cayman_copy_vs(RADEONChipFamily ChipSet, uint32_t *shader, uint32_t variant, int max)
 {
     int i = 0;
 
     /* 0 */
-    shader[i++] = CF_DWORD0(ADDR(4),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(4),
 			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
 			    CF_CONST(0),
 			    COND(SQ_CF_COND_ACTIVE),
 			    I_COUNT(2),
@@ -288,13 +288,13 @@ int cayman_copy_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 			    CF_INST(SQ_CF_INST_TC),
 			    BARRIER(1));
     /* 1 */
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(CF_POS0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(CF_POS0),
 					  TYPE(SQ_EXPORT_POS),
 					  RW_GPR(1),
 					  RW_REL(ABSOLUTE),
 					  INDEX_GPR(0),
 					  ELEM_SIZE(0));
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
 					       SRC_SEL_Y(SQ_SEL_Y),
 					       SRC_SEL_Z(SQ_SEL_Z),
 					       SRC_SEL_W(SQ_SEL_W),
@@ -304,13 +304,13 @@ int cayman_copy_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 					       MARK(0),
 					       BARRIER(1));
     /* 2 */
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(0),
 					  TYPE(SQ_EXPORT_PARAM),
 					  RW_GPR(0),
 					  RW_REL(ABSOLUTE),
 					  INDEX_GPR(0),
 					  ELEM_SIZE(0));
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
 					       SRC_SEL_Y(SQ_SEL_Y),
 					       SRC_SEL_Z(SQ_SEL_Z),
 					       SRC_SEL_W(SQ_SEL_W),
@@ -320,9 +320,9 @@ int cayman_copy_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 					       MARK(0),
 					       BARRIER(0));
     /* 3 - end */
-    shader[i++] = CF_DWORD0(ADDR(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(0),
 			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
 			    CF_CONST(0),
 			    COND(SQ_CF_COND_ACTIVE),
 			    I_COUNT(0),
@@ -330,7 +330,7 @@ int cayman_copy_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 			    CF_INST(SQ_CF_INST_END),
 			    BARRIER(1));
     /* 4/5 */
-    shader[i++] = VTX_DWORD0(VTX_INST(SQ_VTX_INST_FETCH),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD0(VTX_INST(SQ_VTX_INST_FETCH),
 			     FETCH_TYPE(SQ_VTX_FETCH_VERTEX_DATA),
 			     FETCH_WHOLE_QUAD(0),
 			     BUFFER_ID(0),
@@ -341,7 +341,7 @@ int cayman_copy_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 			     STRUCTURED_READ(SQ_VTX_STRU_READ_OFF),
 			     LDS_REQ(0),
 			     COALESCED_READ(0));
-    shader[i++] = VTX_DWORD1_GPR(DST_GPR(1),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD1_GPR(DST_GPR(1),
 				 DST_REL(0),
 				 DST_SEL_X(SQ_SEL_X),
 				 DST_SEL_Y(SQ_SEL_Y),
@@ -352,7 +352,7 @@ int cayman_copy_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 				 NUM_FORMAT_ALL(SQ_NUM_FORMAT_SCALED),
 				 FORMAT_COMP_ALL(SQ_FORMAT_COMP_SIGNED),
 				 SRF_MODE_ALL(SRF_MODE_ZERO_CLAMP_MINUS_ONE));
-    shader[i++] = VTX_DWORD2(OFFSET(0),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD2(OFFSET(0),
 #if X_BYTE_ORDER == X_BIG_ENDIAN
                              ENDIAN_SWAP(SQ_ENDIAN_8IN32),
 #else
@@ -361,9 +361,9 @@ int cayman_copy_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 			     CONST_BUF_NO_STRIDE(0),
 			     ALT_CONST(0),
 			     BUFFER_INDEX_MODE(SQ_CF_INDEX_NONE));
-    shader[i++] = VTX_DWORD_PAD;
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD_PAD;
     /* 6/7 */
-    shader[i++] = VTX_DWORD0(VTX_INST(SQ_VTX_INST_FETCH),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD0(VTX_INST(SQ_VTX_INST_FETCH),
 			     FETCH_TYPE(SQ_VTX_FETCH_VERTEX_DATA),
 			     FETCH_WHOLE_QUAD(0),
 			     BUFFER_ID(0),
@@ -374,7 +374,7 @@ int cayman_copy_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 			     STRUCTURED_READ(SQ_VTX_STRU_READ_OFF),
 			     LDS_REQ(0),
 			     COALESCED_READ(0));
-    shader[i++] = VTX_DWORD1_GPR(DST_GPR(0),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD1_GPR(DST_GPR(0),
 				 DST_REL(0),
 				 DST_SEL_X(SQ_SEL_X),
 				 DST_SEL_Y(SQ_SEL_Y),
@@ -385,7 +385,7 @@ int cayman_copy_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 				 NUM_FORMAT_ALL(SQ_NUM_FORMAT_SCALED),
 				 FORMAT_COMP_ALL(SQ_FORMAT_COMP_SIGNED),
 				 SRF_MODE_ALL(SRF_MODE_ZERO_CLAMP_MINUS_ONE));
-    shader[i++] = VTX_DWORD2(OFFSET(8),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD2(OFFSET(8),
 #if X_BYTE_ORDER == X_BIG_ENDIAN
                              ENDIAN_SWAP(SQ_ENDIAN_8IN32),
 #else
@@ -394,22 +394,22 @@ int cayman_copy_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 			     CONST_BUF_NO_STRIDE(0),
 			     ALT_CONST(0),
 			     BUFFER_INDEX_MODE(SQ_CF_INDEX_NONE));
-    shader[i++] = VTX_DWORD_PAD;
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD_PAD;
 
     return i;
 }
 
 /* copy ps --------------------------------------- */
-int cayman_copy_ps(RADEONChipFamily ChipSet, uint32_t* shader)
+int cayman_copy_ps(RADEONChipFamily ChipSet, uint32_t *shader, uint32_t variant, int max)
 {
     int i = 0;
 
     /* CF INST 0 */
-    shader[i++] = CF_ALU_DWORD0(ADDR(4),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD0(ADDR(4),
 				KCACHE_BANK0(0),
 				KCACHE_BANK1(0),
 				KCACHE_MODE0(SQ_CF_KCACHE_NOP));
-    shader[i++] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
 				KCACHE_ADDR0(0),
 				KCACHE_ADDR1(0),
 				I_COUNT(4),
@@ -418,9 +418,9 @@ int cayman_copy_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 				WHOLE_QUAD_MODE(0),
 				BARRIER(1));
     /* CF INST 1 */
-    shader[i++] = CF_DWORD0(ADDR(8),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(8),
 			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
 			    CF_CONST(0),
 			    COND(SQ_CF_COND_ACTIVE),
 			    I_COUNT(1),
@@ -428,13 +428,13 @@ int cayman_copy_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			    CF_INST(SQ_CF_INST_TC),
 			    BARRIER(1));
     /* CF INST 2 */
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(CF_PIXEL_MRT0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(CF_PIXEL_MRT0),
 					  TYPE(SQ_EXPORT_PIXEL),
 					  RW_GPR(0),
 					  RW_REL(ABSOLUTE),
 					  INDEX_GPR(0),
 					  ELEM_SIZE(1));
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
 					       SRC_SEL_Y(SQ_SEL_Y),
 					       SRC_SEL_Z(SQ_SEL_Z),
 					       SRC_SEL_W(SQ_SEL_W),
@@ -444,9 +444,9 @@ int cayman_copy_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 					       MARK(0),
 					       BARRIER(1));
     /* CF INST 3 - end */
-    shader[i++] = CF_DWORD0(ADDR(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(0),
 			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
 			    CF_CONST(0),
 			    COND(SQ_CF_COND_ACTIVE),
 			    I_COUNT(0),
@@ -454,7 +454,7 @@ int cayman_copy_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			    CF_INST(SQ_CF_INST_END),
 			    BARRIER(1));
     /* 4 interpolate tex coords */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_Y),
 			     SRC0_NEG(0),
@@ -465,7 +465,7 @@ int cayman_copy_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     INDEX_MODE(SQ_INDEX_AR_X),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
 				 UPDATE_PRED(0),
@@ -478,7 +478,7 @@ int cayman_copy_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 				 DST_ELEM(ELEM_X),
 				 CLAMP(0));
     /* 5 */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_X),
 			     SRC0_NEG(0),
@@ -489,7 +489,7 @@ int cayman_copy_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     INDEX_MODE(SQ_INDEX_AR_X),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
 				 UPDATE_PRED(0),
@@ -502,7 +502,7 @@ int cayman_copy_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 				 DST_ELEM(ELEM_Y),
 				 CLAMP(0));
     /* 6 */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_Y),
 			     SRC0_NEG(0),
@@ -513,7 +513,7 @@ int cayman_copy_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     INDEX_MODE(SQ_INDEX_AR_X),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
 				 UPDATE_PRED(0),
@@ -526,7 +526,7 @@ int cayman_copy_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 				 DST_ELEM(ELEM_Z),
 				 CLAMP(0));
     /* 7 */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_X),
 			     SRC0_NEG(0),
@@ -537,7 +537,7 @@ int cayman_copy_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     INDEX_MODE(SQ_INDEX_AR_X),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(1));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
 				 UPDATE_PRED(0),
@@ -551,7 +551,7 @@ int cayman_copy_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 				 CLAMP(0));
 
     /* 8/9 TEX INST 0 */
-    shader[i++] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
 			     INST_MOD(0),
 			     FETCH_WHOLE_QUAD(0),
 			     RESOURCE_ID(0),
@@ -560,7 +560,7 @@ int cayman_copy_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     ALT_CONST(0),
 			     RESOURCE_INDEX_MODE(SQ_CF_INDEX_NONE),
 			     SAMPLER_INDEX_MODE(SQ_CF_INDEX_NONE));
-    shader[i++] = TEX_DWORD1(DST_GPR(0),
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD1(DST_GPR(0),
 			     DST_REL(ABSOLUTE),
 			     DST_SEL_X(SQ_SEL_X), /* R */
 			     DST_SEL_Y(SQ_SEL_Y), /* G */
@@ -571,7 +571,7 @@ int cayman_copy_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     COORD_TYPE_Y(TEX_UNNORMALIZED),
 			     COORD_TYPE_Z(TEX_UNNORMALIZED),
 			     COORD_TYPE_W(TEX_UNNORMALIZED));
-    shader[i++] = TEX_DWORD2(OFFSET_X(0),
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD2(OFFSET_X(0),
 			     OFFSET_Y(0),
 			     OFFSET_Z(0),
 			     SAMPLER_ID(0),
@@ -579,19 +579,19 @@ int cayman_copy_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     SRC_SEL_Y(SQ_SEL_Y),
 			     SRC_SEL_Z(SQ_SEL_0),
 			     SRC_SEL_W(SQ_SEL_1));
-    shader[i++] = TEX_DWORD_PAD;
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD_PAD;
 
     return i;
 }
 
-int cayman_xv_vs(RADEONChipFamily ChipSet, uint32_t* shader)
+int cayman_xv_vs(RADEONChipFamily ChipSet, uint32_t *shader, uint32_t variant, int max)
 {
     int i = 0;
 
     /* 0 */
-    shader[i++] = CF_DWORD0(ADDR(8),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(8),
 			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
                             CF_CONST(0),
                             COND(SQ_CF_COND_ACTIVE),
                             I_COUNT(2),
@@ -600,11 +600,11 @@ int cayman_xv_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                             BARRIER(1));
 
     /* 1 - ALU */
-    shader[i++] = CF_ALU_DWORD0(ADDR(5),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD0(ADDR(5),
 				KCACHE_BANK0(0),
 				KCACHE_BANK1(0),
 				KCACHE_MODE0(SQ_CF_KCACHE_LOCK_1));
-    shader[i++] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
 				KCACHE_ADDR0(0),
 				KCACHE_ADDR1(0),
 				I_COUNT(2),
@@ -614,13 +614,13 @@ int cayman_xv_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 				BARRIER(1));
 
     /* 2 */
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(CF_POS0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(CF_POS0),
                                           TYPE(SQ_EXPORT_POS),
                                           RW_GPR(1),
                                           RW_REL(ABSOLUTE),
                                           INDEX_GPR(0),
                                           ELEM_SIZE(3));
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
                                                SRC_SEL_Y(SQ_SEL_Y),
                                                SRC_SEL_Z(SQ_SEL_Z),
                                                SRC_SEL_W(SQ_SEL_W),
@@ -630,13 +630,13 @@ int cayman_xv_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                                MARK(0),
                                                BARRIER(1));
     /* 3 */
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(0),
                                           TYPE(SQ_EXPORT_PARAM),
                                           RW_GPR(0),
                                           RW_REL(ABSOLUTE),
                                           INDEX_GPR(0),
                                           ELEM_SIZE(3));
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
                                                SRC_SEL_Y(SQ_SEL_Y),
                                                SRC_SEL_Z(SQ_SEL_Z),
                                                SRC_SEL_W(SQ_SEL_W),
@@ -646,9 +646,9 @@ int cayman_xv_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                                MARK(0),
                                                BARRIER(0));
     /* 4 - end */
-    shader[i++] = CF_DWORD0(ADDR(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(0),
 			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
 			    CF_CONST(0),
 			    COND(SQ_CF_COND_ACTIVE),
 			    I_COUNT(0),
@@ -656,7 +656,7 @@ int cayman_xv_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 			    CF_INST(SQ_CF_INST_END),
 			    BARRIER(1));
     /* 5 texX / w */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_X),
                              SRC0_NEG(0),
@@ -667,7 +667,7 @@ int cayman_xv_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_AR_X),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
                                  UPDATE_PRED(0),
@@ -681,7 +681,7 @@ int cayman_xv_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 6 texY / h */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_Y),
                              SRC0_NEG(0),
@@ -692,7 +692,7 @@ int cayman_xv_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_AR_X),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(1));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
                                  UPDATE_PRED(0),
@@ -706,10 +706,10 @@ int cayman_xv_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 7 - padding */
-    shader[i++] = 0x00000000;
-    shader[i++] = 0x00000000;
+    shader[RADEON_SHADER_DW(i, max)] = 0x00000000;
+    shader[RADEON_SHADER_DW(i, max)] = 0x00000000;
     /* 8/9 */
-    shader[i++] = VTX_DWORD0(VTX_INST(SQ_VTX_INST_FETCH),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD0(VTX_INST(SQ_VTX_INST_FETCH),
                              FETCH_TYPE(SQ_VTX_FETCH_VERTEX_DATA),
                              FETCH_WHOLE_QUAD(0),
                              BUFFER_ID(0),
@@ -720,7 +720,7 @@ int cayman_xv_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 			     STRUCTURED_READ(SQ_VTX_STRU_READ_OFF),
 			     LDS_REQ(0),
 			     COALESCED_READ(0));
-    shader[i++] = VTX_DWORD1_GPR(DST_GPR(1),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD1_GPR(DST_GPR(1),
                                  DST_REL(ABSOLUTE),
                                  DST_SEL_X(SQ_SEL_X),
                                  DST_SEL_Y(SQ_SEL_Y),
@@ -731,7 +731,7 @@ int cayman_xv_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  NUM_FORMAT_ALL(SQ_NUM_FORMAT_SCALED),
                                  FORMAT_COMP_ALL(SQ_FORMAT_COMP_SIGNED),
                                  SRF_MODE_ALL(SRF_MODE_ZERO_CLAMP_MINUS_ONE));
-    shader[i++] = VTX_DWORD2(OFFSET(0),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD2(OFFSET(0),
 #if X_BYTE_ORDER == X_BIG_ENDIAN
                              ENDIAN_SWAP(SQ_ENDIAN_8IN32),
 #else
@@ -740,9 +740,9 @@ int cayman_xv_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              CONST_BUF_NO_STRIDE(0),
 			     ALT_CONST(0),
 			     BUFFER_INDEX_MODE(SQ_CF_INDEX_NONE));
-    shader[i++] = VTX_DWORD_PAD;
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD_PAD;
     /* 10/11 */
-    shader[i++] = VTX_DWORD0(VTX_INST(SQ_VTX_INST_FETCH),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD0(VTX_INST(SQ_VTX_INST_FETCH),
                              FETCH_TYPE(SQ_VTX_FETCH_VERTEX_DATA),
                              FETCH_WHOLE_QUAD(0),
                              BUFFER_ID(0),
@@ -753,7 +753,7 @@ int cayman_xv_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 			     STRUCTURED_READ(SQ_VTX_STRU_READ_OFF),
 			     LDS_REQ(0),
 			     COALESCED_READ(0));
-    shader[i++] = VTX_DWORD1_GPR(DST_GPR(0),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD1_GPR(DST_GPR(0),
                                  DST_REL(ABSOLUTE),
                                  DST_SEL_X(SQ_SEL_X),
                                  DST_SEL_Y(SQ_SEL_Y),
@@ -764,7 +764,7 @@ int cayman_xv_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  NUM_FORMAT_ALL(SQ_NUM_FORMAT_SCALED),
                                  FORMAT_COMP_ALL(SQ_FORMAT_COMP_SIGNED),
                                  SRF_MODE_ALL(SRF_MODE_ZERO_CLAMP_MINUS_ONE));
-    shader[i++] = VTX_DWORD2(OFFSET(8),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD2(OFFSET(8),
 #if X_BYTE_ORDER == X_BIG_ENDIAN
                              ENDIAN_SWAP(SQ_ENDIAN_8IN32),
 #else
@@ -773,21 +773,21 @@ int cayman_xv_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              CONST_BUF_NO_STRIDE(0),
 			     ALT_CONST(0),
 			     BUFFER_INDEX_MODE(SQ_CF_INDEX_NONE));
-    shader[i++] = VTX_DWORD_PAD;
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD_PAD;
 
     return i;
 }
 
-int cayman_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader)
+int cayman_xv_ps(RADEONChipFamily ChipSet, uint32_t *shader, uint32_t variant, int max)
 {
     int i = 0;
 
     /* 0 */
-    shader[i++] = CF_ALU_DWORD0(ADDR(6),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD0(ADDR(8),
 				KCACHE_BANK0(0),
 				KCACHE_BANK1(0),
 				KCACHE_MODE0(SQ_CF_KCACHE_NOP));
-    shader[i++] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
 				KCACHE_ADDR0(0),
 				KCACHE_ADDR1(0),
 				I_COUNT(4),
@@ -796,9 +796,9 @@ int cayman_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 				WHOLE_QUAD_MODE(0),
 				BARRIER(1));
     /* 1 */
-    shader[i++] = CF_DWORD0(ADDR(22),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(24),
 			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
                             CF_CONST(0),
                             COND(SQ_CF_COND_BOOL),
                             I_COUNT(0),
@@ -806,9 +806,9 @@ int cayman_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader)
                             CF_INST(SQ_CF_INST_CALL),
                             BARRIER(0));
     /* 2 */
-    shader[i++] = CF_DWORD0(ADDR(30),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(32),
 			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
                             CF_CONST(0),
                             COND(SQ_CF_COND_NOT_BOOL),
                             I_COUNT(0),
@@ -816,11 +816,11 @@ int cayman_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader)
                             CF_INST(SQ_CF_INST_CALL),
                             BARRIER(0));
     /* 3 */
-    shader[i++] = CF_ALU_DWORD0(ADDR(10),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD0(ADDR(12),
                                 KCACHE_BANK0(0),
                                 KCACHE_BANK1(0),
                                 KCACHE_MODE0(SQ_CF_KCACHE_LOCK_1));
-    shader[i++] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
                                 KCACHE_ADDR0(0),
                                 KCACHE_ADDR1(0),
                                 I_COUNT(12),
@@ -828,14 +828,34 @@ int cayman_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader)
                                 CF_INST(SQ_CF_INST_ALU),
 				WHOLE_QUAD_MODE(0),
                                 BARRIER(1));
-    /* 4 */
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(CF_PIXEL_MRT0),
+    /* 4 - gamma correction, bool 1 */
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(36),
+                            JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
+                            CF_CONST(1),
+                            COND(SQ_CF_COND_BOOL),
+                            I_COUNT(0),
+                            VALID_PIXEL_MODE(0),
+                            CF_INST(SQ_CF_INST_CALL),
+                            BARRIER(0));
+    /* 5 */
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(0),
+                            JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
+                            CF_CONST(0),
+                            COND(SQ_CF_COND_ACTIVE),
+                            I_COUNT(0),
+                            VALID_PIXEL_MODE(0),
+                            CF_INST(SQ_CF_INST_NOP),
+                            BARRIER(1));
+    /* 6 */
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(CF_PIXEL_MRT0),
                                           TYPE(SQ_EXPORT_PIXEL),
                                           RW_GPR(2),
                                           RW_REL(ABSOLUTE),
                                           INDEX_GPR(0),
                                           ELEM_SIZE(3));
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
                                                SRC_SEL_Y(SQ_SEL_Y),
                                                SRC_SEL_Z(SQ_SEL_Z),
                                                SRC_SEL_W(SQ_SEL_W),
@@ -844,18 +864,18 @@ int cayman_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader)
                                                CF_INST(SQ_CF_INST_EXPORT_DONE),
                                                MARK(0),
                                                BARRIER(1));
-    /* 5 - end */
-    shader[i++] = CF_DWORD0(ADDR(0),
+    /* 7 - end */
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(0),
 			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
 			    CF_CONST(0),
 			    COND(SQ_CF_COND_ACTIVE),
 			    I_COUNT(0),
 			    VALID_PIXEL_MODE(0),
 			    CF_INST(SQ_CF_INST_END),
 			    BARRIER(1));
-    /* 6 interpolate tex coords */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    /* 8 interpolate tex coords */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_Y),
 			     SRC0_NEG(0),
@@ -866,7 +886,7 @@ int cayman_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     INDEX_MODE(SQ_INDEX_AR_X),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
 				 UPDATE_PRED(0),
@@ -878,8 +898,8 @@ int cayman_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 				 DST_REL(ABSOLUTE),
 				 DST_ELEM(ELEM_X),
 				 CLAMP(0));
-    /* 7 */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    /* 9 */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_X),
 			     SRC0_NEG(0),
@@ -890,7 +910,7 @@ int cayman_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     INDEX_MODE(SQ_INDEX_AR_X),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
 				 UPDATE_PRED(0),
@@ -902,8 +922,8 @@ int cayman_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 				 DST_REL(ABSOLUTE),
 				 DST_ELEM(ELEM_Y),
 				 CLAMP(0));
-    /* 8 */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    /* 10 */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_Y),
 			     SRC0_NEG(0),
@@ -914,7 +934,7 @@ int cayman_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     INDEX_MODE(SQ_INDEX_AR_X),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
 				 UPDATE_PRED(0),
@@ -926,8 +946,8 @@ int cayman_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 				 DST_REL(ABSOLUTE),
 				 DST_ELEM(ELEM_Z),
 				 CLAMP(0));
-    /* 9 */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    /* 11 */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_X),
 			     SRC0_NEG(0),
@@ -938,7 +958,7 @@ int cayman_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     INDEX_MODE(SQ_INDEX_AR_X),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(1));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
 				 UPDATE_PRED(0),
@@ -951,9 +971,9 @@ int cayman_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 				 DST_ELEM(ELEM_W),
 				 CLAMP(0));
 
-    /* 10,11,12,13 */
+    /* 12,13,14,15 */
     /* r2.x = MAD(c0.w, r1.x, c0.x) */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 0),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_W),
                              SRC0_NEG(0),
@@ -964,7 +984,7 @@ int cayman_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP3(SRC2_SEL(ALU_SRC_KCACHE0_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(ALU_SRC_KCACHE0_BASE + 0),
                                  SRC2_REL(ABSOLUTE),
                                  SRC2_ELEM(ELEM_X),
                                  SRC2_NEG(0),
@@ -975,7 +995,7 @@ int cayman_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader)
                                  DST_ELEM(ELEM_X),
                                  CLAMP(0));
     /* r2.y = MAD(c0.w, r1.x, c0.y) */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 0),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_W),
                              SRC0_NEG(0),
@@ -986,7 +1006,7 @@ int cayman_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP3(SRC2_SEL(ALU_SRC_KCACHE0_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(ALU_SRC_KCACHE0_BASE + 0),
                                  SRC2_REL(ABSOLUTE),
                                  SRC2_ELEM(ELEM_Y),
                                  SRC2_NEG(0),
@@ -997,7 +1017,7 @@ int cayman_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader)
                                  DST_ELEM(ELEM_Y),
                                  CLAMP(0));
     /* r2.z = MAD(c0.w, r1.x, c0.z) */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 0),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_W),
                              SRC0_NEG(0),
@@ -1008,7 +1028,7 @@ int cayman_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP3(SRC2_SEL(ALU_SRC_KCACHE0_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(ALU_SRC_KCACHE0_BASE + 0),
                                  SRC2_REL(ABSOLUTE),
                                  SRC2_ELEM(ELEM_Z),
                                  SRC2_NEG(0),
@@ -1019,7 +1039,7 @@ int cayman_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader)
                                  DST_ELEM(ELEM_Z),
                                  CLAMP(0));
     /* r2.w = MAD(0, 0, 1) */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(SQ_ALU_SRC_0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(SQ_ALU_SRC_0),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_X),
                              SRC0_NEG(0),
@@ -1030,7 +1050,7 @@ int cayman_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(1));
-    shader[i++] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_1),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_1),
                                  SRC2_REL(ABSOLUTE),
                                  SRC2_ELEM(ELEM_X),
                                  SRC2_NEG(0),
@@ -1041,9 +1061,9 @@ int cayman_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader)
                                  DST_ELEM(ELEM_W),
                                  CLAMP(0));
 
-    /* 14,15,16,17 */
+    /* 16,17,18,19 */
     /* r2.x = MAD(c1.x, r1.y, pv.x) */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 1),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 1),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_X),
                              SRC0_NEG(0),
@@ -1054,7 +1074,162 @@ int cayman_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_PV),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_PV),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_X),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_X),
+                                 CLAMP(0));
+    /* r2.y = MAD(c1.y, r1.y, pv.y) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 1),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Y),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 1),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Y),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_PV),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_Y),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Y),
+                                 CLAMP(0));
+    /* r2.z = MAD(c1.z, r1.y, pv.z) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 1),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Z),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 1),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Y),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_PV),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_Z),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Z),
+                                 CLAMP(0));
+    /* r2.w = MAD(0, 0, 1) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(SQ_ALU_SRC_0),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(SQ_ALU_SRC_0),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_X),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_1),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_W),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_W),
+                                 CLAMP(0));
+    /* 20,21,22,23 */
+    /* r2.x = MAD(c2.x, r1.z, pv.x) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 1),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Z),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_PV),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_X),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_X),
+                                 CLAMP(1));
+    /* r2.y = MAD(c2.y, r1.z, pv.y) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Y),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 1),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Z),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_PV),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_Y),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Y),
+                                 CLAMP(1));
+    /* r2.z = MAD(c2.z, r1.z, pv.z) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Z),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 1),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Z),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_PV),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_Z),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Z),
+                                 CLAMP(1));
+    /* r2.w = MAD(0, 0, 1) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(SQ_ALU_SRC_0),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(SQ_ALU_SRC_0),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_X),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_1),
                                  SRC2_REL(ABSOLUTE),
                                  SRC2_ELEM(ELEM_X),
                                  SRC2_NEG(0),
@@ -1062,337 +1237,2229 @@ int cayman_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader)
                                  BANK_SWIZZLE(SQ_ALU_VEC_012),
                                  DST_GPR(2),
                                  DST_REL(ABSOLUTE),
-                                 DST_ELEM(ELEM_X),
-                                 CLAMP(0));
-    /* r2.y = MAD(c1.y, r1.y, pv.y) */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 1),
+                                 DST_ELEM(ELEM_W),
+                                 CLAMP(1));
+
+    /* 24 */
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(26),
+			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
+                            CF_CONST(0),
+                            COND(SQ_CF_COND_ACTIVE),
+                            I_COUNT(3),
+                            VALID_PIXEL_MODE(0),
+                            CF_INST(SQ_CF_INST_TC),
+                            BARRIER(1));
+    /* 25 */
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(0),
+			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
+			    CF_CONST(0),
+			    COND(SQ_CF_COND_ACTIVE),
+			    I_COUNT(0),
+			    VALID_PIXEL_MODE(0),
+			    CF_INST(SQ_CF_INST_RETURN),
+			    BARRIER(1));
+    /* 26/27 */
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
+                             INST_MOD(0),
+                             FETCH_WHOLE_QUAD(0),
+                             RESOURCE_ID(0),
+                             SRC_GPR(0),
+                             SRC_REL(ABSOLUTE),
+                             ALT_CONST(0),
+			     RESOURCE_INDEX_MODE(SQ_CF_INDEX_NONE),
+			     SAMPLER_INDEX_MODE(SQ_CF_INDEX_NONE));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD1(DST_GPR(1),
+                             DST_REL(ABSOLUTE),
+                             DST_SEL_X(SQ_SEL_X),
+                             DST_SEL_Y(SQ_SEL_MASK),
+                             DST_SEL_Z(SQ_SEL_MASK),
+                             DST_SEL_W(SQ_SEL_1),
+                             LOD_BIAS(0),
+                             COORD_TYPE_X(TEX_NORMALIZED),
+                             COORD_TYPE_Y(TEX_NORMALIZED),
+                             COORD_TYPE_Z(TEX_NORMALIZED),
+                             COORD_TYPE_W(TEX_NORMALIZED));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD2(OFFSET_X(0),
+                             OFFSET_Y(0),
+                             OFFSET_Z(0),
+                             SAMPLER_ID(0),
+                             SRC_SEL_X(SQ_SEL_X),
+                             SRC_SEL_Y(SQ_SEL_Y),
+                             SRC_SEL_Z(SQ_SEL_0),
+                             SRC_SEL_W(SQ_SEL_1));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD_PAD;
+    /* 28/29 */
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
+                             INST_MOD(0),
+                             FETCH_WHOLE_QUAD(0),
+                             RESOURCE_ID(1),
+                             SRC_GPR(0),
+                             SRC_REL(ABSOLUTE),
+                             ALT_CONST(0),
+			     RESOURCE_INDEX_MODE(SQ_CF_INDEX_NONE),
+			     SAMPLER_INDEX_MODE(SQ_CF_INDEX_NONE));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD1(DST_GPR(1),
+                             DST_REL(ABSOLUTE),
+                             DST_SEL_X(SQ_SEL_MASK),
+                             DST_SEL_Y(SQ_SEL_MASK),
+                             DST_SEL_Z(SQ_SEL_X),
+                             DST_SEL_W(SQ_SEL_MASK),
+                             LOD_BIAS(0),
+                             COORD_TYPE_X(TEX_NORMALIZED),
+                             COORD_TYPE_Y(TEX_NORMALIZED),
+                             COORD_TYPE_Z(TEX_NORMALIZED),
+                             COORD_TYPE_W(TEX_NORMALIZED));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD2(OFFSET_X(0),
+                             OFFSET_Y(0),
+                             OFFSET_Z(0),
+                             SAMPLER_ID(1),
+                             SRC_SEL_X(SQ_SEL_X),
+                             SRC_SEL_Y(SQ_SEL_Y),
+                             SRC_SEL_Z(SQ_SEL_0),
+                             SRC_SEL_W(SQ_SEL_1));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD_PAD;
+    /* 30/31 */
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
+                             INST_MOD(0),
+                             FETCH_WHOLE_QUAD(0),
+                             RESOURCE_ID(2),
+                             SRC_GPR(0),
+                             SRC_REL(ABSOLUTE),
+                             ALT_CONST(0),
+			     RESOURCE_INDEX_MODE(SQ_CF_INDEX_NONE),
+			     SAMPLER_INDEX_MODE(SQ_CF_INDEX_NONE));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD1(DST_GPR(1),
+                             DST_REL(ABSOLUTE),
+                             DST_SEL_X(SQ_SEL_MASK),
+                             DST_SEL_Y(SQ_SEL_X),
+                             DST_SEL_Z(SQ_SEL_MASK),
+                             DST_SEL_W(SQ_SEL_MASK),
+                             LOD_BIAS(0),
+                             COORD_TYPE_X(TEX_NORMALIZED),
+                             COORD_TYPE_Y(TEX_NORMALIZED),
+                             COORD_TYPE_Z(TEX_NORMALIZED),
+                             COORD_TYPE_W(TEX_NORMALIZED));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD2(OFFSET_X(0),
+                             OFFSET_Y(0),
+                             OFFSET_Z(0),
+                             SAMPLER_ID(2),
+                             SRC_SEL_X(SQ_SEL_X),
+                             SRC_SEL_Y(SQ_SEL_Y),
+                             SRC_SEL_Z(SQ_SEL_0),
+                             SRC_SEL_W(SQ_SEL_1));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD_PAD;
+    /* 32 */
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(34),
+			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
+                            CF_CONST(0),
+                            COND(SQ_CF_COND_ACTIVE),
+                            I_COUNT(1),
+                            VALID_PIXEL_MODE(0),
+                            CF_INST(SQ_CF_INST_TC),
+                            BARRIER(1));
+    /* 33 */
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(0),
+			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
+			    CF_CONST(0),
+			    COND(SQ_CF_COND_ACTIVE),
+			    I_COUNT(0),
+			    VALID_PIXEL_MODE(0),
+			    CF_INST(SQ_CF_INST_RETURN),
+			    BARRIER(1));
+    /* 34/35 */
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
+                             INST_MOD(0),
+                             FETCH_WHOLE_QUAD(0),
+                             RESOURCE_ID(0),
+                             SRC_GPR(0),
+                             SRC_REL(ABSOLUTE),
+                             ALT_CONST(0),
+                             RESOURCE_INDEX_MODE(SQ_CF_INDEX_NONE),
+                             SAMPLER_INDEX_MODE(SQ_CF_INDEX_NONE));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD1(DST_GPR(1),
+                             DST_REL(ABSOLUTE),
+                             DST_SEL_X(SQ_SEL_X),
+                             DST_SEL_Y(SQ_SEL_Y),
+                             DST_SEL_Z(SQ_SEL_Z),
+                             DST_SEL_W(SQ_SEL_1),
+                             LOD_BIAS(0),
+                             COORD_TYPE_X(TEX_NORMALIZED),
+                             COORD_TYPE_Y(TEX_NORMALIZED),
+                             COORD_TYPE_Z(TEX_NORMALIZED),
+                             COORD_TYPE_W(TEX_NORMALIZED));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD2(OFFSET_X(0),
+                             OFFSET_Y(0),
+                             OFFSET_Z(0),
+                             SAMPLER_ID(0),
+                             SRC_SEL_X(SQ_SEL_X),
+                             SRC_SEL_Y(SQ_SEL_Y),
+                             SRC_SEL_Z(SQ_SEL_0),
+                             SRC_SEL_W(SQ_SEL_1));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD_PAD;
+
+    /* 36 - gamma: r2.xyz = 2 ^ (log2(r2.xyz) * c1.w) */
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD0(ADDR(38),
+                                KCACHE_BANK0(0),
+                                KCACHE_BANK1(0),
+                                KCACHE_MODE0(SQ_CF_KCACHE_LOCK_1));
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
+                                KCACHE_ADDR0(0),
+                                KCACHE_ADDR1(0),
+                                I_COUNT(21),
+                                ALT_CONST(0),
+                                CF_INST(SQ_CF_INST_ALU),
+                                WHOLE_QUAD_MODE(0),
+                                BARRIER(1));
+    /* 37 */
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(0),
+                            JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
+                            CF_CONST(0),
+                            COND(SQ_CF_COND_ACTIVE),
+                            I_COUNT(0),
+                            VALID_PIXEL_MODE(0),
+                            CF_INST(SQ_CF_INST_RETURN),
+                            BARRIER(1));
+    /* 38,39,40 */
+    /* r2.x = LOG_CLAMPED(r2.x) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_X),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(1),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_LOG_CLAMPED),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_X),
+                                 CLAMP(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_X),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(0),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_LOG_CLAMPED),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Y),
+                                 CLAMP(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_X),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(0),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_LOG_CLAMPED),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Z),
+                                 CLAMP(0));
+    /* 41,42,43 */
+    /* r2.y = LOG_CLAMPED(r2.y) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Y),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Y),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(0),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_LOG_CLAMPED),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_X),
+                                 CLAMP(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Y),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Y),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(1),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_LOG_CLAMPED),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Y),
+                                 CLAMP(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Y),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Y),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(0),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_LOG_CLAMPED),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Z),
+                                 CLAMP(0));
+    /* 44,45,46 */
+    /* r2.z = LOG_CLAMPED(r2.z) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Z),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Z),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(0),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_LOG_CLAMPED),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_X),
+                                 CLAMP(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Z),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Z),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(0),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_LOG_CLAMPED),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Y),
+                                 CLAMP(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Z),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Z),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(1),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_LOG_CLAMPED),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Z),
+                                 CLAMP(0));
+    /* 47,48,49 */
+    /* r2.x = MUL(r2.x, c1.w) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_KCACHE0_BASE + 1),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_W),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(1),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_MUL),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_X),
+                                 CLAMP(0));
+    /* r2.y = MUL(r2.y, c1.w) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Y),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_KCACHE0_BASE + 1),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_W),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(1),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_MUL),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Y),
+                                 CLAMP(0));
+    /* r2.z = MUL(r2.z, c1.w) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Z),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_KCACHE0_BASE + 1),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_W),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(1),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_MUL),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Z),
+                                 CLAMP(0));
+    /* 50,51,52 */
+    /* r2.x = EXP_IEEE(r2.x) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_X),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(1),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_EXP_IEEE),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_X),
+                                 CLAMP(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_X),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(0),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_EXP_IEEE),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Y),
+                                 CLAMP(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_X),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(0),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_EXP_IEEE),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Z),
+                                 CLAMP(1));
+    /* 53,54,55 */
+    /* r2.y = EXP_IEEE(r2.y) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Y),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Y),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(0),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_EXP_IEEE),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_X),
+                                 CLAMP(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Y),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Y),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(1),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_EXP_IEEE),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Y),
+                                 CLAMP(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Y),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Y),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(0),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_EXP_IEEE),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Z),
+                                 CLAMP(1));
+    /* 56,57,58 */
+    /* r2.z = EXP_IEEE(r2.z) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Z),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Z),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(0),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_EXP_IEEE),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_X),
+                                 CLAMP(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Z),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Z),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(0),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_EXP_IEEE),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Y),
+                                 CLAMP(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Z),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Z),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(1),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_EXP_IEEE),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Z),
+                                 CLAMP(1));
+
+    return i;
+}
+
+/*
+ * xv bicubic ps: planar sources only.  Luma is filtered with four
+ * bilinear fetches placed and weighted from the bicubic lookup table
+ * (resource 3), chroma is sampled bilinearly as in the xv ps.
+ * c3 = { width, height, 1 / width, 1 / height } of the luma plane.
+ */
+int cayman_xv_bicubic_ps(RADEONChipFamily ChipSet, uint32_t *shader, uint32_t variant, int max)
+{
+    int i = 0;
+
+    /* 0 */
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD0(ADDR(9),
+                                KCACHE_BANK0(0),
+                                KCACHE_BANK1(0),
+                                KCACHE_MODE0(SQ_CF_KCACHE_LOCK_1));
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
+                                KCACHE_ADDR0(0),
+                                KCACHE_ADDR1(0),
+                                I_COUNT(6),
+                                ALT_CONST(0),
+                                CF_INST(SQ_CF_INST_ALU),
+                                WHOLE_QUAD_MODE(0),
+                                BARRIER(1));
+    /* 1 */
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(38),
+                            JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
+                            CF_CONST(0),
+                            COND(SQ_CF_COND_ACTIVE),
+                            I_COUNT(4),
+                            VALID_PIXEL_MODE(0),
+                            CF_INST(SQ_CF_INST_TC),
+                            BARRIER(1));
+    /* 2 */
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD0(ADDR(15),
+                                KCACHE_BANK0(0),
+                                KCACHE_BANK1(0),
+                                KCACHE_MODE0(SQ_CF_KCACHE_LOCK_1));
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
+                                KCACHE_ADDR0(0),
+                                KCACHE_ADDR1(0),
+                                I_COUNT(4),
+                                ALT_CONST(0),
+                                CF_INST(SQ_CF_INST_ALU),
+                                WHOLE_QUAD_MODE(0),
+                                BARRIER(1));
+    /* 3 */
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(46),
+                            JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
+                            CF_CONST(0),
+                            COND(SQ_CF_COND_ACTIVE),
+                            I_COUNT(4),
+                            VALID_PIXEL_MODE(0),
+                            CF_INST(SQ_CF_INST_TC),
+                            BARRIER(1));
+    /* 4 */
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD0(ADDR(19),
+                                KCACHE_BANK0(0),
+                                KCACHE_BANK1(0),
+                                KCACHE_MODE0(SQ_CF_KCACHE_LOCK_1));
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
+                                KCACHE_ADDR0(0),
+                                KCACHE_ADDR1(0),
+                                I_COUNT(18),
+                                ALT_CONST(0),
+                                CF_INST(SQ_CF_INST_ALU),
+                                WHOLE_QUAD_MODE(0),
+                                BARRIER(1));
+    /* 5 - gamma correction, bool 1 */
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(54),
+                            JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
+                            CF_CONST(1),
+                            COND(SQ_CF_COND_BOOL),
+                            I_COUNT(0),
+                            VALID_PIXEL_MODE(0),
+                            CF_INST(SQ_CF_INST_CALL),
+                            BARRIER(0));
+    /* 6 */
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(0),
+                            JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
+                            CF_CONST(0),
+                            COND(SQ_CF_COND_ACTIVE),
+                            I_COUNT(0),
+                            VALID_PIXEL_MODE(0),
+                            CF_INST(SQ_CF_INST_NOP),
+                            BARRIER(1));
+    /* 7 */
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(CF_PIXEL_MRT0),
+                                          TYPE(SQ_EXPORT_PIXEL),
+                                          RW_GPR(2),
+                                          RW_REL(ABSOLUTE),
+                                          INDEX_GPR(0),
+                                          ELEM_SIZE(3));
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
+                                               SRC_SEL_Y(SQ_SEL_Y),
+                                               SRC_SEL_Z(SQ_SEL_Z),
+                                               SRC_SEL_W(SQ_SEL_W),
+                                               BURST_COUNT(1),
+                                               VALID_PIXEL_MODE(0),
+                                               CF_INST(SQ_CF_INST_EXPORT_DONE),
+                                               MARK(0),
+                                               BARRIER(1));
+    /* 8 - end */
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(0),
+                            JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
+                            CF_CONST(0),
+                            COND(SQ_CF_COND_ACTIVE),
+                            I_COUNT(0),
+                            VALID_PIXEL_MODE(0),
+                            CF_INST(SQ_CF_INST_END),
+                            BARRIER(1));
+    /* 9,10,11,12 interpolate tex coords */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Y),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_PARAM_BASE + 0),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_X),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_AR_X),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(1),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_INTERP_XY),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_210),
+                                 DST_GPR(0),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_X),
+                                 CLAMP(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_PARAM_BASE + 0),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_X),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_AR_X),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(1),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_INTERP_XY),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_210),
+                                 DST_GPR(0),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Y),
+                                 CLAMP(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Y),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_PARAM_BASE + 0),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_X),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_AR_X),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(0),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_INTERP_XY),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_210),
+                                 DST_GPR(0),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Z),
+                                 CLAMP(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_PARAM_BASE + 0),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_X),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_AR_X),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(0),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_INTERP_XY),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_210),
+                                 DST_GPR(0),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_W),
+                                 CLAMP(0));
+    /* 13,14 */
+    /* r3.x = MAD(r0.x, c3.x, 0.5) - texel position, fraction indexes the filter table */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_KCACHE0_BASE + 3),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_X),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_0_5),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_X),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(3),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_X),
+                                 CLAMP(0));
+    /* r3.y = MAD(r0.y, c3.y, 0.5) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Y),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_KCACHE0_BASE + 3),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Y),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_0_5),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_X),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(3),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Y),
+                                 CLAMP(0));
+    /* 15 */
+    /* r6.x = MAD(r4.x, c3.z, r0.x) - left column */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 4),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_KCACHE0_BASE + 3),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Z),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(ALU_SRC_GPR_BASE + 0),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_X),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(6),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_X),
+                                 CLAMP(0));
+    /* 16 */
+    /* r6.y = MAD(r5.x, c3.w, r0.y) - top row */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 5),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_KCACHE0_BASE + 3),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_W),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(ALU_SRC_GPR_BASE + 0),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_Y),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(6),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Y),
+                                 CLAMP(0));
+    /* 17 */
+    /* r6.z = MAD(r4.y, c3.z, r0.x) - right column */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 4),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Y),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_KCACHE0_BASE + 3),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Z),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(ALU_SRC_GPR_BASE + 0),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_X),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(6),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Z),
+                                 CLAMP(0));
+    /* 18 */
+    /* r6.w = MAD(r5.y, c3.w, r0.y) - bottom row */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 5),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Y),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_KCACHE0_BASE + 3),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_W),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(ALU_SRC_GPR_BASE + 0),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_Y),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(6),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_W),
+                                 CLAMP(0));
+    /* 19,20 */
+    /* r8.x = ADD(r7.x, -r7.y) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 7),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 7),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Y),
+                             SRC1_NEG(1),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(1),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_ADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(8),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_X),
+                                 CLAMP(0));
+    /* r8.y = ADD(r7.z, -r7.w) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 7),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Z),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 7),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_W),
+                             SRC1_NEG(1),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(1),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_ADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(8),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Y),
+                                 CLAMP(0));
+    /* 21,22 */
+    /* r8.x = MAD(r8.x, r4.z, r7.y) - horizontal blend, top */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 8),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 4),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Z),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(ALU_SRC_GPR_BASE + 7),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_Y),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(8),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_X),
+                                 CLAMP(0));
+    /* r8.y = MAD(r8.y, r4.z, r7.w) - horizontal blend, bottom */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 8),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Y),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 4),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Z),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(ALU_SRC_GPR_BASE + 7),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_W),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(8),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Y),
+                                 CLAMP(0));
+    /* 23 */
+    /* r8.z = ADD(r8.x, -r8.y) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 8),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 8),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Y),
+                             SRC1_NEG(1),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(1),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_ADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(8),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Z),
+                                 CLAMP(0));
+    /* 24 */
+    /* r1.x = MAD(r8.z, r5.z, r8.y) - vertical blend, filtered Y */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 8),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Z),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 5),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Z),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(ALU_SRC_GPR_BASE + 8),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_Y),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(1),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_X),
+                                 CLAMP(0));
+    /* 25,26,27,28 */
+    /* r2.x = MAD(c0.w, r1.x, c0.x) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 0),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_W),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 1),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_X),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(ALU_SRC_KCACHE0_BASE + 0),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_X),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_X),
+                                 CLAMP(0));
+    /* r2.y = MAD(c0.w, r1.x, c0.y) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 0),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_W),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 1),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_X),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(ALU_SRC_KCACHE0_BASE + 0),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_Y),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Y),
+                                 CLAMP(0));
+    /* r2.z = MAD(c0.w, r1.x, c0.z) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 0),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_W),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 1),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_X),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(ALU_SRC_KCACHE0_BASE + 0),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_Z),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Z),
+                                 CLAMP(0));
+    /* r2.w = MAD(0, 0, 1) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(SQ_ALU_SRC_0),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(SQ_ALU_SRC_0),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_X),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_1),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_X),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_W),
+                                 CLAMP(0));
+    /* 29,30,31,32 */
+    /* r2.x = MAD(c1.x, r1.y, pv.x) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 1),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 1),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Y),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_PV),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_X),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_X),
+                                 CLAMP(0));
+    /* r2.y = MAD(c1.y, r1.y, pv.y) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 1),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Y),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 1),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Y),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_PV),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_Y),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Y),
+                                 CLAMP(0));
+    /* r2.z = MAD(c1.z, r1.y, pv.z) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 1),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Z),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 1),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Y),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_PV),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_Z),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Z),
+                                 CLAMP(0));
+    /* r2.w = MAD(0, 0, 1) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(SQ_ALU_SRC_0),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(SQ_ALU_SRC_0),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_X),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_1),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_X),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_W),
+                                 CLAMP(0));
+    /* 33,34,35,36 */
+    /* r2.x = MAD(c2.x, r1.z, pv.x) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 1),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Z),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_PV),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_X),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_X),
+                                 CLAMP(1));
+    /* r2.y = MAD(c2.y, r1.z, pv.y) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Y),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 1),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Z),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_PV),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_Y),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Y),
+                                 CLAMP(1));
+    /* r2.z = MAD(c2.z, r1.z, pv.z) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Z),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 1),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Z),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_PV),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_Z),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Z),
+                                 CLAMP(1));
+    /* r2.w = MAD(0, 0, 1) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(SQ_ALU_SRC_0),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(SQ_ALU_SRC_0),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_X),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_1),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_X),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_W),
+                                 CLAMP(1));
+    /* 37 */
+    shader[RADEON_SHADER_DW(i, max)] = 0x00000000;
+    shader[RADEON_SHADER_DW(i, max)] = 0x00000000;
+    /* 38/39 - filter weights and offsets for x */
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
+                             INST_MOD(0),
+                             FETCH_WHOLE_QUAD(0),
+                             RESOURCE_ID(3),
+                             SRC_GPR(3),
+                             SRC_REL(ABSOLUTE),
+                             ALT_CONST(0),
+                             RESOURCE_INDEX_MODE(SQ_CF_INDEX_NONE),
+                             SAMPLER_INDEX_MODE(SQ_CF_INDEX_NONE));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD1(DST_GPR(4),
+                             DST_REL(ABSOLUTE),
+                             DST_SEL_X(SQ_SEL_X),
+                             DST_SEL_Y(SQ_SEL_Y),
+                             DST_SEL_Z(SQ_SEL_Z),
+                             DST_SEL_W(SQ_SEL_MASK),
+                             LOD_BIAS(0),
+                             COORD_TYPE_X(TEX_NORMALIZED),
+                             COORD_TYPE_Y(TEX_NORMALIZED),
+                             COORD_TYPE_Z(TEX_NORMALIZED),
+                             COORD_TYPE_W(TEX_NORMALIZED));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD2(OFFSET_X(0),
+                             OFFSET_Y(0),
+                             OFFSET_Z(0),
+                             SAMPLER_ID(3),
+                             SRC_SEL_X(SQ_SEL_X),
+                             SRC_SEL_Y(SQ_SEL_0),
+                             SRC_SEL_Z(SQ_SEL_0),
+                             SRC_SEL_W(SQ_SEL_1));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD_PAD;
+    /* 40/41 - filter weights and offsets for y */
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
+                             INST_MOD(0),
+                             FETCH_WHOLE_QUAD(0),
+                             RESOURCE_ID(3),
+                             SRC_GPR(3),
+                             SRC_REL(ABSOLUTE),
+                             ALT_CONST(0),
+                             RESOURCE_INDEX_MODE(SQ_CF_INDEX_NONE),
+                             SAMPLER_INDEX_MODE(SQ_CF_INDEX_NONE));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD1(DST_GPR(5),
+                             DST_REL(ABSOLUTE),
+                             DST_SEL_X(SQ_SEL_X),
+                             DST_SEL_Y(SQ_SEL_Y),
+                             DST_SEL_Z(SQ_SEL_Z),
+                             DST_SEL_W(SQ_SEL_MASK),
+                             LOD_BIAS(0),
+                             COORD_TYPE_X(TEX_NORMALIZED),
+                             COORD_TYPE_Y(TEX_NORMALIZED),
+                             COORD_TYPE_Z(TEX_NORMALIZED),
+                             COORD_TYPE_W(TEX_NORMALIZED));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD2(OFFSET_X(0),
+                             OFFSET_Y(0),
+                             OFFSET_Z(0),
+                             SAMPLER_ID(3),
+                             SRC_SEL_X(SQ_SEL_Y),
+                             SRC_SEL_Y(SQ_SEL_0),
+                             SRC_SEL_Z(SQ_SEL_0),
+                             SRC_SEL_W(SQ_SEL_1));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD_PAD;
+    /* 42/43 - V */
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
+                             INST_MOD(0),
+                             FETCH_WHOLE_QUAD(0),
+                             RESOURCE_ID(1),
+                             SRC_GPR(0),
+                             SRC_REL(ABSOLUTE),
+                             ALT_CONST(0),
+                             RESOURCE_INDEX_MODE(SQ_CF_INDEX_NONE),
+                             SAMPLER_INDEX_MODE(SQ_CF_INDEX_NONE));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD1(DST_GPR(1),
+                             DST_REL(ABSOLUTE),
+                             DST_SEL_X(SQ_SEL_MASK),
+                             DST_SEL_Y(SQ_SEL_MASK),
+                             DST_SEL_Z(SQ_SEL_X),
+                             DST_SEL_W(SQ_SEL_MASK),
+                             LOD_BIAS(0),
+                             COORD_TYPE_X(TEX_NORMALIZED),
+                             COORD_TYPE_Y(TEX_NORMALIZED),
+                             COORD_TYPE_Z(TEX_NORMALIZED),
+                             COORD_TYPE_W(TEX_NORMALIZED));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD2(OFFSET_X(0),
+                             OFFSET_Y(0),
+                             OFFSET_Z(0),
+                             SAMPLER_ID(1),
+                             SRC_SEL_X(SQ_SEL_X),
+                             SRC_SEL_Y(SQ_SEL_Y),
+                             SRC_SEL_Z(SQ_SEL_0),
+                             SRC_SEL_W(SQ_SEL_1));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD_PAD;
+    /* 44/45 - U */
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
+                             INST_MOD(0),
+                             FETCH_WHOLE_QUAD(0),
+                             RESOURCE_ID(2),
+                             SRC_GPR(0),
+                             SRC_REL(ABSOLUTE),
+                             ALT_CONST(0),
+                             RESOURCE_INDEX_MODE(SQ_CF_INDEX_NONE),
+                             SAMPLER_INDEX_MODE(SQ_CF_INDEX_NONE));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD1(DST_GPR(1),
+                             DST_REL(ABSOLUTE),
+                             DST_SEL_X(SQ_SEL_MASK),
+                             DST_SEL_Y(SQ_SEL_X),
+                             DST_SEL_Z(SQ_SEL_MASK),
+                             DST_SEL_W(SQ_SEL_MASK),
+                             LOD_BIAS(0),
+                             COORD_TYPE_X(TEX_NORMALIZED),
+                             COORD_TYPE_Y(TEX_NORMALIZED),
+                             COORD_TYPE_Z(TEX_NORMALIZED),
+                             COORD_TYPE_W(TEX_NORMALIZED));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD2(OFFSET_X(0),
+                             OFFSET_Y(0),
+                             OFFSET_Z(0),
+                             SAMPLER_ID(2),
+                             SRC_SEL_X(SQ_SEL_X),
+                             SRC_SEL_Y(SQ_SEL_Y),
+                             SRC_SEL_Z(SQ_SEL_0),
+                             SRC_SEL_W(SQ_SEL_1));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD_PAD;
+    /* 46/47 - Y top left */
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
+                             INST_MOD(0),
+                             FETCH_WHOLE_QUAD(0),
+                             RESOURCE_ID(0),
+                             SRC_GPR(6),
+                             SRC_REL(ABSOLUTE),
+                             ALT_CONST(0),
+                             RESOURCE_INDEX_MODE(SQ_CF_INDEX_NONE),
+                             SAMPLER_INDEX_MODE(SQ_CF_INDEX_NONE));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD1(DST_GPR(7),
+                             DST_REL(ABSOLUTE),
+                             DST_SEL_X(SQ_SEL_X),
+                             DST_SEL_Y(SQ_SEL_MASK),
+                             DST_SEL_Z(SQ_SEL_MASK),
+                             DST_SEL_W(SQ_SEL_MASK),
+                             LOD_BIAS(0),
+                             COORD_TYPE_X(TEX_NORMALIZED),
+                             COORD_TYPE_Y(TEX_NORMALIZED),
+                             COORD_TYPE_Z(TEX_NORMALIZED),
+                             COORD_TYPE_W(TEX_NORMALIZED));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD2(OFFSET_X(0),
+                             OFFSET_Y(0),
+                             OFFSET_Z(0),
+                             SAMPLER_ID(0),
+                             SRC_SEL_X(SQ_SEL_X),
+                             SRC_SEL_Y(SQ_SEL_Y),
+                             SRC_SEL_Z(SQ_SEL_0),
+                             SRC_SEL_W(SQ_SEL_1));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD_PAD;
+    /* 48/49 - Y top right */
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
+                             INST_MOD(0),
+                             FETCH_WHOLE_QUAD(0),
+                             RESOURCE_ID(0),
+                             SRC_GPR(6),
+                             SRC_REL(ABSOLUTE),
+                             ALT_CONST(0),
+                             RESOURCE_INDEX_MODE(SQ_CF_INDEX_NONE),
+                             SAMPLER_INDEX_MODE(SQ_CF_INDEX_NONE));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD1(DST_GPR(7),
+                             DST_REL(ABSOLUTE),
+                             DST_SEL_X(SQ_SEL_MASK),
+                             DST_SEL_Y(SQ_SEL_X),
+                             DST_SEL_Z(SQ_SEL_MASK),
+                             DST_SEL_W(SQ_SEL_MASK),
+                             LOD_BIAS(0),
+                             COORD_TYPE_X(TEX_NORMALIZED),
+                             COORD_TYPE_Y(TEX_NORMALIZED),
+                             COORD_TYPE_Z(TEX_NORMALIZED),
+                             COORD_TYPE_W(TEX_NORMALIZED));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD2(OFFSET_X(0),
+                             OFFSET_Y(0),
+                             OFFSET_Z(0),
+                             SAMPLER_ID(0),
+                             SRC_SEL_X(SQ_SEL_Z),
+                             SRC_SEL_Y(SQ_SEL_Y),
+                             SRC_SEL_Z(SQ_SEL_0),
+                             SRC_SEL_W(SQ_SEL_1));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD_PAD;
+    /* 50/51 - Y bottom left */
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
+                             INST_MOD(0),
+                             FETCH_WHOLE_QUAD(0),
+                             RESOURCE_ID(0),
+                             SRC_GPR(6),
+                             SRC_REL(ABSOLUTE),
+                             ALT_CONST(0),
+                             RESOURCE_INDEX_MODE(SQ_CF_INDEX_NONE),
+                             SAMPLER_INDEX_MODE(SQ_CF_INDEX_NONE));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD1(DST_GPR(7),
+                             DST_REL(ABSOLUTE),
+                             DST_SEL_X(SQ_SEL_MASK),
+                             DST_SEL_Y(SQ_SEL_MASK),
+                             DST_SEL_Z(SQ_SEL_X),
+                             DST_SEL_W(SQ_SEL_MASK),
+                             LOD_BIAS(0),
+                             COORD_TYPE_X(TEX_NORMALIZED),
+                             COORD_TYPE_Y(TEX_NORMALIZED),
+                             COORD_TYPE_Z(TEX_NORMALIZED),
+                             COORD_TYPE_W(TEX_NORMALIZED));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD2(OFFSET_X(0),
+                             OFFSET_Y(0),
+                             OFFSET_Z(0),
+                             SAMPLER_ID(0),
+                             SRC_SEL_X(SQ_SEL_X),
+                             SRC_SEL_Y(SQ_SEL_W),
+                             SRC_SEL_Z(SQ_SEL_0),
+                             SRC_SEL_W(SQ_SEL_1));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD_PAD;
+    /* 52/53 - Y bottom right */
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
+                             INST_MOD(0),
+                             FETCH_WHOLE_QUAD(0),
+                             RESOURCE_ID(0),
+                             SRC_GPR(6),
+                             SRC_REL(ABSOLUTE),
+                             ALT_CONST(0),
+                             RESOURCE_INDEX_MODE(SQ_CF_INDEX_NONE),
+                             SAMPLER_INDEX_MODE(SQ_CF_INDEX_NONE));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD1(DST_GPR(7),
+                             DST_REL(ABSOLUTE),
+                             DST_SEL_X(SQ_SEL_MASK),
+                             DST_SEL_Y(SQ_SEL_MASK),
+                             DST_SEL_Z(SQ_SEL_MASK),
+                             DST_SEL_W(SQ_SEL_X),
+                             LOD_BIAS(0),
+                             COORD_TYPE_X(TEX_NORMALIZED),
+                             COORD_TYPE_Y(TEX_NORMALIZED),
+                             COORD_TYPE_Z(TEX_NORMALIZED),
+                             COORD_TYPE_W(TEX_NORMALIZED));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD2(OFFSET_X(0),
+                             OFFSET_Y(0),
+                             OFFSET_Z(0),
+                             SAMPLER_ID(0),
+                             SRC_SEL_X(SQ_SEL_Z),
+                             SRC_SEL_Y(SQ_SEL_W),
+                             SRC_SEL_Z(SQ_SEL_0),
+                             SRC_SEL_W(SQ_SEL_1));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD_PAD;
+
+    /* 54 - gamma: r2.xyz = 2 ^ (log2(r2.xyz) * c1.w) */
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD0(ADDR(56),
+                                KCACHE_BANK0(0),
+                                KCACHE_BANK1(0),
+                                KCACHE_MODE0(SQ_CF_KCACHE_LOCK_1));
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
+                                KCACHE_ADDR0(0),
+                                KCACHE_ADDR1(0),
+                                I_COUNT(21),
+                                ALT_CONST(0),
+                                CF_INST(SQ_CF_INST_ALU),
+                                WHOLE_QUAD_MODE(0),
+                                BARRIER(1));
+    /* 55 */
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(0),
+                            JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
+                            CF_CONST(0),
+                            COND(SQ_CF_COND_ACTIVE),
+                            I_COUNT(0),
+                            VALID_PIXEL_MODE(0),
+                            CF_INST(SQ_CF_INST_RETURN),
+                            BARRIER(1));
+    /* 56,57,58 */
+    /* r2.x = LOG_CLAMPED(r2.x) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_X),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(1),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_LOG_CLAMPED),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_X),
+                                 CLAMP(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_X),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(0),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_LOG_CLAMPED),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Y),
+                                 CLAMP(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_X),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(0),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_LOG_CLAMPED),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Z),
+                                 CLAMP(0));
+    /* 59,60,61 */
+    /* r2.y = LOG_CLAMPED(r2.y) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Y),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Y),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(0),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_LOG_CLAMPED),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_X),
+                                 CLAMP(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Y),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Y),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(1),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_LOG_CLAMPED),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Y),
+                                 CLAMP(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Y),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Y),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(0),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_LOG_CLAMPED),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Z),
+                                 CLAMP(0));
+    /* 62,63,64 */
+    /* r2.z = LOG_CLAMPED(r2.z) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Z),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Z),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(0),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_LOG_CLAMPED),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_X),
+                                 CLAMP(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Z),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Z),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(0),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_LOG_CLAMPED),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Y),
+                                 CLAMP(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Z),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Z),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(1),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_LOG_CLAMPED),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Z),
+                                 CLAMP(0));
+    /* 65,66,67 */
+    /* r2.x = MUL(r2.x, c1.w) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_KCACHE0_BASE + 1),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_W),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(1),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_MUL),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_X),
+                                 CLAMP(0));
+    /* r2.y = MUL(r2.y, c1.w) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Y),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_KCACHE0_BASE + 1),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_W),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(1),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_MUL),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Y),
+                                 CLAMP(0));
+    /* r2.z = MUL(r2.z, c1.w) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Z),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_KCACHE0_BASE + 1),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_W),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(1),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_MUL),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Z),
+                                 CLAMP(0));
+    /* 68,69,70 */
+    /* r2.x = EXP_IEEE(r2.x) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_X),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(1),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_EXP_IEEE),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_X),
+                                 CLAMP(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_X),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(0),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_EXP_IEEE),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Y),
+                                 CLAMP(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_X),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(0),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_EXP_IEEE),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Z),
+                                 CLAMP(1));
+    /* 71,72,73 */
+    /* r2.y = EXP_IEEE(r2.y) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_Y),
                              SRC0_NEG(0),
-                             SRC1_SEL(ALU_SRC_GPR_BASE + 1),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 2),
                              SRC1_REL(ABSOLUTE),
                              SRC1_ELEM(ELEM_Y),
                              SRC1_NEG(0),
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_PV),
-                                 SRC2_REL(ABSOLUTE),
-                                 SRC2_ELEM(ELEM_Y),
-                                 SRC2_NEG(0),
-                                 ALU_INST(SQ_OP3_INST_MULADD),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(0),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_EXP_IEEE),
                                  BANK_SWIZZLE(SQ_ALU_VEC_012),
                                  DST_GPR(2),
                                  DST_REL(ABSOLUTE),
-                                 DST_ELEM(ELEM_Y),
-                                 CLAMP(0));
-    /* r2.z = MAD(c1.z, r1.y, pv.z) */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 1),
+                                 DST_ELEM(ELEM_X),
+                                 CLAMP(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
                              SRC0_REL(ABSOLUTE),
-                             SRC0_ELEM(ELEM_Z),
+                             SRC0_ELEM(ELEM_Y),
                              SRC0_NEG(0),
-                             SRC1_SEL(ALU_SRC_GPR_BASE + 1),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 2),
                              SRC1_REL(ABSOLUTE),
                              SRC1_ELEM(ELEM_Y),
                              SRC1_NEG(0),
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_PV),
-                                 SRC2_REL(ABSOLUTE),
-                                 SRC2_ELEM(ELEM_Z),
-                                 SRC2_NEG(0),
-                                 ALU_INST(SQ_OP3_INST_MULADD),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(1),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_EXP_IEEE),
                                  BANK_SWIZZLE(SQ_ALU_VEC_012),
                                  DST_GPR(2),
                                  DST_REL(ABSOLUTE),
-                                 DST_ELEM(ELEM_Z),
-                                 CLAMP(0));
-    /* r2.w = MAD(0, 0, 1) */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(SQ_ALU_SRC_0),
+                                 DST_ELEM(ELEM_Y),
+                                 CLAMP(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
                              SRC0_REL(ABSOLUTE),
-                             SRC0_ELEM(ELEM_X),
+                             SRC0_ELEM(ELEM_Y),
                              SRC0_NEG(0),
-                             SRC1_SEL(SQ_ALU_SRC_0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 2),
                              SRC1_REL(ABSOLUTE),
-                             SRC1_ELEM(ELEM_X),
+                             SRC1_ELEM(ELEM_Y),
                              SRC1_NEG(0),
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(1));
-    shader[i++] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_1),
-                                 SRC2_REL(ABSOLUTE),
-                                 SRC2_ELEM(ELEM_W),
-                                 SRC2_NEG(0),
-                                 ALU_INST(SQ_OP3_INST_MULADD),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(0),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_EXP_IEEE),
                                  BANK_SWIZZLE(SQ_ALU_VEC_012),
                                  DST_GPR(2),
                                  DST_REL(ABSOLUTE),
-                                 DST_ELEM(ELEM_W),
-                                 CLAMP(0));
-    /* 18,19,20,21 */
-    /* r2.x = MAD(c2.x, r1.z, pv.x) */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 2),
+                                 DST_ELEM(ELEM_Z),
+                                 CLAMP(1));
+    /* 74,75,76 */
+    /* r2.z = EXP_IEEE(r2.z) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
                              SRC0_REL(ABSOLUTE),
-                             SRC0_ELEM(ELEM_X),
+                             SRC0_ELEM(ELEM_Z),
                              SRC0_NEG(0),
-                             SRC1_SEL(ALU_SRC_GPR_BASE + 1),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 2),
                              SRC1_REL(ABSOLUTE),
                              SRC1_ELEM(ELEM_Z),
                              SRC1_NEG(0),
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_PV),
-                                 SRC2_REL(ABSOLUTE),
-                                 SRC2_ELEM(ELEM_X),
-                                 SRC2_NEG(0),
-                                 ALU_INST(SQ_OP3_INST_MULADD),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(0),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_EXP_IEEE),
                                  BANK_SWIZZLE(SQ_ALU_VEC_012),
                                  DST_GPR(2),
                                  DST_REL(ABSOLUTE),
                                  DST_ELEM(ELEM_X),
                                  CLAMP(1));
-    /* r2.y = MAD(c2.y, r1.z, pv.y) */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 2),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
                              SRC0_REL(ABSOLUTE),
-                             SRC0_ELEM(ELEM_Y),
+                             SRC0_ELEM(ELEM_Z),
                              SRC0_NEG(0),
-                             SRC1_SEL(ALU_SRC_GPR_BASE + 1),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 2),
                              SRC1_REL(ABSOLUTE),
                              SRC1_ELEM(ELEM_Z),
                              SRC1_NEG(0),
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_PV),
-                                 SRC2_REL(ABSOLUTE),
-                                 SRC2_ELEM(ELEM_Y),
-                                 SRC2_NEG(0),
-                                 ALU_INST(SQ_OP3_INST_MULADD),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(0),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_EXP_IEEE),
                                  BANK_SWIZZLE(SQ_ALU_VEC_012),
                                  DST_GPR(2),
                                  DST_REL(ABSOLUTE),
                                  DST_ELEM(ELEM_Y),
                                  CLAMP(1));
-    /* r2.z = MAD(c2.z, r1.z, pv.z) */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 2),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_Z),
                              SRC0_NEG(0),
-                             SRC1_SEL(ALU_SRC_GPR_BASE + 1),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 2),
                              SRC1_REL(ABSOLUTE),
                              SRC1_ELEM(ELEM_Z),
                              SRC1_NEG(0),
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
-                             LAST(0));
-    shader[i++] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_PV),
-                                 SRC2_REL(ABSOLUTE),
-                                 SRC2_ELEM(ELEM_Z),
-                                 SRC2_NEG(0),
-                                 ALU_INST(SQ_OP3_INST_MULADD),
-                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
-                                 DST_GPR(2),
-                                 DST_REL(ABSOLUTE),
-                                 DST_ELEM(ELEM_Z),
-                                 CLAMP(1));
-    /* r2.w = MAD(0, 0, 1) */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(SQ_ALU_SRC_0),
-                             SRC0_REL(ABSOLUTE),
-                             SRC0_ELEM(ELEM_X),
-                             SRC0_NEG(0),
-                             SRC1_SEL(SQ_ALU_SRC_0),
-                             SRC1_REL(ABSOLUTE),
-                             SRC1_ELEM(ELEM_X),
-                             SRC1_NEG(0),
-                             INDEX_MODE(SQ_INDEX_LOOP),
-                             PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(1));
-    shader[i++] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_1),
-                                 SRC2_REL(ABSOLUTE),
-                                 SRC2_ELEM(ELEM_X),
-                                 SRC2_NEG(0),
-                                 ALU_INST(SQ_OP3_INST_MULADD),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(1),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_EXP_IEEE),
                                  BANK_SWIZZLE(SQ_ALU_VEC_012),
                                  DST_GPR(2),
                                  DST_REL(ABSOLUTE),
-                                 DST_ELEM(ELEM_W),
+                                 DST_ELEM(ELEM_Z),
                                  CLAMP(1));
 
-    /* 22 */
-    shader[i++] = CF_DWORD0(ADDR(24),
-			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
-                            CF_CONST(0),
-                            COND(SQ_CF_COND_ACTIVE),
-                            I_COUNT(3),
-                            VALID_PIXEL_MODE(0),
-                            CF_INST(SQ_CF_INST_TC),
-                            BARRIER(1));
-    /* 23 */
-    shader[i++] = CF_DWORD0(ADDR(0),
-			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
-			    CF_CONST(0),
-			    COND(SQ_CF_COND_ACTIVE),
-			    I_COUNT(0),
-			    VALID_PIXEL_MODE(0),
-			    CF_INST(SQ_CF_INST_RETURN),
-			    BARRIER(1));
-    /* 24/25 */
-    shader[i++] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
-                             INST_MOD(0),
-                             FETCH_WHOLE_QUAD(0),
-                             RESOURCE_ID(0),
-                             SRC_GPR(0),
-                             SRC_REL(ABSOLUTE),
-                             ALT_CONST(0),
-			     RESOURCE_INDEX_MODE(SQ_CF_INDEX_NONE),
-			     SAMPLER_INDEX_MODE(SQ_CF_INDEX_NONE));
-    shader[i++] = TEX_DWORD1(DST_GPR(1),
-                             DST_REL(ABSOLUTE),
-                             DST_SEL_X(SQ_SEL_X),
-                             DST_SEL_Y(SQ_SEL_MASK),
-                             DST_SEL_Z(SQ_SEL_MASK),
-                             DST_SEL_W(SQ_SEL_1),
-                             LOD_BIAS(0),
-                             COORD_TYPE_X(TEX_NORMALIZED),
-                             COORD_TYPE_Y(TEX_NORMALIZED),
-                             COORD_TYPE_Z(TEX_NORMALIZED),
-                             COORD_TYPE_W(TEX_NORMALIZED));
-    shader[i++] = TEX_DWORD2(OFFSET_X(0),
-                             OFFSET_Y(0),
-                             OFFSET_Z(0),
-                             SAMPLER_ID(0),
-                             SRC_SEL_X(SQ_SEL_X),
-                             SRC_SEL_Y(SQ_SEL_Y),
-                             SRC_SEL_Z(SQ_SEL_0),
-                             SRC_SEL_W(SQ_SEL_1));
-    shader[i++] = TEX_DWORD_PAD;
-    /* 26/27 */
-    shader[i++] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
-                             INST_MOD(0),
-                             FETCH_WHOLE_QUAD(0),
-                             RESOURCE_ID(1),
-                             SRC_GPR(0),
-                             SRC_REL(ABSOLUTE),
-                             ALT_CONST(0),
-			     RESOURCE_INDEX_MODE(SQ_CF_INDEX_NONE),
-			     SAMPLER_INDEX_MODE(SQ_CF_INDEX_NONE));
-    shader[i++] = TEX_DWORD1(DST_GPR(1),
-                             DST_REL(ABSOLUTE),
-                             DST_SEL_X(SQ_SEL_MASK),
-                             DST_SEL_Y(SQ_SEL_MASK),
-                             DST_SEL_Z(SQ_SEL_X),
-                             DST_SEL_W(SQ_SEL_MASK),
-                             LOD_BIAS(0),
-                             COORD_TYPE_X(TEX_NORMALIZED),
-                             COORD_TYPE_Y(TEX_NORMALIZED),
-                             COORD_TYPE_Z(TEX_NORMALIZED),
-                             COORD_TYPE_W(TEX_NORMALIZED));
-    shader[i++] = TEX_DWORD2(OFFSET_X(0),
-                             OFFSET_Y(0),
-                             OFFSET_Z(0),
-                             SAMPLER_ID(1),
-                             SRC_SEL_X(SQ_SEL_X),
-                             SRC_SEL_Y(SQ_SEL_Y),
-                             SRC_SEL_Z(SQ_SEL_0),
-                             SRC_SEL_W(SQ_SEL_1));
-    shader[i++] = TEX_DWORD_PAD;
-    /* 28/29 */
-    shader[i++] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
-                             INST_MOD(0),
-                             FETCH_WHOLE_QUAD(0),
-                             RESOURCE_ID(2),
-                             SRC_GPR(0),
-                             SRC_REL(ABSOLUTE),
-                             ALT_CONST(0),
-			     RESOURCE_INDEX_MODE(SQ_CF_INDEX_NONE),
-			     SAMPLER_INDEX_MODE(SQ_CF_INDEX_NONE));
-    shader[i++] = TEX_DWORD1(DST_GPR(1),
-                             DST_REL(ABSOLUTE),
-                             DST_SEL_X(SQ_SEL_MASK),
-                             DST_SEL_Y(SQ_SEL_X),
-                             DST_SEL_Z(SQ_SEL_MASK),
-                             DST_SEL_W(SQ_SEL_MASK),
-                             LOD_BIAS(0),
-                             COORD_TYPE_X(TEX_NORMALIZED),
-                             COORD_TYPE_Y(TEX_NORMALIZED),
-                             COORD_TYPE_Z(TEX_NORMALIZED),
-                             COORD_TYPE_W(TEX_NORMALIZED));
-    shader[i++] = TEX_DWORD2(OFFSET_X(0),
-                             OFFSET_Y(0),
-                             OFFSET_Z(0),
-                             SAMPLER_ID(2),
-                             SRC_SEL_X(SQ_SEL_X),
-                             SRC_SEL_Y(SQ_SEL_Y),
-                             SRC_SEL_Z(SQ_SEL_0),
-                             SRC_SEL_W(SQ_SEL_1));
-    shader[i++] = TEX_DWORD_PAD;
-    /* 30 */
-    shader[i++] = CF_DWORD0(ADDR(32),
-			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
-                            CF_CONST(0),
-                            COND(SQ_CF_COND_ACTIVE),
-                            I_COUNT(1),
-                            VALID_PIXEL_MODE(0),
-                            CF_INST(SQ_CF_INST_TC),
-                            BARRIER(1));
-    /* 31 */
-    shader[i++] = CF_DWORD0(ADDR(0),
-			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
-			    CF_CONST(0),
-			    COND(SQ_CF_COND_ACTIVE),
-			    I_COUNT(0),
-			    VALID_PIXEL_MODE(0),
-			    CF_INST(SQ_CF_INST_RETURN),
-			    BARRIER(1));
-    /* 32/33 */
-    shader[i++] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
-                             INST_MOD(0),
-                             FETCH_WHOLE_QUAD(0),
-                             RESOURCE_ID(0),
-                             SRC_GPR(0),
-                             SRC_REL(ABSOLUTE),
-                             ALT_CONST(0),
-                             RESOURCE_INDEX_MODE(SQ_CF_INDEX_NONE),
-                             SAMPLER_INDEX_MODE(SQ_CF_INDEX_NONE));
-    shader[i++] = TEX_DWORD1(DST_GPR(1),
-                             DST_REL(ABSOLUTE),
-                             DST_SEL_X(SQ_SEL_X),
-                             DST_SEL_Y(SQ_SEL_Y),
-                             DST_SEL_Z(SQ_SEL_Z),
-                             DST_SEL_W(SQ_SEL_1),
-                             LOD_BIAS(0),
-                             COORD_TYPE_X(TEX_NORMALIZED),
-                             COORD_TYPE_Y(TEX_NORMALIZED),
-                             COORD_TYPE_Z(TEX_NORMALIZED),
-                             COORD_TYPE_W(TEX_NORMALIZED));
-    shader[i++] = TEX_DWORD2(OFFSET_X(0),
-                             OFFSET_Y(0),
-                             OFFSET_Z(0),
-                             SAMPLER_ID(0),
-                             SRC_SEL_X(SQ_SEL_X),
-                             SRC_SEL_Y(SQ_SEL_Y),
-                             SRC_SEL_Z(SQ_SEL_0),
-                             SRC_SEL_W(SQ_SEL_1));
-    shader[i++] = TEX_DWORD_PAD;
-
     return i;
 }
 
 /* comp vs --------------------------------------- */
-int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
+int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t *shader, uint32_t variant, int max)
 {
     int i = 0;
 
     /* 0 */
-    shader[i++] = CF_DWORD0(ADDR(3),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(3),
 			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
                             CF_CONST(0),
                             COND(SQ_CF_COND_BOOL),
                             I_COUNT(0),
@@ -1400,9 +3467,9 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                             CF_INST(SQ_CF_INST_CALL),
                             BARRIER(0));
     /* 1 */
-    shader[i++] = CF_DWORD0(ADDR(9),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(9),
 			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
                             CF_CONST(0),
                             COND(SQ_CF_COND_NOT_BOOL),
                             I_COUNT(0),
@@ -1410,9 +3477,9 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                             CF_INST(SQ_CF_INST_CALL),
                             BARRIER(0));
     /* 2 - end */
-    shader[i++] = CF_DWORD0(ADDR(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(0),
 			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
 			    CF_CONST(0),
 			    COND(SQ_CF_COND_ACTIVE),
 			    I_COUNT(0),
@@ -1420,9 +3487,9 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 			    CF_INST(SQ_CF_INST_END),
 			    BARRIER(1));
     /* 3 - mask sub */
-    shader[i++] = CF_DWORD0(ADDR(44),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(44),
 			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
 			    CF_CONST(0),
 			    COND(SQ_CF_COND_ACTIVE),
 			    I_COUNT(3),
@@ -1431,11 +3498,11 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 			    BARRIER(1));
 
     /* 4 - ALU */
-    shader[i++] = CF_ALU_DWORD0(ADDR(14),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD0(ADDR(14),
 				KCACHE_BANK0(0),
 				KCACHE_BANK1(0),
 				KCACHE_MODE0(SQ_CF_KCACHE_LOCK_1));
-    shader[i++] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
 				KCACHE_ADDR0(0),
 				KCACHE_ADDR1(0),
 				I_COUNT(20),
@@ -1445,13 +3512,13 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 				BARRIER(1));
 
     /* 5 - dst */
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(CF_POS0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(CF_POS0),
 					  TYPE(SQ_EXPORT_POS),
 					  RW_GPR(2),
 					  RW_REL(ABSOLUTE),
 					  INDEX_GPR(0),
 					  ELEM_SIZE(0));
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
 					       SRC_SEL_Y(SQ_SEL_Y),
 					       SRC_SEL_Z(SQ_SEL_0),
 					       SRC_SEL_W(SQ_SEL_1),
@@ -1461,13 +3528,13 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 					       MARK(0),
 					       BARRIER(1));
     /* 6 - src */
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(0),
 					  TYPE(SQ_EXPORT_PARAM),
 					  RW_GPR(1),
 					  RW_REL(ABSOLUTE),
 					  INDEX_GPR(0),
 					  ELEM_SIZE(0));
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
 					       SRC_SEL_Y(SQ_SEL_Y),
 					       SRC_SEL_Z(SQ_SEL_0),
 					       SRC_SEL_W(SQ_SEL_1),
@@ -1477,13 +3544,13 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 					       MARK(0),
 					       BARRIER(0));
     /* 7 - mask */
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(1),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(1),
 					  TYPE(SQ_EXPORT_PARAM),
 					  RW_GPR(0),
 					  RW_REL(ABSOLUTE),
 					  INDEX_GPR(0),
 					  ELEM_SIZE(0));
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
 					       SRC_SEL_Y(SQ_SEL_Y),
 					       SRC_SEL_Z(SQ_SEL_0),
 					       SRC_SEL_W(SQ_SEL_1),
@@ -1493,9 +3560,9 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 					       MARK(0),
 					       BARRIER(0));
     /* 8 */
-    shader[i++] = CF_DWORD0(ADDR(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(0),
 			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
 			    CF_CONST(0),
 			    COND(SQ_CF_COND_ACTIVE),
 			    I_COUNT(0),
@@ -1503,9 +3570,9 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 			    CF_INST(SQ_CF_INST_RETURN),
 			    BARRIER(1));
     /* 9 - non-mask sub */
-    shader[i++] = CF_DWORD0(ADDR(50),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(50),
 			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
 			    CF_CONST(0),
 			    COND(SQ_CF_COND_ACTIVE),
 			    I_COUNT(2),
@@ -1514,11 +3581,11 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 			    BARRIER(1));
 
     /* 10 - ALU */
-    shader[i++] = CF_ALU_DWORD0(ADDR(34),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD0(ADDR(34),
 				KCACHE_BANK0(0),
 				KCACHE_BANK1(0),
 				KCACHE_MODE0(SQ_CF_KCACHE_LOCK_1));
-    shader[i++] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
 				KCACHE_ADDR0(0),
 				KCACHE_ADDR1(0),
 				I_COUNT(10),
@@ -1528,13 +3595,13 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 				BARRIER(1));
 
     /* 11 - dst */
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(CF_POS0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(CF_POS0),
 					  TYPE(SQ_EXPORT_POS),
 					  RW_GPR(1),
 					  RW_REL(ABSOLUTE),
 					  INDEX_GPR(0),
 					  ELEM_SIZE(0));
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
 					       SRC_SEL_Y(SQ_SEL_Y),
 					       SRC_SEL_Z(SQ_SEL_0),
 					       SRC_SEL_W(SQ_SEL_1),
@@ -1544,13 +3611,13 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 					       MARK(0),
 					       BARRIER(1));
     /* 12 - src */
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(0),
 					  TYPE(SQ_EXPORT_PARAM),
 					  RW_GPR(0),
 					  RW_REL(ABSOLUTE),
 					  INDEX_GPR(0),
 					  ELEM_SIZE(0));
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
 					       SRC_SEL_Y(SQ_SEL_Y),
 					       SRC_SEL_Z(SQ_SEL_0),
 					       SRC_SEL_W(SQ_SEL_1),
@@ -1560,9 +3627,9 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 					       MARK(0),
 					       BARRIER(0));
     /* 13 */
-    shader[i++] = CF_DWORD0(ADDR(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(0),
 			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
 			    CF_CONST(0),
 			    COND(SQ_CF_COND_ACTIVE),
 			    I_COUNT(0),
@@ -1571,7 +3638,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 			    BARRIER(1));
 
     /* 14 srcX.x DOT4 - mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 1),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 1),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_X),
                              SRC0_NEG(0),
@@ -1582,7 +3649,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
                                  UPDATE_PRED(0),
@@ -1596,7 +3663,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 15 srcX.y DOT4 - mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 1),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 1),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_Y),
                              SRC0_NEG(0),
@@ -1607,7 +3674,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
                                  UPDATE_PRED(0),
@@ -1621,7 +3688,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 16 srcX.z DOT4 - mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 1),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 1),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_Z),
                              SRC0_NEG(0),
@@ -1632,7 +3699,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
                                  UPDATE_PRED(0),
@@ -1646,7 +3713,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 17 srcX.w DOT4 - mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 1),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 1),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_W),
                              SRC0_NEG(0),
@@ -1657,7 +3724,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(1));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
                                  UPDATE_PRED(0),
@@ -1671,7 +3738,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 18 srcY.x DOT4 - mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 1),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 1),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_X),
                              SRC0_NEG(0),
@@ -1682,7 +3749,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
                                  UPDATE_PRED(0),
@@ -1696,7 +3763,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 19 srcY.y DOT4 - mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 1),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 1),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_Y),
                              SRC0_NEG(0),
@@ -1707,7 +3774,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
                                  UPDATE_PRED(0),
@@ -1721,7 +3788,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 20 srcY.z DOT4 - mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 1),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 1),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_Z),
                              SRC0_NEG(0),
@@ -1732,7 +3799,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
                                  UPDATE_PRED(0),
@@ -1746,7 +3813,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 21 srcY.w DOT4 - mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 1),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 1),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_W),
                              SRC0_NEG(0),
@@ -1757,7 +3824,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(1));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
                                  UPDATE_PRED(0),
@@ -1771,7 +3838,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 22 maskX.x DOT4 - mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_X),
                              SRC0_NEG(0),
@@ -1782,7 +3849,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
                                  UPDATE_PRED(0),
@@ -1796,7 +3863,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 23 maskX.y DOT4 - mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_Y),
                              SRC0_NEG(0),
@@ -1807,7 +3874,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
                                  UPDATE_PRED(0),
@@ -1821,7 +3888,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 24 maskX.z DOT4 - mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_Z),
                              SRC0_NEG(0),
@@ -1832,7 +3899,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
                                  UPDATE_PRED(0),
@@ -1846,7 +3913,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 25 maskX.w DOT4 - mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_W),
                              SRC0_NEG(0),
@@ -1857,7 +3924,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(1));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
                                  UPDATE_PRED(0),
@@ -1871,7 +3938,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 26 maskY.x DOT4 - mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_X),
                              SRC0_NEG(0),
@@ -1882,7 +3949,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
                                  UPDATE_PRED(0),
@@ -1896,7 +3963,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 27 maskY.y DOT4 - mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_Y),
                              SRC0_NEG(0),
@@ -1907,7 +3974,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
                                  UPDATE_PRED(0),
@@ -1921,7 +3988,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 28 maskY.z DOT4 - mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_Z),
                              SRC0_NEG(0),
@@ -1932,7 +3999,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
                                  UPDATE_PRED(0),
@@ -1946,7 +4013,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 29 maskY.w DOT4 - mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_W),
                              SRC0_NEG(0),
@@ -1957,7 +4024,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(1));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
                                  UPDATE_PRED(0),
@@ -1971,7 +4038,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 30 srcX / w */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 3),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 3),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_X),
                              SRC0_NEG(0),
@@ -1982,7 +4049,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_AR_X),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(1));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
                                  UPDATE_PRED(0),
@@ -1996,7 +4063,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 31 srcY / h */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 3),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 3),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_Y),
                              SRC0_NEG(0),
@@ -2007,7 +4074,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_AR_X),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(1));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
                                  UPDATE_PRED(0),
@@ -2021,7 +4088,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 32 maskX / w */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 4),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 4),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_X),
                              SRC0_NEG(0),
@@ -2032,7 +4099,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_AR_X),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(1));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
                                  UPDATE_PRED(0),
@@ -2046,7 +4113,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 33 maskY / h */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 4),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 4),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_Y),
                              SRC0_NEG(0),
@@ -2057,7 +4124,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_AR_X),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(1));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
                                  UPDATE_PRED(0),
@@ -2071,7 +4138,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 34 srcX.x DOT4 - non-mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_X),
                              SRC0_NEG(0),
@@ -2082,7 +4149,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
                                  UPDATE_PRED(0),
@@ -2096,7 +4163,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 35 srcX.y DOT4 - non-mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_Y),
                              SRC0_NEG(0),
@@ -2107,7 +4174,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
                                  UPDATE_PRED(0),
@@ -2121,7 +4188,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 36 srcX.z DOT4 - non-mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_Z),
                              SRC0_NEG(0),
@@ -2132,7 +4199,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
                                  UPDATE_PRED(0),
@@ -2146,7 +4213,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 37 srcX.w DOT4 - non-mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_W),
                              SRC0_NEG(0),
@@ -2157,7 +4224,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(1));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
                                  UPDATE_PRED(0),
@@ -2171,7 +4238,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 38 srcY.x DOT4 - non-mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_X),
                              SRC0_NEG(0),
@@ -2182,7 +4249,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
                                  UPDATE_PRED(0),
@@ -2196,7 +4263,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 39 srcY.y DOT4 - non-mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_Y),
                              SRC0_NEG(0),
@@ -2207,7 +4274,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
                                  UPDATE_PRED(0),
@@ -2221,7 +4288,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 40 srcY.z DOT4 - non-mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_Z),
                              SRC0_NEG(0),
@@ -2232,7 +4299,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
                                  UPDATE_PRED(0),
@@ -2246,7 +4313,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 41 srcY.w DOT4 - non-mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_W),
                              SRC0_NEG(0),
@@ -2257,7 +4324,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(1));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
                                  UPDATE_PRED(0),
@@ -2271,7 +4338,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 42 srcX / w */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_X),
                              SRC0_NEG(0),
@@ -2282,7 +4349,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_AR_X),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(1));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
                                  UPDATE_PRED(0),
@@ -2296,7 +4363,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 43 srcY / h */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_Y),
                              SRC0_NEG(0),
@@ -2307,7 +4374,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_AR_X),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(1));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
                                  UPDATE_PRED(0),
@@ -2320,7 +4387,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  DST_ELEM(ELEM_Y),
                                  CLAMP(0));
     /* mask vfetch - 44/45 - dst */
-    shader[i++] = VTX_DWORD0(VTX_INST(SQ_VTX_INST_FETCH),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD0(VTX_INST(SQ_VTX_INST_FETCH),
 			     FETCH_TYPE(SQ_VTX_FETCH_VERTEX_DATA),
 			     FETCH_WHOLE_QUAD(0),
 			     BUFFER_ID(0),
@@ -2331,7 +4398,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 			     STRUCTURED_READ(SQ_VTX_STRU_READ_OFF),
 			     LDS_REQ(0),
 			     COALESCED_READ(0));
-    shader[i++] = VTX_DWORD1_GPR(DST_GPR(2),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD1_GPR(DST_GPR(2),
 				 DST_REL(0),
 				 DST_SEL_X(SQ_SEL_X),
 				 DST_SEL_Y(SQ_SEL_Y),
@@ -2342,7 +4409,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 				 NUM_FORMAT_ALL(SQ_NUM_FORMAT_SCALED),
 				 FORMAT_COMP_ALL(SQ_FORMAT_COMP_SIGNED),
 				 SRF_MODE_ALL(SRF_MODE_ZERO_CLAMP_MINUS_ONE));
-    shader[i++] = VTX_DWORD2(OFFSET(0),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD2(OFFSET(0),
 #if X_BYTE_ORDER == X_BIG_ENDIAN
                              ENDIAN_SWAP(SQ_ENDIAN_8IN32),
 #else
@@ -2351,9 +4418,9 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 			     CONST_BUF_NO_STRIDE(0),
 			     ALT_CONST(0),
 			     BUFFER_INDEX_MODE(SQ_CF_INDEX_NONE));
-    shader[i++] = VTX_DWORD_PAD;
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD_PAD;
     /* 46/47 - src */
-    shader[i++] = VTX_DWORD0(VTX_INST(SQ_VTX_INST_FETCH),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD0(VTX_INST(SQ_VTX_INST_FETCH),
 			     FETCH_TYPE(SQ_VTX_FETCH_VERTEX_DATA),
 			     FETCH_WHOLE_QUAD(0),
 			     BUFFER_ID(0),
@@ -2364,7 +4431,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 			     STRUCTURED_READ(SQ_VTX_STRU_READ_OFF),
 			     LDS_REQ(0),
 			     COALESCED_READ(0));
-    shader[i++] = VTX_DWORD1_GPR(DST_GPR(1),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD1_GPR(DST_GPR(1),
 				 DST_REL(0),
 				 DST_SEL_X(SQ_SEL_X),
 				 DST_SEL_Y(SQ_SEL_Y),
@@ -2375,7 +4442,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 				 NUM_FORMAT_ALL(SQ_NUM_FORMAT_SCALED),
 				 FORMAT_COMP_ALL(SQ_FORMAT_COMP_SIGNED),
 				 SRF_MODE_ALL(SRF_MODE_ZERO_CLAMP_MINUS_ONE));
-    shader[i++] = VTX_DWORD2(OFFSET(8),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD2(OFFSET(8),
 #if X_BYTE_ORDER == X_BIG_ENDIAN
                              ENDIAN_SWAP(SQ_ENDIAN_8IN32),
 #else
@@ -2384,9 +4451,9 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 			     CONST_BUF_NO_STRIDE(0),
 			     ALT_CONST(0),
 			     BUFFER_INDEX_MODE(SQ_CF_INDEX_NONE));
-    shader[i++] = VTX_DWORD_PAD;
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD_PAD;
     /* 48/49 - mask */
-    shader[i++] = VTX_DWORD0(VTX_INST(SQ_VTX_INST_FETCH),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD0(VTX_INST(SQ_VTX_INST_FETCH),
 			     FETCH_TYPE(SQ_VTX_FETCH_VERTEX_DATA),
 			     FETCH_WHOLE_QUAD(0),
 			     BUFFER_ID(0),
@@ -2397,7 +4464,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 			     STRUCTURED_READ(SQ_VTX_STRU_READ_OFF),
 			     LDS_REQ(0),
 			     COALESCED_READ(0));
-    shader[i++] = VTX_DWORD1_GPR(DST_GPR(0),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD1_GPR(DST_GPR(0),
 				 DST_REL(0),
 				 DST_SEL_X(SQ_SEL_X),
 				 DST_SEL_Y(SQ_SEL_Y),
@@ -2408,7 +4475,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 				 NUM_FORMAT_ALL(SQ_NUM_FORMAT_SCALED),
 				 FORMAT_COMP_ALL(SQ_FORMAT_COMP_SIGNED),
 				 SRF_MODE_ALL(SRF_MODE_ZERO_CLAMP_MINUS_ONE));
-    shader[i++] = VTX_DWORD2(OFFSET(16),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD2(OFFSET(16),
 #if X_BYTE_ORDER == X_BIG_ENDIAN
                              ENDIAN_SWAP(SQ_ENDIAN_8IN32),
 #else
@@ -2417,10 +4484,10 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 			     CONST_BUF_NO_STRIDE(0),
 			     ALT_CONST(0),
 			     BUFFER_INDEX_MODE(SQ_CF_INDEX_NONE));
-    shader[i++] = VTX_DWORD_PAD;
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD_PAD;
 
     /* no mask vfetch - 50/51 - dst */
-    shader[i++] = VTX_DWORD0(VTX_INST(SQ_VTX_INST_FETCH),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD0(VTX_INST(SQ_VTX_INST_FETCH),
 			     FETCH_TYPE(SQ_VTX_FETCH_VERTEX_DATA),
 			     FETCH_WHOLE_QUAD(0),
 			     BUFFER_ID(0),
@@ -2431,7 +4498,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 			     STRUCTURED_READ(SQ_VTX_STRU_READ_OFF),
 			     LDS_REQ(0),
 			     COALESCED_READ(0));
-    shader[i++] = VTX_DWORD1_GPR(DST_GPR(1),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD1_GPR(DST_GPR(1),
 				 DST_REL(0),
 				 DST_SEL_X(SQ_SEL_X),
 				 DST_SEL_Y(SQ_SEL_Y),
@@ -2442,7 +4509,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 				 NUM_FORMAT_ALL(SQ_NUM_FORMAT_SCALED),
 				 FORMAT_COMP_ALL(SQ_FORMAT_COMP_SIGNED),
 				 SRF_MODE_ALL(SRF_MODE_ZERO_CLAMP_MINUS_ONE));
-    shader[i++] = VTX_DWORD2(OFFSET(0),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD2(OFFSET(0),
 #if X_BYTE_ORDER == X_BIG_ENDIAN
                              ENDIAN_SWAP(SQ_ENDIAN_8IN32),
 #else
@@ -2451,9 +4518,9 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 			     CONST_BUF_NO_STRIDE(0),
 			     ALT_CONST(0),
 			     BUFFER_INDEX_MODE(SQ_CF_INDEX_NONE));
-    shader[i++] = VTX_DWORD_PAD;
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD_PAD;
     /* 52/53 - src */
-    shader[i++] = VTX_DWORD0(VTX_INST(SQ_VTX_INST_FETCH),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD0(VTX_INST(SQ_VTX_INST_FETCH),
 			     FETCH_TYPE(SQ_VTX_FETCH_VERTEX_DATA),
 			     FETCH_WHOLE_QUAD(0),
 			     BUFFER_ID(0),
@@ -2464,7 +4531,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 			     STRUCTURED_READ(SQ_VTX_STRU_READ_OFF),
 			     LDS_REQ(0),
 			     COALESCED_READ(0));
-    shader[i++] = VTX_DWORD1_GPR(DST_GPR(0),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD1_GPR(DST_GPR(0),
 				 DST_REL(0),
 				 DST_SEL_X(SQ_SEL_X),
 				 DST_SEL_Y(SQ_SEL_Y),
@@ -2475,7 +4542,7 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 				 NUM_FORMAT_ALL(SQ_NUM_FORMAT_SCALED),
 				 FORMAT_COMP_ALL(SQ_FORMAT_COMP_SIGNED),
 				 SRF_MODE_ALL(SRF_MODE_ZERO_CLAMP_MINUS_ONE));
-    shader[i++] = VTX_DWORD2(OFFSET(8),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD2(OFFSET(8),
 #if X_BYTE_ORDER == X_BIG_ENDIAN
                              ENDIAN_SWAP(SQ_ENDIAN_8IN32),
 #else
@@ -2484,21 +4551,32 @@ int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 			     CONST_BUF_NO_STRIDE(0),
                              ALT_CONST(0),
                              BUFFER_INDEX_MODE(SQ_CF_INDEX_NONE));
-    shader[i++] = VTX_DWORD_PAD;
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD_PAD;
+
+    if (variant & RADEON_COMP_STATIC) {
+	/* mask or non-mask sub, then the end of the program */
+	static const int mask_cf[] = { 3, 5, 2, 1 };
+	static const int non_mask_cf[] = { 9, 4, 2, 1 };
+
+	if (variant & RADEON_COMP_MASK_TEX)
+	    radeon_shader_flatten(shader, mask_cf, 2);
+	else
+	    radeon_shader_flatten(shader, non_mask_cf, 2);
+    }
 
     return i;
 }
 
 /* comp ps --------------------------------------- */
-int cayman_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
+int cayman_comp_ps(RADEONChipFamily ChipSet, uint32_t *shader, uint32_t variant, int max)
 {
     int i = 0;
 
     /* 0 */
     /* call interp-fetch-mask if boolean1 == true */
-    shader[i++] = CF_DWORD0(ADDR(12),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(12),
 			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
                             CF_CONST(1),
                             COND(SQ_CF_COND_BOOL),
                             I_COUNT(0),
@@ -2508,9 +4586,9 @@ int cayman_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 
     /* 1 */
     /* call read-constant-mask if boolean1 == false */
-    shader[i++] = CF_DWORD0(ADDR(15),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(15),
 			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
                             CF_CONST(1),
                             COND(SQ_CF_COND_NOT_BOOL),
                             I_COUNT(0),
@@ -2520,9 +4598,9 @@ int cayman_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 
     /* 2 */
     /* call interp-fetch-src if boolean0 == true */
-    shader[i++] = CF_DWORD0(ADDR(7),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(7),
 			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
                             CF_CONST(0),
                             COND(SQ_CF_COND_BOOL),
                             I_COUNT(0),
@@ -2532,9 +4610,9 @@ int cayman_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 
     /* 3 */
     /* call read-constant-src if boolean0 == false */
-    shader[i++] = CF_DWORD0(ADDR(10),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(10),
 			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
                             CF_CONST(0),
                             COND(SQ_CF_COND_NOT_BOOL),
                             I_COUNT(0),
@@ -2543,11 +4621,11 @@ int cayman_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
                             BARRIER(0));
     /* 4 */
     /* src IN mask (GPR2 := GPR1 .* GPR0) */
-    shader[i++] = CF_ALU_DWORD0(ADDR(17),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD0(ADDR(17),
 				KCACHE_BANK0(0),
 				KCACHE_BANK1(0),
 				KCACHE_MODE0(SQ_CF_KCACHE_NOP));
-    shader[i++] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
 				KCACHE_ADDR0(0),
 				KCACHE_ADDR1(0),
 				I_COUNT(4),
@@ -2558,13 +4636,13 @@ int cayman_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 
     /* 5 */
     /* export pixel data */
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(CF_PIXEL_MRT0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(CF_PIXEL_MRT0),
 					  TYPE(SQ_EXPORT_PIXEL),
 					  RW_GPR(0),
 					  RW_REL(ABSOLUTE),
 					  INDEX_GPR(0),
 					  ELEM_SIZE(1));
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
 					       SRC_SEL_Y(SQ_SEL_Y),
 					       SRC_SEL_Z(SQ_SEL_Z),
 					       SRC_SEL_W(SQ_SEL_W),
@@ -2576,9 +4654,9 @@ int cayman_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 
     /* 6 */
     /* end of program */
-    shader[i++] = CF_DWORD0(ADDR(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(0),
 			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
 			    CF_CONST(0),
 			    COND(SQ_CF_COND_ACTIVE),
 			    I_COUNT(0),
@@ -2590,11 +4668,11 @@ int cayman_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 
     /* 7 */
     /* interpolate src */
-    shader[i++] = CF_ALU_DWORD0(ADDR(21),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD0(ADDR(21),
 				KCACHE_BANK0(0),
 				KCACHE_BANK1(0),
 				KCACHE_MODE0(SQ_CF_KCACHE_NOP));
-    shader[i++] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
 				KCACHE_ADDR0(0),
 				KCACHE_ADDR1(0),
 				I_COUNT(4),
@@ -2605,9 +4683,9 @@ int cayman_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 
     /* 8 */
     /* texture fetch src into GPR0 */
-    shader[i++] = CF_DWORD0(ADDR(26),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(26),
 			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
 			    CF_CONST(0),
 			    COND(SQ_CF_COND_ACTIVE),
 			    I_COUNT(1),
@@ -2617,9 +4695,9 @@ int cayman_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 
     /* 9 */
     /* return */
-    shader[i++] = CF_DWORD0(ADDR(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(0),
 			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
 			    CF_CONST(0),
 			    COND(SQ_CF_COND_ACTIVE),
 			    I_COUNT(0),
@@ -2631,11 +4709,11 @@ int cayman_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 
     /* 10 */
     /* read constants into GPR0 */
-    shader[i++] = CF_ALU_DWORD0(ADDR(28),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD0(ADDR(28),
 				KCACHE_BANK0(0),
 				KCACHE_BANK1(0),
 				KCACHE_MODE0(SQ_CF_KCACHE_LOCK_1));
-    shader[i++] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
 				KCACHE_ADDR0(0),
 				KCACHE_ADDR1(0),
 				I_COUNT(4),
@@ -2646,9 +4724,9 @@ int cayman_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 
     /* 11 */
     /* return */
-    shader[i++] = CF_DWORD0(ADDR(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(0),
 			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
 			    CF_CONST(0),
 			    COND(SQ_CF_COND_ACTIVE),
 			    I_COUNT(0),
@@ -2660,11 +4738,11 @@ int cayman_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 
     /* 12 */
     /* interpolate mask */
-    shader[i++] = CF_ALU_DWORD0(ADDR(32),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD0(ADDR(32),
 				KCACHE_BANK0(0),
 				KCACHE_BANK1(0),
 				KCACHE_MODE0(SQ_CF_KCACHE_NOP));
-    shader[i++] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
 				KCACHE_ADDR0(0),
 				KCACHE_ADDR1(0),
 				I_COUNT(4),
@@ -2675,9 +4753,9 @@ int cayman_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 
     /* 13 */
     /* texture fetch mask into GPR1 */
-    shader[i++] = CF_DWORD0(ADDR(36),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(36),
 			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
 			    CF_CONST(0),
 			    COND(SQ_CF_COND_ACTIVE),
 			    I_COUNT(1),
@@ -2687,9 +4765,9 @@ int cayman_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 
     /* 14 */
     /* return */
-    shader[i++] = CF_DWORD0(ADDR(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(0),
 			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
 			    CF_CONST(0),
 			    COND(SQ_CF_COND_ACTIVE),
 			    I_COUNT(0),
@@ -2701,11 +4779,11 @@ int cayman_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 
     /* 15 */
     /* read constants into GPR1 */
-    shader[i++] = CF_ALU_DWORD0(ADDR(38),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD0(ADDR(38),
 				KCACHE_BANK0(0),
 				KCACHE_BANK1(0),
 				KCACHE_MODE0(SQ_CF_KCACHE_LOCK_1));
-    shader[i++] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
 				KCACHE_ADDR0(0),
 				KCACHE_ADDR1(0),
 				I_COUNT(4),
@@ -2716,9 +4794,9 @@ int cayman_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 
     /* 16 */
     /* return */
-    shader[i++] = CF_DWORD0(ADDR(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(0),
 			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
 			    CF_CONST(0),
 			    COND(SQ_CF_COND_ACTIVE),
 			    I_COUNT(0),
@@ -2730,7 +4808,7 @@ int cayman_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 
     /* 17 */
     /* MUL gpr[0].x gpr[0].x gpr[1].x */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_X),
 			     SRC0_NEG(0),
@@ -2741,7 +4819,7 @@ int cayman_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     INDEX_MODE(SQ_INDEX_LOOP),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
 				 UPDATE_PRED(0),
@@ -2756,7 +4834,7 @@ int cayman_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 
     /* 18 */
     /* MUL gpr[0].y gpr[0].y gpr[1].y */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_Y),
 			     SRC0_NEG(0),
@@ -2767,7 +4845,7 @@ int cayman_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     INDEX_MODE(SQ_INDEX_LOOP),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
 				 UPDATE_PRED(0),
@@ -2781,7 +4859,7 @@ int cayman_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 				 CLAMP(1));
     /* 19 */
     /* MUL gpr[0].z gpr[0].z gpr[1].z */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_Z),
 			     SRC0_NEG(0),
@@ -2792,7 +4870,7 @@ int cayman_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     INDEX_MODE(SQ_INDEX_LOOP),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
 				 UPDATE_PRED(0),
@@ -2806,7 +4884,7 @@ int cayman_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 				 CLAMP(1));
     /* 20 */
     /* MUL gpr[0].w gpr[0].w gpr[1].w */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_W),
 			     SRC0_NEG(0),
@@ -2817,7 +4895,7 @@ int cayman_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     INDEX_MODE(SQ_INDEX_LOOP),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(1));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
 				 UPDATE_PRED(0),
@@ -2832,7 +4910,7 @@ int cayman_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 
     /* 21 */
     /* INTERP_XY GPR0.x, GPR0.y PARAM0.x */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_Y),
 			     SRC0_NEG(0),
@@ -2843,7 +4921,7 @@ int cayman_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     INDEX_MODE(SQ_INDEX_AR_X),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
 				 UPDATE_PRED(0),
@@ -2857,7 +4935,7 @@ int cayman_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 				 CLAMP(0));
     /* 22 */
     /* INTERP_XY GPR0.y, GPR0.x PARAM0.x */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_X),
 			     SRC0_NEG(0),
@@ -2868,7 +4946,7 @@ int cayman_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     INDEX_MODE(SQ_INDEX_AR_X),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
 				 UPDATE_PRED(0),
@@ -2882,7 +4960,7 @@ int cayman_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 				 CLAMP(0));
     /* 23 */
     /* INTERP_XY GPR0.z, GPR0.y PARAM0.x */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_Y),
 			     SRC0_NEG(0),
@@ -2893,7 +4971,7 @@ int cayman_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     INDEX_MODE(SQ_INDEX_AR_X),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
 				 UPDATE_PRED(0),
@@ -2908,7 +4986,7 @@ int cayman_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 
     /* 24 */
     /* INTERP_XY GPR0.w, GPR0.x PARAM0.x */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_X),
 			     SRC0_NEG(0),
@@ -2919,7 +4997,7 @@ int cayman_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     INDEX_MODE(SQ_INDEX_AR_X),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(1));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
 				 UPDATE_PRED(0),
@@ -2933,12 +5011,12 @@ int cayman_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 				 CLAMP(0));
 
     /* 25 */
-    shader[i++] = 0;
-    shader[i++] = 0;
+    shader[RADEON_SHADER_DW(i, max)] = 0;
+    shader[RADEON_SHADER_DW(i, max)] = 0;
 
     /* 26/27 */
     /* SAMPLE RID=0 GPR0, GPR0 */
-    shader[i++] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
 			     INST_MOD(0),
 			     FETCH_WHOLE_QUAD(0),
 			     RESOURCE_ID(0),
@@ -2947,7 +5025,7 @@ int cayman_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     ALT_CONST(0),
 			     RESOURCE_INDEX_MODE(SQ_CF_INDEX_NONE),
 			     SAMPLER_INDEX_MODE(SQ_CF_INDEX_NONE));
-    shader[i++] = TEX_DWORD1(DST_GPR(0),
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD1(DST_GPR(0),
 			     DST_REL(ABSOLUTE),
 			     DST_SEL_X(SQ_SEL_X),
 			     DST_SEL_Y(SQ_SEL_Y),
@@ -2958,7 +5036,7 @@ int cayman_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     COORD_TYPE_Y(TEX_NORMALIZED),
 			     COORD_TYPE_Z(TEX_NORMALIZED),
 			     COORD_TYPE_W(TEX_NORMALIZED));
-    shader[i++] = TEX_DWORD2(OFFSET_X(0),
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD2(OFFSET_X(0),
 			     OFFSET_Y(0),
 			     OFFSET_Z(0),
 			     SAMPLER_ID(0),
@@ -2966,11 +5044,11 @@ int cayman_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     SRC_SEL_Y(SQ_SEL_Y),
 			     SRC_SEL_Z(SQ_SEL_0),
 			     SRC_SEL_W(SQ_SEL_1));
-    shader[i++] = TEX_DWORD_PAD;
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD_PAD;
 
     /* 28 */
     /* MOV GPR0.x, KC4.x */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 4),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 4),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_X),
 			     SRC0_NEG(0),
@@ -2981,7 +5059,7 @@ int cayman_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     INDEX_MODE(SQ_INDEX_AR_X),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
 				 UPDATE_PRED(0),
@@ -2996,7 +5074,7 @@ int cayman_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 
     /* 29 */
     /* MOV GPR0.y, KC4.y */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 4),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 4),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_Y),
 			     SRC0_NEG(0),
@@ -3007,7 +5085,7 @@ int cayman_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     INDEX_MODE(SQ_INDEX_AR_X),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
 				 UPDATE_PRED(0),
@@ -3022,7 +5100,7 @@ int cayman_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 
     /* 30  */
     /* MOV GPR0.z, KC4.z */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 4),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 4),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_Z),
 			     SRC0_NEG(0),
@@ -3033,7 +5111,7 @@ int cayman_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     INDEX_MODE(SQ_INDEX_AR_X),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
 				 UPDATE_PRED(0),
@@ -3048,7 +5126,7 @@ int cayman_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 
     /* 31 */
     /* MOV GPR0.w, KC4.w */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 4),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 4),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_W),
 			     SRC0_NEG(0),
@@ -3059,7 +5137,7 @@ int cayman_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     INDEX_MODE(SQ_INDEX_AR_X),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(1));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
 				 UPDATE_PRED(0),
@@ -3074,7 +5152,7 @@ int cayman_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 
     /* 32 */
     /* INTERP_XY GPR1.x, PARAM1 */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_Y),
 			     SRC0_NEG(0),
@@ -3085,7 +5163,7 @@ int cayman_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     INDEX_MODE(SQ_INDEX_AR_X),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
 				 UPDATE_PRED(0),
@@ -3099,7 +5177,7 @@ int cayman_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 				 CLAMP(0));
     /* 33 */
     /* INTERP_XY GPR1.y, PARAM1 */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_X),
 			     SRC0_NEG(0),
@@ -3110,7 +5188,7 @@ int cayman_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     INDEX_MODE(SQ_INDEX_AR_X),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
 				 UPDATE_PRED(0),
@@ -3124,7 +5202,7 @@ int cayman_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 				 CLAMP(0));
     /* 34 */
     /* INTERP_XY GPR1.z, PARAM1 */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_Y),
 			     SRC0_NEG(0),
@@ -3135,7 +5213,7 @@ int cayman_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     INDEX_MODE(SQ_INDEX_AR_X),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
 				 UPDATE_PRED(0),
@@ -3149,7 +5227,7 @@ int cayman_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 				 CLAMP(0));
     /* 35 */
     /* INTERP_XY GPR1.w, PARAM1 */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_X),
 			     SRC0_NEG(0),
@@ -3160,7 +5238,7 @@ int cayman_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     INDEX_MODE(SQ_INDEX_AR_X),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(1));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
 				 UPDATE_PRED(0),
@@ -3175,7 +5253,7 @@ int cayman_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 
     /* 36/37 */
     /* SAMPLE RID=1 GPR1, GPR1 */
-    shader[i++] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
 			     INST_MOD(0),
 			     FETCH_WHOLE_QUAD(0),
 			     RESOURCE_ID(1),
@@ -3184,7 +5262,7 @@ int cayman_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     ALT_CONST(0),
 			     RESOURCE_INDEX_MODE(SQ_CF_INDEX_NONE),
 			     SAMPLER_INDEX_MODE(SQ_CF_INDEX_NONE));
-    shader[i++] = TEX_DWORD1(DST_GPR(1),
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD1(DST_GPR(1),
 			     DST_REL(ABSOLUTE),
 			     DST_SEL_X(SQ_SEL_X),
 			     DST_SEL_Y(SQ_SEL_Y),
@@ -3195,7 +5273,7 @@ int cayman_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     COORD_TYPE_Y(TEX_NORMALIZED),
 			     COORD_TYPE_Z(TEX_NORMALIZED),
 			     COORD_TYPE_W(TEX_NORMALIZED));
-    shader[i++] = TEX_DWORD2(OFFSET_X(0),
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD2(OFFSET_X(0),
 			     OFFSET_Y(0),
 			     OFFSET_Z(0),
 			     SAMPLER_ID(1),
@@ -3203,11 +5281,11 @@ int cayman_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     SRC_SEL_Y(SQ_SEL_Y),
 			     SRC_SEL_Z(SQ_SEL_0),
 			     SRC_SEL_W(SQ_SEL_1));
-    shader[i++] = TEX_DWORD_PAD;
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD_PAD;
 
     /* 38 */
     /* MOV GPR1.x, KC5.x */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 5),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 5),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_X),
 			     SRC0_NEG(0),
@@ -3218,7 +5296,7 @@ int cayman_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     INDEX_MODE(SQ_INDEX_AR_X),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
 				 UPDATE_PRED(0),
@@ -3233,7 +5311,7 @@ int cayman_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 
     /* 39 */
     /* MOV GPR1.y, KC5.y */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 5),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 5),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_Y),
 			     SRC0_NEG(0),
@@ -3244,7 +5322,7 @@ int cayman_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     INDEX_MODE(SQ_INDEX_AR_X),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
 				 UPDATE_PRED(0),
@@ -3259,7 +5337,7 @@ int cayman_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 
     /* 40 */
     /* MOV GPR1.z, KC5.z */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 5),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 5),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_Z),
 			     SRC0_NEG(0),
@@ -3270,7 +5348,7 @@ int cayman_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     INDEX_MODE(SQ_INDEX_AR_X),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
 				 UPDATE_PRED(0),
@@ -3285,7 +5363,7 @@ int cayman_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 
     /* 41 */
     /* MOV GPR1.w, KC5.w */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 5),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 5),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_W),
 			     SRC0_NEG(0),
@@ -3296,7 +5374,7 @@ int cayman_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     INDEX_MODE(SQ_INDEX_AR_X),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(1));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
 				 UPDATE_PRED(0),
@@ -3309,5 +5387,30 @@ int cayman_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 				 DST_ELEM(ELEM_W),
 				 CLAMP(1));
 
+    if (variant & RADEON_COMP_STATIC) {
+	/* mask and src subroutines, then src IN mask and the export; with
+	 * no mask, src goes out as it is */
+	int cf[6], n = 0;
+
+	if (variant & RADEON_COMP_MASK) {
+	    if (variant & RADEON_COMP_MASK_TEX) {
+		cf[n++] = 12; cf[n++] = 2;
+	    } else {
+		cf[n++] = 15; cf[n++] = 1;
+	    }
+	}
+	if (variant & RADEON_COMP_SRC_TEX) {
+	    cf[n++] = 7; cf[n++] = 2;
+	} else {
+	    cf[n++] = 10; cf[n++] = 1;
+	}
+	if (variant & RADEON_COMP_MASK) {
+	    cf[n++] = 4; cf[n++] = 3;
+	} else {
+	    cf[n++] = 5; cf[n++] = 2;
+	}
+	radeon_shader_flatten(shader, cf, n / 2);
+    }
+
     return i;
 }
@@ -49,8 +49,6 @@
 #include <X11/extensions/dpms.h>
 #endif
 
-#define DEFAULT_NOMINAL_FRAME_RATE 60
-
 static Bool
 RADEONZaphodStringMatches(ScrnInfoPtr pScrn, const char *s, char *output_name)
 {
@@ -227,12 +225,20 @@ drmmode_ConvertToKMode(ScrnInfoPtr	scrn,
  */
 int drmmode_get_current_ust(int drm_fd, CARD64 *ust)
 {
+	/* drm_timestamp_monotonic is a global DRM module parameter, so
+	 * the answer is the same for every fd and only queried once
+	 */
+	static int monotonic = -1;
 	uint64_t cap_value;
 	int ret;
 	struct timespec now;
 
-	ret = drmGetCap(drm_fd, DRM_CAP_TIMESTAMP_MONOTONIC, &cap_value);
-	if (ret || !cap_value)
+	if (monotonic < 0) {
+		ret = drmGetCap(drm_fd, DRM_CAP_TIMESTAMP_MONOTONIC, &cap_value);
+		monotonic = !ret && cap_value;
+	}
+
+	if (!monotonic)
 		/* old kernel or drm_timestamp_monotonic turned off */
 		ret = clock_gettime(CLOCK_REALTIME, &now);
 	else
@@ -243,6 +249,30 @@ int drmmode_get_current_ust(int drm_fd, CARD64 *ust)
 	return 0;
 }
 
+/*
+ * Nominal refresh period of the CRTC's current mode, 0 if unknown.
+ */
+static CARD64
+drmmode_crtc_nominal_period_ns(xf86CrtcPtr crtc)
+{
+	CARD64 pix_in_frame = (CARD64)crtc->mode.HTotal * crtc->mode.VTotal;
+
+	if (crtc->mode.Clock == 0 || pix_in_frame == 0)
+		return 0;
+
+	/* mode.Clock is in kHz */
+	return pix_in_frame * 1000000 / crtc->mode.Clock;
+}
+
+void drmmode_crtc_vblank_sample(xf86CrtcPtr crtc, unsigned int seq,
+				unsigned int tv_sec, unsigned int tv_usec)
+{
+	drmmode_crtc_private_ptr drmmode_crtc = crtc->driver_private;
+
+	drmmode_vblank_model_sample(&drmmode_crtc->vblank_model, seq,
+				    (CARD64)tv_sec * 1000000 + tv_usec);
+}
+
 static void
 drmmode_crtc_dpms(xf86CrtcPtr crtc, int mode)
 {
@@ -256,8 +286,8 @@ drmmode_crtc_dpms(xf86CrtcPtr crtc, int mode)
 		drmVBlank vbl;
 
 		/*
-		 * On->Off transition: record the last vblank time,
-		 * sequence number and frame period.
+		 * On->Off transition: anchor the vblank timing model on the
+		 * last vblank, it is used to extrapolate while we are off.
 		 */
 		vbl.request.type = DRM_VBLANK_RELATIVE;
 		vbl.request.type |= radeon_populate_vbl_request_type(crtc);
@@ -267,24 +297,13 @@ drmmode_crtc_dpms(xf86CrtcPtr crtc, int mode)
 			xf86DrvMsg(scrn->scrnIndex, X_ERROR,
 				   "%s cannot get last vblank counter\n",
 				   __func__);
-		else {
-			CARD64 seq = (CARD64)vbl.reply.sequence;
-			CARD64 nominal_frame_rate, pix_in_frame;
-
-			ust = ((CARD64)vbl.reply.tval_sec * 1000000) +
-				vbl.reply.tval_usec;
-			drmmode_crtc->dpms_last_ust = ust;
-			drmmode_crtc->dpms_last_seq = seq;
-			nominal_frame_rate = crtc->mode.Clock;
-			nominal_frame_rate *= 1000;
-			pix_in_frame = crtc->mode.HTotal * crtc->mode.VTotal;
-			if (nominal_frame_rate == 0 || pix_in_frame == 0)
-				nominal_frame_rate = DEFAULT_NOMINAL_FRAME_RATE;
-			else
-				nominal_frame_rate /= pix_in_frame;
-			drmmode_crtc->dpms_last_fps = nominal_frame_rate;
-		}
+		else
+			drmmode_crtc_vblank_sample(crtc, vbl.reply.sequence,
+						   vbl.reply.tval_sec,
+						   vbl.reply.tval_usec);
 	} else if (drmmode_crtc->dpms_mode != DPMSModeOn && mode == DPMSModeOn) {
+		drmmode_vblank_model_ptr model = &drmmode_crtc->vblank_model;
+
 		/*
 		 * Off->On transition: calculate and accumulate the
 		 * number of interpolated vblanks while we were in Off state
@@ -293,14 +312,14 @@ drmmode_crtc_dpms(xf86CrtcPtr crtc, int mode)
 		if (ret)
 			xf86DrvMsg(scrn->scrnIndex, X_ERROR,
 				   "%s cannot get current time\n", __func__);
-		else if (drmmode_crtc->dpms_last_ust) {
-			CARD64 time_elapsed, delta_seq;
-			time_elapsed = ust - drmmode_crtc->dpms_last_ust;
-			delta_seq = time_elapsed * drmmode_crtc->dpms_last_fps;
-			delta_seq /= 1000000;
-			drmmode_crtc->interpolated_vblanks += delta_seq;
-
+		else if (model->last_ust) {
+			drmmode_crtc->interpolated_vblanks +=
+				drmmode_vblank_model_seq(model, ust) -
+				model->last_seq;
 		}
+
+		/* The kernel counter resumes where it stopped, re-anchor */
+		drmmode_vblank_model_reset(model, model->period_ns);
 	}
 	drmmode_crtc->dpms_mode = mode;
 }
@@ -371,7 +390,7 @@ void drmmode_copy_fb(ScrnInfoPtr pScrn, drmmode_ptr drmmode)
 	if (!fbcon_id)
 		goto fallback;
 
-	if (fbcon_id == drmmode->fb_id) {
+	if (drmmode->fb && fbcon_id == drmmode->fb->handle) {
 		/* in some rare case there might be no fbcon and we might already
 		 * be the one with the current fb to avoid a false deadlck in
 		 * kernel ttm code just do nothing as anyway there is nothing
@@ -432,6 +451,112 @@ fallback:
 	radeon_bo_unmap(info->front_bo);
 }
 
+struct drmmode_fb *
+drmmode_fb_create(int drm_fd, uint32_t width, uint32_t height, uint8_t depth,
+		  uint8_t bpp, uint32_t pitch, uint32_t handle)
+{
+	struct drmmode_fb *fb = malloc(sizeof(*fb));
+
+	if (!fb)
+		return NULL;
+
+	fb->refcnt = 1;
+	if (drmModeAddFB(drm_fd, width, height, depth, bpp, pitch, handle,
+			 &fb->handle) == 0)
+		return fb;
+
+	free(fb);
+	return NULL;
+}
+
+/* Create an fb with the geometry of the screen for the given BO */
+static struct drmmode_fb *
+drmmode_screen_fb_create(ScrnInfoPtr scrn, drmmode_ptr drmmode,
+			 struct radeon_bo *bo)
+{
+	RADEONInfoPtr info = RADEONPTR(scrn);
+	uint32_t tiling_flags = 0;
+	int pitch, height;
+
+	if (info->allowColorTiling) {
+		if (info->ChipFamily >= CHIP_FAMILY_R600)
+			tiling_flags |= RADEON_TILING_MICRO;
+		else
+			tiling_flags |= RADEON_TILING_MACRO;
+	}
+
+	pitch = RADEON_ALIGN(scrn->displayWidth, drmmode_get_pitch_align(scrn, info->pixel_bytes, tiling_flags)) *
+		info->pixel_bytes;
+	height = RADEON_ALIGN(scrn->virtualY, drmmode_get_height_align(scrn, tiling_flags));
+	if (info->ChipFamily >= CHIP_FAMILY_R600 && info->surf_man) {
+		pitch = info->front_surface.level[0].pitch_bytes;
+	}
+
+	return drmmode_fb_create(drmmode->fd, scrn->virtualX, height,
+				 scrn->depth, scrn->bitsPerPixel, pitch,
+				 bo->handle);
+}
+
+/*
+ * Return the fb wrapping a pixmap's BO, creating it on first use. The
+ * pixmap owns the reference; it is dropped when the pixmap's BO changes or
+ * the pixmap is destroyed, and moves along with the BO on DRI2 exchanges.
+ */
+struct drmmode_fb *
+radeon_pixmap_get_fb(ScrnInfoPtr scrn, PixmapPtr pixmap)
+{
+	RADEONInfoPtr info = RADEONPTR(scrn);
+	struct drmmode_fb **fb_ptr = radeon_pixmap_get_fb_ptr(pixmap);
+	struct radeon_bo *bo;
+
+	if (!fb_ptr)
+		return NULL;
+
+	if (!*fb_ptr) {
+		bo = radeon_get_pixmap_bo(pixmap);
+		if (!bo)
+			return NULL;
+
+		*fb_ptr = drmmode_fb_create(info->drmmode.fd,
+					    pixmap->drawable.width,
+					    pixmap->drawable.height,
+					    pixmap->drawable.depth,
+					    pixmap->drawable.bitsPerPixel,
+					    pixmap->devKind, bo->handle);
+	}
+
+	return *fb_ptr;
+}
+
+/*
+ * Return the fb scanning out the front buffer. It is shared with the
+ * screen pixmap when that is backed by the front BO, so flipping back to
+ * the original front reuses it.
+ */
+static struct drmmode_fb *
+drmmode_front_fb(ScrnInfoPtr scrn, drmmode_ptr drmmode)
+{
+	RADEONInfoPtr info = RADEONPTR(scrn);
+	ScreenPtr screen = scrn->pScreen;
+	PixmapPtr ppix;
+
+	if (drmmode->fb)
+		return drmmode->fb;
+
+	if (screen && !info->r600_shadow_fb) {
+		ppix = screen->GetScreenPixmap(screen);
+		if (ppix && radeon_get_pixmap_bo(ppix) == info->front_bo)
+			drmmode_fb_reference(drmmode->fd, &drmmode->fb,
+					     radeon_pixmap_get_fb(scrn, ppix));
+	}
+
+	if (!drmmode->fb)
+		drmmode->fb = drmmode_screen_fb_create(scrn, drmmode,
+						       info->front_bo);
+
+	return drmmode->fb;
+}
+
 static Bool
 drmmode_set_mode_major(xf86CrtcPtr crtc, DisplayModePtr mode,
 		     Rotation rotation, int x, int y)
@@ -450,37 +575,12 @@ drmmode_set_mode_major(xf86CrtcPtr crtc, DisplayModePtr mode,
 	int i;
 	int fb_id;
 	drmModeModeInfo kmode;
-	int pitch;
-	uint32_t tiling_flags = 0;
-	int height;
 
-	if (info->allowColorTiling) {
-		if (info->ChipFamily >= CHIP_FAMILY_R600)
-			tiling_flags |= RADEON_TILING_MICRO;
-		else
-			tiling_flags |= RADEON_TILING_MACRO;
-	}
-
-	pitch = RADEON_ALIGN(pScrn->displayWidth, drmmode_get_pitch_align(pScrn, info->pixel_bytes, tiling_flags)) *
-		info->pixel_bytes;
-	height = RADEON_ALIGN(pScrn->virtualY, drmmode_get_height_align(pScrn, tiling_flags));
-	if (info->ChipFamily >= CHIP_FAMILY_R600) {
-		pitch = info->front_surface.level[0].pitch_bytes;
+	if (!drmmode_front_fb(pScrn, drmmode)) {
+		ErrorF("failed to add fb\n");
+		return FALSE;
 	}
 
-	if (drmmode->fb_id == 0) {
-		ret = drmModeAddFB(drmmode->fd,
-				   pScrn->virtualX, height,
-                                   pScrn->depth, pScrn->bitsPerPixel,
-				   pitch,
-				   info->front_bo->handle,
-                                   &drmmode->fb_id);
-                if (ret < 0) {
-                        ErrorF("failed to add fb\n");
-                        return FALSE;
-                }
-        }
-
 	saved_mode = crtc->mode;
 	saved_x = crtc->x;
 	saved_y = crtc->y;
@@ -521,9 +621,9 @@ drmmode_set_mode_major(xf86CrtcPtr crtc, DisplayModePtr mode,
 		
 		drmmode_ConvertToKMode(crtc->scrn, &kmode, mode);
 
-		fb_id = drmmode->fb_id;
-		if (drmmode_crtc->rotate_fb_id) {
-			fb_id = drmmode_crtc->rotate_fb_id;
+		fb_id = drmmode->fb->handle;
+		if (drmmode_crtc->rotate_fb) {
+			fb_id = drmmode_crtc->rotate_fb->handle;
 			x = y = 0;
 		}
 		ret = drmModeSetCrtc(drmmode->fd, drmmode_crtc->mode_crtc->crtc_id,
@@ -534,6 +634,9 @@ drmmode_set_mode_major(xf86CrtcPtr crtc, DisplayModePtr mode,
 		else
 			ret = TRUE;
 
+		drmmode_vblank_model_reset(&drmmode_crtc->vblank_model,
+					   drmmode_crtc_nominal_period_ns(crtc));
+
 		if (crtc->scrn->pScreen)
 			xf86CrtcSetScreenSubpixelOrder(crtc->scrn->pScreen);
 		/* go through all the outputs and force DPMS them back on? */
@@ -634,7 +737,6 @@ drmmode_crtc_shadow_allocate(xf86CrtcPtr crtc, int width, int height)
 	drmmode_ptr drmmode = drmmode_crtc->drmmode;
 	int size;
 	struct radeon_bo *rotate_bo;
-	int ret;
 	unsigned long rotate_pitch;
 	int base_align;
 
@@ -657,14 +759,6 @@ drmmode_crtc_shadow_allocate(xf86CrtcPtr crtc, int width, int height)
 
 	radeon_bo_map(rotate_bo, 1);
 
-	ret = drmModeAddFB(drmmode->fd, width, height, crtc->scrn->depth,
-			   crtc->scrn->bitsPerPixel, rotate_pitch,
-			   rotate_bo->handle,
-			   &drmmode_crtc->rotate_fb_id);
-	if (ret) {
-		ErrorF("failed to add rotate fb\n");
-	}
-
 	drmmode_crtc->rotate_bo = rotate_bo;
 	return drmmode_crtc->rotate_bo->ptr;
 }
@@ -692,7 +786,14 @@ drmmode_crtc_shadow_create(xf86CrtcPtr crtc, void *data, int width, int height)
 	if (rotate_pixmap == NULL) {
 		xf86DrvMsg(pScrn->scrnIndex, X_ERROR,
 			   "Couldn't allocate shadow pixmap for rotated CRTC\n");
+		return NULL;
 	}
+
+	drmmode_fb_reference(drmmode->fd, &drmmode_crtc->rotate_fb,
+			     radeon_pixmap_get_fb(pScrn, rotate_pixmap));
+	if (!drmmode_crtc->rotate_fb)
+		ErrorF("failed to add rotate fb\n");
+
 	return rotate_pixmap;
 
 }
@@ -703,12 +804,12 @@ drmmode_crtc_shadow_destroy(xf86CrtcPtr crtc, PixmapPtr rotate_pixmap, void *dat
 	drmmode_crtc_private_ptr drmmode_crtc = crtc->driver_private;
 	drmmode_ptr drmmode = drmmode_crtc->drmmode;
 
-	if (rotate_pixmap)
+	if (rotate_pixmap) {
+		drmmode_fb_reference(drmmode->fd, &drmmode_crtc->rotate_fb, NULL);
 		drmmode_destroy_bo_pixmap(rotate_pixmap);
+	}
 
 	if (data) {
-		drmModeRmFB(drmmode->fd, drmmode_crtc->rotate_fb_id);
-		drmmode_crtc->rotate_fb_id = 0;
 		radeon_bo_unmap(drmmode_crtc->rotate_bo);
 		radeon_bo_unref(drmmode_crtc->rotate_bo);
 		drmmode_crtc->rotate_bo = NULL;
@@ -783,6 +884,7 @@ drmmode_crtc_init(ScrnInfoPtr pScrn, drmmode_ptr drmmode, int num)
 	drmmode_crtc = xnfcalloc(sizeof(drmmode_crtc_private_rec), 1);
 	drmmode_crtc->mode_crtc = drmModeGetCrtc(drmmode->fd, drmmode->mode_res->crtcs[num]);
 	drmmode_crtc->drmmode = drmmode;
+	drmmode_vblank_model_reset(&drmmode_crtc->vblank_model, 0);
 	crtc->driver_private = drmmode_crtc;
 	drmmode_crtc_hw_id(crtc);
 
@@ -1376,6 +1478,55 @@ int drmmode_get_base_align(ScrnInfoPtr scrn, int bpe, uint32_t tiling)
 	return base_align;
 }
 
+/*
+ * Queue a blit of the old front buffer contents into the new one. The
+ * copy is only submitted: the GPU orders it after any rendering still
+ * pending on the old front, so the server never waits for it.
+ */
+static void
+drmmode_copy_old_front(ScrnInfoPtr scrn, struct radeon_bo *old_front,
+		       struct radeon_surface *old_surface,
+		       int old_width, int old_height, int old_pitch)
+{
+	RADEONInfoPtr info = RADEONPTR(scrn);
+	PixmapPtr src, dst;
+	uint32_t tiling_flags, pitch;
+
+	if (info->accelOn == FALSE || info->use_glamor)
+		return;
+
+	radeon_bo_get_tiling(old_front, &tiling_flags, &pitch);
+	src = drmmode_create_bo_pixmap(scrn, old_width, old_height,
+				       scrn->depth, scrn->bitsPerPixel,
+				       old_pitch, tiling_flags, old_front,
+				       info->ChipFamily >= CHIP_FAMILY_R600 ?
+				       old_surface : NULL);
+	if (!src)
+		return;
+
+	radeon_bo_get_tiling(info->front_bo, &tiling_flags, &pitch);
+	dst = drmmode_create_bo_pixmap(scrn, scrn->virtualX, scrn->virtualY,
+				       scrn->depth, scrn->bitsPerPixel,
+				       scrn->displayWidth * info->pixel_bytes,
+				       tiling_flags, info->front_bo,
+				       &info->front_surface);
+	if (!dst)
+		goto out_free_src;
+
+	if (info->accel_state->exa->PrepareCopy(src, dst, -1, -1, GXcopy,
+						FB_ALLONES)) {
+		info->accel_state->exa->Copy(dst, 0, 0, 0, 0,
+					     MIN(old_width, scrn->virtualX),
+					     MIN(old_height, scrn->virtualY));
+		info->accel_state->exa->DoneCopy(dst);
+		radeon_cs_flush_indirect(scrn);
+	}
+
+	drmmode_destroy_bo_pixmap(dst);
+ out_free_src:
+	drmmode_destroy_bo_pixmap(src);
+}
+
 static Bool
 drmmode_xf86crtc_resize (ScrnInfoPtr scrn, int width, int height)
 {
@@ -1385,14 +1536,12 @@ drmmode_xf86crtc_resize (ScrnInfoPtr scrn, int width, int height)
 	drmmode_ptr drmmode = drmmode_crtc->drmmode;
 	RADEONInfoPtr info = RADEONPTR(scrn);
 	struct radeon_bo *old_front = NULL;
-	Bool	    ret;
 	ScreenPtr   screen = xf86ScrnToScreen(scrn);
-	uint32_t    old_fb_id;
+	struct drmmode_fb *old_fb;
 	int	    i, pitch, old_width, old_height, old_pitch;
 	int screen_size;
 	int cpp = info->pixel_bytes;
-	struct radeon_bo *front_bo;
-	struct radeon_surface surface;
+	struct radeon_surface surface, old_surface;
 	struct radeon_surface *psurface;
 	uint32_t tiling_flags = 0, base_align;
 	PixmapPtr ppix = screen->GetScreenPixmap(screen);
@@ -1401,11 +1550,7 @@ drmmode_xf86crtc_resize (ScrnInfoPtr scrn, int width, int height)
 	if (scrn->virtualX == width && scrn->virtualY == height)
 		return TRUE;
 
-	front_bo = info->front_bo;
-	radeon_cs_flush_indirect(scrn);
-
-	if (front_bo)
-		radeon_bo_wait(front_bo);
+	old_surface = info->front_surface;
 
 	if (info->allowColorTiling) {
 		if (info->ChipFamily >= CHIP_FAMILY_R600) {
@@ -1481,7 +1626,8 @@ drmmode_xf86crtc_resize (ScrnInfoPtr scrn, int width, int height)
 	old_width = scrn->virtualX;
 	old_height = scrn->virtualY;
 	old_pitch = scrn->displayWidth;
-	old_fb_id = drmmode->fb_id;
+	old_fb = drmmode->fb;
+	drmmode->fb = NULL;
 	old_front = info->front_bo;
 
 	scrn->virtualX = width;
@@ -1505,14 +1651,11 @@ drmmode_xf86crtc_resize (ScrnInfoPtr scrn, int width, int height)
 	if (tiling_flags)
 	    radeon_bo_set_tiling(info->front_bo, tiling_flags, pitch);
 
-	ret = drmModeAddFB(drmmode->fd, width, height, scrn->depth,
-			   scrn->bitsPerPixel, pitch,
-			   info->front_bo->handle,
-			   &drmmode->fb_id);
-	if (ret)
-		goto fail;
-
 	if (!info->r600_shadow_fb) {
+		if (old_front)
+			drmmode_copy_old_front(scrn, old_front, &old_surface,
+					       old_width, old_height,
+					       old_pitch * cpp);
 		radeon_set_pixmap_bo(ppix, info->front_bo);
 		psurface = radeon_get_pixmap_surface(ppix);
 		*psurface = info->front_surface;
@@ -1534,6 +1677,9 @@ drmmode_xf86crtc_resize (ScrnInfoPtr scrn, int width, int height)
 	scrn->pixmapPrivate.ptr = ppix->devPrivate.ptr;
 #endif
 
+	if (!drmmode_front_fb(scrn, drmmode))
+		goto fail;
+
 	for (i = 0; i < xf86_config->num_crtc; i++) {
 		xf86CrtcPtr crtc = xf86_config->crtc[i];
 
@@ -1547,8 +1693,11 @@ drmmode_xf86crtc_resize (ScrnInfoPtr scrn, int width, int height)
 	if (info->use_glamor)
 		radeon_glamor_create_screen_resources(scrn->pScreen);
 
-	if (old_fb_id)
-		drmModeRmFB(drmmode->fd, old_fb_id);
+	/*
+	 * Pending flips and the kernel's own fb and fence references keep
+	 * the old front alive until the GPU and the CRTCs are done with it.
+	 */
+	drmmode_fb_reference(drmmode->fd, &old_fb, NULL);
 	if (old_front)
 		radeon_bo_unref(old_front);
 
@@ -1562,7 +1711,8 @@ drmmode_xf86crtc_resize (ScrnInfoPtr scrn, int width, int height)
 	scrn->virtualX = old_width;
 	scrn->virtualY = old_height;
 	scrn->displayWidth = old_pitch;
-	drmmode->fb_id = old_fb_id;
+	drmmode_fb_reference(drmmode->fd, &drmmode->fb, NULL);
+	drmmode->fb = old_fb;
 
 	return FALSE;
 }
@@ -1575,7 +1725,9 @@ static void
 drmmode_vblank_handler(int fd, unsigned int frame, unsigned int tv_sec,
 			unsigned int tv_usec, void *event_data)
 {
-	radeon_dri2_frame_event_handler(frame, tv_sec, tv_usec, event_data);
+	drmmode_vblank_event_ptr event = event_data;
+
+	event->handler(frame, tv_sec, tv_usec, event_data);
 }
 
 static void
@@ -1586,6 +1738,8 @@ drmmode_flip_handler(int fd, unsigned int frame, unsigned int tv_sec,
 	drmmode_flipdata_ptr flipdata = flipcarrier->flipdata;
 	drmmode_ptr drmmode = flipdata->drmmode;
 
+	drmmode_crtc_vblank_sample(flipcarrier->crtc, frame, tv_sec, tv_usec);
+
 	/* Is this the event whose info shall be delivered to higher level? */
 	if (flipcarrier->dispatch_me) {
 		/* Yes: Cache msc, ust for later delivery. */
@@ -1600,8 +1754,8 @@ drmmode_flip_handler(int fd, unsigned int frame, unsigned int tv_sec,
 	if (flipdata->flip_count > 0)
 		return;
 
-	/* Release framebuffer */
-	drmModeRmFB(drmmode->fd, flipdata->old_fb_id);
+	/* Release the previous front's fb now nothing scans it out */
+	drmmode_fb_reference(drmmode->fd, &flipdata->old_fb, NULL);
 
 	if (flipdata->event_data == NULL)
 		return;
@@ -1925,48 +2079,45 @@ void drmmode_uevent_fini(ScrnInfoPtr scrn, drmmode_ptr drmmode)
 #endif
 }
 
-Bool radeon_do_pageflip(ScrnInfoPtr scrn, struct radeon_bo *new_front, void *data, int ref_crtc_hw_id)
+Bool radeon_do_pageflip(ScrnInfoPtr scrn, PixmapPtr new_front, void *data, int ref_crtc_hw_id)
 {
 	RADEONInfoPtr info = RADEONPTR(scrn);
 	xf86CrtcConfigPtr config = XF86_CRTC_CONFIG_PTR(scrn);
 	drmmode_crtc_private_ptr drmmode_crtc = config->crtc[0]->driver_private;
 	drmmode_ptr drmmode = drmmode_crtc->drmmode;
-	unsigned int pitch;
-	int i, old_fb_id;
-	uint32_t tiling_flags = 0;
-	int height, emitted = 0;
+	struct radeon_bo *bo = radeon_get_pixmap_bo(new_front);
+	struct drmmode_fb *fb;
+	int i, emitted = 0;
 	drmmode_flipdata_ptr flipdata;
 	drmmode_flipevtcarrier_ptr flipcarrier;
 
-	if (info->allowColorTiling) {
-		if (info->ChipFamily >= CHIP_FAMILY_R600)
-			tiling_flags |= RADEON_TILING_MICRO;
-		else
-			tiling_flags |= RADEON_TILING_MACRO;
-	}
-
-	pitch = RADEON_ALIGN(scrn->displayWidth, drmmode_get_pitch_align(scrn, info->pixel_bytes, tiling_flags)) *
-		info->pixel_bytes;
-	height = RADEON_ALIGN(scrn->virtualY, drmmode_get_height_align(scrn, tiling_flags));
-	if (info->ChipFamily >= CHIP_FAMILY_R600 && info->surf_man) {
-		pitch = info->front_surface.level[0].pitch_bytes;
-	}
-
 	/*
-	 * Create a new handle for the back buffer
+	 * Look up the back buffer's fb, only created the first time this BO
+	 * is flipped to
 	 */
-	old_fb_id = drmmode->fb_id;
-	if (drmModeAddFB(drmmode->fd, scrn->virtualX, height,
-			 scrn->depth, scrn->bitsPerPixel, pitch,
-			 new_front->handle, &drmmode->fb_id))
+	fb = radeon_pixmap_get_fb(scrn, new_front);
+	if (!fb)
 		goto error_out;
 
+	/*
+	 * The kernel defers the flip until rendering to the BO has finished,
+	 * so only commands still sitting in our IB need to be submitted.
+	 */
+	if (radeon_bo_is_referenced_by_cs(bo, info->cs))
+		radeon_cs_flush_indirect(scrn);
+
         flipdata = calloc(1, sizeof(drmmode_flipdata_rec));
         if (!flipdata) {
              xf86DrvMsg(scrn->scrnIndex, X_WARNING,
                         "flip queue: data alloc failed.\n");
-             goto error_undo;
+             goto error_out;
         }
+
+	/* The old front stays referenced until the flips have completed */
+	flipdata->old_fb = drmmode->fb;
+	drmmode->fb = NULL;
+	drmmode_fb_reference(drmmode->fd, &drmmode->fb, fb);
+
 	/*
 	 * Queue flips on all enabled CRTCs
 	 * Note that if/when we get per-CRTC buffers, we'll have to update this.
@@ -1984,15 +2135,12 @@ Bool radeon_do_pageflip(ScrnInfoPtr scrn, struct radeon_bo *new_front, void *dat
 		if (!config->crtc[i]->enabled)
 			continue;
 
-		flipdata->flip_count++;
 		drmmode_crtc = config->crtc[i]->driver_private;
 
 		flipcarrier = calloc(1, sizeof(drmmode_flipevtcarrier_rec));
 		if (!flipcarrier) {
 			xf86DrvMsg(scrn->scrnIndex, X_WARNING,
 				   "flip queue: carrier alloc failed.\n");
-			if (emitted == 0)
-				free(flipdata);
 			goto error_undo;
 		}
 
@@ -2001,25 +2149,28 @@ Bool radeon_do_pageflip(ScrnInfoPtr scrn, struct radeon_bo *new_front, void *dat
 		 */
 		flipcarrier->dispatch_me = (drmmode_crtc->hw_id == ref_crtc_hw_id);
 		flipcarrier->flipdata = flipdata;
+		flipcarrier->crtc = config->crtc[i];
 
 		if (drmModePageFlip(drmmode->fd, drmmode_crtc->mode_crtc->crtc_id,
-				    drmmode->fb_id, DRM_MODE_PAGE_FLIP_EVENT, flipcarrier)) {
+				    fb->handle, DRM_MODE_PAGE_FLIP_EVENT, flipcarrier)) {
 			xf86DrvMsg(scrn->scrnIndex, X_WARNING,
 				   "flip queue failed: %s\n", strerror(errno));
 			free(flipcarrier);
-			if (emitted == 0)
-				free(flipdata);
 			goto error_undo;
 		}
+		flipdata->flip_count++;
 		emitted++;
 	}
 
-	flipdata->old_fb_id = old_fb_id;
 	return TRUE;
 
 error_undo:
-	drmModeRmFB(drmmode->fd, drmmode->fb_id);
-	drmmode->fb_id = old_fb_id;
+	/* Flips already queued keep the new front and release the old fb */
+	if (emitted == 0) {
+		drmmode_fb_reference(drmmode->fd, &drmmode->fb, flipdata->old_fb);
+		drmmode_fb_reference(drmmode->fd, &flipdata->old_fb, NULL);
+		free(flipdata);
+	}
 
 error_out:
 	xf86DrvMsg(scrn->scrnIndex, X_WARNING, "Page flip failed: %s\n",
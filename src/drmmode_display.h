@@ -28,6 +28,7 @@
 #define DRMMODE_DISPLAY_H
 
 #include "xf86drmMode.h"
+#include "drmmode_vblank_model.h"
 #ifdef HAVE_LIBUDEV
 #include "libudev.h"
 #endif
@@ -38,9 +39,20 @@
 #define DRM_CAP_TIMESTAMP_MONOTONIC 0x6
 #endif
 
+/*
+ * KMS framebuffer object. Instances are shared by reference: a pixmap
+ * caches the one wrapping its BO, and the scanout and pending flips hold
+ * their own references, so the fb is only removed once nothing can be
+ * scanning it out any more.
+ */
+struct drmmode_fb {
+  int refcnt;
+  uint32_t handle;
+};
+
 typedef struct {
   int fd;
-  unsigned fb_id;
+  struct drmmode_fb *fb;
   drmModeResPtr mode_res;
   drmModeFBPtr mode_fb;
   int cpp;
@@ -55,7 +67,7 @@ typedef struct {
 
 typedef struct {
   drmmode_ptr drmmode;
-  unsigned old_fb_id;
+  struct drmmode_fb *old_fb;
   int flip_count;
   void *event_data;
   unsigned int fe_frame;
@@ -65,20 +77,28 @@ typedef struct {
 
 typedef struct {
   drmmode_flipdata_ptr flipdata;
+  xf86CrtcPtr crtc;
   Bool dispatch_me;
 } drmmode_flipevtcarrier_rec, *drmmode_flipevtcarrier_ptr;
 
+/*
+ * Leading member of the data passed with every DRM_VBLANK_EVENT request,
+ * so drmmode_vblank_handler can hand the event back to whoever queued it.
+ */
+typedef struct {
+    void (*handler)(unsigned int frame, unsigned int tv_sec,
+		    unsigned int tv_usec, void *event_data);
+} drmmode_vblank_event_rec, *drmmode_vblank_event_ptr;
+
 typedef struct {
     drmmode_ptr drmmode;
     drmModeCrtcPtr mode_crtc;
     int hw_id;
     struct radeon_bo *cursor_bo;
     struct radeon_bo *rotate_bo;
-    unsigned rotate_fb_id;
+    struct drmmode_fb *rotate_fb;
     int dpms_mode;
-    CARD64 dpms_last_ust;
-    uint32_t dpms_last_seq;
-    int dpms_last_fps;
+    drmmode_vblank_model_rec vblank_model;
     uint32_t interpolated_vblanks;
     uint16_t lut_r[256], lut_g[256], lut_b[256];
 } drmmode_crtc_private_rec, *drmmode_crtc_private_ptr;
@@ -105,6 +125,26 @@ typedef struct {
 } drmmode_output_private_rec, *drmmode_output_private_ptr;
 
 
+static inline void
+drmmode_fb_reference(int drm_fd, struct drmmode_fb **old, struct drmmode_fb *new)
+{
+	if (new)
+		new->refcnt++;
+
+	if (*old && --(*old)->refcnt == 0) {
+		drmModeRmFB(drm_fd, (*old)->handle);
+		free(*old);
+	}
+
+	*old = new;
+}
+
+extern struct drmmode_fb *drmmode_fb_create(int drm_fd, uint32_t width,
+					    uint32_t height, uint8_t depth,
+					    uint8_t bpp, uint32_t pitch,
+					    uint32_t handle);
+extern struct drmmode_fb *radeon_pixmap_get_fb(ScrnInfoPtr scrn, PixmapPtr pixmap);
+
 extern Bool drmmode_pre_init(ScrnInfoPtr pScrn, drmmode_ptr drmmode, int cpp);
 extern void drmmode_init(ScrnInfoPtr pScrn, drmmode_ptr drmmode);
 extern void drmmode_fini(ScrnInfoPtr pScrn, drmmode_ptr drmmode);
@@ -122,8 +162,11 @@ extern int drmmode_get_height_align(ScrnInfoPtr scrn, uint32_t tiling);
 extern int drmmode_get_pitch_align(ScrnInfoPtr scrn, int bpe, uint32_t tiling);
 extern int drmmode_get_base_align(ScrnInfoPtr scrn, int bpe, uint32_t tiling);
 
-Bool radeon_do_pageflip(ScrnInfoPtr scrn, struct radeon_bo *new_front, void *data, int ref_crtc_hw_id);
+Bool radeon_do_pageflip(ScrnInfoPtr scrn, PixmapPtr new_front, void *data, int ref_crtc_hw_id);
 int drmmode_get_current_ust(int drm_fd, CARD64 *ust);
 
+void drmmode_crtc_vblank_sample(xf86CrtcPtr crtc, unsigned int seq,
+				unsigned int tv_sec, unsigned int tv_usec);
+
 #endif
 
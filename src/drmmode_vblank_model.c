@@ -0,0 +1,171 @@
+/*
+ * Copyright © 2007 Red Hat, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice (including the next
+ * paragraph) shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * Vblank timing model. Kept free of any server or DRM state so it can be
+ * driven by synthetic event streams, see test/vblank_model.c.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdlib.h>
+#include "drmmode_vblank_model.h"
+
+#ifndef TRUE
+#define TRUE 1
+#define FALSE 0
+#endif
+
+#define DEFAULT_NOMINAL_FRAME_RATE 60
+
+/* Samples needed before the model answers queries on its own */
+#define VBLANK_MODEL_MIN_SAMPLES	4
+/* How far past the anchor the model is trusted without a new sample */
+#define VBLANK_MODEL_HORIZON_US		1000000
+/* Distance from a predicted vblank below which we ask the kernel */
+#define VBLANK_MODEL_GUARD_NS		500000
+
+/*
+ * Forget the anchor and start learning again from period_ns, e.g. after
+ * a modeset or when the CRTC's vblank counter stops being continuous.
+ */
+void drmmode_vblank_model_reset(drmmode_vblank_model_ptr model, CARD64 period_ns)
+{
+	if (period_ns == 0)
+		period_ns = 1000000000 / DEFAULT_NOMINAL_FRAME_RATE;
+
+	model->last_seq = 0;
+	model->last_ust = 0;
+	model->period_ns = period_ns;
+	model->samples = 0;
+}
+
+/*
+ * Feed one observed vblank into the model. The period estimate is a
+ * running average of the measured inter-vblank time; a measurement far
+ * off the estimate (mode change, counter jump) drops the confidence.
+ */
+void drmmode_vblank_model_sample(drmmode_vblank_model_ptr model, uint32_t seq, CARD64 ust)
+{
+	int32_t delta_seq;
+	int64_t measured, error;
+
+	/* All-zero timestamps signal a failed event */
+	if (ust == 0)
+		return;
+
+	if (model->period_ns == 0)
+		drmmode_vblank_model_reset(model, 0);
+
+	if (model->last_ust == 0)
+		goto anchor;
+
+	delta_seq = (int32_t)(seq - model->last_seq);
+	if (delta_seq <= 0)
+		/* Older or the same vblank as the anchor, nothing new */
+		return;
+
+	if (ust <= model->last_ust) {
+		model->samples = 0;
+		goto anchor;
+	}
+
+	measured = (int64_t)(ust - model->last_ust) * 1000 / delta_seq;
+	error = measured - (int64_t)model->period_ns;
+
+	if (llabs(error) <= (int64_t)model->period_ns / 50) {
+		/* Long baselines are more precise, weigh them accordingly */
+		if (delta_seq >= 8)
+			model->period_ns = measured;
+		else
+			model->period_ns += error / (8 / delta_seq);
+		model->samples++;
+	} else {
+		if (llabs(error) <= (int64_t)model->period_ns / 4)
+			model->period_ns = measured;
+		model->samples = 0;
+	}
+
+anchor:
+	model->last_seq = seq;
+	model->last_ust = ust;
+}
+
+/*
+ * Predict the sequence number and timestamp of the most recent vblank
+ * at time now. Fails unless the model is confident, close enough to its
+ * anchor and not too close to a vblank boundary; callers must then ask
+ * the kernel instead.
+ */
+Bool drmmode_vblank_model_predict(drmmode_vblank_model_ptr model, CARD64 now,
+				  uint32_t *seq, CARD64 *ust)
+{
+	CARD64 elapsed_ns, frames, into_frame;
+
+	if (model->samples < VBLANK_MODEL_MIN_SAMPLES ||
+	    now < model->last_ust ||
+	    now - model->last_ust > VBLANK_MODEL_HORIZON_US)
+		return FALSE;
+
+	elapsed_ns = (now - model->last_ust) * 1000;
+	frames = elapsed_ns / model->period_ns;
+	into_frame = elapsed_ns - frames * model->period_ns;
+	if (into_frame < VBLANK_MODEL_GUARD_NS ||
+	    model->period_ns - into_frame < VBLANK_MODEL_GUARD_NS)
+		return FALSE;
+
+	*seq = model->last_seq + (uint32_t)frames;
+	*ust = model->last_ust + (frames * model->period_ns + 500) / 1000;
+	return TRUE;
+}
+
+/*
+ * Extrapolate the sequence number of the most recent vblank at time ust,
+ * regardless of confidence. Used for CRTCs in DPMS off state, which stop
+ * delivering events.
+ */
+uint32_t drmmode_vblank_model_seq(drmmode_vblank_model_ptr model, CARD64 ust)
+{
+	if (ust <= model->last_ust)
+		return model->last_seq;
+
+	return model->last_seq +
+		(uint32_t)((ust - model->last_ust) * 1000 / model->period_ns);
+}
+
+/*
+ * Extrapolate the timestamp at which vblank seq happened or will happen.
+ */
+CARD64 drmmode_vblank_model_ust(drmmode_vblank_model_ptr model, uint32_t seq)
+{
+	int64_t delta_ns;
+
+	delta_ns = (int64_t)(int32_t)(seq - model->last_seq) *
+		(int64_t)model->period_ns;
+	if (delta_ns < 0 && (CARD64)(-delta_ns / 1000) > model->last_ust)
+		return 0;
+
+	return model->last_ust + (delta_ns + (delta_ns < 0 ? -500 : 500)) / 1000;
+}
@@ -0,0 +1,49 @@
+/*
+ * Copyright © 2007 Red Hat, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice (including the next
+ * paragraph) shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef DRMMODE_VBLANK_MODEL_H
+#define DRMMODE_VBLANK_MODEL_H
+
+#include <stdint.h>
+#include <X11/Xdefs.h>
+#include <X11/Xmd.h>
+
+/*
+ * Vblank timing model of a CRTC, learnt from the (sequence, timestamp)
+ * pairs of delivered vblank and pageflip events. Sequence numbers are
+ * kernel vblank counter values, timestamps are in microseconds.
+ */
+typedef struct {
+    uint32_t last_seq;		/* anchor: most recent vblank observed */
+    CARD64 last_ust;		/* timestamp of the anchor, 0 if none */
+    CARD64 period_ns;		/* estimated refresh period */
+    int samples;		/* consistent samples since the last reset */
+} drmmode_vblank_model_rec, *drmmode_vblank_model_ptr;
+
+void drmmode_vblank_model_reset(drmmode_vblank_model_ptr model, CARD64 period_ns);
+void drmmode_vblank_model_sample(drmmode_vblank_model_ptr model, uint32_t seq, CARD64 ust);
+Bool drmmode_vblank_model_predict(drmmode_vblank_model_ptr model, CARD64 now,
+				  uint32_t *seq, CARD64 *ust);
+uint32_t drmmode_vblank_model_seq(drmmode_vblank_model_ptr model, CARD64 ust);
+CARD64 drmmode_vblank_model_ust(drmmode_vblank_model_ptr model, uint32_t seq);
+
+#endif
@@ -957,7 +957,7 @@ evergreen_set_default_state(ScrnInfoPtr pScrn)
     tex_resource_t tex_res;
     shader_config_t fs_conf;
     sq_config_t sq_conf;
-    int i;
+    int i, start;
     RADEONInfoPtr info = RADEONPTR(pScrn);
     struct radeon_accel_state *accel_state = info->accel_state;
 
@@ -969,9 +969,13 @@ evergreen_set_default_state(ScrnInfoPtr pScrn)
     if (accel_state->XInited3D)
 	return;
 
+    if (radeon_default_state_replay(pScrn))
+	return;
+
     memset(&tex_res, 0, sizeof(tex_resource_t));
     memset(&fs_conf, 0, sizeof(shader_config_t));
 
+    start = radeon_default_state_begin(pScrn);
     accel_state->XInited3D = TRUE;
 
     evergreen_start_3d(pScrn);
@@ -1410,6 +1414,8 @@ evergreen_set_default_state(ScrnInfoPtr pScrn)
     E32(0);
     E32(0);
     END_BATCH();
+
+    radeon_default_state_end(pScrn, start);
 }
 
 
@@ -1493,3 +1499,140 @@ void evergreen_finish_op(ScrnInfoPtr pScrn, int vtx_size)
 
 }
 
+/*
+ * Transfers between linear buffers can go through the async DMA engine
+ * instead of the 3D pipe, where they overlap with rendering.  Only worth
+ * it for big transfers: every line becomes a packet with two relocations.
+ * The DMA engine can't wait for a vline, so not when the caller would.
+ */
+Bool
+evergreen_dma_wanted(ScrnInfoPtr pScrn, uint32_t line_bytes, int h, Bool vsync)
+{
+    RADEONInfoPtr info = RADEONPTR(pScrn);
+
+    if (!info->dma_copy || vsync)
+	return FALSE;
+
+    if (line_bytes & 3)
+	return FALSE;
+
+    return line_bytes >= 256 && line_bytes * h >= EVERGREEN_DMA_MIN_BYTES;
+}
+
+/*
+ * Copy h lines of line_bytes each on the DMA ring.  The copy is submitted
+ * right away in a CS of its own; the kernel orders it against the work
+ * already submitted for both buffers, and anything submitted later that
+ * uses them waits for it.  Offsets and pitches must be dword aligned.
+ */
+Bool
+evergreen_dma_copy(ScrnInfoPtr pScrn,
+		   struct radeon_bo *dst_bo, uint32_t dst_domain,
+		   uint32_t dst_offset, uint32_t dst_pitch,
+		   struct radeon_bo *src_bo, uint32_t src_domain,
+		   uint32_t src_offset, uint32_t src_pitch,
+		   uint32_t line_bytes, int h)
+{
+    RADEONInfoPtr info = RADEONPTR(pScrn);
+    struct drm_radeon_cs_chunk chunks[3];
+    uint64_t chunk_array[3];
+    struct drm_radeon_cs_reloc *relocs;
+    struct drm_radeon_cs cs;
+    uint32_t flags[2];
+    uint32_t *ib;
+    uint32_t line_dw, left, n;
+    int num_copies, ndw, i, r, y, ret;
+
+    if ((dst_offset | dst_pitch | src_offset | src_pitch | line_bytes) & 3)
+	return FALSE;
+
+    /* lines back to back on both sides are copied as one range */
+    line_dw = line_bytes >> 2;
+    if (dst_pitch == line_bytes && src_pitch == line_bytes) {
+	line_dw *= h;
+	h = 1;
+    }
+
+    num_copies = h * ((line_dw + DMA_COPY_MAX_DW - 1) / DMA_COPY_MAX_DW);
+    /* the DMA ring wants IBs padded to 8 dwords */
+    ndw = RADEON_ALIGN(num_copies * 5, 8);
+
+    ib = malloc(ndw * sizeof(uint32_t));
+    relocs = calloc(num_copies * 2, sizeof(struct drm_radeon_cs_reloc));
+    if (!ib || !relocs) {
+	free(ib);
+	free(relocs);
+	return FALSE;
+    }
+
+    i = r = 0;
+    for (y = 0; y < h; y++) {
+	uint32_t dst = dst_offset + y * dst_pitch;
+	uint32_t src = src_offset + y * src_pitch;
+
+	for (left = line_dw; left; left -= n) {
+	    n = min(left, DMA_COPY_MAX_DW);
+
+	    ib[i++] = DMA_PACKET(DMA_PACKET_COPY, 0, n);
+	    ib[i++] = dst;
+	    ib[i++] = src;
+	    ib[i++] = 0;
+	    ib[i++] = 0;
+
+	    /* the kernel takes the source then the destination reloc */
+	    relocs[r].handle = src_bo->handle;
+	    relocs[r].read_domains = src_domain;
+	    r++;
+	    relocs[r].handle = dst_bo->handle;
+	    relocs[r].write_domain = dst_domain;
+	    r++;
+
+	    dst += n << 2;
+	    src += n << 2;
+	}
+    }
+    while (i < ndw)
+	ib[i++] = DMA_PACKET(DMA_PACKET_NOP, 0, 0);
+
+    /* unsubmitted 3D work on either buffer has to reach the kernel first */
+    if (radeon_bo_is_referenced_by_cs(dst_bo, info->cs) ||
+	radeon_bo_is_referenced_by_cs(src_bo, info->cs))
+	radeon_cs_flush_indirect(pScrn);
+
+    flags[0] = 0;
+    flags[1] = RADEON_CS_RING_DMA;
+
+    chunks[0].chunk_id = RADEON_CHUNK_ID_IB;
+    chunks[0].length_dw = ndw;
+    chunks[0].chunk_data = (uint64_t)(uintptr_t)ib;
+    chunks[1].chunk_id = RADEON_CHUNK_ID_RELOCS;
+    chunks[1].length_dw = r * sizeof(struct drm_radeon_cs_reloc) / 4;
+    chunks[1].chunk_data = (uint64_t)(uintptr_t)relocs;
+    chunks[2].chunk_id = RADEON_CHUNK_ID_FLAGS;
+    chunks[2].length_dw = 2;
+    chunks[2].chunk_data = (uint64_t)(uintptr_t)flags;
+
+    for (i = 0; i < 3; i++)
+	chunk_array[i] = (uint64_t)(uintptr_t)&chunks[i];
+
+    memset(&cs, 0, sizeof(cs));
+    cs.num_chunks = 3;
+    cs.chunks = (uint64_t)(uintptr_t)chunk_array;
+
+    ret = drmCommandWriteRead(info->dri2.drm_fd, DRM_RADEON_CS,
+			      &cs, sizeof(cs));
+
+    free(ib);
+    free(relocs);
+
+    /* only give up on the ring if the kernel doesn't take DMA CSs */
+    if (ret == -EINVAL) {
+	xf86DrvMsg(pScrn->scrnIndex, X_WARNING,
+		   "DMA copy rejected, using the 3D engine\n");
+	info->dma_copy = FALSE;
+    }
+    if (ret)
+	return FALSE;
+
+    return TRUE;
+}
@@ -40,17 +40,18 @@
 #include "radeon_exa_shared.h"
 #include "radeon_vbo.h"
 
-extern int cayman_solid_vs(RADEONChipFamily ChipSet, uint32_t* vs);
-extern int cayman_solid_ps(RADEONChipFamily ChipSet, uint32_t* ps);
+extern int cayman_solid_vs(RADEONChipFamily ChipSet, uint32_t* vs, uint32_t variant, int max);
+extern int cayman_solid_ps(RADEONChipFamily ChipSet, uint32_t* ps, uint32_t variant, int max);
 
-extern int cayman_copy_vs(RADEONChipFamily ChipSet, uint32_t* vs);
-extern int cayman_copy_ps(RADEONChipFamily ChipSet, uint32_t* ps);
+extern int cayman_copy_vs(RADEONChipFamily ChipSet, uint32_t* vs, uint32_t variant, int max);
+extern int cayman_copy_ps(RADEONChipFamily ChipSet, uint32_t* ps, uint32_t variant, int max);
 
-extern int cayman_xv_vs(RADEONChipFamily ChipSet, uint32_t* shader);
-extern int cayman_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader);
+extern int cayman_xv_vs(RADEONChipFamily ChipSet, uint32_t* shader, uint32_t variant, int max);
+extern int cayman_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader, uint32_t variant, int max);
+extern int cayman_xv_bicubic_ps(RADEONChipFamily ChipSet, uint32_t* shader, uint32_t variant, int max);
 
-extern int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* vs);
-extern int cayman_comp_ps(RADEONChipFamily ChipSet, uint32_t* ps);
+extern int cayman_comp_vs(RADEONChipFamily ChipSet, uint32_t* vs, uint32_t variant, int max);
+extern int cayman_comp_ps(RADEONChipFamily ChipSet, uint32_t* ps, uint32_t variant, int max);
 
 static Bool
 EVERGREENPrepareSolid(PixmapPtr pPix, int alu, Pixel pm, Pixel fg)
@@ -72,6 +73,7 @@ EVERGREENPrepareSolid(PixmapPtr pPix, int alu, Pixel pm, Pixel fg)
 	RADEON_FALLBACK(("invalid planemask\n"));
 
     dst.bo = radeon_get_pixmap_bo(pPix);
+    dst.offset = radeon_get_pixmap_offset(pPix);
     dst.tiling_flags = radeon_get_pixmap_tiling(pPix);
     dst.surface = radeon_get_pixmap_surface(pPix);
 
@@ -79,7 +81,7 @@ EVERGREENPrepareSolid(PixmapPtr pPix, int alu, Pixel pm, Pixel fg)
     dst.width = pPix->drawable.width;
     dst.height = pPix->drawable.height;
     dst.bpp = pPix->drawable.bitsPerPixel;
-    dst.domain = RADEON_GEM_DOMAIN_VRAM;
+    dst.domain = radeon_pixmap_write_domain(pPix);
 
     if (!R600SetAccelState(pScrn,
 			   NULL,
@@ -124,7 +126,7 @@ EVERGREENPrepareSolid(PixmapPtr pPix, int alu, Pixel pm, Pixel fg)
     cb_conf.id = 0;
     cb_conf.w = accel_state->dst_obj.pitch;
     cb_conf.h = accel_state->dst_obj.height;
-    cb_conf.base = 0;
+    cb_conf.base = accel_state->dst_obj.offset;
     cb_conf.bo = accel_state->dst_obj.bo;
     cb_conf.surface = accel_state->dst_obj.surface;
 
@@ -306,8 +308,8 @@ EVERGREENDoPrepareCopy(ScrnInfoPtr pScrn)
     tex_res.pitch               = accel_state->src_obj[0].pitch;
     tex_res.depth               = 0;
     tex_res.dim                 = SQ_TEX_DIM_2D;
-    tex_res.base                = 0;
-    tex_res.mip_base            = 0;
+    tex_res.base                = accel_state->src_obj[0].offset;
+    tex_res.mip_base            = accel_state->src_obj[0].offset;
     tex_res.size                = accel_state->src_size[0];
     tex_res.bo                  = accel_state->src_obj[0].bo;
     tex_res.mip_bo              = accel_state->src_obj[0].bo;
@@ -353,7 +355,7 @@ EVERGREENDoPrepareCopy(ScrnInfoPtr pScrn)
     cb_conf.id = 0;
     cb_conf.w = accel_state->dst_obj.pitch;
     cb_conf.h = accel_state->dst_obj.height;
-    cb_conf.base = 0;
+    cb_conf.base = accel_state->dst_obj.offset;
     cb_conf.bo = accel_state->dst_obj.bo;
     cb_conf.surface = accel_state->dst_obj.surface;
     if (accel_state->dst_obj.bpp == 8) {
@@ -440,6 +442,31 @@ EVERGREENAppendCopyVertex(ScrnInfoPtr pScrn,
     radeon_vbo_commit(pScrn, &accel_state->vbo);
 }
 
+/* Copy a rectangle between two surfaces, used to tile textured video planes */
+Bool
+EVERGREENCopyRect(ScrnInfoPtr pScrn,
+	          struct r600_accel_object *src_obj,
+	          struct r600_accel_object *dst_obj,
+	          int srcX, int srcY, int dstX, int dstY, int w, int h)
+{
+    RADEONInfoPtr info = RADEONPTR(pScrn);
+    struct radeon_accel_state *accel_state = info->accel_state;
+
+    if (!R600SetAccelState(pScrn,
+			   src_obj,
+			   NULL,
+			   dst_obj,
+			   accel_state->copy_vs_offset, accel_state->copy_ps_offset,
+			   3, 0xffffffff))
+	return FALSE;
+
+    EVERGREENDoPrepareCopy(pScrn);
+    EVERGREENAppendCopyVertex(pScrn, srcX, srcY, dstX, dstY, w, h);
+    EVERGREENDoCopy(pScrn);
+
+    return TRUE;
+}
+
 static Bool
 EVERGREENPrepareCopy(PixmapPtr pSrc,   PixmapPtr pDst,
 		     int xdir, int ydir,
@@ -464,12 +491,15 @@ EVERGREENPrepareCopy(PixmapPtr pSrc,   PixmapPtr pDst,
     accel_state->same_surface = FALSE;
 
     src_obj.bo = radeon_get_pixmap_bo(pSrc);
+    src_obj.offset = radeon_get_pixmap_offset(pSrc);
     dst_obj.bo = radeon_get_pixmap_bo(pDst);
+    dst_obj.offset = radeon_get_pixmap_offset(pDst);
     dst_obj.surface = radeon_get_pixmap_surface(pDst);
     src_obj.surface = radeon_get_pixmap_surface(pSrc);
     dst_obj.tiling_flags = radeon_get_pixmap_tiling(pDst);
     src_obj.tiling_flags = radeon_get_pixmap_tiling(pSrc);
-    if (radeon_get_pixmap_bo(pSrc) == radeon_get_pixmap_bo(pDst))
+    if (radeon_get_pixmap_bo(pSrc) == radeon_get_pixmap_bo(pDst) &&
+	src_obj.offset == dst_obj.offset)
 	accel_state->same_surface = TRUE;
 
     src_obj.width = pSrc->drawable.width;
@@ -480,10 +510,7 @@ EVERGREENPrepareCopy(PixmapPtr pSrc,   PixmapPtr pDst,
     dst_obj.width = pDst->drawable.width;
     dst_obj.height = pDst->drawable.height;
     dst_obj.bpp = pDst->drawable.bitsPerPixel;
-    if (radeon_get_pixmap_shared(pDst) == TRUE)
-	dst_obj.domain = RADEON_GEM_DOMAIN_GTT;
-    else
-	dst_obj.domain = RADEON_GEM_DOMAIN_VRAM;
+    dst_obj.domain = radeon_pixmap_write_domain(pDst);
 
     if (!R600SetAccelState(pScrn,
 			   &src_obj,
@@ -586,6 +613,7 @@ EVERGREENCopy(PixmapPtr pDst,
 	uint32_t orig_src_tiling_flags = accel_state->src_obj[0].tiling_flags;
 	uint32_t orig_dst_tiling_flags = accel_state->dst_obj.tiling_flags;
 	struct radeon_bo *orig_bo = accel_state->dst_obj.bo;
+	uint32_t orig_offset = accel_state->dst_obj.offset;
 	int orig_rop = accel_state->rop;
 	struct radeon_surface *orig_dst_surface = accel_state->dst_obj.surface;
 	struct radeon_surface *orig_src_surface = accel_state->src_obj[0].surface;
@@ -593,6 +621,7 @@ EVERGREENCopy(PixmapPtr pDst,
 	/* src to tmp */
 	accel_state->dst_obj.domain = RADEON_GEM_DOMAIN_VRAM;
 	accel_state->dst_obj.bo = accel_state->copy_area_bo;
+	accel_state->dst_obj.offset = 0;
 	accel_state->dst_obj.tiling_flags = 0;
 	accel_state->rop = 3;
 	accel_state->dst_obj.surface = NULL;
@@ -603,10 +632,12 @@ EVERGREENCopy(PixmapPtr pDst,
 	/* tmp to dst */
 	accel_state->src_obj[0].domain = RADEON_GEM_DOMAIN_VRAM;
 	accel_state->src_obj[0].bo = accel_state->copy_area_bo;
+	accel_state->src_obj[0].offset = 0;
 	accel_state->src_obj[0].tiling_flags = 0;
 	accel_state->src_obj[0].surface = NULL;
 	accel_state->dst_obj.domain = orig_dst_domain;
 	accel_state->dst_obj.bo = orig_bo;
+	accel_state->dst_obj.offset = orig_offset;
 	accel_state->dst_obj.tiling_flags = orig_dst_tiling_flags;
 	accel_state->rop = orig_rop;
 	accel_state->dst_obj.surface = orig_dst_surface;
@@ -617,6 +648,7 @@ EVERGREENCopy(PixmapPtr pDst,
 	/* restore state */
 	accel_state->src_obj[0].domain = orig_src_domain;
 	accel_state->src_obj[0].bo = orig_bo;
+	accel_state->src_obj[0].offset = orig_offset;
 	accel_state->src_obj[0].tiling_flags = orig_src_tiling_flags;
 	accel_state->src_obj[0].surface = orig_src_surface;
     } else
@@ -865,8 +897,8 @@ static Bool EVERGREENTextureSetup(PicturePtr pPict, PixmapPtr pPix,
     tex_res.pitch               = accel_state->src_obj[unit].pitch;
     tex_res.depth               = 0;
     tex_res.dim                 = SQ_TEX_DIM_2D;
-    tex_res.base                = 0;
-    tex_res.mip_base            = 0;
+    tex_res.base                = accel_state->src_obj[unit].offset;
+    tex_res.mip_base            = accel_state->src_obj[unit].offset;
     tex_res.size                = accel_state->src_size[unit];
     tex_res.format              = EVERGREENTexFormats[i].card_fmt;
     tex_res.bo                  = accel_state->src_obj[unit].bo;
@@ -1263,6 +1295,30 @@ static void EVERGREENSetSolidConsts(ScrnInfoPtr pScrn, float *buf, int format, u
     buf[3] = pix_a;
 }
 
+/* The straight-line comp_vs/comp_ps for variant, or the generic ones
+ * (variant 0) if the shader cache is full
+ */
+static uint32_t EVERGREENCompositeShaders(ScrnInfoPtr pScrn, uint32_t variant,
+					  uint32_t *vs_offset, uint32_t *ps_offset)
+{
+    RADEONInfoPtr info = RADEONPTR(pScrn);
+    struct radeon_accel_state *accel_state = info->accel_state;
+    radeon_shader_gen vs = evergreen_comp_vs, ps = evergreen_comp_ps;
+
+    if (info->ChipFamily >= CHIP_FAMILY_CAYMAN) {
+	vs = cayman_comp_vs;
+	ps = cayman_comp_ps;
+    }
+
+    if (radeon_shader_get(pScrn, vs, variant & RADEON_COMP_VS_KEY, vs_offset) &&
+	radeon_shader_get(pScrn, ps, variant, ps_offset))
+	return variant;
+
+    *vs_offset = accel_state->comp_vs_offset;
+    *ps_offset = accel_state->comp_ps_offset;
+    return 0;
+}
+
 static Bool EVERGREENPrepareComposite(int op, PicturePtr pSrcPicture,
 				      PicturePtr pMaskPicture, PicturePtr pDstPicture,
 				      PixmapPtr pSrc, PixmapPtr pMask, PixmapPtr pDst)
@@ -1278,12 +1334,14 @@ static Bool EVERGREENPrepareComposite(int op, PicturePtr pSrcPicture,
     struct r600_accel_object src_obj, mask_obj, dst_obj;
     float *cbuf;
     uint32_t ps_bool_consts = 0;
+    uint32_t variant = RADEON_COMP_STATIC, vs_offset, ps_offset;
 
     if (pDst->drawable.bitsPerPixel < 8 || (pSrc && pSrc->drawable.bitsPerPixel < 8))
 	return FALSE;
 
     if (pSrc) {
 	src_obj.bo = radeon_get_pixmap_bo(pSrc);
+	src_obj.offset = radeon_get_pixmap_offset(pSrc);
 	src_obj.surface = radeon_get_pixmap_surface(pSrc);
 	src_obj.tiling_flags = radeon_get_pixmap_tiling(pSrc);
 	src_obj.pitch = exaGetPixmapPitch(pSrc) / (pSrc->drawable.bitsPerPixel / 8);
@@ -1294,20 +1352,19 @@ static Bool EVERGREENPrepareComposite(int op, PicturePtr pSrcPicture,
     }
 
     dst_obj.bo = radeon_get_pixmap_bo(pDst);
+    dst_obj.offset = radeon_get_pixmap_offset(pDst);
     dst_obj.surface = radeon_get_pixmap_surface(pDst);
     dst_obj.tiling_flags = radeon_get_pixmap_tiling(pDst);
     dst_obj.pitch = exaGetPixmapPitch(pDst) / (pDst->drawable.bitsPerPixel / 8);
     dst_obj.width = pDst->drawable.width;
     dst_obj.height = pDst->drawable.height;
     dst_obj.bpp = pDst->drawable.bitsPerPixel;
-    if (radeon_get_pixmap_shared(pDst) == TRUE)
-	dst_obj.domain = RADEON_GEM_DOMAIN_GTT;
-    else
-	dst_obj.domain = RADEON_GEM_DOMAIN_VRAM;
+    dst_obj.domain = radeon_pixmap_write_domain(pDst);
 
     if (pMaskPicture) {
 	if (pMask) {
 	    mask_obj.bo = radeon_get_pixmap_bo(pMask);
+	    mask_obj.offset = radeon_get_pixmap_offset(pMask);
 	    mask_obj.tiling_flags = radeon_get_pixmap_tiling(pMask);
 	    mask_obj.pitch = exaGetPixmapPitch(pMask) / (pMask->drawable.bitsPerPixel / 8);
 	    mask_obj.surface = radeon_get_pixmap_surface(pMask);
@@ -1334,11 +1391,19 @@ static Bool EVERGREENPrepareComposite(int op, PicturePtr pSrcPicture,
 	accel_state->src_alpha = FALSE;
     }
 
+    if (pSrc)
+	variant |= RADEON_COMP_SRC_TEX;
+    if (pMaskPicture)
+	variant |= RADEON_COMP_MASK;
+    if (pMask)
+	variant |= RADEON_COMP_MASK_TEX;
+    variant = EVERGREENCompositeShaders(pScrn, variant, &vs_offset, &ps_offset);
+
     if (!R600SetAccelState(pScrn,
 		pSrc ? &src_obj : NULL,
 		(pMaskPicture && pMask) ? &mask_obj : NULL,
 		&dst_obj,
-		accel_state->comp_vs_offset, accel_state->comp_ps_offset,
+		vs_offset, ps_offset,
 		3, 0xffffffff))
 	return FALSE;
 
@@ -1383,16 +1448,19 @@ static Bool EVERGREENPrepareComposite(int op, PicturePtr pSrcPicture,
     } else
         accel_state->is_transform[1] = FALSE;
 
-    if (pSrc)
-	ps_bool_consts |= (1 << 0);
-    if (pMask)
-	ps_bool_consts |= (1 << 1);
-    evergreen_set_bool_consts(pScrn, SQ_BOOL_CONST_ps, ps_bool_consts);
+    /* only the generic programs look at the bool consts */
+    if (!(variant & RADEON_COMP_STATIC)) {
+	if (pSrc)
+	    ps_bool_consts |= (1 << 0);
+	if (pMask)
+	    ps_bool_consts |= (1 << 1);
+	evergreen_set_bool_consts(pScrn, SQ_BOOL_CONST_ps, ps_bool_consts);
 
-    if (pMask) {
-	evergreen_set_bool_consts(pScrn, SQ_BOOL_CONST_vs, (1 << 0));
-    } else {
-	evergreen_set_bool_consts(pScrn, SQ_BOOL_CONST_vs, (0 << 0));
+	if (pMask) {
+	    evergreen_set_bool_consts(pScrn, SQ_BOOL_CONST_vs, (1 << 0));
+	} else {
+	    evergreen_set_bool_consts(pScrn, SQ_BOOL_CONST_vs, (0 << 0));
+	}
     }
 
     /* Shader */
@@ -1415,7 +1483,7 @@ static Bool EVERGREENPrepareComposite(int op, PicturePtr pSrcPicture,
     cb_conf.id = 0;
     cb_conf.w = accel_state->dst_obj.pitch;
     cb_conf.h = accel_state->dst_obj.height;
-    cb_conf.base = 0;
+    cb_conf.base = accel_state->dst_obj.offset;
     cb_conf.format = dst_format;
     cb_conf.bo = accel_state->dst_obj.bo;
     cb_conf.surface = accel_state->dst_obj.surface;
@@ -1641,6 +1709,7 @@ EVERGREENUploadToScreen(PixmapPtr pDst, int x, int y, int w, int h,
     uint32_t dst_pitch_hw = exaGetPixmapPitch(pDst) / (bpp / 8);
     int ret;
     Bool flush = TRUE;
+    Bool use_dma = FALSE;
     Bool r;
     int i;
     struct r600_accel_object src_obj, dst_obj;
@@ -1652,6 +1721,7 @@ EVERGREENUploadToScreen(PixmapPtr pDst, int x, int y, int w, int h,
     driver_priv = exaGetPixmapDriverPrivate(pDst);
     if (!driver_priv || !driver_priv->bo)
 	return FALSE;
+    radeon_pixmap_transfer(pDst, w * h * (bpp / 8), TRUE);
 
     /* If we know the BO won't be busy, don't bother with a scratch */
     copy_dst = driver_priv->bo;
@@ -1679,6 +1749,7 @@ EVERGREENUploadToScreen(PixmapPtr pDst, int x, int y, int w, int h,
     src_obj.bpp = bpp;
     src_obj.domain = RADEON_GEM_DOMAIN_GTT;
     src_obj.bo = scratch;
+    src_obj.offset = 0;
     src_obj.tiling_flags = 0;
     src_obj.surface = NULL;
 
@@ -1686,12 +1757,19 @@ EVERGREENUploadToScreen(PixmapPtr pDst, int x, int y, int w, int h,
     dst_obj.width = pDst->drawable.width;
     dst_obj.height = pDst->drawable.height;
     dst_obj.bpp = bpp;
-    dst_obj.domain = RADEON_GEM_DOMAIN_VRAM;
+    dst_obj.domain = radeon_get_pixmap_domain(pDst);
     dst_obj.bo = radeon_get_pixmap_bo(pDst);
+    dst_obj.offset = radeon_get_pixmap_offset(pDst);
     dst_obj.tiling_flags = radeon_get_pixmap_tiling(pDst);
     dst_obj.surface = radeon_get_pixmap_surface(pDst);
 
-    if (!R600SetAccelState(pScrn,
+    /* linear destinations can be filled by the DMA engine */
+    if (!(driver_priv->tiling_flags & (RADEON_TILING_MACRO | RADEON_TILING_MICRO)))
+	use_dma = evergreen_dma_wanted(pScrn, w * bpp / 8, h,
+				       accel_state->vsync);
+
+    if (!use_dma &&
+	!R600SetAccelState(pScrn,
 			   &src_obj,
 			   NULL,
 			   &dst_obj,
@@ -1716,7 +1794,7 @@ copy:
     size = w * bpp / 8;
     dst = copy_dst->ptr;
     if (copy_dst == driver_priv->bo)
-	dst += y * copy_pitch + x * bpp / 8;
+	dst += driver_priv->offset + y * copy_pitch + x * bpp / 8;
     for (i = 0; i < h; i++) {
 	memcpy(dst + i * copy_pitch, src, size);
         src += src_pitch;
@@ -1724,6 +1802,27 @@ copy:
     radeon_bo_unmap(copy_dst);
 
     if (copy_dst == scratch) {
+	if (use_dma) {
+	    if (evergreen_dma_copy(pScrn,
+				   driver_priv->bo, driver_priv->domain,
+				   driver_priv->offset + y * pDst->devKind + x * bpp / 8,
+				   pDst->devKind,
+				   scratch, RADEON_GEM_DOMAIN_GTT,
+				   0, scratch_pitch * (bpp / 8),
+				   w * bpp / 8, h))
+		goto out;
+
+	    if (!R600SetAccelState(pScrn,
+				   &src_obj,
+				   NULL,
+				   &dst_obj,
+				   accel_state->copy_vs_offset, accel_state->copy_ps_offset,
+				   3, 0xffffffff)) {
+		r = FALSE;
+		goto out;
+	    }
+	}
+
 	if (info->accel_state->vsync)
 	    RADEONVlineHelperSet(pScrn, x, y, x + w, y + h);
 
@@ -1767,6 +1866,7 @@ EVERGREENDownloadFromScreen(PixmapPtr pSrc, int x, int y, int w,
     driver_priv = exaGetPixmapDriverPrivate(pSrc);
     if (!driver_priv || !driver_priv->bo)
 	return FALSE;
+    radeon_pixmap_transfer(pSrc, w * h * (bpp / 8), FALSE);
 
     /* If we know the BO won't end up in VRAM anyway, don't bother with a scratch */
     copy_src = driver_priv->bo;
@@ -1800,6 +1900,24 @@ EVERGREENDownloadFromScreen(PixmapPtr pSrc, int x, int y, int w,
     if (scratch == NULL) {
 	goto copy;
     }
+
+    /* linear sources can be read back by the DMA engine */
+    if (!(driver_priv->tiling_flags & (RADEON_TILING_MACRO | RADEON_TILING_MICRO)) &&
+	evergreen_dma_wanted(pScrn, w * bpp / 8, h, FALSE) &&
+	evergreen_dma_copy(pScrn,
+			   scratch, RADEON_GEM_DOMAIN_GTT,
+			   0, scratch_pitch * (bpp / 8),
+			   driver_priv->bo, RADEON_GEM_DOMAIN_VRAM,
+			   driver_priv->offset + y * pSrc->devKind + x * bpp / 8,
+			   pSrc->devKind,
+			   w * bpp / 8, h)) {
+	/* mapping the scratch waits for the copy */
+	copy_src = scratch;
+	copy_pitch = scratch_pitch * (bpp / 8);
+	flush = FALSE;
+	goto copy;
+    }
+
     radeon_cs_space_reset_bos(info->cs);
     radeon_cs_space_add_persistent_bo(info->cs, info->accel_state->shaders_bo,
 				      RADEON_GEM_DOMAIN_VRAM, 0);
@@ -1818,6 +1936,7 @@ EVERGREENDownloadFromScreen(PixmapPtr pSrc, int x, int y, int w,
     src_obj.bpp = bpp;
     src_obj.domain = RADEON_GEM_DOMAIN_VRAM | RADEON_GEM_DOMAIN_GTT;
     src_obj.bo = radeon_get_pixmap_bo(pSrc);
+    src_obj.offset = radeon_get_pixmap_offset(pSrc);
     src_obj.tiling_flags = radeon_get_pixmap_tiling(pSrc);
     src_obj.surface = radeon_get_pixmap_surface(pSrc);
 
@@ -1825,6 +1944,7 @@ EVERGREENDownloadFromScreen(PixmapPtr pSrc, int x, int y, int w,
     dst_obj.width = w;
     dst_obj.height = h;
     dst_obj.bo = scratch;
+    dst_obj.offset = 0;
     dst_obj.bpp = bpp;
     dst_obj.domain = RADEON_GEM_DOMAIN_GTT;
     dst_obj.tiling_flags = 0;
@@ -1860,7 +1980,7 @@ copy:
     r = TRUE;
     w *= bpp / 8;
     if (copy_src == driver_priv->bo)
-	size = y * copy_pitch + x * bpp / 8;
+	size = driver_priv->offset + y * copy_pitch + x * bpp / 8;
     else
 	size = 0;
     while (h--) {
@@ -1892,127 +2012,43 @@ EVERGREENSync(ScreenPtr pScreen, int marker)
     return;
 }
 
-static Bool
-EVERGREENAllocShaders(ScrnInfoPtr pScrn, ScreenPtr pScreen)
-{
-    RADEONInfoPtr info = RADEONPTR(pScrn);
-    struct radeon_accel_state *accel_state = info->accel_state;
-
-    /* 512 bytes per shader for now */
-    int size = 512 * 9;
-
-    accel_state->shaders_bo = radeon_bo_open(info->bufmgr, 0, size, 0,
-					     RADEON_GEM_DOMAIN_VRAM, 0);
-    if (accel_state->shaders_bo == NULL) {
-	ErrorF("Allocating shader failed\n");
-	return FALSE;
-    }
-    return TRUE;
-}
-
 static Bool
 EVERGREENLoadShaders(ScrnInfoPtr pScrn)
 {
-    RADEONInfoPtr info = RADEONPTR(pScrn);
-    struct radeon_accel_state *accel_state = info->accel_state;
-    RADEONChipFamily ChipSet = info->ChipFamily;
-    uint32_t *shader;
-    int ret;
-
-    ret = radeon_bo_map(accel_state->shaders_bo, 1);
-    if (ret) {
-	FatalError("failed to map shader %d\n", ret);
+    struct radeon_accel_state *accel_state = RADEONPTR(pScrn)->accel_state;
+
+    if (!radeon_shader_get(pScrn, evergreen_solid_vs, 0, &accel_state->solid_vs_offset) ||
+	!radeon_shader_get(pScrn, evergreen_solid_ps, 0, &accel_state->solid_ps_offset) ||
+	!radeon_shader_get(pScrn, evergreen_copy_vs, 0, &accel_state->copy_vs_offset) ||
+	!radeon_shader_get(pScrn, evergreen_copy_ps, 0, &accel_state->copy_ps_offset) ||
+	!radeon_shader_get(pScrn, evergreen_comp_vs, 0, &accel_state->comp_vs_offset) ||
+	!radeon_shader_get(pScrn, evergreen_comp_ps, 0, &accel_state->comp_ps_offset) ||
+	!radeon_shader_get(pScrn, evergreen_xv_vs, 0, &accel_state->xv_vs_offset) ||
+	!radeon_shader_get(pScrn, evergreen_xv_ps, 0, &accel_state->xv_ps_offset) ||
+	!radeon_shader_get(pScrn, evergreen_xv_bicubic_ps, 0, &accel_state->xv_bicubic_ps_offset)) {
+	ErrorF("Generating shaders failed\n");
 	return FALSE;
     }
-    shader = accel_state->shaders_bo->ptr;
-
-    /*  solid vs --------------------------------------- */
-    accel_state->solid_vs_offset = 0;
-    evergreen_solid_vs(ChipSet, shader + accel_state->solid_vs_offset / 4);
-
-    /*  solid ps --------------------------------------- */
-    accel_state->solid_ps_offset = 512;
-    evergreen_solid_ps(ChipSet, shader + accel_state->solid_ps_offset / 4);
-
-    /*  copy vs --------------------------------------- */
-    accel_state->copy_vs_offset = 1024;
-    evergreen_copy_vs(ChipSet, shader + accel_state->copy_vs_offset / 4);
-
-    /*  copy ps --------------------------------------- */
-    accel_state->copy_ps_offset = 1536;
-    evergreen_copy_ps(ChipSet, shader + accel_state->copy_ps_offset / 4);
-
-    /*  comp vs --------------------------------------- */
-    accel_state->comp_vs_offset = 2048;
-    evergreen_comp_vs(ChipSet, shader + accel_state->comp_vs_offset / 4);
-
-    /*  comp ps --------------------------------------- */
-    accel_state->comp_ps_offset = 2560;
-    evergreen_comp_ps(ChipSet, shader + accel_state->comp_ps_offset / 4);
-
-    /*  xv vs --------------------------------------- */
-    accel_state->xv_vs_offset = 3072;
-    evergreen_xv_vs(ChipSet, shader + accel_state->xv_vs_offset / 4);
-
-    /*  xv ps --------------------------------------- */
-    accel_state->xv_ps_offset = 3584;
-    evergreen_xv_ps(ChipSet, shader + accel_state->xv_ps_offset / 4);
-
-    radeon_bo_unmap(accel_state->shaders_bo);
-
     return TRUE;
 }
 
 static Bool
 CAYMANLoadShaders(ScrnInfoPtr pScrn)
 {
-    RADEONInfoPtr info = RADEONPTR(pScrn);
-    struct radeon_accel_state *accel_state = info->accel_state;
-    RADEONChipFamily ChipSet = info->ChipFamily;
-    uint32_t *shader;
-    int ret;
-
-    ret = radeon_bo_map(accel_state->shaders_bo, 1);
-    if (ret) {
-	FatalError("failed to map shader %d\n", ret);
+    struct radeon_accel_state *accel_state = RADEONPTR(pScrn)->accel_state;
+
+    if (!radeon_shader_get(pScrn, cayman_solid_vs, 0, &accel_state->solid_vs_offset) ||
+	!radeon_shader_get(pScrn, cayman_solid_ps, 0, &accel_state->solid_ps_offset) ||
+	!radeon_shader_get(pScrn, cayman_copy_vs, 0, &accel_state->copy_vs_offset) ||
+	!radeon_shader_get(pScrn, cayman_copy_ps, 0, &accel_state->copy_ps_offset) ||
+	!radeon_shader_get(pScrn, cayman_comp_vs, 0, &accel_state->comp_vs_offset) ||
+	!radeon_shader_get(pScrn, cayman_comp_ps, 0, &accel_state->comp_ps_offset) ||
+	!radeon_shader_get(pScrn, cayman_xv_vs, 0, &accel_state->xv_vs_offset) ||
+	!radeon_shader_get(pScrn, cayman_xv_ps, 0, &accel_state->xv_ps_offset) ||
+	!radeon_shader_get(pScrn, cayman_xv_bicubic_ps, 0, &accel_state->xv_bicubic_ps_offset)) {
+	ErrorF("Generating shaders failed\n");
 	return FALSE;
     }
-    shader = accel_state->shaders_bo->ptr;
-
-    /*  solid vs --------------------------------------- */
-    accel_state->solid_vs_offset = 0;
-    cayman_solid_vs(ChipSet, shader + accel_state->solid_vs_offset / 4);
-
-    /*  solid ps --------------------------------------- */
-    accel_state->solid_ps_offset = 512;
-    cayman_solid_ps(ChipSet, shader + accel_state->solid_ps_offset / 4);
-
-    /*  copy vs --------------------------------------- */
-    accel_state->copy_vs_offset = 1024;
-    cayman_copy_vs(ChipSet, shader + accel_state->copy_vs_offset / 4);
-
-    /*  copy ps --------------------------------------- */
-    accel_state->copy_ps_offset = 1536;
-    cayman_copy_ps(ChipSet, shader + accel_state->copy_ps_offset / 4);
-
-    /*  comp vs --------------------------------------- */
-    accel_state->comp_vs_offset = 2048;
-    cayman_comp_vs(ChipSet, shader + accel_state->comp_vs_offset / 4);
-
-    /*  comp ps --------------------------------------- */
-    accel_state->comp_ps_offset = 2560;
-    cayman_comp_ps(ChipSet, shader + accel_state->comp_ps_offset / 4);
-
-    /*  xv vs --------------------------------------- */
-    accel_state->xv_vs_offset = 3072;
-    cayman_xv_vs(ChipSet, shader + accel_state->xv_vs_offset / 4);
-
-    /*  xv ps --------------------------------------- */
-    accel_state->xv_ps_offset = 3584;
-    cayman_xv_ps(ChipSet, shader + accel_state->xv_ps_offset / 4);
-
-    radeon_bo_unmap(accel_state->shaders_bo);
-
     return TRUE;
 }
 
@@ -2094,7 +2130,7 @@ EVERGREENDrawInit(ScreenPtr pScreen)
 
     radeon_vbo_init_lists(pScrn);
 
-    if (!EVERGREENAllocShaders(pScrn, pScreen))
+    if (!radeon_shader_cache_init(pScrn))
 	return FALSE;
 
     if (info->ChipFamily >= CHIP_FAMILY_CAYMAN) {
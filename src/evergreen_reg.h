@@ -112,6 +112,14 @@ enum {
 /* IT_INDEX_TYPE */
 #define IT_INDEX_TYPE_SWAP_MODE(x) ((x) << 2)
 
+/* Async DMA engine packets */
+#define DMA_PACKET(cmd, sub_cmd, n) ((((cmd) & 0xF) << 28) |		\
+				     (((sub_cmd) & 0xFF) << 20) |	\
+				     (((n) & 0xFFFFF) << 0))
+#define DMA_PACKET_COPY         0x3
+#define DMA_PACKET_NOP          0xf
+#define DMA_COPY_MAX_DW         0xFFFFF
+
 enum {
 
     SQ_LDS_ALLOC_PS                                       = 0x288ec,
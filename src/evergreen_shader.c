@@ -34,14 +34,14 @@
 #include "evergreen_reg.h"
 
 /* solid vs --------------------------------------- */
-int evergreen_solid_vs(RADEONChipFamily ChipSet, uint32_t* shader)
+int evergreen_solid_vs(RADEONChipFamily ChipSet, uint32_t *shader, uint32_t variant, int max)
 {
     int i = 0;
 
     /* 0 */
-    shader[i++] = CF_DWORD0(ADDR(4),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(4),
 			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
 			    CF_CONST(0),
 			    COND(SQ_CF_COND_ACTIVE),
 			    I_COUNT(1),
@@ -51,13 +51,13 @@ int evergreen_solid_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 			    WHOLE_QUAD_MODE(0),
 			    BARRIER(1));
     /* 1 */
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(CF_POS0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(CF_POS0),
 					  TYPE(SQ_EXPORT_POS),
 					  RW_GPR(1),
 					  RW_REL(ABSOLUTE),
 					  INDEX_GPR(0),
 					  ELEM_SIZE(0));
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
 					       SRC_SEL_Y(SQ_SEL_Y),
 					       SRC_SEL_Z(SQ_SEL_Z),
 					       SRC_SEL_W(SQ_SEL_W),
@@ -68,13 +68,13 @@ int evergreen_solid_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 					       MARK(0),
 					       BARRIER(1));
     /* 2 - always export a param whether it's used or not */
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(0),
 					  TYPE(SQ_EXPORT_PARAM),
 					  RW_GPR(0),
 					  RW_REL(ABSOLUTE),
 					  INDEX_GPR(0),
 					  ELEM_SIZE(0));
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
 					       SRC_SEL_Y(SQ_SEL_Y),
 					       SRC_SEL_Z(SQ_SEL_Z),
 					       SRC_SEL_W(SQ_SEL_W),
@@ -85,10 +85,10 @@ int evergreen_solid_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 					       MARK(0),
 					       BARRIER(0));
     /* 3 - padding */
-    shader[i++] = 0x00000000;
-    shader[i++] = 0x00000000;
+    shader[RADEON_SHADER_DW(i, max)] = 0x00000000;
+    shader[RADEON_SHADER_DW(i, max)] = 0x00000000;
     /* 4/5 */
-    shader[i++] = VTX_DWORD0(VTX_INST(SQ_VTX_INST_FETCH),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD0(VTX_INST(SQ_VTX_INST_FETCH),
 			     FETCH_TYPE(SQ_VTX_FETCH_VERTEX_DATA),
 			     FETCH_WHOLE_QUAD(0),
 			     BUFFER_ID(0),
@@ -96,7 +96,7 @@ int evergreen_solid_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 			     SRC_REL(ABSOLUTE),
 			     SRC_SEL_X(SQ_SEL_X),
 			     MEGA_FETCH_COUNT(8));
-    shader[i++] = VTX_DWORD1_GPR(DST_GPR(1),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD1_GPR(DST_GPR(1),
 				 DST_REL(0),
 				 DST_SEL_X(SQ_SEL_X),
 				 DST_SEL_Y(SQ_SEL_Y),
@@ -107,7 +107,7 @@ int evergreen_solid_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 				 NUM_FORMAT_ALL(SQ_NUM_FORMAT_SCALED),
 				 FORMAT_COMP_ALL(SQ_FORMAT_COMP_SIGNED),
 				 SRF_MODE_ALL(SRF_MODE_ZERO_CLAMP_MINUS_ONE));
-    shader[i++] = VTX_DWORD2(OFFSET(0),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD2(OFFSET(0),
 #if X_BYTE_ORDER == X_BIG_ENDIAN
 			     ENDIAN_SWAP(SQ_ENDIAN_8IN32),
 #else
@@ -117,22 +117,22 @@ int evergreen_solid_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 			     MEGA_FETCH(1),
 			     ALT_CONST(0),
 			     BUFFER_INDEX_MODE(SQ_CF_INDEX_NONE));
-    shader[i++] = VTX_DWORD_PAD;
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD_PAD;
 
     return i;
 }
 
 /* solid ps --------------------------------------- */
-int evergreen_solid_ps(RADEONChipFamily ChipSet, uint32_t* shader)
+int evergreen_solid_ps(RADEONChipFamily ChipSet, uint32_t *shader, uint32_t variant, int max)
 {
     int i = 0;
 
     /* 0 */
-    shader[i++] = CF_ALU_DWORD0(ADDR(2),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD0(ADDR(2),
 				KCACHE_BANK0(0),
 				KCACHE_BANK1(0),
 				KCACHE_MODE0(SQ_CF_KCACHE_LOCK_1));
-    shader[i++] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
 				KCACHE_ADDR0(0),
 				KCACHE_ADDR1(0),
 				I_COUNT(4),
@@ -141,13 +141,13 @@ int evergreen_solid_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 				WHOLE_QUAD_MODE(0),
 				BARRIER(1));
     /* 1 */
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(CF_PIXEL_MRT0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(CF_PIXEL_MRT0),
 					  TYPE(SQ_EXPORT_PIXEL),
 					  RW_GPR(0),
 					  RW_REL(ABSOLUTE),
 					  INDEX_GPR(0),
 					  ELEM_SIZE(1));
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
 					       SRC_SEL_Y(SQ_SEL_Y),
 					       SRC_SEL_Z(SQ_SEL_Z),
 					       SRC_SEL_W(SQ_SEL_W),
@@ -159,7 +159,7 @@ int evergreen_solid_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 					       BARRIER(1));
 
     /* 2 */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 0),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_X),
 			     SRC0_NEG(0),
@@ -170,7 +170,7 @@ int evergreen_solid_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     INDEX_MODE(SQ_INDEX_AR_X),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
 				 UPDATE_PRED(0),
@@ -183,7 +183,7 @@ int evergreen_solid_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 				 DST_ELEM(ELEM_X),
 				 CLAMP(1));
     /* 3 */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 0),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_Y),
 			     SRC0_NEG(0),
@@ -194,7 +194,7 @@ int evergreen_solid_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     INDEX_MODE(SQ_INDEX_AR_X),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
 				 UPDATE_PRED(0),
@@ -207,7 +207,7 @@ int evergreen_solid_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 				 DST_ELEM(ELEM_Y),
 				 CLAMP(1));
     /* 4 */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 0),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_Z),
 			     SRC0_NEG(0),
@@ -218,7 +218,7 @@ int evergreen_solid_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     INDEX_MODE(SQ_INDEX_AR_X),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
 				 UPDATE_PRED(0),
@@ -231,7 +231,7 @@ int evergreen_solid_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 				 DST_ELEM(ELEM_Z),
 				 CLAMP(1));
     /* 5 */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 0),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_W),
 			     SRC0_NEG(0),
@@ -242,7 +242,7 @@ int evergreen_solid_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     INDEX_MODE(SQ_INDEX_AR_X),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(1));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
 				 UPDATE_PRED(0),
@@ -259,14 +259,14 @@ int evergreen_solid_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 }
 
 /* copy vs --------------------------------------- */
-int evergreen_copy_vs(RADEONChipFamily ChipSet, uint32_t* shader)
+int evergreen_copy_vs(RADEONChipFamily ChipSet, uint32_t *shader, uint32_t variant, int max)
 {
     int i = 0;
 
     /* 0 */
-    shader[i++] = CF_DWORD0(ADDR(4),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(4),
 			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
 			    CF_CONST(0),
 			    COND(SQ_CF_COND_ACTIVE),
 			    I_COUNT(2),
@@ -276,13 +276,13 @@ int evergreen_copy_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 			    WHOLE_QUAD_MODE(0),
 			    BARRIER(1));
     /* 1 */
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(CF_POS0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(CF_POS0),
 					  TYPE(SQ_EXPORT_POS),
 					  RW_GPR(1),
 					  RW_REL(ABSOLUTE),
 					  INDEX_GPR(0),
 					  ELEM_SIZE(0));
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
 					       SRC_SEL_Y(SQ_SEL_Y),
 					       SRC_SEL_Z(SQ_SEL_Z),
 					       SRC_SEL_W(SQ_SEL_W),
@@ -293,13 +293,13 @@ int evergreen_copy_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 					       MARK(0),
 					       BARRIER(1));
     /* 2 */
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(0),
 					  TYPE(SQ_EXPORT_PARAM),
 					  RW_GPR(0),
 					  RW_REL(ABSOLUTE),
 					  INDEX_GPR(0),
 					  ELEM_SIZE(0));
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
 					       SRC_SEL_Y(SQ_SEL_Y),
 					       SRC_SEL_Z(SQ_SEL_Z),
 					       SRC_SEL_W(SQ_SEL_W),
@@ -310,10 +310,10 @@ int evergreen_copy_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 					       MARK(0),
 					       BARRIER(0));
     /* 3 */
-    shader[i++] = 0x00000000;
-    shader[i++] = 0x00000000;
+    shader[RADEON_SHADER_DW(i, max)] = 0x00000000;
+    shader[RADEON_SHADER_DW(i, max)] = 0x00000000;
     /* 4/5 */
-    shader[i++] = VTX_DWORD0(VTX_INST(SQ_VTX_INST_FETCH),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD0(VTX_INST(SQ_VTX_INST_FETCH),
 			     FETCH_TYPE(SQ_VTX_FETCH_VERTEX_DATA),
 			     FETCH_WHOLE_QUAD(0),
 			     BUFFER_ID(0),
@@ -321,7 +321,7 @@ int evergreen_copy_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 			     SRC_REL(ABSOLUTE),
 			     SRC_SEL_X(SQ_SEL_X),
 			     MEGA_FETCH_COUNT(16));
-    shader[i++] = VTX_DWORD1_GPR(DST_GPR(1),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD1_GPR(DST_GPR(1),
 				 DST_REL(0),
 				 DST_SEL_X(SQ_SEL_X),
 				 DST_SEL_Y(SQ_SEL_Y),
@@ -332,7 +332,7 @@ int evergreen_copy_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 				 NUM_FORMAT_ALL(SQ_NUM_FORMAT_SCALED),
 				 FORMAT_COMP_ALL(SQ_FORMAT_COMP_SIGNED),
 				 SRF_MODE_ALL(SRF_MODE_ZERO_CLAMP_MINUS_ONE));
-    shader[i++] = VTX_DWORD2(OFFSET(0),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD2(OFFSET(0),
 #if X_BYTE_ORDER == X_BIG_ENDIAN
                              ENDIAN_SWAP(SQ_ENDIAN_8IN32),
 #else
@@ -342,9 +342,9 @@ int evergreen_copy_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 			     MEGA_FETCH(1),
 			     ALT_CONST(0),
 			     BUFFER_INDEX_MODE(SQ_CF_INDEX_NONE));
-    shader[i++] = VTX_DWORD_PAD;
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD_PAD;
     /* 6/7 */
-    shader[i++] = VTX_DWORD0(VTX_INST(SQ_VTX_INST_FETCH),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD0(VTX_INST(SQ_VTX_INST_FETCH),
 			     FETCH_TYPE(SQ_VTX_FETCH_VERTEX_DATA),
 			     FETCH_WHOLE_QUAD(0),
 			     BUFFER_ID(0),
@@ -352,7 +352,7 @@ int evergreen_copy_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 			     SRC_REL(ABSOLUTE),
 			     SRC_SEL_X(SQ_SEL_X),
 			     MEGA_FETCH_COUNT(8));
-    shader[i++] = VTX_DWORD1_GPR(DST_GPR(0),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD1_GPR(DST_GPR(0),
 				 DST_REL(0),
 				 DST_SEL_X(SQ_SEL_X),
 				 DST_SEL_Y(SQ_SEL_Y),
@@ -363,7 +363,7 @@ int evergreen_copy_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 				 NUM_FORMAT_ALL(SQ_NUM_FORMAT_SCALED),
 				 FORMAT_COMP_ALL(SQ_FORMAT_COMP_SIGNED),
 				 SRF_MODE_ALL(SRF_MODE_ZERO_CLAMP_MINUS_ONE));
-    shader[i++] = VTX_DWORD2(OFFSET(8),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD2(OFFSET(8),
 #if X_BYTE_ORDER == X_BIG_ENDIAN
                              ENDIAN_SWAP(SQ_ENDIAN_8IN32),
 #else
@@ -373,22 +373,22 @@ int evergreen_copy_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 			     MEGA_FETCH(0),
 			     ALT_CONST(0),
 			     BUFFER_INDEX_MODE(SQ_CF_INDEX_NONE));
-    shader[i++] = VTX_DWORD_PAD;
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD_PAD;
 
     return i;
 }
 
 /* copy ps --------------------------------------- */
-int evergreen_copy_ps(RADEONChipFamily ChipSet, uint32_t* shader)
+int evergreen_copy_ps(RADEONChipFamily ChipSet, uint32_t *shader, uint32_t variant, int max)
 {
     int i = 0;
 
     /* CF INST 0 */
-    shader[i++] = CF_ALU_DWORD0(ADDR(3),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD0(ADDR(3),
 				KCACHE_BANK0(0),
 				KCACHE_BANK1(0),
 				KCACHE_MODE0(SQ_CF_KCACHE_NOP));
-    shader[i++] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
 				KCACHE_ADDR0(0),
 				KCACHE_ADDR1(0),
 				I_COUNT(4),
@@ -397,9 +397,9 @@ int evergreen_copy_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 				WHOLE_QUAD_MODE(0),
 				BARRIER(1));
     /* CF INST 1 */
-    shader[i++] = CF_DWORD0(ADDR(8),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(8),
 			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
 			    CF_CONST(0),
 			    COND(SQ_CF_COND_ACTIVE),
 			    I_COUNT(1),
@@ -409,13 +409,13 @@ int evergreen_copy_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			    WHOLE_QUAD_MODE(0),
 			    BARRIER(1));
     /* CF INST 2 */
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(CF_PIXEL_MRT0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(CF_PIXEL_MRT0),
 					  TYPE(SQ_EXPORT_PIXEL),
 					  RW_GPR(0),
 					  RW_REL(ABSOLUTE),
 					  INDEX_GPR(0),
 					  ELEM_SIZE(1));
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
 					       SRC_SEL_Y(SQ_SEL_Y),
 					       SRC_SEL_Z(SQ_SEL_Z),
 					       SRC_SEL_W(SQ_SEL_W),
@@ -427,7 +427,7 @@ int evergreen_copy_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 					       BARRIER(1));
 
     /* 3 interpolate tex coords */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_Y),
 			     SRC0_NEG(0),
@@ -438,7 +438,7 @@ int evergreen_copy_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     INDEX_MODE(SQ_INDEX_AR_X),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
 				 UPDATE_PRED(0),
@@ -451,7 +451,7 @@ int evergreen_copy_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 				 DST_ELEM(ELEM_X),
 				 CLAMP(0));
     /* 4 */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_X),
 			     SRC0_NEG(0),
@@ -462,7 +462,7 @@ int evergreen_copy_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     INDEX_MODE(SQ_INDEX_AR_X),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
 				 UPDATE_PRED(0),
@@ -475,7 +475,7 @@ int evergreen_copy_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 				 DST_ELEM(ELEM_Y),
 				 CLAMP(0));
     /* 5 */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_Y),
 			     SRC0_NEG(0),
@@ -486,7 +486,7 @@ int evergreen_copy_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     INDEX_MODE(SQ_INDEX_AR_X),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
 				 UPDATE_PRED(0),
@@ -499,7 +499,7 @@ int evergreen_copy_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 				 DST_ELEM(ELEM_Z),
 				 CLAMP(0));
     /* 6 */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_X),
 			     SRC0_NEG(0),
@@ -510,7 +510,7 @@ int evergreen_copy_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     INDEX_MODE(SQ_INDEX_AR_X),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(1));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
 				 UPDATE_PRED(0),
@@ -524,11 +524,11 @@ int evergreen_copy_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 				 CLAMP(0));
 
     /* 7 */
-    shader[i++] = 0x00000000;
-    shader[i++] = 0x00000000;
+    shader[RADEON_SHADER_DW(i, max)] = 0x00000000;
+    shader[RADEON_SHADER_DW(i, max)] = 0x00000000;
 
     /* 8/9 TEX INST 0 */
-    shader[i++] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
 			     INST_MOD(0),
 			     FETCH_WHOLE_QUAD(0),
 			     RESOURCE_ID(0),
@@ -537,7 +537,7 @@ int evergreen_copy_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     ALT_CONST(0),
 			     RESOURCE_INDEX_MODE(SQ_CF_INDEX_NONE),
 			     SAMPLER_INDEX_MODE(SQ_CF_INDEX_NONE));
-    shader[i++] = TEX_DWORD1(DST_GPR(0),
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD1(DST_GPR(0),
 			     DST_REL(ABSOLUTE),
 			     DST_SEL_X(SQ_SEL_X), /* R */
 			     DST_SEL_Y(SQ_SEL_Y), /* G */
@@ -548,7 +548,7 @@ int evergreen_copy_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     COORD_TYPE_Y(TEX_UNNORMALIZED),
 			     COORD_TYPE_Z(TEX_UNNORMALIZED),
 			     COORD_TYPE_W(TEX_UNNORMALIZED));
-    shader[i++] = TEX_DWORD2(OFFSET_X(0),
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD2(OFFSET_X(0),
 			     OFFSET_Y(0),
 			     OFFSET_Z(0),
 			     SAMPLER_ID(0),
@@ -556,19 +556,19 @@ int evergreen_copy_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     SRC_SEL_Y(SQ_SEL_Y),
 			     SRC_SEL_Z(SQ_SEL_0),
 			     SRC_SEL_W(SQ_SEL_1));
-    shader[i++] = TEX_DWORD_PAD;
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD_PAD;
 
     return i;
 }
 
-int evergreen_xv_vs(RADEONChipFamily ChipSet, uint32_t* shader)
+int evergreen_xv_vs(RADEONChipFamily ChipSet, uint32_t *shader, uint32_t variant, int max)
 {
     int i = 0;
 
     /* 0 */
-    shader[i++] = CF_DWORD0(ADDR(6),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(6),
 			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
                             CF_CONST(0),
                             COND(SQ_CF_COND_ACTIVE),
                             I_COUNT(2),
@@ -579,11 +579,11 @@ int evergreen_xv_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                             BARRIER(1));
 
     /* 1 - ALU */
-    shader[i++] = CF_ALU_DWORD0(ADDR(4),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD0(ADDR(4),
 				KCACHE_BANK0(0),
 				KCACHE_BANK1(0),
 				KCACHE_MODE0(SQ_CF_KCACHE_LOCK_1));
-    shader[i++] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
 				KCACHE_ADDR0(0),
 				KCACHE_ADDR1(0),
 				I_COUNT(2),
@@ -593,13 +593,13 @@ int evergreen_xv_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 				BARRIER(1));
 
     /* 2 */
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(CF_POS0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(CF_POS0),
                                           TYPE(SQ_EXPORT_POS),
                                           RW_GPR(1),
                                           RW_REL(ABSOLUTE),
                                           INDEX_GPR(0),
                                           ELEM_SIZE(3));
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
                                                SRC_SEL_Y(SQ_SEL_Y),
                                                SRC_SEL_Z(SQ_SEL_Z),
                                                SRC_SEL_W(SQ_SEL_W),
@@ -610,13 +610,13 @@ int evergreen_xv_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                                MARK(0),
                                                BARRIER(1));
     /* 3 */
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(0),
                                           TYPE(SQ_EXPORT_PARAM),
                                           RW_GPR(0),
                                           RW_REL(ABSOLUTE),
                                           INDEX_GPR(0),
                                           ELEM_SIZE(3));
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
                                                SRC_SEL_Y(SQ_SEL_Y),
                                                SRC_SEL_Z(SQ_SEL_Z),
                                                SRC_SEL_W(SQ_SEL_W),
@@ -629,7 +629,7 @@ int evergreen_xv_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 
 
     /* 4 texX / w */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_X),
                              SRC0_NEG(0),
@@ -640,7 +640,7 @@ int evergreen_xv_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_AR_X),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
                                  UPDATE_PRED(0),
@@ -654,7 +654,7 @@ int evergreen_xv_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 5 texY / h */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_Y),
                              SRC0_NEG(0),
@@ -665,7 +665,7 @@ int evergreen_xv_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_AR_X),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(1));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
                                  UPDATE_PRED(0),
@@ -679,7 +679,7 @@ int evergreen_xv_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 6/7 */
-    shader[i++] = VTX_DWORD0(VTX_INST(SQ_VTX_INST_FETCH),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD0(VTX_INST(SQ_VTX_INST_FETCH),
                              FETCH_TYPE(SQ_VTX_FETCH_VERTEX_DATA),
                              FETCH_WHOLE_QUAD(0),
                              BUFFER_ID(0),
@@ -687,7 +687,7 @@ int evergreen_xv_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              SRC_REL(ABSOLUTE),
                              SRC_SEL_X(SQ_SEL_X),
                              MEGA_FETCH_COUNT(16));
-    shader[i++] = VTX_DWORD1_GPR(DST_GPR(1),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD1_GPR(DST_GPR(1),
                                  DST_REL(ABSOLUTE),
                                  DST_SEL_X(SQ_SEL_X),
                                  DST_SEL_Y(SQ_SEL_Y),
@@ -698,7 +698,7 @@ int evergreen_xv_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  NUM_FORMAT_ALL(SQ_NUM_FORMAT_SCALED),
                                  FORMAT_COMP_ALL(SQ_FORMAT_COMP_SIGNED),
                                  SRF_MODE_ALL(SRF_MODE_ZERO_CLAMP_MINUS_ONE));
-    shader[i++] = VTX_DWORD2(OFFSET(0),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD2(OFFSET(0),
 #if X_BYTE_ORDER == X_BIG_ENDIAN
                              ENDIAN_SWAP(SQ_ENDIAN_8IN32),
 #else
@@ -708,9 +708,9 @@ int evergreen_xv_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              MEGA_FETCH(1),
 			     ALT_CONST(0),
 			     BUFFER_INDEX_MODE(SQ_CF_INDEX_NONE));
-    shader[i++] = VTX_DWORD_PAD;
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD_PAD;
     /* 8/9 */
-    shader[i++] = VTX_DWORD0(VTX_INST(SQ_VTX_INST_FETCH),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD0(VTX_INST(SQ_VTX_INST_FETCH),
                              FETCH_TYPE(SQ_VTX_FETCH_VERTEX_DATA),
                              FETCH_WHOLE_QUAD(0),
                              BUFFER_ID(0),
@@ -718,7 +718,7 @@ int evergreen_xv_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              SRC_REL(ABSOLUTE),
                              SRC_SEL_X(SQ_SEL_X),
                              MEGA_FETCH_COUNT(8));
-    shader[i++] = VTX_DWORD1_GPR(DST_GPR(0),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD1_GPR(DST_GPR(0),
                                  DST_REL(ABSOLUTE),
                                  DST_SEL_X(SQ_SEL_X),
                                  DST_SEL_Y(SQ_SEL_Y),
@@ -729,7 +729,7 @@ int evergreen_xv_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  NUM_FORMAT_ALL(SQ_NUM_FORMAT_SCALED),
                                  FORMAT_COMP_ALL(SQ_FORMAT_COMP_SIGNED),
                                  SRF_MODE_ALL(SRF_MODE_ZERO_CLAMP_MINUS_ONE));
-    shader[i++] = VTX_DWORD2(OFFSET(8),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD2(OFFSET(8),
 #if X_BYTE_ORDER == X_BIG_ENDIAN
                              ENDIAN_SWAP(SQ_ENDIAN_8IN32),
 #else
@@ -739,21 +739,21 @@ int evergreen_xv_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              MEGA_FETCH(0),
 			     ALT_CONST(0),
 			     BUFFER_INDEX_MODE(SQ_CF_INDEX_NONE));
-    shader[i++] = VTX_DWORD_PAD;
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD_PAD;
 
     return i;
 }
 
-int evergreen_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader)
+int evergreen_xv_ps(RADEONChipFamily ChipSet, uint32_t *shader, uint32_t variant, int max)
 {
     int i = 0;
 
     /* 0 */
-    shader[i++] = CF_ALU_DWORD0(ADDR(5),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD0(ADDR(7),
 				KCACHE_BANK0(0),
 				KCACHE_BANK1(0),
 				KCACHE_MODE0(SQ_CF_KCACHE_NOP));
-    shader[i++] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
 				KCACHE_ADDR0(0),
 				KCACHE_ADDR1(0),
 				I_COUNT(4),
@@ -762,9 +762,9 @@ int evergreen_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 				WHOLE_QUAD_MODE(0),
 				BARRIER(1));
     /* 1 */
-    shader[i++] = CF_DWORD0(ADDR(21),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(23),
 			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
                             CF_CONST(0),
                             COND(SQ_CF_COND_BOOL),
                             I_COUNT(0),
@@ -774,9 +774,9 @@ int evergreen_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader)
                             WHOLE_QUAD_MODE(0),
                             BARRIER(0));
     /* 2 */
-    shader[i++] = CF_DWORD0(ADDR(30),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(32),
 			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
                             CF_CONST(0),
                             COND(SQ_CF_COND_NOT_BOOL),
                             I_COUNT(0),
@@ -786,11 +786,11 @@ int evergreen_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader)
                             WHOLE_QUAD_MODE(0),
                             BARRIER(0));
     /* 3 */
-    shader[i++] = CF_ALU_DWORD0(ADDR(9),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD0(ADDR(11),
                                 KCACHE_BANK0(0),
                                 KCACHE_BANK1(0),
                                 KCACHE_MODE0(SQ_CF_KCACHE_LOCK_1));
-    shader[i++] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
                                 KCACHE_ADDR0(0),
                                 KCACHE_ADDR1(0),
                                 I_COUNT(12),
@@ -798,14 +798,38 @@ int evergreen_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader)
                                 CF_INST(SQ_CF_INST_ALU),
                                 WHOLE_QUAD_MODE(0),
                                 BARRIER(1));
-    /* 4 */
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(CF_PIXEL_MRT0),
+    /* 4 - gamma correction, bool 1 */
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(36),
+                            JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
+                            CF_CONST(1),
+                            COND(SQ_CF_COND_BOOL),
+                            I_COUNT(0),
+                            VALID_PIXEL_MODE(0),
+                            END_OF_PROGRAM(0),
+                            CF_INST(SQ_CF_INST_CALL),
+                            WHOLE_QUAD_MODE(0),
+                            BARRIER(0));
+    /* 5 */
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(0),
+                            JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
+                            CF_CONST(0),
+                            COND(SQ_CF_COND_ACTIVE),
+                            I_COUNT(0),
+                            VALID_PIXEL_MODE(0),
+                            END_OF_PROGRAM(0),
+                            CF_INST(SQ_CF_INST_NOP),
+                            WHOLE_QUAD_MODE(0),
+                            BARRIER(1));
+    /* 6 */
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(CF_PIXEL_MRT0),
                                           TYPE(SQ_EXPORT_PIXEL),
                                           RW_GPR(2),
                                           RW_REL(ABSOLUTE),
                                           INDEX_GPR(0),
                                           ELEM_SIZE(3));
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
                                                SRC_SEL_Y(SQ_SEL_Y),
                                                SRC_SEL_Z(SQ_SEL_Z),
                                                SRC_SEL_W(SQ_SEL_W),
@@ -815,8 +839,8 @@ int evergreen_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader)
                                                CF_INST(SQ_CF_INST_EXPORT_DONE),
                                                MARK(0),
                                                BARRIER(1));
-    /* 5 interpolate tex coords */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    /* 7 interpolate tex coords */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_Y),
 			     SRC0_NEG(0),
@@ -827,7 +851,7 @@ int evergreen_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     INDEX_MODE(SQ_INDEX_AR_X),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
 				 UPDATE_PRED(0),
@@ -839,8 +863,8 @@ int evergreen_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 				 DST_REL(ABSOLUTE),
 				 DST_ELEM(ELEM_X),
 				 CLAMP(0));
-    /* 6 */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    /* 8 */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_X),
 			     SRC0_NEG(0),
@@ -851,7 +875,7 @@ int evergreen_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     INDEX_MODE(SQ_INDEX_AR_X),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
 				 UPDATE_PRED(0),
@@ -863,8 +887,8 @@ int evergreen_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 				 DST_REL(ABSOLUTE),
 				 DST_ELEM(ELEM_Y),
 				 CLAMP(0));
-    /* 7 */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    /* 9 */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_Y),
 			     SRC0_NEG(0),
@@ -875,7 +899,7 @@ int evergreen_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     INDEX_MODE(SQ_INDEX_AR_X),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
 				 UPDATE_PRED(0),
@@ -887,8 +911,8 @@ int evergreen_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 				 DST_REL(ABSOLUTE),
 				 DST_ELEM(ELEM_Z),
 				 CLAMP(0));
-    /* 8 */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    /* 10 */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_X),
 			     SRC0_NEG(0),
@@ -899,7 +923,7 @@ int evergreen_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     INDEX_MODE(SQ_INDEX_AR_X),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(1));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
 				 UPDATE_PRED(0),
@@ -912,9 +936,9 @@ int evergreen_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 				 DST_ELEM(ELEM_W),
 				 CLAMP(0));
 
-    /* 9,10,11,12 */
+    /* 11,12,13,14 */
     /* r2.x = MAD(c0.w, r1.x, c0.x) */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 0),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_W),
                              SRC0_NEG(0),
@@ -925,7 +949,7 @@ int evergreen_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP3(SRC2_SEL(ALU_SRC_KCACHE0_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(ALU_SRC_KCACHE0_BASE + 0),
                                  SRC2_REL(ABSOLUTE),
                                  SRC2_ELEM(ELEM_X),
                                  SRC2_NEG(0),
@@ -936,7 +960,7 @@ int evergreen_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader)
                                  DST_ELEM(ELEM_X),
                                  CLAMP(0));
     /* r2.y = MAD(c0.w, r1.x, c0.y) */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 0),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_W),
                              SRC0_NEG(0),
@@ -947,7 +971,7 @@ int evergreen_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP3(SRC2_SEL(ALU_SRC_KCACHE0_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(ALU_SRC_KCACHE0_BASE + 0),
                                  SRC2_REL(ABSOLUTE),
                                  SRC2_ELEM(ELEM_Y),
                                  SRC2_NEG(0),
@@ -958,7 +982,7 @@ int evergreen_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader)
                                  DST_ELEM(ELEM_Y),
                                  CLAMP(0));
     /* r2.z = MAD(c0.w, r1.x, c0.z) */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 0),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_W),
                              SRC0_NEG(0),
@@ -969,7 +993,7 @@ int evergreen_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP3(SRC2_SEL(ALU_SRC_KCACHE0_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(ALU_SRC_KCACHE0_BASE + 0),
                                  SRC2_REL(ABSOLUTE),
                                  SRC2_ELEM(ELEM_Z),
                                  SRC2_NEG(0),
@@ -980,7 +1004,7 @@ int evergreen_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader)
                                  DST_ELEM(ELEM_Z),
                                  CLAMP(0));
     /* r2.w = MAD(0, 0, 1) */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(SQ_ALU_SRC_0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(SQ_ALU_SRC_0),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_X),
                              SRC0_NEG(0),
@@ -991,7 +1015,7 @@ int evergreen_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(1));
-    shader[i++] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_1),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_1),
                                  SRC2_REL(ABSOLUTE),
                                  SRC2_ELEM(ELEM_X),
                                  SRC2_NEG(0),
@@ -1002,9 +1026,9 @@ int evergreen_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader)
                                  DST_ELEM(ELEM_W),
                                  CLAMP(0));
 
-    /* 13,14,15,16 */
+    /* 15,16,17,18 */
     /* r2.x = MAD(c1.x, r1.y, pv.x) */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 1),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 1),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_X),
                              SRC0_NEG(0),
@@ -1015,7 +1039,7 @@ int evergreen_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_PV),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_PV),
                                  SRC2_REL(ABSOLUTE),
                                  SRC2_ELEM(ELEM_X),
                                  SRC2_NEG(0),
@@ -1026,7 +1050,7 @@ int evergreen_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader)
                                  DST_ELEM(ELEM_X),
                                  CLAMP(0));
     /* r2.y = MAD(c1.y, r1.y, pv.y) */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 1),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 1),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_Y),
                              SRC0_NEG(0),
@@ -1037,7 +1061,96 @@ int evergreen_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_PV),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_PV),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_Y),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Y),
+                                 CLAMP(0));
+    /* r2.z = MAD(c1.z, r1.y, pv.z) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 1),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Z),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 1),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Y),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_PV),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_Z),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Z),
+                                 CLAMP(0));
+    /* r2.w = MAD(0, 0, 1) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(SQ_ALU_SRC_0),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(SQ_ALU_SRC_0),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_X),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_1),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_W),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_W),
+                                 CLAMP(0));
+    /* 19,20,21,22 */
+    /* r2.x = MAD(c2.x, r1.z, pv.x) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 1),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Z),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_PV),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_X),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_X),
+                                 CLAMP(1));
+    /* r2.y = MAD(c2.y, r1.z, pv.y) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Y),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 1),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Z),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_PV),
                                  SRC2_REL(ABSOLUTE),
                                  SRC2_ELEM(ELEM_Y),
                                  SRC2_NEG(0),
@@ -1045,326 +1158,1732 @@ int evergreen_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader)
                                  BANK_SWIZZLE(SQ_ALU_VEC_012),
                                  DST_GPR(2),
                                  DST_REL(ABSOLUTE),
-                                 DST_ELEM(ELEM_Y),
+                                 DST_ELEM(ELEM_Y),
+                                 CLAMP(1));
+    /* r2.z = MAD(c2.z, r1.z, pv.z) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Z),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 1),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Z),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_PV),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_Z),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Z),
+                                 CLAMP(1));
+    /* r2.w = MAD(0, 0, 1) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(SQ_ALU_SRC_0),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(SQ_ALU_SRC_0),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_X),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_1),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_X),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_W),
+                                 CLAMP(1));
+
+    /* 23 */
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(26),
+			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
+                            CF_CONST(0),
+                            COND(SQ_CF_COND_ACTIVE),
+                            I_COUNT(3),
+                            VALID_PIXEL_MODE(0),
+                            END_OF_PROGRAM(0),
+                            CF_INST(SQ_CF_INST_TC),
+                            WHOLE_QUAD_MODE(0),
+                            BARRIER(1));
+    /* 24 */
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(0),
+			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
+			    CF_CONST(0),
+			    COND(SQ_CF_COND_ACTIVE),
+			    I_COUNT(0),
+			    VALID_PIXEL_MODE(0),
+			    END_OF_PROGRAM(0),
+			    CF_INST(SQ_CF_INST_RETURN),
+			    WHOLE_QUAD_MODE(0),
+			    BARRIER(1));
+    /* 25 */
+    shader[RADEON_SHADER_DW(i, max)] = 0x00000000;
+    shader[RADEON_SHADER_DW(i, max)] = 0x00000000;
+    /* 26/27 */
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
+                             INST_MOD(0),
+                             FETCH_WHOLE_QUAD(0),
+                             RESOURCE_ID(0),
+                             SRC_GPR(0),
+                             SRC_REL(ABSOLUTE),
+                             ALT_CONST(0),
+			     RESOURCE_INDEX_MODE(SQ_CF_INDEX_NONE),
+			     SAMPLER_INDEX_MODE(SQ_CF_INDEX_NONE));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD1(DST_GPR(1),
+                             DST_REL(ABSOLUTE),
+                             DST_SEL_X(SQ_SEL_X),
+                             DST_SEL_Y(SQ_SEL_MASK),
+                             DST_SEL_Z(SQ_SEL_MASK),
+                             DST_SEL_W(SQ_SEL_1),
+                             LOD_BIAS(0),
+                             COORD_TYPE_X(TEX_NORMALIZED),
+                             COORD_TYPE_Y(TEX_NORMALIZED),
+                             COORD_TYPE_Z(TEX_NORMALIZED),
+                             COORD_TYPE_W(TEX_NORMALIZED));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD2(OFFSET_X(0),
+                             OFFSET_Y(0),
+                             OFFSET_Z(0),
+                             SAMPLER_ID(0),
+                             SRC_SEL_X(SQ_SEL_X),
+                             SRC_SEL_Y(SQ_SEL_Y),
+                             SRC_SEL_Z(SQ_SEL_0),
+                             SRC_SEL_W(SQ_SEL_1));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD_PAD;
+    /* 28/29 */
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
+                             INST_MOD(0),
+                             FETCH_WHOLE_QUAD(0),
+                             RESOURCE_ID(1),
+                             SRC_GPR(0),
+                             SRC_REL(ABSOLUTE),
+                             ALT_CONST(0),
+			     RESOURCE_INDEX_MODE(SQ_CF_INDEX_NONE),
+			     SAMPLER_INDEX_MODE(SQ_CF_INDEX_NONE));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD1(DST_GPR(1),
+                             DST_REL(ABSOLUTE),
+                             DST_SEL_X(SQ_SEL_MASK),
+                             DST_SEL_Y(SQ_SEL_MASK),
+                             DST_SEL_Z(SQ_SEL_X),
+                             DST_SEL_W(SQ_SEL_MASK),
+                             LOD_BIAS(0),
+                             COORD_TYPE_X(TEX_NORMALIZED),
+                             COORD_TYPE_Y(TEX_NORMALIZED),
+                             COORD_TYPE_Z(TEX_NORMALIZED),
+                             COORD_TYPE_W(TEX_NORMALIZED));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD2(OFFSET_X(0),
+                             OFFSET_Y(0),
+                             OFFSET_Z(0),
+                             SAMPLER_ID(1),
+                             SRC_SEL_X(SQ_SEL_X),
+                             SRC_SEL_Y(SQ_SEL_Y),
+                             SRC_SEL_Z(SQ_SEL_0),
+                             SRC_SEL_W(SQ_SEL_1));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD_PAD;
+    /* 30/31 */
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
+                             INST_MOD(0),
+                             FETCH_WHOLE_QUAD(0),
+                             RESOURCE_ID(2),
+                             SRC_GPR(0),
+                             SRC_REL(ABSOLUTE),
+                             ALT_CONST(0),
+			     RESOURCE_INDEX_MODE(SQ_CF_INDEX_NONE),
+			     SAMPLER_INDEX_MODE(SQ_CF_INDEX_NONE));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD1(DST_GPR(1),
+                             DST_REL(ABSOLUTE),
+                             DST_SEL_X(SQ_SEL_MASK),
+                             DST_SEL_Y(SQ_SEL_X),
+                             DST_SEL_Z(SQ_SEL_MASK),
+                             DST_SEL_W(SQ_SEL_MASK),
+                             LOD_BIAS(0),
+                             COORD_TYPE_X(TEX_NORMALIZED),
+                             COORD_TYPE_Y(TEX_NORMALIZED),
+                             COORD_TYPE_Z(TEX_NORMALIZED),
+                             COORD_TYPE_W(TEX_NORMALIZED));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD2(OFFSET_X(0),
+                             OFFSET_Y(0),
+                             OFFSET_Z(0),
+                             SAMPLER_ID(2),
+                             SRC_SEL_X(SQ_SEL_X),
+                             SRC_SEL_Y(SQ_SEL_Y),
+                             SRC_SEL_Z(SQ_SEL_0),
+                             SRC_SEL_W(SQ_SEL_1));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD_PAD;
+    /* 32 */
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(34),
+			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
+                            CF_CONST(0),
+                            COND(SQ_CF_COND_ACTIVE),
+                            I_COUNT(1),
+                            VALID_PIXEL_MODE(0),
+                            END_OF_PROGRAM(0),
+                            CF_INST(SQ_CF_INST_TC),
+                            WHOLE_QUAD_MODE(0),
+                            BARRIER(1));
+    /* 33 */
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(0),
+			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
+			    CF_CONST(0),
+			    COND(SQ_CF_COND_ACTIVE),
+			    I_COUNT(0),
+			    VALID_PIXEL_MODE(0),
+			    END_OF_PROGRAM(0),
+			    CF_INST(SQ_CF_INST_RETURN),
+			    WHOLE_QUAD_MODE(0),
+			    BARRIER(1));
+    /* 34/35 */
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
+                             INST_MOD(0),
+                             FETCH_WHOLE_QUAD(0),
+                             RESOURCE_ID(0),
+                             SRC_GPR(0),
+                             SRC_REL(ABSOLUTE),
+                             ALT_CONST(0),
+                             RESOURCE_INDEX_MODE(SQ_CF_INDEX_NONE),
+                             SAMPLER_INDEX_MODE(SQ_CF_INDEX_NONE));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD1(DST_GPR(1),
+                             DST_REL(ABSOLUTE),
+                             DST_SEL_X(SQ_SEL_X),
+                             DST_SEL_Y(SQ_SEL_Y),
+                             DST_SEL_Z(SQ_SEL_Z),
+                             DST_SEL_W(SQ_SEL_1),
+                             LOD_BIAS(0),
+                             COORD_TYPE_X(TEX_NORMALIZED),
+                             COORD_TYPE_Y(TEX_NORMALIZED),
+                             COORD_TYPE_Z(TEX_NORMALIZED),
+                             COORD_TYPE_W(TEX_NORMALIZED));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD2(OFFSET_X(0),
+                             OFFSET_Y(0),
+                             OFFSET_Z(0),
+                             SAMPLER_ID(0),
+                             SRC_SEL_X(SQ_SEL_X),
+                             SRC_SEL_Y(SQ_SEL_Y),
+                             SRC_SEL_Z(SQ_SEL_0),
+                             SRC_SEL_W(SQ_SEL_1));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD_PAD;
+
+    /* 36 - gamma: r2.xyz = 2 ^ (log2(r2.xyz) * c1.w) */
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD0(ADDR(38),
+                                KCACHE_BANK0(0),
+                                KCACHE_BANK1(0),
+                                KCACHE_MODE0(SQ_CF_KCACHE_LOCK_1));
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
+                                KCACHE_ADDR0(0),
+                                KCACHE_ADDR1(0),
+                                I_COUNT(9),
+                                ALT_CONST(0),
+                                CF_INST(SQ_CF_INST_ALU),
+                                WHOLE_QUAD_MODE(0),
+                                BARRIER(1));
+    /* 37 */
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(0),
+                            JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
+                            CF_CONST(0),
+                            COND(SQ_CF_COND_ACTIVE),
+                            I_COUNT(0),
+                            VALID_PIXEL_MODE(0),
+                            END_OF_PROGRAM(0),
+                            CF_INST(SQ_CF_INST_RETURN),
+                            WHOLE_QUAD_MODE(0),
+                            BARRIER(1));
+    /* 38 */
+    /* r2.x = LOG_CLAMPED(r2.x) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_X),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(1),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_LOG_CLAMPED),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_X),
+                                 CLAMP(0));
+    /* 39 */
+    /* r2.y = LOG_CLAMPED(r2.y) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Y),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Y),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(1),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_LOG_CLAMPED),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Y),
+                                 CLAMP(0));
+    /* 40 */
+    /* r2.z = LOG_CLAMPED(r2.z) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Z),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Z),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(1),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_LOG_CLAMPED),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Z),
+                                 CLAMP(0));
+    /* 41,42,43 */
+    /* r2.x = MUL(r2.x, c1.w) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_KCACHE0_BASE + 1),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_W),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(1),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_MUL),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_X),
+                                 CLAMP(0));
+    /* r2.y = MUL(r2.y, c1.w) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Y),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_KCACHE0_BASE + 1),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_W),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(1),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_MUL),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Y),
+                                 CLAMP(0));
+    /* r2.z = MUL(r2.z, c1.w) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Z),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_KCACHE0_BASE + 1),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_W),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(1),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_MUL),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Z),
+                                 CLAMP(0));
+    /* 44 */
+    /* r2.x = EXP_IEEE(r2.x) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_X),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(1),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_EXP_IEEE),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_X),
+                                 CLAMP(1));
+    /* 45 */
+    /* r2.y = EXP_IEEE(r2.y) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Y),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Y),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(1),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_EXP_IEEE),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Y),
+                                 CLAMP(1));
+    /* 46 */
+    /* r2.z = EXP_IEEE(r2.z) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Z),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Z),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(1),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_EXP_IEEE),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Z),
+                                 CLAMP(1));
+
+    return i;
+}
+
+/*
+ * xv bicubic ps: planar sources only.  Luma is filtered with four
+ * bilinear fetches placed and weighted from the bicubic lookup table
+ * (resource 3), chroma is sampled bilinearly as in the xv ps.
+ * c3 = { width, height, 1 / width, 1 / height } of the luma plane.
+ */
+int evergreen_xv_bicubic_ps(RADEONChipFamily ChipSet, uint32_t *shader, uint32_t variant, int max)
+{
+    int i = 0;
+
+    /* 0 */
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD0(ADDR(8),
+                                KCACHE_BANK0(0),
+                                KCACHE_BANK1(0),
+                                KCACHE_MODE0(SQ_CF_KCACHE_LOCK_1));
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
+                                KCACHE_ADDR0(0),
+                                KCACHE_ADDR1(0),
+                                I_COUNT(6),
+                                ALT_CONST(0),
+                                CF_INST(SQ_CF_INST_ALU),
+                                WHOLE_QUAD_MODE(0),
+                                BARRIER(1));
+    /* 1 */
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(36),
+                            JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
+                            CF_CONST(0),
+                            COND(SQ_CF_COND_ACTIVE),
+                            I_COUNT(4),
+                            VALID_PIXEL_MODE(0),
+                            END_OF_PROGRAM(0),
+                            CF_INST(SQ_CF_INST_TC),
+                            WHOLE_QUAD_MODE(0),
+                            BARRIER(1));
+    /* 2 */
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD0(ADDR(14),
+                                KCACHE_BANK0(0),
+                                KCACHE_BANK1(0),
+                                KCACHE_MODE0(SQ_CF_KCACHE_LOCK_1));
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
+                                KCACHE_ADDR0(0),
+                                KCACHE_ADDR1(0),
+                                I_COUNT(4),
+                                ALT_CONST(0),
+                                CF_INST(SQ_CF_INST_ALU),
+                                WHOLE_QUAD_MODE(0),
+                                BARRIER(1));
+    /* 3 */
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(44),
+                            JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
+                            CF_CONST(0),
+                            COND(SQ_CF_COND_ACTIVE),
+                            I_COUNT(4),
+                            VALID_PIXEL_MODE(0),
+                            END_OF_PROGRAM(0),
+                            CF_INST(SQ_CF_INST_TC),
+                            WHOLE_QUAD_MODE(0),
+                            BARRIER(1));
+    /* 4 */
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD0(ADDR(18),
+                                KCACHE_BANK0(0),
+                                KCACHE_BANK1(0),
+                                KCACHE_MODE0(SQ_CF_KCACHE_LOCK_1));
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
+                                KCACHE_ADDR0(0),
+                                KCACHE_ADDR1(0),
+                                I_COUNT(18),
+                                ALT_CONST(0),
+                                CF_INST(SQ_CF_INST_ALU),
+                                WHOLE_QUAD_MODE(0),
+                                BARRIER(1));
+    /* 5 - gamma correction, bool 1 */
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(52),
+                            JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
+                            CF_CONST(1),
+                            COND(SQ_CF_COND_BOOL),
+                            I_COUNT(0),
+                            VALID_PIXEL_MODE(0),
+                            END_OF_PROGRAM(0),
+                            CF_INST(SQ_CF_INST_CALL),
+                            WHOLE_QUAD_MODE(0),
+                            BARRIER(0));
+    /* 6 */
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(0),
+                            JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
+                            CF_CONST(0),
+                            COND(SQ_CF_COND_ACTIVE),
+                            I_COUNT(0),
+                            VALID_PIXEL_MODE(0),
+                            END_OF_PROGRAM(0),
+                            CF_INST(SQ_CF_INST_NOP),
+                            WHOLE_QUAD_MODE(0),
+                            BARRIER(1));
+    /* 7 */
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(CF_PIXEL_MRT0),
+                                          TYPE(SQ_EXPORT_PIXEL),
+                                          RW_GPR(2),
+                                          RW_REL(ABSOLUTE),
+                                          INDEX_GPR(0),
+                                          ELEM_SIZE(3));
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
+                                               SRC_SEL_Y(SQ_SEL_Y),
+                                               SRC_SEL_Z(SQ_SEL_Z),
+                                               SRC_SEL_W(SQ_SEL_W),
+                                               BURST_COUNT(1),
+                                               VALID_PIXEL_MODE(0),
+                                               END_OF_PROGRAM(1),
+                                               CF_INST(SQ_CF_INST_EXPORT_DONE),
+                                               MARK(0),
+                                               BARRIER(1));
+    /* 8,9,10,11 interpolate tex coords */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Y),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_PARAM_BASE + 0),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_X),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_AR_X),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(1),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_INTERP_XY),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_210),
+                                 DST_GPR(0),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_X),
+                                 CLAMP(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_PARAM_BASE + 0),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_X),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_AR_X),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(1),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_INTERP_XY),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_210),
+                                 DST_GPR(0),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Y),
+                                 CLAMP(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Y),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_PARAM_BASE + 0),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_X),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_AR_X),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(0),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_INTERP_XY),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_210),
+                                 DST_GPR(0),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Z),
+                                 CLAMP(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_PARAM_BASE + 0),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_X),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_AR_X),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(0),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_INTERP_XY),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_210),
+                                 DST_GPR(0),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_W),
+                                 CLAMP(0));
+    /* 12,13 */
+    /* r3.x = MAD(r0.x, c3.x, 0.5) - texel position, fraction indexes the filter table */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_KCACHE0_BASE + 3),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_X),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_0_5),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_X),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(3),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_X),
+                                 CLAMP(0));
+    /* r3.y = MAD(r0.y, c3.y, 0.5) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Y),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_KCACHE0_BASE + 3),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Y),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_0_5),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_X),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(3),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Y),
+                                 CLAMP(0));
+    /* 14 */
+    /* r6.x = MAD(r4.x, c3.z, r0.x) - left column */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 4),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_KCACHE0_BASE + 3),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Z),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(ALU_SRC_GPR_BASE + 0),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_X),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(6),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_X),
+                                 CLAMP(0));
+    /* 15 */
+    /* r6.y = MAD(r5.x, c3.w, r0.y) - top row */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 5),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_KCACHE0_BASE + 3),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_W),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(ALU_SRC_GPR_BASE + 0),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_Y),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(6),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Y),
+                                 CLAMP(0));
+    /* 16 */
+    /* r6.z = MAD(r4.y, c3.z, r0.x) - right column */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 4),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Y),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_KCACHE0_BASE + 3),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Z),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(ALU_SRC_GPR_BASE + 0),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_X),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(6),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Z),
+                                 CLAMP(0));
+    /* 17 */
+    /* r6.w = MAD(r5.y, c3.w, r0.y) - bottom row */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 5),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Y),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_KCACHE0_BASE + 3),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_W),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(ALU_SRC_GPR_BASE + 0),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_Y),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(6),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_W),
+                                 CLAMP(0));
+    /* 18,19 */
+    /* r8.x = ADD(r7.x, -r7.y) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 7),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 7),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Y),
+                             SRC1_NEG(1),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(1),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_ADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(8),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_X),
+                                 CLAMP(0));
+    /* r8.y = ADD(r7.z, -r7.w) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 7),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Z),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 7),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_W),
+                             SRC1_NEG(1),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(1),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_ADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(8),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Y),
+                                 CLAMP(0));
+    /* 20,21 */
+    /* r8.x = MAD(r8.x, r4.z, r7.y) - horizontal blend, top */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 8),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 4),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Z),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(ALU_SRC_GPR_BASE + 7),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_Y),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(8),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_X),
+                                 CLAMP(0));
+    /* r8.y = MAD(r8.y, r4.z, r7.w) - horizontal blend, bottom */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 8),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Y),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 4),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Z),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(ALU_SRC_GPR_BASE + 7),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_W),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(8),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Y),
+                                 CLAMP(0));
+    /* 22 */
+    /* r8.z = ADD(r8.x, -r8.y) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 8),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 8),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Y),
+                             SRC1_NEG(1),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(1),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_ADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(8),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Z),
+                                 CLAMP(0));
+    /* 23 */
+    /* r1.x = MAD(r8.z, r5.z, r8.y) - vertical blend, filtered Y */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 8),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Z),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 5),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Z),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(ALU_SRC_GPR_BASE + 8),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_Y),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(1),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_X),
+                                 CLAMP(0));
+    /* 24,25,26,27 */
+    /* r2.x = MAD(c0.w, r1.x, c0.x) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 0),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_W),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 1),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_X),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(ALU_SRC_KCACHE0_BASE + 0),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_X),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_X),
+                                 CLAMP(0));
+    /* r2.y = MAD(c0.w, r1.x, c0.y) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 0),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_W),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 1),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_X),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(ALU_SRC_KCACHE0_BASE + 0),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_Y),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Y),
+                                 CLAMP(0));
+    /* r2.z = MAD(c0.w, r1.x, c0.z) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 0),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_W),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 1),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_X),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(ALU_SRC_KCACHE0_BASE + 0),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_Z),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Z),
+                                 CLAMP(0));
+    /* r2.w = MAD(0, 0, 1) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(SQ_ALU_SRC_0),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(SQ_ALU_SRC_0),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_X),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_1),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_X),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_W),
+                                 CLAMP(0));
+    /* 28,29,30,31 */
+    /* r2.x = MAD(c1.x, r1.y, pv.x) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 1),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 1),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Y),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_PV),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_X),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_X),
+                                 CLAMP(0));
+    /* r2.y = MAD(c1.y, r1.y, pv.y) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 1),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Y),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 1),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Y),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_PV),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_Y),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Y),
+                                 CLAMP(0));
+    /* r2.z = MAD(c1.z, r1.y, pv.z) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 1),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Z),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 1),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Y),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_PV),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_Z),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Z),
+                                 CLAMP(0));
+    /* r2.w = MAD(0, 0, 1) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(SQ_ALU_SRC_0),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(SQ_ALU_SRC_0),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_X),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_1),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_X),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_W),
+                                 CLAMP(0));
+    /* 32,33,34,35 */
+    /* r2.x = MAD(c2.x, r1.z, pv.x) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 1),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Z),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_PV),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_X),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_X),
+                                 CLAMP(1));
+    /* r2.y = MAD(c2.y, r1.z, pv.y) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Y),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 1),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Z),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_PV),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_Y),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Y),
+                                 CLAMP(1));
+    /* r2.z = MAD(c2.z, r1.z, pv.z) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Z),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 1),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Z),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_PV),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_Z),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Z),
+                                 CLAMP(1));
+    /* r2.w = MAD(0, 0, 1) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(SQ_ALU_SRC_0),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(SQ_ALU_SRC_0),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_X),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_1),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_X),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_W),
+                                 CLAMP(1));
+    /* 36/37 - filter weights and offsets for x */
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
+                             INST_MOD(0),
+                             FETCH_WHOLE_QUAD(0),
+                             RESOURCE_ID(3),
+                             SRC_GPR(3),
+                             SRC_REL(ABSOLUTE),
+                             ALT_CONST(0),
+                             RESOURCE_INDEX_MODE(SQ_CF_INDEX_NONE),
+                             SAMPLER_INDEX_MODE(SQ_CF_INDEX_NONE));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD1(DST_GPR(4),
+                             DST_REL(ABSOLUTE),
+                             DST_SEL_X(SQ_SEL_X),
+                             DST_SEL_Y(SQ_SEL_Y),
+                             DST_SEL_Z(SQ_SEL_Z),
+                             DST_SEL_W(SQ_SEL_MASK),
+                             LOD_BIAS(0),
+                             COORD_TYPE_X(TEX_NORMALIZED),
+                             COORD_TYPE_Y(TEX_NORMALIZED),
+                             COORD_TYPE_Z(TEX_NORMALIZED),
+                             COORD_TYPE_W(TEX_NORMALIZED));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD2(OFFSET_X(0),
+                             OFFSET_Y(0),
+                             OFFSET_Z(0),
+                             SAMPLER_ID(3),
+                             SRC_SEL_X(SQ_SEL_X),
+                             SRC_SEL_Y(SQ_SEL_0),
+                             SRC_SEL_Z(SQ_SEL_0),
+                             SRC_SEL_W(SQ_SEL_1));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD_PAD;
+    /* 38/39 - filter weights and offsets for y */
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
+                             INST_MOD(0),
+                             FETCH_WHOLE_QUAD(0),
+                             RESOURCE_ID(3),
+                             SRC_GPR(3),
+                             SRC_REL(ABSOLUTE),
+                             ALT_CONST(0),
+                             RESOURCE_INDEX_MODE(SQ_CF_INDEX_NONE),
+                             SAMPLER_INDEX_MODE(SQ_CF_INDEX_NONE));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD1(DST_GPR(5),
+                             DST_REL(ABSOLUTE),
+                             DST_SEL_X(SQ_SEL_X),
+                             DST_SEL_Y(SQ_SEL_Y),
+                             DST_SEL_Z(SQ_SEL_Z),
+                             DST_SEL_W(SQ_SEL_MASK),
+                             LOD_BIAS(0),
+                             COORD_TYPE_X(TEX_NORMALIZED),
+                             COORD_TYPE_Y(TEX_NORMALIZED),
+                             COORD_TYPE_Z(TEX_NORMALIZED),
+                             COORD_TYPE_W(TEX_NORMALIZED));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD2(OFFSET_X(0),
+                             OFFSET_Y(0),
+                             OFFSET_Z(0),
+                             SAMPLER_ID(3),
+                             SRC_SEL_X(SQ_SEL_Y),
+                             SRC_SEL_Y(SQ_SEL_0),
+                             SRC_SEL_Z(SQ_SEL_0),
+                             SRC_SEL_W(SQ_SEL_1));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD_PAD;
+    /* 40/41 - V */
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
+                             INST_MOD(0),
+                             FETCH_WHOLE_QUAD(0),
+                             RESOURCE_ID(1),
+                             SRC_GPR(0),
+                             SRC_REL(ABSOLUTE),
+                             ALT_CONST(0),
+                             RESOURCE_INDEX_MODE(SQ_CF_INDEX_NONE),
+                             SAMPLER_INDEX_MODE(SQ_CF_INDEX_NONE));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD1(DST_GPR(1),
+                             DST_REL(ABSOLUTE),
+                             DST_SEL_X(SQ_SEL_MASK),
+                             DST_SEL_Y(SQ_SEL_MASK),
+                             DST_SEL_Z(SQ_SEL_X),
+                             DST_SEL_W(SQ_SEL_MASK),
+                             LOD_BIAS(0),
+                             COORD_TYPE_X(TEX_NORMALIZED),
+                             COORD_TYPE_Y(TEX_NORMALIZED),
+                             COORD_TYPE_Z(TEX_NORMALIZED),
+                             COORD_TYPE_W(TEX_NORMALIZED));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD2(OFFSET_X(0),
+                             OFFSET_Y(0),
+                             OFFSET_Z(0),
+                             SAMPLER_ID(1),
+                             SRC_SEL_X(SQ_SEL_X),
+                             SRC_SEL_Y(SQ_SEL_Y),
+                             SRC_SEL_Z(SQ_SEL_0),
+                             SRC_SEL_W(SQ_SEL_1));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD_PAD;
+    /* 42/43 - U */
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
+                             INST_MOD(0),
+                             FETCH_WHOLE_QUAD(0),
+                             RESOURCE_ID(2),
+                             SRC_GPR(0),
+                             SRC_REL(ABSOLUTE),
+                             ALT_CONST(0),
+                             RESOURCE_INDEX_MODE(SQ_CF_INDEX_NONE),
+                             SAMPLER_INDEX_MODE(SQ_CF_INDEX_NONE));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD1(DST_GPR(1),
+                             DST_REL(ABSOLUTE),
+                             DST_SEL_X(SQ_SEL_MASK),
+                             DST_SEL_Y(SQ_SEL_X),
+                             DST_SEL_Z(SQ_SEL_MASK),
+                             DST_SEL_W(SQ_SEL_MASK),
+                             LOD_BIAS(0),
+                             COORD_TYPE_X(TEX_NORMALIZED),
+                             COORD_TYPE_Y(TEX_NORMALIZED),
+                             COORD_TYPE_Z(TEX_NORMALIZED),
+                             COORD_TYPE_W(TEX_NORMALIZED));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD2(OFFSET_X(0),
+                             OFFSET_Y(0),
+                             OFFSET_Z(0),
+                             SAMPLER_ID(2),
+                             SRC_SEL_X(SQ_SEL_X),
+                             SRC_SEL_Y(SQ_SEL_Y),
+                             SRC_SEL_Z(SQ_SEL_0),
+                             SRC_SEL_W(SQ_SEL_1));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD_PAD;
+    /* 44/45 - Y top left */
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
+                             INST_MOD(0),
+                             FETCH_WHOLE_QUAD(0),
+                             RESOURCE_ID(0),
+                             SRC_GPR(6),
+                             SRC_REL(ABSOLUTE),
+                             ALT_CONST(0),
+                             RESOURCE_INDEX_MODE(SQ_CF_INDEX_NONE),
+                             SAMPLER_INDEX_MODE(SQ_CF_INDEX_NONE));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD1(DST_GPR(7),
+                             DST_REL(ABSOLUTE),
+                             DST_SEL_X(SQ_SEL_X),
+                             DST_SEL_Y(SQ_SEL_MASK),
+                             DST_SEL_Z(SQ_SEL_MASK),
+                             DST_SEL_W(SQ_SEL_MASK),
+                             LOD_BIAS(0),
+                             COORD_TYPE_X(TEX_NORMALIZED),
+                             COORD_TYPE_Y(TEX_NORMALIZED),
+                             COORD_TYPE_Z(TEX_NORMALIZED),
+                             COORD_TYPE_W(TEX_NORMALIZED));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD2(OFFSET_X(0),
+                             OFFSET_Y(0),
+                             OFFSET_Z(0),
+                             SAMPLER_ID(0),
+                             SRC_SEL_X(SQ_SEL_X),
+                             SRC_SEL_Y(SQ_SEL_Y),
+                             SRC_SEL_Z(SQ_SEL_0),
+                             SRC_SEL_W(SQ_SEL_1));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD_PAD;
+    /* 46/47 - Y top right */
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
+                             INST_MOD(0),
+                             FETCH_WHOLE_QUAD(0),
+                             RESOURCE_ID(0),
+                             SRC_GPR(6),
+                             SRC_REL(ABSOLUTE),
+                             ALT_CONST(0),
+                             RESOURCE_INDEX_MODE(SQ_CF_INDEX_NONE),
+                             SAMPLER_INDEX_MODE(SQ_CF_INDEX_NONE));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD1(DST_GPR(7),
+                             DST_REL(ABSOLUTE),
+                             DST_SEL_X(SQ_SEL_MASK),
+                             DST_SEL_Y(SQ_SEL_X),
+                             DST_SEL_Z(SQ_SEL_MASK),
+                             DST_SEL_W(SQ_SEL_MASK),
+                             LOD_BIAS(0),
+                             COORD_TYPE_X(TEX_NORMALIZED),
+                             COORD_TYPE_Y(TEX_NORMALIZED),
+                             COORD_TYPE_Z(TEX_NORMALIZED),
+                             COORD_TYPE_W(TEX_NORMALIZED));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD2(OFFSET_X(0),
+                             OFFSET_Y(0),
+                             OFFSET_Z(0),
+                             SAMPLER_ID(0),
+                             SRC_SEL_X(SQ_SEL_Z),
+                             SRC_SEL_Y(SQ_SEL_Y),
+                             SRC_SEL_Z(SQ_SEL_0),
+                             SRC_SEL_W(SQ_SEL_1));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD_PAD;
+    /* 48/49 - Y bottom left */
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
+                             INST_MOD(0),
+                             FETCH_WHOLE_QUAD(0),
+                             RESOURCE_ID(0),
+                             SRC_GPR(6),
+                             SRC_REL(ABSOLUTE),
+                             ALT_CONST(0),
+                             RESOURCE_INDEX_MODE(SQ_CF_INDEX_NONE),
+                             SAMPLER_INDEX_MODE(SQ_CF_INDEX_NONE));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD1(DST_GPR(7),
+                             DST_REL(ABSOLUTE),
+                             DST_SEL_X(SQ_SEL_MASK),
+                             DST_SEL_Y(SQ_SEL_MASK),
+                             DST_SEL_Z(SQ_SEL_X),
+                             DST_SEL_W(SQ_SEL_MASK),
+                             LOD_BIAS(0),
+                             COORD_TYPE_X(TEX_NORMALIZED),
+                             COORD_TYPE_Y(TEX_NORMALIZED),
+                             COORD_TYPE_Z(TEX_NORMALIZED),
+                             COORD_TYPE_W(TEX_NORMALIZED));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD2(OFFSET_X(0),
+                             OFFSET_Y(0),
+                             OFFSET_Z(0),
+                             SAMPLER_ID(0),
+                             SRC_SEL_X(SQ_SEL_X),
+                             SRC_SEL_Y(SQ_SEL_W),
+                             SRC_SEL_Z(SQ_SEL_0),
+                             SRC_SEL_W(SQ_SEL_1));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD_PAD;
+    /* 50/51 - Y bottom right */
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
+                             INST_MOD(0),
+                             FETCH_WHOLE_QUAD(0),
+                             RESOURCE_ID(0),
+                             SRC_GPR(6),
+                             SRC_REL(ABSOLUTE),
+                             ALT_CONST(0),
+                             RESOURCE_INDEX_MODE(SQ_CF_INDEX_NONE),
+                             SAMPLER_INDEX_MODE(SQ_CF_INDEX_NONE));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD1(DST_GPR(7),
+                             DST_REL(ABSOLUTE),
+                             DST_SEL_X(SQ_SEL_MASK),
+                             DST_SEL_Y(SQ_SEL_MASK),
+                             DST_SEL_Z(SQ_SEL_MASK),
+                             DST_SEL_W(SQ_SEL_X),
+                             LOD_BIAS(0),
+                             COORD_TYPE_X(TEX_NORMALIZED),
+                             COORD_TYPE_Y(TEX_NORMALIZED),
+                             COORD_TYPE_Z(TEX_NORMALIZED),
+                             COORD_TYPE_W(TEX_NORMALIZED));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD2(OFFSET_X(0),
+                             OFFSET_Y(0),
+                             OFFSET_Z(0),
+                             SAMPLER_ID(0),
+                             SRC_SEL_X(SQ_SEL_Z),
+                             SRC_SEL_Y(SQ_SEL_W),
+                             SRC_SEL_Z(SQ_SEL_0),
+                             SRC_SEL_W(SQ_SEL_1));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD_PAD;
+
+    /* 52 - gamma: r2.xyz = 2 ^ (log2(r2.xyz) * c1.w) */
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD0(ADDR(54),
+                                KCACHE_BANK0(0),
+                                KCACHE_BANK1(0),
+                                KCACHE_MODE0(SQ_CF_KCACHE_LOCK_1));
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
+                                KCACHE_ADDR0(0),
+                                KCACHE_ADDR1(0),
+                                I_COUNT(9),
+                                ALT_CONST(0),
+                                CF_INST(SQ_CF_INST_ALU),
+                                WHOLE_QUAD_MODE(0),
+                                BARRIER(1));
+    /* 53 */
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(0),
+                            JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
+                            CF_CONST(0),
+                            COND(SQ_CF_COND_ACTIVE),
+                            I_COUNT(0),
+                            VALID_PIXEL_MODE(0),
+                            END_OF_PROGRAM(0),
+                            CF_INST(SQ_CF_INST_RETURN),
+                            WHOLE_QUAD_MODE(0),
+                            BARRIER(1));
+    /* 54 */
+    /* r2.x = LOG_CLAMPED(r2.x) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_X),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(1),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_LOG_CLAMPED),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_X),
+                                 CLAMP(0));
+    /* 55 */
+    /* r2.y = LOG_CLAMPED(r2.y) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Y),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Y),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(1),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_LOG_CLAMPED),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Y),
+                                 CLAMP(0));
+    /* 56 */
+    /* r2.z = LOG_CLAMPED(r2.z) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Z),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Z),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(1),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_LOG_CLAMPED),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Z),
+                                 CLAMP(0));
+    /* 57,58,59 */
+    /* r2.x = MUL(r2.x, c1.w) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_KCACHE0_BASE + 1),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_W),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(1),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_MUL),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_X),
                                  CLAMP(0));
-    /* r2.z = MAD(c1.z, r1.y, pv.z) */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 1),
+    /* r2.y = MUL(r2.y, c1.w) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
                              SRC0_REL(ABSOLUTE),
-                             SRC0_ELEM(ELEM_Z),
+                             SRC0_ELEM(ELEM_Y),
                              SRC0_NEG(0),
-                             SRC1_SEL(ALU_SRC_GPR_BASE + 1),
+                             SRC1_SEL(ALU_SRC_KCACHE0_BASE + 1),
                              SRC1_REL(ABSOLUTE),
-                             SRC1_ELEM(ELEM_Y),
+                             SRC1_ELEM(ELEM_W),
                              SRC1_NEG(0),
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_PV),
-                                 SRC2_REL(ABSOLUTE),
-                                 SRC2_ELEM(ELEM_Z),
-                                 SRC2_NEG(0),
-                                 ALU_INST(SQ_OP3_INST_MULADD),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(1),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_MUL),
                                  BANK_SWIZZLE(SQ_ALU_VEC_012),
                                  DST_GPR(2),
                                  DST_REL(ABSOLUTE),
-                                 DST_ELEM(ELEM_Z),
+                                 DST_ELEM(ELEM_Y),
                                  CLAMP(0));
-    /* r2.w = MAD(0, 0, 1) */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(SQ_ALU_SRC_0),
+    /* r2.z = MUL(r2.z, c1.w) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
                              SRC0_REL(ABSOLUTE),
-                             SRC0_ELEM(ELEM_X),
+                             SRC0_ELEM(ELEM_Z),
                              SRC0_NEG(0),
-                             SRC1_SEL(SQ_ALU_SRC_0),
+                             SRC1_SEL(ALU_SRC_KCACHE0_BASE + 1),
                              SRC1_REL(ABSOLUTE),
-                             SRC1_ELEM(ELEM_X),
+                             SRC1_ELEM(ELEM_W),
                              SRC1_NEG(0),
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(1));
-    shader[i++] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_1),
-                                 SRC2_REL(ABSOLUTE),
-                                 SRC2_ELEM(ELEM_W),
-                                 SRC2_NEG(0),
-                                 ALU_INST(SQ_OP3_INST_MULADD),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(1),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_MUL),
                                  BANK_SWIZZLE(SQ_ALU_VEC_012),
                                  DST_GPR(2),
                                  DST_REL(ABSOLUTE),
-                                 DST_ELEM(ELEM_W),
+                                 DST_ELEM(ELEM_Z),
                                  CLAMP(0));
-    /* 17,18,19,20 */
-    /* r2.x = MAD(c2.x, r1.z, pv.x) */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 2),
+    /* 60 */
+    /* r2.x = EXP_IEEE(r2.x) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_X),
                              SRC0_NEG(0),
-                             SRC1_SEL(ALU_SRC_GPR_BASE + 1),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 2),
                              SRC1_REL(ABSOLUTE),
-                             SRC1_ELEM(ELEM_Z),
+                             SRC1_ELEM(ELEM_X),
                              SRC1_NEG(0),
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
-                             LAST(0));
-    shader[i++] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_PV),
-                                 SRC2_REL(ABSOLUTE),
-                                 SRC2_ELEM(ELEM_X),
-                                 SRC2_NEG(0),
-                                 ALU_INST(SQ_OP3_INST_MULADD),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(1),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_EXP_IEEE),
                                  BANK_SWIZZLE(SQ_ALU_VEC_012),
                                  DST_GPR(2),
                                  DST_REL(ABSOLUTE),
                                  DST_ELEM(ELEM_X),
                                  CLAMP(1));
-    /* r2.y = MAD(c2.y, r1.z, pv.y) */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 2),
+    /* 61 */
+    /* r2.y = EXP_IEEE(r2.y) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_Y),
                              SRC0_NEG(0),
-                             SRC1_SEL(ALU_SRC_GPR_BASE + 1),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 2),
                              SRC1_REL(ABSOLUTE),
-                             SRC1_ELEM(ELEM_Z),
+                             SRC1_ELEM(ELEM_Y),
                              SRC1_NEG(0),
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
-                             LAST(0));
-    shader[i++] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_PV),
-                                 SRC2_REL(ABSOLUTE),
-                                 SRC2_ELEM(ELEM_Y),
-                                 SRC2_NEG(0),
-                                 ALU_INST(SQ_OP3_INST_MULADD),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(1),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_EXP_IEEE),
                                  BANK_SWIZZLE(SQ_ALU_VEC_012),
                                  DST_GPR(2),
                                  DST_REL(ABSOLUTE),
                                  DST_ELEM(ELEM_Y),
                                  CLAMP(1));
-    /* r2.z = MAD(c2.z, r1.z, pv.z) */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 2),
+    /* 62 */
+    /* r2.z = EXP_IEEE(r2.z) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_Z),
                              SRC0_NEG(0),
-                             SRC1_SEL(ALU_SRC_GPR_BASE + 1),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 2),
                              SRC1_REL(ABSOLUTE),
                              SRC1_ELEM(ELEM_Z),
                              SRC1_NEG(0),
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
-                             LAST(0));
-    shader[i++] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_PV),
-                                 SRC2_REL(ABSOLUTE),
-                                 SRC2_ELEM(ELEM_Z),
-                                 SRC2_NEG(0),
-                                 ALU_INST(SQ_OP3_INST_MULADD),
-                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
-                                 DST_GPR(2),
-                                 DST_REL(ABSOLUTE),
-                                 DST_ELEM(ELEM_Z),
-                                 CLAMP(1));
-    /* r2.w = MAD(0, 0, 1) */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(SQ_ALU_SRC_0),
-                             SRC0_REL(ABSOLUTE),
-                             SRC0_ELEM(ELEM_X),
-                             SRC0_NEG(0),
-                             SRC1_SEL(SQ_ALU_SRC_0),
-                             SRC1_REL(ABSOLUTE),
-                             SRC1_ELEM(ELEM_X),
-                             SRC1_NEG(0),
-                             INDEX_MODE(SQ_INDEX_LOOP),
-                             PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(1));
-    shader[i++] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_1),
-                                 SRC2_REL(ABSOLUTE),
-                                 SRC2_ELEM(ELEM_X),
-                                 SRC2_NEG(0),
-                                 ALU_INST(SQ_OP3_INST_MULADD),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(1),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_EXP_IEEE),
                                  BANK_SWIZZLE(SQ_ALU_VEC_012),
                                  DST_GPR(2),
                                  DST_REL(ABSOLUTE),
-                                 DST_ELEM(ELEM_W),
+                                 DST_ELEM(ELEM_Z),
                                  CLAMP(1));
 
-    /* 21 */
-    shader[i++] = CF_DWORD0(ADDR(24),
-			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
-                            CF_CONST(0),
-                            COND(SQ_CF_COND_ACTIVE),
-                            I_COUNT(3),
-                            VALID_PIXEL_MODE(0),
-                            END_OF_PROGRAM(0),
-                            CF_INST(SQ_CF_INST_TC),
-                            WHOLE_QUAD_MODE(0),
-                            BARRIER(1));
-    /* 22 */
-    shader[i++] = CF_DWORD0(ADDR(0),
-			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
-			    CF_CONST(0),
-			    COND(SQ_CF_COND_ACTIVE),
-			    I_COUNT(0),
-			    VALID_PIXEL_MODE(0),
-			    END_OF_PROGRAM(0),
-			    CF_INST(SQ_CF_INST_RETURN),
-			    WHOLE_QUAD_MODE(0),
-			    BARRIER(1));
-    /* 23 */
-    shader[i++] = 0x00000000;
-    shader[i++] = 0x00000000;
-    /* 24/25 */
-    shader[i++] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
-                             INST_MOD(0),
-                             FETCH_WHOLE_QUAD(0),
-                             RESOURCE_ID(0),
-                             SRC_GPR(0),
-                             SRC_REL(ABSOLUTE),
-                             ALT_CONST(0),
-			     RESOURCE_INDEX_MODE(SQ_CF_INDEX_NONE),
-			     SAMPLER_INDEX_MODE(SQ_CF_INDEX_NONE));
-    shader[i++] = TEX_DWORD1(DST_GPR(1),
-                             DST_REL(ABSOLUTE),
-                             DST_SEL_X(SQ_SEL_X),
-                             DST_SEL_Y(SQ_SEL_MASK),
-                             DST_SEL_Z(SQ_SEL_MASK),
-                             DST_SEL_W(SQ_SEL_1),
-                             LOD_BIAS(0),
-                             COORD_TYPE_X(TEX_NORMALIZED),
-                             COORD_TYPE_Y(TEX_NORMALIZED),
-                             COORD_TYPE_Z(TEX_NORMALIZED),
-                             COORD_TYPE_W(TEX_NORMALIZED));
-    shader[i++] = TEX_DWORD2(OFFSET_X(0),
-                             OFFSET_Y(0),
-                             OFFSET_Z(0),
-                             SAMPLER_ID(0),
-                             SRC_SEL_X(SQ_SEL_X),
-                             SRC_SEL_Y(SQ_SEL_Y),
-                             SRC_SEL_Z(SQ_SEL_0),
-                             SRC_SEL_W(SQ_SEL_1));
-    shader[i++] = TEX_DWORD_PAD;
-    /* 26/27 */
-    shader[i++] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
-                             INST_MOD(0),
-                             FETCH_WHOLE_QUAD(0),
-                             RESOURCE_ID(1),
-                             SRC_GPR(0),
-                             SRC_REL(ABSOLUTE),
-                             ALT_CONST(0),
-			     RESOURCE_INDEX_MODE(SQ_CF_INDEX_NONE),
-			     SAMPLER_INDEX_MODE(SQ_CF_INDEX_NONE));
-    shader[i++] = TEX_DWORD1(DST_GPR(1),
-                             DST_REL(ABSOLUTE),
-                             DST_SEL_X(SQ_SEL_MASK),
-                             DST_SEL_Y(SQ_SEL_MASK),
-                             DST_SEL_Z(SQ_SEL_X),
-                             DST_SEL_W(SQ_SEL_MASK),
-                             LOD_BIAS(0),
-                             COORD_TYPE_X(TEX_NORMALIZED),
-                             COORD_TYPE_Y(TEX_NORMALIZED),
-                             COORD_TYPE_Z(TEX_NORMALIZED),
-                             COORD_TYPE_W(TEX_NORMALIZED));
-    shader[i++] = TEX_DWORD2(OFFSET_X(0),
-                             OFFSET_Y(0),
-                             OFFSET_Z(0),
-                             SAMPLER_ID(1),
-                             SRC_SEL_X(SQ_SEL_X),
-                             SRC_SEL_Y(SQ_SEL_Y),
-                             SRC_SEL_Z(SQ_SEL_0),
-                             SRC_SEL_W(SQ_SEL_1));
-    shader[i++] = TEX_DWORD_PAD;
-    /* 28/29 */
-    shader[i++] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
-                             INST_MOD(0),
-                             FETCH_WHOLE_QUAD(0),
-                             RESOURCE_ID(2),
-                             SRC_GPR(0),
-                             SRC_REL(ABSOLUTE),
-                             ALT_CONST(0),
-			     RESOURCE_INDEX_MODE(SQ_CF_INDEX_NONE),
-			     SAMPLER_INDEX_MODE(SQ_CF_INDEX_NONE));
-    shader[i++] = TEX_DWORD1(DST_GPR(1),
-                             DST_REL(ABSOLUTE),
-                             DST_SEL_X(SQ_SEL_MASK),
-                             DST_SEL_Y(SQ_SEL_X),
-                             DST_SEL_Z(SQ_SEL_MASK),
-                             DST_SEL_W(SQ_SEL_MASK),
-                             LOD_BIAS(0),
-                             COORD_TYPE_X(TEX_NORMALIZED),
-                             COORD_TYPE_Y(TEX_NORMALIZED),
-                             COORD_TYPE_Z(TEX_NORMALIZED),
-                             COORD_TYPE_W(TEX_NORMALIZED));
-    shader[i++] = TEX_DWORD2(OFFSET_X(0),
-                             OFFSET_Y(0),
-                             OFFSET_Z(0),
-                             SAMPLER_ID(2),
-                             SRC_SEL_X(SQ_SEL_X),
-                             SRC_SEL_Y(SQ_SEL_Y),
-                             SRC_SEL_Z(SQ_SEL_0),
-                             SRC_SEL_W(SQ_SEL_1));
-    shader[i++] = TEX_DWORD_PAD;
-    /* 30 */
-    shader[i++] = CF_DWORD0(ADDR(32),
-			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
-                            CF_CONST(0),
-                            COND(SQ_CF_COND_ACTIVE),
-                            I_COUNT(1),
-                            VALID_PIXEL_MODE(0),
-                            END_OF_PROGRAM(0),
-                            CF_INST(SQ_CF_INST_TC),
-                            WHOLE_QUAD_MODE(0),
-                            BARRIER(1));
-    /* 31 */
-    shader[i++] = CF_DWORD0(ADDR(0),
-			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
-			    CF_CONST(0),
-			    COND(SQ_CF_COND_ACTIVE),
-			    I_COUNT(0),
-			    VALID_PIXEL_MODE(0),
-			    END_OF_PROGRAM(0),
-			    CF_INST(SQ_CF_INST_RETURN),
-			    WHOLE_QUAD_MODE(0),
-			    BARRIER(1));
-    /* 32/33 */
-    shader[i++] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
-                             INST_MOD(0),
-                             FETCH_WHOLE_QUAD(0),
-                             RESOURCE_ID(0),
-                             SRC_GPR(0),
-                             SRC_REL(ABSOLUTE),
-                             ALT_CONST(0),
-                             RESOURCE_INDEX_MODE(SQ_CF_INDEX_NONE),
-                             SAMPLER_INDEX_MODE(SQ_CF_INDEX_NONE));
-    shader[i++] = TEX_DWORD1(DST_GPR(1),
-                             DST_REL(ABSOLUTE),
-                             DST_SEL_X(SQ_SEL_X),
-                             DST_SEL_Y(SQ_SEL_Y),
-                             DST_SEL_Z(SQ_SEL_Z),
-                             DST_SEL_W(SQ_SEL_1),
-                             LOD_BIAS(0),
-                             COORD_TYPE_X(TEX_NORMALIZED),
-                             COORD_TYPE_Y(TEX_NORMALIZED),
-                             COORD_TYPE_Z(TEX_NORMALIZED),
-                             COORD_TYPE_W(TEX_NORMALIZED));
-    shader[i++] = TEX_DWORD2(OFFSET_X(0),
-                             OFFSET_Y(0),
-                             OFFSET_Z(0),
-                             SAMPLER_ID(0),
-                             SRC_SEL_X(SQ_SEL_X),
-                             SRC_SEL_Y(SQ_SEL_Y),
-                             SRC_SEL_Z(SQ_SEL_0),
-                             SRC_SEL_W(SQ_SEL_1));
-    shader[i++] = TEX_DWORD_PAD;
-
     return i;
 }
 
 /* comp vs --------------------------------------- */
-int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
+int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t *shader, uint32_t variant, int max)
 {
     int i = 0;
 
     /* 0 */
-    shader[i++] = CF_DWORD0(ADDR(3),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(3),
 			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
                             CF_CONST(0),
                             COND(SQ_CF_COND_BOOL),
                             I_COUNT(0),
@@ -1374,9 +2893,9 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                             WHOLE_QUAD_MODE(0),
                             BARRIER(0));
     /* 1 */
-    shader[i++] = CF_DWORD0(ADDR(9),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(9),
 			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
                             CF_CONST(0),
                             COND(SQ_CF_COND_NOT_BOOL),
                             I_COUNT(0),
@@ -1386,9 +2905,9 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                             WHOLE_QUAD_MODE(0),
                             BARRIER(0));
     /* 2 */
-    shader[i++] = CF_DWORD0(ADDR(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(0),
                             JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
                             CF_CONST(0),
                             COND(SQ_CF_COND_ACTIVE),
                             I_COUNT(0),
@@ -1398,9 +2917,9 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                             WHOLE_QUAD_MODE(0),
                             BARRIER(1));
     /* 3 - mask sub */
-    shader[i++] = CF_DWORD0(ADDR(44),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(44),
 			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
 			    CF_CONST(0),
 			    COND(SQ_CF_COND_ACTIVE),
 			    I_COUNT(3),
@@ -1411,11 +2930,11 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 			    BARRIER(1));
 
     /* 4 - ALU */
-    shader[i++] = CF_ALU_DWORD0(ADDR(14),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD0(ADDR(14),
 				KCACHE_BANK0(0),
 				KCACHE_BANK1(0),
 				KCACHE_MODE0(SQ_CF_KCACHE_LOCK_1));
-    shader[i++] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
 				KCACHE_ADDR0(0),
 				KCACHE_ADDR1(0),
 				I_COUNT(20),
@@ -1425,13 +2944,13 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 				BARRIER(1));
 
     /* 5 - dst */
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(CF_POS0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(CF_POS0),
 					  TYPE(SQ_EXPORT_POS),
 					  RW_GPR(2),
 					  RW_REL(ABSOLUTE),
 					  INDEX_GPR(0),
 					  ELEM_SIZE(0));
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
 					       SRC_SEL_Y(SQ_SEL_Y),
 					       SRC_SEL_Z(SQ_SEL_0),
 					       SRC_SEL_W(SQ_SEL_1),
@@ -1442,13 +2961,13 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 					       MARK(0),
 					       BARRIER(1));
     /* 6 - src */
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(0),
 					  TYPE(SQ_EXPORT_PARAM),
 					  RW_GPR(1),
 					  RW_REL(ABSOLUTE),
 					  INDEX_GPR(0),
 					  ELEM_SIZE(0));
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
 					       SRC_SEL_Y(SQ_SEL_Y),
 					       SRC_SEL_Z(SQ_SEL_0),
 					       SRC_SEL_W(SQ_SEL_1),
@@ -1459,13 +2978,13 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 					       MARK(0),
 					       BARRIER(0));
     /* 7 - mask */
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(1),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(1),
 					  TYPE(SQ_EXPORT_PARAM),
 					  RW_GPR(0),
 					  RW_REL(ABSOLUTE),
 					  INDEX_GPR(0),
 					  ELEM_SIZE(0));
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
 					       SRC_SEL_Y(SQ_SEL_Y),
 					       SRC_SEL_Z(SQ_SEL_0),
 					       SRC_SEL_W(SQ_SEL_1),
@@ -1476,9 +2995,9 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 					       WHOLE_QUAD_MODE(0),
 					       BARRIER(0));
     /* 8 */
-    shader[i++] = CF_DWORD0(ADDR(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(0),
 			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
 			    CF_CONST(0),
 			    COND(SQ_CF_COND_ACTIVE),
 			    I_COUNT(0),
@@ -1488,9 +3007,9 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 			    WHOLE_QUAD_MODE(0),
 			    BARRIER(1));
     /* 9 - non-mask sub */
-    shader[i++] = CF_DWORD0(ADDR(50),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(50),
 			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
 			    CF_CONST(0),
 			    COND(SQ_CF_COND_ACTIVE),
 			    I_COUNT(2),
@@ -1501,11 +3020,11 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 			    BARRIER(1));
 
     /* 10 - ALU */
-    shader[i++] = CF_ALU_DWORD0(ADDR(34),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD0(ADDR(34),
 				KCACHE_BANK0(0),
 				KCACHE_BANK1(0),
 				KCACHE_MODE0(SQ_CF_KCACHE_LOCK_1));
-    shader[i++] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
 				KCACHE_ADDR0(0),
 				KCACHE_ADDR1(0),
 				I_COUNT(10),
@@ -1515,13 +3034,13 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 				BARRIER(1));
 
     /* 11 - dst */
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(CF_POS0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(CF_POS0),
 					  TYPE(SQ_EXPORT_POS),
 					  RW_GPR(1),
 					  RW_REL(ABSOLUTE),
 					  INDEX_GPR(0),
 					  ELEM_SIZE(0));
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
 					       SRC_SEL_Y(SQ_SEL_Y),
 					       SRC_SEL_Z(SQ_SEL_0),
 					       SRC_SEL_W(SQ_SEL_1),
@@ -1532,13 +3051,13 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 					       MARK(0),
 					       BARRIER(1));
     /* 12 - src */
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(0),
 					  TYPE(SQ_EXPORT_PARAM),
 					  RW_GPR(0),
 					  RW_REL(ABSOLUTE),
 					  INDEX_GPR(0),
 					  ELEM_SIZE(0));
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
 					       SRC_SEL_Y(SQ_SEL_Y),
 					       SRC_SEL_Z(SQ_SEL_0),
 					       SRC_SEL_W(SQ_SEL_1),
@@ -1549,9 +3068,9 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 					       MARK(0),
 					       BARRIER(0));
     /* 13 */
-    shader[i++] = CF_DWORD0(ADDR(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(0),
 			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
 			    CF_CONST(0),
 			    COND(SQ_CF_COND_ACTIVE),
 			    I_COUNT(0),
@@ -1562,7 +3081,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 			    BARRIER(1));
 
     /* 14 srcX.x DOT4 - mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 1),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 1),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_X),
                              SRC0_NEG(0),
@@ -1573,7 +3092,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
                                  UPDATE_PRED(0),
@@ -1587,7 +3106,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 15 srcX.y DOT4 - mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 1),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 1),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_Y),
                              SRC0_NEG(0),
@@ -1598,7 +3117,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
                                  UPDATE_PRED(0),
@@ -1612,7 +3131,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 16 srcX.z DOT4 - mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 1),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 1),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_Z),
                              SRC0_NEG(0),
@@ -1623,7 +3142,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
                                  UPDATE_PRED(0),
@@ -1637,7 +3156,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 17 srcX.w DOT4 - mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 1),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 1),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_W),
                              SRC0_NEG(0),
@@ -1648,7 +3167,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(1));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
                                  UPDATE_PRED(0),
@@ -1662,7 +3181,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 18 srcY.x DOT4 - mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 1),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 1),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_X),
                              SRC0_NEG(0),
@@ -1673,7 +3192,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
                                  UPDATE_PRED(0),
@@ -1687,7 +3206,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 19 srcY.y DOT4 - mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 1),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 1),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_Y),
                              SRC0_NEG(0),
@@ -1698,7 +3217,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
                                  UPDATE_PRED(0),
@@ -1712,7 +3231,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 20 srcY.z DOT4 - mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 1),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 1),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_Z),
                              SRC0_NEG(0),
@@ -1723,7 +3242,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
                                  UPDATE_PRED(0),
@@ -1737,7 +3256,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 21 srcY.w DOT4 - mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 1),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 1),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_W),
                              SRC0_NEG(0),
@@ -1748,7 +3267,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(1));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
                                  UPDATE_PRED(0),
@@ -1762,7 +3281,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 22 maskX.x DOT4 - mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_X),
                              SRC0_NEG(0),
@@ -1773,7 +3292,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
                                  UPDATE_PRED(0),
@@ -1787,7 +3306,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 23 maskX.y DOT4 - mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_Y),
                              SRC0_NEG(0),
@@ -1798,7 +3317,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
                                  UPDATE_PRED(0),
@@ -1812,7 +3331,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 24 maskX.z DOT4 - mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_Z),
                              SRC0_NEG(0),
@@ -1823,7 +3342,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
                                  UPDATE_PRED(0),
@@ -1837,7 +3356,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 25 maskX.w DOT4 - mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_W),
                              SRC0_NEG(0),
@@ -1848,7 +3367,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(1));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
                                  UPDATE_PRED(0),
@@ -1862,7 +3381,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 26 maskY.x DOT4 - mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_X),
                              SRC0_NEG(0),
@@ -1873,7 +3392,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
                                  UPDATE_PRED(0),
@@ -1887,7 +3406,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 27 maskY.y DOT4 - mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_Y),
                              SRC0_NEG(0),
@@ -1898,7 +3417,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
                                  UPDATE_PRED(0),
@@ -1912,7 +3431,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 28 maskY.z DOT4 - mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_Z),
                              SRC0_NEG(0),
@@ -1923,7 +3442,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
                                  UPDATE_PRED(0),
@@ -1937,7 +3456,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 29 maskY.w DOT4 - mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_W),
                              SRC0_NEG(0),
@@ -1948,7 +3467,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(1));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
                                  UPDATE_PRED(0),
@@ -1962,7 +3481,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 30 srcX / w */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 3),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 3),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_X),
                              SRC0_NEG(0),
@@ -1973,7 +3492,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_AR_X),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(1));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
                                  UPDATE_PRED(0),
@@ -1987,7 +3506,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 31 srcY / h */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 3),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 3),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_Y),
                              SRC0_NEG(0),
@@ -1998,7 +3517,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_AR_X),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(1));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
                                  UPDATE_PRED(0),
@@ -2012,7 +3531,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 32 maskX / w */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 4),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 4),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_X),
                              SRC0_NEG(0),
@@ -2023,7 +3542,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_AR_X),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(1));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
                                  UPDATE_PRED(0),
@@ -2037,7 +3556,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 33 maskY / h */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 4),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 4),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_Y),
                              SRC0_NEG(0),
@@ -2048,7 +3567,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_AR_X),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(1));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
                                  UPDATE_PRED(0),
@@ -2062,7 +3581,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 34 srcX.x DOT4 - non-mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_X),
                              SRC0_NEG(0),
@@ -2073,7 +3592,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
                                  UPDATE_PRED(0),
@@ -2087,7 +3606,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 35 srcX.y DOT4 - non-mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_Y),
                              SRC0_NEG(0),
@@ -2098,7 +3617,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
                                  UPDATE_PRED(0),
@@ -2112,7 +3631,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 36 srcX.z DOT4 - non-mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_Z),
                              SRC0_NEG(0),
@@ -2123,7 +3642,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
                                  UPDATE_PRED(0),
@@ -2137,7 +3656,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 37 srcX.w DOT4 - non-mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_W),
                              SRC0_NEG(0),
@@ -2148,7 +3667,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(1));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
                                  UPDATE_PRED(0),
@@ -2162,7 +3681,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 38 srcY.x DOT4 - non-mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_X),
                              SRC0_NEG(0),
@@ -2173,7 +3692,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
                                  UPDATE_PRED(0),
@@ -2187,7 +3706,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 39 srcY.y DOT4 - non-mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_Y),
                              SRC0_NEG(0),
@@ -2198,7 +3717,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
                                  UPDATE_PRED(0),
@@ -2212,7 +3731,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 40 srcY.z DOT4 - non-mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_Z),
                              SRC0_NEG(0),
@@ -2223,7 +3742,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
                                  UPDATE_PRED(0),
@@ -2237,7 +3756,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 41 srcY.w DOT4 - non-mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_W),
                              SRC0_NEG(0),
@@ -2248,7 +3767,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(1));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
                                  UPDATE_PRED(0),
@@ -2262,7 +3781,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 42 srcX / w */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_X),
                              SRC0_NEG(0),
@@ -2273,7 +3792,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_AR_X),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(1));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
                                  UPDATE_PRED(0),
@@ -2287,7 +3806,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 43 srcY / h */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_Y),
                              SRC0_NEG(0),
@@ -2298,7 +3817,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_AR_X),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(1));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
                                  UPDATE_PRED(0),
@@ -2312,7 +3831,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* mask vfetch - 44/45 - dst */
-    shader[i++] = VTX_DWORD0(VTX_INST(SQ_VTX_INST_FETCH),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD0(VTX_INST(SQ_VTX_INST_FETCH),
 			     FETCH_TYPE(SQ_VTX_FETCH_VERTEX_DATA),
 			     FETCH_WHOLE_QUAD(0),
 			     BUFFER_ID(0),
@@ -2320,7 +3839,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 			     SRC_REL(ABSOLUTE),
 			     SRC_SEL_X(SQ_SEL_X),
 			     MEGA_FETCH_COUNT(24));
-    shader[i++] = VTX_DWORD1_GPR(DST_GPR(2),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD1_GPR(DST_GPR(2),
 				 DST_REL(0),
 				 DST_SEL_X(SQ_SEL_X),
 				 DST_SEL_Y(SQ_SEL_Y),
@@ -2331,7 +3850,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 				 NUM_FORMAT_ALL(SQ_NUM_FORMAT_SCALED),
 				 FORMAT_COMP_ALL(SQ_FORMAT_COMP_SIGNED),
 				 SRF_MODE_ALL(SRF_MODE_ZERO_CLAMP_MINUS_ONE));
-    shader[i++] = VTX_DWORD2(OFFSET(0),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD2(OFFSET(0),
 #if X_BYTE_ORDER == X_BIG_ENDIAN
                              ENDIAN_SWAP(SQ_ENDIAN_8IN32),
 #else
@@ -2341,9 +3860,9 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 			     MEGA_FETCH(1),
 			     ALT_CONST(0),
 			     BUFFER_INDEX_MODE(SQ_CF_INDEX_NONE));
-    shader[i++] = VTX_DWORD_PAD;
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD_PAD;
     /* 46/47 - src */
-    shader[i++] = VTX_DWORD0(VTX_INST(SQ_VTX_INST_FETCH),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD0(VTX_INST(SQ_VTX_INST_FETCH),
 			     FETCH_TYPE(SQ_VTX_FETCH_VERTEX_DATA),
 			     FETCH_WHOLE_QUAD(0),
 			     BUFFER_ID(0),
@@ -2351,7 +3870,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 			     SRC_REL(ABSOLUTE),
 			     SRC_SEL_X(SQ_SEL_X),
 			     MEGA_FETCH_COUNT(8));
-    shader[i++] = VTX_DWORD1_GPR(DST_GPR(1),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD1_GPR(DST_GPR(1),
 				 DST_REL(0),
 				 DST_SEL_X(SQ_SEL_X),
 				 DST_SEL_Y(SQ_SEL_Y),
@@ -2362,7 +3881,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 				 NUM_FORMAT_ALL(SQ_NUM_FORMAT_SCALED),
 				 FORMAT_COMP_ALL(SQ_FORMAT_COMP_SIGNED),
 				 SRF_MODE_ALL(SRF_MODE_ZERO_CLAMP_MINUS_ONE));
-    shader[i++] = VTX_DWORD2(OFFSET(8),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD2(OFFSET(8),
 #if X_BYTE_ORDER == X_BIG_ENDIAN
                              ENDIAN_SWAP(SQ_ENDIAN_8IN32),
 #else
@@ -2372,9 +3891,9 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 			     MEGA_FETCH(0),
 			     ALT_CONST(0),
 			     BUFFER_INDEX_MODE(SQ_CF_INDEX_NONE));
-    shader[i++] = VTX_DWORD_PAD;
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD_PAD;
     /* 48/49 - mask */
-    shader[i++] = VTX_DWORD0(VTX_INST(SQ_VTX_INST_FETCH),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD0(VTX_INST(SQ_VTX_INST_FETCH),
 			     FETCH_TYPE(SQ_VTX_FETCH_VERTEX_DATA),
 			     FETCH_WHOLE_QUAD(0),
 			     BUFFER_ID(0),
@@ -2382,7 +3901,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 			     SRC_REL(ABSOLUTE),
 			     SRC_SEL_X(SQ_SEL_X),
 			     MEGA_FETCH_COUNT(8));
-    shader[i++] = VTX_DWORD1_GPR(DST_GPR(0),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD1_GPR(DST_GPR(0),
 				 DST_REL(0),
 				 DST_SEL_X(SQ_SEL_X),
 				 DST_SEL_Y(SQ_SEL_Y),
@@ -2393,7 +3912,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 				 NUM_FORMAT_ALL(SQ_NUM_FORMAT_SCALED),
 				 FORMAT_COMP_ALL(SQ_FORMAT_COMP_SIGNED),
 				 SRF_MODE_ALL(SRF_MODE_ZERO_CLAMP_MINUS_ONE));
-    shader[i++] = VTX_DWORD2(OFFSET(16),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD2(OFFSET(16),
 #if X_BYTE_ORDER == X_BIG_ENDIAN
                              ENDIAN_SWAP(SQ_ENDIAN_8IN32),
 #else
@@ -2403,10 +3922,10 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 			     MEGA_FETCH(0),
 			     ALT_CONST(0),
 			     BUFFER_INDEX_MODE(SQ_CF_INDEX_NONE));
-    shader[i++] = VTX_DWORD_PAD;
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD_PAD;
 
     /* no mask vfetch - 50/51 - dst */
-    shader[i++] = VTX_DWORD0(VTX_INST(SQ_VTX_INST_FETCH),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD0(VTX_INST(SQ_VTX_INST_FETCH),
 			     FETCH_TYPE(SQ_VTX_FETCH_VERTEX_DATA),
 			     FETCH_WHOLE_QUAD(0),
 			     BUFFER_ID(0),
@@ -2414,7 +3933,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 			     SRC_REL(ABSOLUTE),
 			     SRC_SEL_X(SQ_SEL_X),
 			     MEGA_FETCH_COUNT(16));
-    shader[i++] = VTX_DWORD1_GPR(DST_GPR(1),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD1_GPR(DST_GPR(1),
 				 DST_REL(0),
 				 DST_SEL_X(SQ_SEL_X),
 				 DST_SEL_Y(SQ_SEL_Y),
@@ -2425,7 +3944,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 				 NUM_FORMAT_ALL(SQ_NUM_FORMAT_SCALED),
 				 FORMAT_COMP_ALL(SQ_FORMAT_COMP_SIGNED),
 				 SRF_MODE_ALL(SRF_MODE_ZERO_CLAMP_MINUS_ONE));
-    shader[i++] = VTX_DWORD2(OFFSET(0),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD2(OFFSET(0),
 #if X_BYTE_ORDER == X_BIG_ENDIAN
                              ENDIAN_SWAP(SQ_ENDIAN_8IN32),
 #else
@@ -2435,9 +3954,9 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 			     MEGA_FETCH(1),
 			     ALT_CONST(0),
 			     BUFFER_INDEX_MODE(SQ_CF_INDEX_NONE));
-    shader[i++] = VTX_DWORD_PAD;
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD_PAD;
     /* 52/53 - src */
-    shader[i++] = VTX_DWORD0(VTX_INST(SQ_VTX_INST_FETCH),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD0(VTX_INST(SQ_VTX_INST_FETCH),
 			     FETCH_TYPE(SQ_VTX_FETCH_VERTEX_DATA),
 			     FETCH_WHOLE_QUAD(0),
 			     BUFFER_ID(0),
@@ -2445,7 +3964,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 			     SRC_REL(ABSOLUTE),
 			     SRC_SEL_X(SQ_SEL_X),
 			     MEGA_FETCH_COUNT(8));
-    shader[i++] = VTX_DWORD1_GPR(DST_GPR(0),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD1_GPR(DST_GPR(0),
 				 DST_REL(0),
 				 DST_SEL_X(SQ_SEL_X),
 				 DST_SEL_Y(SQ_SEL_Y),
@@ -2456,7 +3975,7 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 				 NUM_FORMAT_ALL(SQ_NUM_FORMAT_SCALED),
 				 FORMAT_COMP_ALL(SQ_FORMAT_COMP_SIGNED),
 				 SRF_MODE_ALL(SRF_MODE_ZERO_CLAMP_MINUS_ONE));
-    shader[i++] = VTX_DWORD2(OFFSET(8),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD2(OFFSET(8),
 #if X_BYTE_ORDER == X_BIG_ENDIAN
                              ENDIAN_SWAP(SQ_ENDIAN_8IN32),
 #else
@@ -2466,21 +3985,32 @@ int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 			     MEGA_FETCH(0),
                              ALT_CONST(0),
                              BUFFER_INDEX_MODE(SQ_CF_INDEX_NONE));
-    shader[i++] = VTX_DWORD_PAD;
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD_PAD;
+
+    if (variant & RADEON_COMP_STATIC) {
+	/* mask or non-mask sub, then the end of the program */
+	static const int mask_cf[] = { 3, 5, 2, 1 };
+	static const int non_mask_cf[] = { 9, 4, 2, 1 };
+
+	if (variant & RADEON_COMP_MASK_TEX)
+	    radeon_shader_flatten(shader, mask_cf, 2);
+	else
+	    radeon_shader_flatten(shader, non_mask_cf, 2);
+    }
 
     return i;
 }
 
 /* comp ps --------------------------------------- */
-int evergreen_comp_ps(RADEONChipFamily ChipSet, uint32_t *shader)
+int evergreen_comp_ps(RADEONChipFamily ChipSet, uint32_t *shader, uint32_t variant, int max)
 {
     int i = 0;
 
     /* 0 */
     /* call interp-fetch-mask if boolean1 == true */
-    shader[i++] = CF_DWORD0(ADDR(11),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(11),
 			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
                             CF_CONST(1),
                             COND(SQ_CF_COND_BOOL),
                             I_COUNT(0),
@@ -2492,9 +4022,9 @@ int evergreen_comp_ps(RADEONChipFamily ChipSet, uint32_t *shader)
 
     /* 1 */
     /* call read-constant-mask if boolean1 == false */
-    shader[i++] = CF_DWORD0(ADDR(14),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(14),
 			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
                             CF_CONST(1),
                             COND(SQ_CF_COND_NOT_BOOL),
                             I_COUNT(0),
@@ -2506,9 +4036,9 @@ int evergreen_comp_ps(RADEONChipFamily ChipSet, uint32_t *shader)
 
     /* 2 */
     /* call interp-fetch-src if boolean0 == true */
-    shader[i++] = CF_DWORD0(ADDR(6),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(6),
 			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
                             CF_CONST(0),
                             COND(SQ_CF_COND_BOOL),
                             I_COUNT(0),
@@ -2520,9 +4050,9 @@ int evergreen_comp_ps(RADEONChipFamily ChipSet, uint32_t *shader)
 
     /* 3 */
     /* call read-constant-src if boolean0 == false */
-    shader[i++] = CF_DWORD0(ADDR(9),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(9),
 			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
                             CF_CONST(0),
                             COND(SQ_CF_COND_NOT_BOOL),
                             I_COUNT(0),
@@ -2533,11 +4063,11 @@ int evergreen_comp_ps(RADEONChipFamily ChipSet, uint32_t *shader)
                             BARRIER(0));
     /* 4 */
     /* src IN mask (GPR2 := GPR1 .* GPR0) */
-    shader[i++] = CF_ALU_DWORD0(ADDR(16),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD0(ADDR(16),
 				KCACHE_BANK0(0),
 				KCACHE_BANK1(0),
 				KCACHE_MODE0(SQ_CF_KCACHE_NOP));
-    shader[i++] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
 				KCACHE_ADDR0(0),
 				KCACHE_ADDR1(0),
 				I_COUNT(4),
@@ -2548,13 +4078,13 @@ int evergreen_comp_ps(RADEONChipFamily ChipSet, uint32_t *shader)
 
     /* 5 */
     /* export pixel data */
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(CF_PIXEL_MRT0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(CF_PIXEL_MRT0),
 					  TYPE(SQ_EXPORT_PIXEL),
 					  RW_GPR(0),
 					  RW_REL(ABSOLUTE),
 					  INDEX_GPR(0),
 					  ELEM_SIZE(1));
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
 					       SRC_SEL_Y(SQ_SEL_Y),
 					       SRC_SEL_Z(SQ_SEL_Z),
 					       SRC_SEL_W(SQ_SEL_W),
@@ -2569,11 +4099,11 @@ int evergreen_comp_ps(RADEONChipFamily ChipSet, uint32_t *shader)
 
     /* 6 */
     /* interpolate src */
-    shader[i++] = CF_ALU_DWORD0(ADDR(20),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD0(ADDR(20),
 				KCACHE_BANK0(0),
 				KCACHE_BANK1(0),
 				KCACHE_MODE0(SQ_CF_KCACHE_NOP));
-    shader[i++] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
 				KCACHE_ADDR0(0),
 				KCACHE_ADDR1(0),
 				I_COUNT(4),
@@ -2584,9 +4114,9 @@ int evergreen_comp_ps(RADEONChipFamily ChipSet, uint32_t *shader)
 
     /* 7 */
     /* texture fetch src into GPR0 */
-    shader[i++] = CF_DWORD0(ADDR(24),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(24),
 			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
 			    CF_CONST(0),
 			    COND(SQ_CF_COND_ACTIVE),
 			    I_COUNT(1),
@@ -2598,9 +4128,9 @@ int evergreen_comp_ps(RADEONChipFamily ChipSet, uint32_t *shader)
 
     /* 8 */
     /* return */
-    shader[i++] = CF_DWORD0(ADDR(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(0),
 			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
 			    CF_CONST(0),
 			    COND(SQ_CF_COND_ACTIVE),
 			    I_COUNT(0),
@@ -2614,11 +4144,11 @@ int evergreen_comp_ps(RADEONChipFamily ChipSet, uint32_t *shader)
 
     /* 9 */
     /* read constants into GPR0 */
-    shader[i++] = CF_ALU_DWORD0(ADDR(26),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD0(ADDR(26),
 				KCACHE_BANK0(0),
 				KCACHE_BANK1(0),
 				KCACHE_MODE0(SQ_CF_KCACHE_LOCK_1));
-    shader[i++] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
 				KCACHE_ADDR0(0),
 				KCACHE_ADDR1(0),
 				I_COUNT(4),
@@ -2629,9 +4159,9 @@ int evergreen_comp_ps(RADEONChipFamily ChipSet, uint32_t *shader)
 
     /* 10 */
     /* return */
-    shader[i++] = CF_DWORD0(ADDR(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(0),
 			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
 			    CF_CONST(0),
 			    COND(SQ_CF_COND_ACTIVE),
 			    I_COUNT(0),
@@ -2645,11 +4175,11 @@ int evergreen_comp_ps(RADEONChipFamily ChipSet, uint32_t *shader)
 
     /* 11 */
     /* interpolate mask */
-    shader[i++] = CF_ALU_DWORD0(ADDR(30),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD0(ADDR(30),
 				KCACHE_BANK0(0),
 				KCACHE_BANK1(0),
 				KCACHE_MODE0(SQ_CF_KCACHE_NOP));
-    shader[i++] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
 				KCACHE_ADDR0(0),
 				KCACHE_ADDR1(0),
 				I_COUNT(4),
@@ -2660,9 +4190,9 @@ int evergreen_comp_ps(RADEONChipFamily ChipSet, uint32_t *shader)
 
     /* 12 */
     /* texture fetch mask into GPR1 */
-    shader[i++] = CF_DWORD0(ADDR(34),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(34),
 			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
 			    CF_CONST(0),
 			    COND(SQ_CF_COND_ACTIVE),
 			    I_COUNT(1),
@@ -2674,9 +4204,9 @@ int evergreen_comp_ps(RADEONChipFamily ChipSet, uint32_t *shader)
 
     /* 13 */
     /* return */
-    shader[i++] = CF_DWORD0(ADDR(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(0),
 			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
 			    CF_CONST(0),
 			    COND(SQ_CF_COND_ACTIVE),
 			    I_COUNT(0),
@@ -2690,11 +4220,11 @@ int evergreen_comp_ps(RADEONChipFamily ChipSet, uint32_t *shader)
 
     /* 14 */
     /* read constants into GPR1 */
-    shader[i++] = CF_ALU_DWORD0(ADDR(36),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD0(ADDR(36),
 				KCACHE_BANK0(0),
 				KCACHE_BANK1(0),
 				KCACHE_MODE0(SQ_CF_KCACHE_LOCK_1));
-    shader[i++] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
 				KCACHE_ADDR0(0),
 				KCACHE_ADDR1(0),
 				I_COUNT(4),
@@ -2705,9 +4235,9 @@ int evergreen_comp_ps(RADEONChipFamily ChipSet, uint32_t *shader)
 
     /* 15 */
     /* return */
-    shader[i++] = CF_DWORD0(ADDR(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(0),
 			    JUMPTABLE_SEL(SQ_CF_JUMPTABLE_SEL_CONST_A));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
 			    CF_CONST(0),
 			    COND(SQ_CF_COND_ACTIVE),
 			    I_COUNT(0),
@@ -2721,7 +4251,7 @@ int evergreen_comp_ps(RADEONChipFamily ChipSet, uint32_t *shader)
 
     /* 16 */
     /* MUL gpr[0].x gpr[0].x gpr[1].x */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_X),
 			     SRC0_NEG(0),
@@ -2732,7 +4262,7 @@ int evergreen_comp_ps(RADEONChipFamily ChipSet, uint32_t *shader)
 			     INDEX_MODE(SQ_INDEX_LOOP),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
 				 UPDATE_PRED(0),
@@ -2747,7 +4277,7 @@ int evergreen_comp_ps(RADEONChipFamily ChipSet, uint32_t *shader)
 
     /* 17 */
     /* MUL gpr[0].y gpr[0].y gpr[1].y */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_Y),
 			     SRC0_NEG(0),
@@ -2758,7 +4288,7 @@ int evergreen_comp_ps(RADEONChipFamily ChipSet, uint32_t *shader)
 			     INDEX_MODE(SQ_INDEX_LOOP),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
 				 UPDATE_PRED(0),
@@ -2772,7 +4302,7 @@ int evergreen_comp_ps(RADEONChipFamily ChipSet, uint32_t *shader)
 				 CLAMP(1));
     /* 18 */
     /* MUL gpr[0].z gpr[0].z gpr[1].z */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_Z),
 			     SRC0_NEG(0),
@@ -2783,7 +4313,7 @@ int evergreen_comp_ps(RADEONChipFamily ChipSet, uint32_t *shader)
 			     INDEX_MODE(SQ_INDEX_LOOP),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
 				 UPDATE_PRED(0),
@@ -2797,7 +4327,7 @@ int evergreen_comp_ps(RADEONChipFamily ChipSet, uint32_t *shader)
 				 CLAMP(1));
     /* 19 */
     /* MUL gpr[0].w gpr[0].w gpr[1].w */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_W),
 			     SRC0_NEG(0),
@@ -2808,7 +4338,7 @@ int evergreen_comp_ps(RADEONChipFamily ChipSet, uint32_t *shader)
 			     INDEX_MODE(SQ_INDEX_LOOP),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(1));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
 				 UPDATE_PRED(0),
@@ -2823,7 +4353,7 @@ int evergreen_comp_ps(RADEONChipFamily ChipSet, uint32_t *shader)
 
     /* 20 */
     /* INTERP_XY GPR0.x, GPR0.y PARAM0.x */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_Y),
 			     SRC0_NEG(0),
@@ -2834,7 +4364,7 @@ int evergreen_comp_ps(RADEONChipFamily ChipSet, uint32_t *shader)
 			     INDEX_MODE(SQ_INDEX_AR_X),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
 				 UPDATE_PRED(0),
@@ -2848,7 +4378,7 @@ int evergreen_comp_ps(RADEONChipFamily ChipSet, uint32_t *shader)
 				 CLAMP(0));
     /* 21 */
     /* INTERP_XY GPR0.y, GPR0.x PARAM0.x */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_X),
 			     SRC0_NEG(0),
@@ -2859,7 +4389,7 @@ int evergreen_comp_ps(RADEONChipFamily ChipSet, uint32_t *shader)
 			     INDEX_MODE(SQ_INDEX_AR_X),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
 				 UPDATE_PRED(0),
@@ -2873,7 +4403,7 @@ int evergreen_comp_ps(RADEONChipFamily ChipSet, uint32_t *shader)
 				 CLAMP(0));
     /* 22 */
     /* INTERP_XY GPR0.z, GPR0.y PARAM0.x */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_Y),
 			     SRC0_NEG(0),
@@ -2884,7 +4414,7 @@ int evergreen_comp_ps(RADEONChipFamily ChipSet, uint32_t *shader)
 			     INDEX_MODE(SQ_INDEX_AR_X),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
 				 UPDATE_PRED(0),
@@ -2899,7 +4429,7 @@ int evergreen_comp_ps(RADEONChipFamily ChipSet, uint32_t *shader)
 
     /* 23 */
     /* INTERP_XY GPR0.w, GPR0.x PARAM0.x */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_X),
 			     SRC0_NEG(0),
@@ -2910,7 +4440,7 @@ int evergreen_comp_ps(RADEONChipFamily ChipSet, uint32_t *shader)
 			     INDEX_MODE(SQ_INDEX_AR_X),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(1));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
 				 UPDATE_PRED(0),
@@ -2925,7 +4455,7 @@ int evergreen_comp_ps(RADEONChipFamily ChipSet, uint32_t *shader)
 
     /* 24/25 */
     /* SAMPLE RID=0 GPR0, GPR0 */
-    shader[i++] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
 			     INST_MOD(0),
 			     FETCH_WHOLE_QUAD(0),
 			     RESOURCE_ID(0),
@@ -2934,7 +4464,7 @@ int evergreen_comp_ps(RADEONChipFamily ChipSet, uint32_t *shader)
 			     ALT_CONST(0),
 			     RESOURCE_INDEX_MODE(SQ_CF_INDEX_NONE),
 			     SAMPLER_INDEX_MODE(SQ_CF_INDEX_NONE));
-    shader[i++] = TEX_DWORD1(DST_GPR(0),
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD1(DST_GPR(0),
 			     DST_REL(ABSOLUTE),
 			     DST_SEL_X(SQ_SEL_X),
 			     DST_SEL_Y(SQ_SEL_Y),
@@ -2945,7 +4475,7 @@ int evergreen_comp_ps(RADEONChipFamily ChipSet, uint32_t *shader)
 			     COORD_TYPE_Y(TEX_NORMALIZED),
 			     COORD_TYPE_Z(TEX_NORMALIZED),
 			     COORD_TYPE_W(TEX_NORMALIZED));
-    shader[i++] = TEX_DWORD2(OFFSET_X(0),
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD2(OFFSET_X(0),
 			     OFFSET_Y(0),
 			     OFFSET_Z(0),
 			     SAMPLER_ID(0),
@@ -2953,11 +4483,11 @@ int evergreen_comp_ps(RADEONChipFamily ChipSet, uint32_t *shader)
 			     SRC_SEL_Y(SQ_SEL_Y),
 			     SRC_SEL_Z(SQ_SEL_0),
 			     SRC_SEL_W(SQ_SEL_1));
-    shader[i++] = TEX_DWORD_PAD;
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD_PAD;
 
     /* 26 */
     /* MOV GPR0.x, KC4.x */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 4),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 4),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_X),
 			     SRC0_NEG(0),
@@ -2968,7 +4498,7 @@ int evergreen_comp_ps(RADEONChipFamily ChipSet, uint32_t *shader)
 			     INDEX_MODE(SQ_INDEX_AR_X),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
 				 UPDATE_PRED(0),
@@ -2983,7 +4513,7 @@ int evergreen_comp_ps(RADEONChipFamily ChipSet, uint32_t *shader)
 
     /* 27 */
     /* MOV GPR0.y, KC4.y */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 4),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 4),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_Y),
 			     SRC0_NEG(0),
@@ -2994,7 +4524,7 @@ int evergreen_comp_ps(RADEONChipFamily ChipSet, uint32_t *shader)
 			     INDEX_MODE(SQ_INDEX_AR_X),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
 				 UPDATE_PRED(0),
@@ -3009,7 +4539,7 @@ int evergreen_comp_ps(RADEONChipFamily ChipSet, uint32_t *shader)
 
     /* 28  */
     /* MOV GPR0.z, KC4.z */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 4),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 4),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_Z),
 			     SRC0_NEG(0),
@@ -3020,7 +4550,7 @@ int evergreen_comp_ps(RADEONChipFamily ChipSet, uint32_t *shader)
 			     INDEX_MODE(SQ_INDEX_AR_X),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
 				 UPDATE_PRED(0),
@@ -3035,7 +4565,7 @@ int evergreen_comp_ps(RADEONChipFamily ChipSet, uint32_t *shader)
 
     /* 29 */
     /* MOV GPR0.w, KC4.w */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 4),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 4),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_W),
 			     SRC0_NEG(0),
@@ -3046,7 +4576,7 @@ int evergreen_comp_ps(RADEONChipFamily ChipSet, uint32_t *shader)
 			     INDEX_MODE(SQ_INDEX_AR_X),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(1));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
 				 UPDATE_PRED(0),
@@ -3061,7 +4591,7 @@ int evergreen_comp_ps(RADEONChipFamily ChipSet, uint32_t *shader)
 
     /* 30 */
     /* INTERP_XY GPR1.x, PARAM1 */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_Y),
 			     SRC0_NEG(0),
@@ -3072,7 +4602,7 @@ int evergreen_comp_ps(RADEONChipFamily ChipSet, uint32_t *shader)
 			     INDEX_MODE(SQ_INDEX_AR_X),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
 				 UPDATE_PRED(0),
@@ -3086,7 +4616,7 @@ int evergreen_comp_ps(RADEONChipFamily ChipSet, uint32_t *shader)
 				 CLAMP(0));
     /* 31 */
     /* INTERP_XY GPR1.y, PARAM1 */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_X),
 			     SRC0_NEG(0),
@@ -3097,7 +4627,7 @@ int evergreen_comp_ps(RADEONChipFamily ChipSet, uint32_t *shader)
 			     INDEX_MODE(SQ_INDEX_AR_X),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
 				 UPDATE_PRED(0),
@@ -3111,7 +4641,7 @@ int evergreen_comp_ps(RADEONChipFamily ChipSet, uint32_t *shader)
 				 CLAMP(0));
     /* 32 */
     /* INTERP_XY GPR1.z, PARAM1 */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_Y),
 			     SRC0_NEG(0),
@@ -3122,7 +4652,7 @@ int evergreen_comp_ps(RADEONChipFamily ChipSet, uint32_t *shader)
 			     INDEX_MODE(SQ_INDEX_AR_X),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
 				 UPDATE_PRED(0),
@@ -3136,7 +4666,7 @@ int evergreen_comp_ps(RADEONChipFamily ChipSet, uint32_t *shader)
 				 CLAMP(0));
     /* 33 */
     /* INTERP_XY GPR1.w, PARAM1 */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_X),
 			     SRC0_NEG(0),
@@ -3147,7 +4677,7 @@ int evergreen_comp_ps(RADEONChipFamily ChipSet, uint32_t *shader)
 			     INDEX_MODE(SQ_INDEX_AR_X),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(1));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
 				 UPDATE_PRED(0),
@@ -3162,7 +4692,7 @@ int evergreen_comp_ps(RADEONChipFamily ChipSet, uint32_t *shader)
 
     /* 34/35 */
     /* SAMPLE RID=1 GPR1, GPR1 */
-    shader[i++] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
 			     INST_MOD(0),
 			     FETCH_WHOLE_QUAD(0),
 			     RESOURCE_ID(1),
@@ -3171,7 +4701,7 @@ int evergreen_comp_ps(RADEONChipFamily ChipSet, uint32_t *shader)
 			     ALT_CONST(0),
 			     RESOURCE_INDEX_MODE(SQ_CF_INDEX_NONE),
 			     SAMPLER_INDEX_MODE(SQ_CF_INDEX_NONE));
-    shader[i++] = TEX_DWORD1(DST_GPR(1),
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD1(DST_GPR(1),
 			     DST_REL(ABSOLUTE),
 			     DST_SEL_X(SQ_SEL_X),
 			     DST_SEL_Y(SQ_SEL_Y),
@@ -3182,7 +4712,7 @@ int evergreen_comp_ps(RADEONChipFamily ChipSet, uint32_t *shader)
 			     COORD_TYPE_Y(TEX_NORMALIZED),
 			     COORD_TYPE_Z(TEX_NORMALIZED),
 			     COORD_TYPE_W(TEX_NORMALIZED));
-    shader[i++] = TEX_DWORD2(OFFSET_X(0),
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD2(OFFSET_X(0),
 			     OFFSET_Y(0),
 			     OFFSET_Z(0),
 			     SAMPLER_ID(1),
@@ -3190,11 +4720,11 @@ int evergreen_comp_ps(RADEONChipFamily ChipSet, uint32_t *shader)
 			     SRC_SEL_Y(SQ_SEL_Y),
 			     SRC_SEL_Z(SQ_SEL_0),
 			     SRC_SEL_W(SQ_SEL_1));
-    shader[i++] = TEX_DWORD_PAD;
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD_PAD;
 
     /* 36 */
     /* MOV GPR1.x, KC5.x */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 5),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 5),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_X),
 			     SRC0_NEG(0),
@@ -3205,7 +4735,7 @@ int evergreen_comp_ps(RADEONChipFamily ChipSet, uint32_t *shader)
 			     INDEX_MODE(SQ_INDEX_AR_X),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
 				 UPDATE_PRED(0),
@@ -3220,7 +4750,7 @@ int evergreen_comp_ps(RADEONChipFamily ChipSet, uint32_t *shader)
 
     /* 37 */
     /* MOV GPR1.y, KC5.y */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 5),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 5),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_Y),
 			     SRC0_NEG(0),
@@ -3231,7 +4761,7 @@ int evergreen_comp_ps(RADEONChipFamily ChipSet, uint32_t *shader)
 			     INDEX_MODE(SQ_INDEX_AR_X),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
 				 UPDATE_PRED(0),
@@ -3246,7 +4776,7 @@ int evergreen_comp_ps(RADEONChipFamily ChipSet, uint32_t *shader)
 
     /* 38 */
     /* MOV GPR1.z, KC5.z */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 5),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 5),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_Z),
 			     SRC0_NEG(0),
@@ -3257,7 +4787,7 @@ int evergreen_comp_ps(RADEONChipFamily ChipSet, uint32_t *shader)
 			     INDEX_MODE(SQ_INDEX_AR_X),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
 				 UPDATE_PRED(0),
@@ -3272,7 +4802,7 @@ int evergreen_comp_ps(RADEONChipFamily ChipSet, uint32_t *shader)
 
     /* 39 */
     /* MOV GPR1.w, KC5.w */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 5),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_KCACHE0_BASE + 5),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_W),
 			     SRC0_NEG(0),
@@ -3283,7 +4813,7 @@ int evergreen_comp_ps(RADEONChipFamily ChipSet, uint32_t *shader)
 			     INDEX_MODE(SQ_INDEX_AR_X),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(1));
-    shader[i++] = ALU_DWORD1_OP2(SRC0_ABS(0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
 				 UPDATE_PRED(0),
@@ -3296,5 +4826,30 @@ int evergreen_comp_ps(RADEONChipFamily ChipSet, uint32_t *shader)
 				 DST_ELEM(ELEM_W),
 				 CLAMP(1));
 
+    if (variant & RADEON_COMP_STATIC) {
+	/* mask and src subroutines, then src IN mask and the export; with
+	 * no mask, src goes out as it is */
+	int cf[6], n = 0;
+
+	if (variant & RADEON_COMP_MASK) {
+	    if (variant & RADEON_COMP_MASK_TEX) {
+		cf[n++] = 11; cf[n++] = 2;
+	    } else {
+		cf[n++] = 14; cf[n++] = 1;
+	    }
+	}
+	if (variant & RADEON_COMP_SRC_TEX) {
+	    cf[n++] = 6; cf[n++] = 2;
+	} else {
+	    cf[n++] = 9; cf[n++] = 1;
+	}
+	if (variant & RADEON_COMP_MASK) {
+	    cf[n++] = 4; cf[n++] = 2;
+	} else {
+	    cf[n++] = 5; cf[n++] = 1;
+	}
+	radeon_shader_flatten(shader, cf, n / 2);
+    }
+
     return i;
 }
@@ -277,16 +277,17 @@
 		 ((ssx) << 20) | ((ssy) << 23) | ((ssz) << 26) | ((ssw) << 29)))
 #define TEX_DWORD_PAD cpu_to_le32(0x00000000)
 
-extern int evergreen_solid_vs(RADEONChipFamily ChipSet, uint32_t* vs);
-extern int evergreen_solid_ps(RADEONChipFamily ChipSet, uint32_t* ps);
+extern int evergreen_solid_vs(RADEONChipFamily ChipSet, uint32_t* vs, uint32_t variant, int max);
+extern int evergreen_solid_ps(RADEONChipFamily ChipSet, uint32_t* ps, uint32_t variant, int max);
 
-extern int evergreen_copy_vs(RADEONChipFamily ChipSet, uint32_t* vs);
-extern int evergreen_copy_ps(RADEONChipFamily ChipSet, uint32_t* ps);
+extern int evergreen_copy_vs(RADEONChipFamily ChipSet, uint32_t* vs, uint32_t variant, int max);
+extern int evergreen_copy_ps(RADEONChipFamily ChipSet, uint32_t* ps, uint32_t variant, int max);
 
-extern int evergreen_xv_vs(RADEONChipFamily ChipSet, uint32_t* shader);
-extern int evergreen_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader);
+extern int evergreen_xv_vs(RADEONChipFamily ChipSet, uint32_t *shader, uint32_t variant, int max);
+extern int evergreen_xv_ps(RADEONChipFamily ChipSet, uint32_t *shader, uint32_t variant, int max);
+extern int evergreen_xv_bicubic_ps(RADEONChipFamily ChipSet, uint32_t *shader, uint32_t variant, int max);
 
-extern int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* vs);
-extern int evergreen_comp_ps(RADEONChipFamily ChipSet, uint32_t* ps);
+extern int evergreen_comp_vs(RADEONChipFamily ChipSet, uint32_t* vs, uint32_t variant, int max);
+extern int evergreen_comp_ps(RADEONChipFamily ChipSet, uint32_t* ps, uint32_t variant, int max);
 
 #endif
@@ -335,6 +335,19 @@ evergreen_draw_auto(ScrnInfoPtr pScrn, draw_config_t *draw_conf);
 
 void evergreen_finish_op(ScrnInfoPtr pScrn, int vtx_size);
 
+/* smallest transfer sent to the async DMA engine */
+#define EVERGREEN_DMA_MIN_BYTES (128 * 1024)
+
+Bool
+evergreen_dma_wanted(ScrnInfoPtr pScrn, uint32_t line_bytes, int h, Bool vsync);
+Bool
+evergreen_dma_copy(ScrnInfoPtr pScrn,
+		   struct radeon_bo *dst_bo, uint32_t dst_domain,
+		   uint32_t dst_offset, uint32_t dst_pitch,
+		   struct radeon_bo *src_bo, uint32_t src_domain,
+		   uint32_t src_offset, uint32_t src_pitch,
+		   uint32_t line_bytes, int h);
+
 extern Bool
 R600SetAccelState(ScrnInfoPtr pScrn,
 		  struct r600_accel_object *src0,
@@ -343,6 +356,12 @@ R600SetAccelState(ScrnInfoPtr pScrn,
 		  uint32_t vs_offset, uint32_t ps_offset,
 		  int rop, Pixel planemask);
 
+extern Bool
+EVERGREENCopyRect(ScrnInfoPtr pScrn,
+	          struct r600_accel_object *src_obj,
+	          struct r600_accel_object *dst_obj,
+	          int srcX, int srcY, int dstX, int dstY, int w, int h);
+
 extern Bool RADEONPrepareAccess_CS(PixmapPtr pPix, int index);
 extern void RADEONFinishAccess_CS(PixmapPtr pPix, int index);
 extern void *RADEONEXACreatePixmap(ScreenPtr pScreen, int size, int align);
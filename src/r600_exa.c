@@ -151,6 +151,7 @@ R600PrepareSolid(PixmapPtr pPix, int alu, Pixel pm, Pixel fg)
 	RADEON_FALLBACK(("invalid planemask\n"));
 
     dst.bo = radeon_get_pixmap_bo(pPix);
+    dst.offset = radeon_get_pixmap_offset(pPix);
     dst.tiling_flags = radeon_get_pixmap_tiling(pPix);
     dst.surface = radeon_get_pixmap_surface(pPix);
 
@@ -158,7 +159,7 @@ R600PrepareSolid(PixmapPtr pPix, int alu, Pixel pm, Pixel fg)
     dst.width = pPix->drawable.width;
     dst.height = pPix->drawable.height;
     dst.bpp = pPix->drawable.bitsPerPixel;
-    dst.domain = RADEON_GEM_DOMAIN_VRAM;
+    dst.domain = radeon_pixmap_write_domain(pPix);
 
     if (!R600SetAccelState(pScrn,
 			   NULL,
@@ -202,7 +203,7 @@ R600PrepareSolid(PixmapPtr pPix, int alu, Pixel pm, Pixel fg)
     cb_conf.id = 0;
     cb_conf.w = accel_state->dst_obj.pitch;
     cb_conf.h = accel_state->dst_obj.height;
-    cb_conf.base = 0;
+    cb_conf.base = accel_state->dst_obj.offset;
     cb_conf.bo = accel_state->dst_obj.bo;
     cb_conf.surface = accel_state->dst_obj.surface;
 
@@ -377,8 +378,8 @@ R600DoPrepareCopy(ScrnInfoPtr pScrn)
     tex_res.pitch               = accel_state->src_obj[0].pitch;
     tex_res.depth               = 0;
     tex_res.dim                 = SQ_TEX_DIM_2D;
-    tex_res.base                = 0;
-    tex_res.mip_base            = 0;
+    tex_res.base                = accel_state->src_obj[0].offset;
+    tex_res.mip_base            = accel_state->src_obj[0].offset;
     tex_res.size                = accel_state->src_size[0];
     tex_res.bo                  = accel_state->src_obj[0].bo;
     tex_res.mip_bo              = accel_state->src_obj[0].bo;
@@ -425,7 +426,7 @@ R600DoPrepareCopy(ScrnInfoPtr pScrn)
     cb_conf.id = 0;
     cb_conf.w = accel_state->dst_obj.pitch;
     cb_conf.h = accel_state->dst_obj.height;
-    cb_conf.base = 0;
+    cb_conf.base = accel_state->dst_obj.offset;
     cb_conf.bo = accel_state->dst_obj.bo;
     cb_conf.surface = accel_state->dst_obj.surface;
     if (accel_state->dst_obj.bpp == 8) {
@@ -511,6 +512,31 @@ R600AppendCopyVertex(ScrnInfoPtr pScrn,
     radeon_vbo_commit(pScrn, &accel_state->vbo);
 }
 
+/* Copy a rectangle between two surfaces, used to tile textured video planes */
+Bool
+R600CopyRect(ScrnInfoPtr pScrn,
+	     struct r600_accel_object *src_obj,
+	     struct r600_accel_object *dst_obj,
+	     int srcX, int srcY, int dstX, int dstY, int w, int h)
+{
+    RADEONInfoPtr info = RADEONPTR(pScrn);
+    struct radeon_accel_state *accel_state = info->accel_state;
+
+    if (!R600SetAccelState(pScrn,
+			   src_obj,
+			   NULL,
+			   dst_obj,
+			   accel_state->copy_vs_offset, accel_state->copy_ps_offset,
+			   3, 0xffffffff))
+	return FALSE;
+
+    R600DoPrepareCopy(pScrn);
+    R600AppendCopyVertex(pScrn, srcX, srcY, dstX, dstY, w, h);
+    R600DoCopy(pScrn);
+
+    return TRUE;
+}
+
 static Bool
 R600PrepareCopy(PixmapPtr pSrc,   PixmapPtr pDst,
 		int xdir, int ydir,
@@ -535,12 +561,15 @@ R600PrepareCopy(PixmapPtr pSrc,   PixmapPtr pDst,
     accel_state->same_surface = FALSE;
 
     src_obj.bo = radeon_get_pixmap_bo(pSrc);
+    src_obj.offset = radeon_get_pixmap_offset(pSrc);
     dst_obj.bo = radeon_get_pixmap_bo(pDst);
+    dst_obj.offset = radeon_get_pixmap_offset(pDst);
     dst_obj.tiling_flags = radeon_get_pixmap_tiling(pDst);
     src_obj.tiling_flags = radeon_get_pixmap_tiling(pSrc);
     src_obj.surface = radeon_get_pixmap_surface(pSrc);
     dst_obj.surface = radeon_get_pixmap_surface(pDst);
-    if (radeon_get_pixmap_bo(pSrc) == radeon_get_pixmap_bo(pDst))
+    if (radeon_get_pixmap_bo(pSrc) == radeon_get_pixmap_bo(pDst) &&
+	src_obj.offset == dst_obj.offset)
 	accel_state->same_surface = TRUE;
 
     src_obj.width = pSrc->drawable.width;
@@ -551,10 +580,7 @@ R600PrepareCopy(PixmapPtr pSrc,   PixmapPtr pDst,
     dst_obj.width = pDst->drawable.width;
     dst_obj.height = pDst->drawable.height;
     dst_obj.bpp = pDst->drawable.bitsPerPixel;
-    if (radeon_get_pixmap_shared(pDst) == TRUE) {
-	dst_obj.domain = RADEON_GEM_DOMAIN_GTT;
-    } else
-	dst_obj.domain = RADEON_GEM_DOMAIN_VRAM;
+    dst_obj.domain = radeon_pixmap_write_domain(pDst);
 
     if (!R600SetAccelState(pScrn,
 			   &src_obj,
@@ -649,11 +675,13 @@ R600Copy(PixmapPtr pDst,
 	uint32_t orig_src_tiling_flags = accel_state->src_obj[0].tiling_flags;
 	uint32_t orig_dst_tiling_flags = accel_state->dst_obj.tiling_flags;
 	struct radeon_bo *orig_bo = accel_state->dst_obj.bo;
+	uint32_t orig_offset = accel_state->dst_obj.offset;
 	int orig_rop = accel_state->rop;
 
 	/* src to tmp */
 	accel_state->dst_obj.domain = RADEON_GEM_DOMAIN_VRAM;
 	accel_state->dst_obj.bo = accel_state->copy_area_bo;
+	accel_state->dst_obj.offset = 0;
 	accel_state->dst_obj.tiling_flags = 0;
 	accel_state->rop = 3;
 	R600DoPrepareCopy(pScrn);
@@ -663,9 +691,11 @@ R600Copy(PixmapPtr pDst,
 	/* tmp to dst */
 	accel_state->src_obj[0].domain = RADEON_GEM_DOMAIN_VRAM;
 	accel_state->src_obj[0].bo = accel_state->copy_area_bo;
+	accel_state->src_obj[0].offset = 0;
 	accel_state->src_obj[0].tiling_flags = 0;
 	accel_state->dst_obj.domain = orig_dst_domain;
 	accel_state->dst_obj.bo = orig_bo;
+	accel_state->dst_obj.offset = orig_offset;
 	accel_state->dst_obj.tiling_flags = orig_dst_tiling_flags;
 	accel_state->rop = orig_rop;
 	R600DoPrepareCopy(pScrn);
@@ -675,6 +705,7 @@ R600Copy(PixmapPtr pDst,
 	/* restore state */
 	accel_state->src_obj[0].domain = orig_src_domain;
 	accel_state->src_obj[0].bo = orig_bo;
+	accel_state->src_obj[0].offset = orig_offset;
 	accel_state->src_obj[0].tiling_flags = orig_src_tiling_flags;
     } else
 	R600AppendCopyVertex(pScrn, srcX, srcY, dstX, dstY, w, h);
@@ -869,8 +900,8 @@ static Bool R600TextureSetup(PicturePtr pPict, PixmapPtr pPix,
     tex_res.pitch               = accel_state->src_obj[unit].pitch;
     tex_res.depth               = 0;
     tex_res.dim                 = SQ_TEX_DIM_2D;
-    tex_res.base                = 0;
-    tex_res.mip_base            = 0;
+    tex_res.base                = accel_state->src_obj[unit].offset;
+    tex_res.mip_base            = accel_state->src_obj[unit].offset;
     tex_res.size                = accel_state->src_size[unit];
     tex_res.format              = R600TexFormats[i].card_fmt;
     tex_res.bo                  = accel_state->src_obj[unit].bo;
@@ -1160,6 +1191,24 @@ static Bool R600CheckComposite(int op, PicturePtr pSrcPicture, PicturePtr pMaskP
 
 }
 
+/* The straight-line comp_vs/comp_ps for variant, or the generic ones
+ * (variant 0) if the shader cache is full
+ */
+static uint32_t R600CompositeShaders(ScrnInfoPtr pScrn, uint32_t variant,
+				     uint32_t *vs_offset, uint32_t *ps_offset)
+{
+    struct radeon_accel_state *accel_state = RADEONPTR(pScrn)->accel_state;
+
+    if (radeon_shader_get(pScrn, R600_comp_vs, variant & RADEON_COMP_VS_KEY,
+			  vs_offset) &&
+	radeon_shader_get(pScrn, R600_comp_ps, variant, ps_offset))
+	return variant;
+
+    *vs_offset = accel_state->comp_vs_offset;
+    *ps_offset = accel_state->comp_ps_offset;
+    return 0;
+}
+
 static Bool R600PrepareComposite(int op, PicturePtr pSrcPicture,
 				 PicturePtr pMaskPicture, PicturePtr pDstPicture,
 				 PixmapPtr pSrc, PixmapPtr pMask, PixmapPtr pDst)
@@ -1172,6 +1221,7 @@ static Bool R600PrepareComposite(int op, PicturePtr pSrcPicture,
     cb_config_t cb_conf;
     shader_config_t vs_conf, ps_conf;
     struct r600_accel_object src_obj, mask_obj, dst_obj;
+    uint32_t variant, vs_offset, ps_offset;
 
     if (pDst->drawable.bitsPerPixel < 8 || (pSrc && pSrc->drawable.bitsPerPixel < 8))
 	return FALSE;
@@ -1183,7 +1233,9 @@ static Bool R600PrepareComposite(int op, PicturePtr pSrcPicture,
     }
 
     dst_obj.bo = radeon_get_pixmap_bo(pDst);
+    dst_obj.offset = radeon_get_pixmap_offset(pDst);
     src_obj.bo = radeon_get_pixmap_bo(pSrc);
+    src_obj.offset = radeon_get_pixmap_offset(pSrc);
     dst_obj.tiling_flags = radeon_get_pixmap_tiling(pDst);
     src_obj.tiling_flags = radeon_get_pixmap_tiling(pSrc);
     dst_obj.surface = radeon_get_pixmap_surface(pDst);
@@ -1200,10 +1252,7 @@ static Bool R600PrepareComposite(int op, PicturePtr pSrcPicture,
     dst_obj.width = pDst->drawable.width;
     dst_obj.height = pDst->drawable.height;
     dst_obj.bpp = pDst->drawable.bitsPerPixel;
-    if (radeon_get_pixmap_shared(pDst) == TRUE)
-	dst_obj.domain = RADEON_GEM_DOMAIN_GTT;
-    else
-	dst_obj.domain = RADEON_GEM_DOMAIN_VRAM;
+    dst_obj.domain = radeon_pixmap_write_domain(pDst);
 
     if (pMaskPicture) {
 	if (!pMask) {
@@ -1216,6 +1265,7 @@ static Bool R600PrepareComposite(int op, PicturePtr pSrcPicture,
 	}
 
 	mask_obj.bo = radeon_get_pixmap_bo(pMask);
+	mask_obj.offset = radeon_get_pixmap_offset(pMask);
 	mask_obj.tiling_flags = radeon_get_pixmap_tiling(pMask);
 	mask_obj.surface = radeon_get_pixmap_surface(pMask);
 
@@ -1226,11 +1276,17 @@ static Bool R600PrepareComposite(int op, PicturePtr pSrcPicture,
 	mask_obj.bpp = pMask->drawable.bitsPerPixel;
 	mask_obj.domain = RADEON_GEM_DOMAIN_VRAM | RADEON_GEM_DOMAIN_GTT;
 
+	/* solid sources and masks are scratch pixmaps, always textured */
+	variant = R600CompositeShaders(pScrn,
+				       RADEON_COMP_STATIC | RADEON_COMP_SRC_TEX |
+				       RADEON_COMP_MASK | RADEON_COMP_MASK_TEX,
+				       &vs_offset, &ps_offset);
+
 	if (!R600SetAccelState(pScrn,
 			       &src_obj,
 			       &mask_obj,
 			       &dst_obj,
-			       accel_state->comp_vs_offset, accel_state->comp_ps_offset,
+			       vs_offset, ps_offset,
 			       3, 0xffffffff))
 	    return FALSE;
 
@@ -1246,11 +1302,15 @@ static Bool R600PrepareComposite(int op, PicturePtr pSrcPicture,
 	    accel_state->src_alpha = FALSE;
 	}
     } else {
+	variant = R600CompositeShaders(pScrn,
+				       RADEON_COMP_STATIC | RADEON_COMP_SRC_TEX,
+				       &vs_offset, &ps_offset);
+
 	if (!R600SetAccelState(pScrn,
 			       &src_obj,
 			       NULL,
 			       &dst_obj,
-			       accel_state->comp_vs_offset, accel_state->comp_ps_offset,
+			       vs_offset, ps_offset,
 			       3, 0xffffffff))
 	    return FALSE;
 
@@ -1292,12 +1352,15 @@ static Bool R600PrepareComposite(int op, PicturePtr pSrcPicture,
     } else
         accel_state->is_transform[1] = FALSE;
 
-    if (pMask) {
-	r600_set_bool_consts(pScrn, SQ_BOOL_CONST_vs, (1 << 0));
-	r600_set_bool_consts(pScrn, SQ_BOOL_CONST_ps, (1 << 0));
-    } else {
-	r600_set_bool_consts(pScrn, SQ_BOOL_CONST_vs, (0 << 0));
-	r600_set_bool_consts(pScrn, SQ_BOOL_CONST_ps, (0 << 0));
+    /* only the generic programs look at the bool consts */
+    if (!(variant & RADEON_COMP_STATIC)) {
+	if (pMask) {
+	    r600_set_bool_consts(pScrn, SQ_BOOL_CONST_vs, (1 << 0));
+	    r600_set_bool_consts(pScrn, SQ_BOOL_CONST_ps, (1 << 0));
+	} else {
+	    r600_set_bool_consts(pScrn, SQ_BOOL_CONST_vs, (0 << 0));
+	    r600_set_bool_consts(pScrn, SQ_BOOL_CONST_ps, (0 << 0));
+	}
     }
 
     /* Shader */
@@ -1321,7 +1384,7 @@ static Bool R600PrepareComposite(int op, PicturePtr pSrcPicture,
     cb_conf.id = 0;
     cb_conf.w = accel_state->dst_obj.pitch;
     cb_conf.h = accel_state->dst_obj.height;
-    cb_conf.base = 0;
+    cb_conf.base = accel_state->dst_obj.offset;
     cb_conf.format = dst_format;
     cb_conf.bo = accel_state->dst_obj.bo;
     cb_conf.surface = accel_state->dst_obj.surface;
@@ -1532,6 +1595,7 @@ R600UploadToScreenCS(PixmapPtr pDst, int x, int y, int w, int h,
     driver_priv = exaGetPixmapDriverPrivate(pDst);
     if (!driver_priv || !driver_priv->bo)
 	return FALSE;
+    radeon_pixmap_transfer(pDst, w * h * (bpp / 8), TRUE);
 
     /* If we know the BO won't be busy, don't bother with a scratch */
     copy_dst = driver_priv->bo;
@@ -1562,6 +1626,7 @@ R600UploadToScreenCS(PixmapPtr pDst, int x, int y, int w, int h,
     src_obj.bpp = bpp;
     src_obj.domain = RADEON_GEM_DOMAIN_GTT;
     src_obj.bo = scratch;
+    src_obj.offset = 0;
     src_obj.tiling_flags = 0;
     src_obj.surface = NULL;
 
@@ -1569,8 +1634,9 @@ R600UploadToScreenCS(PixmapPtr pDst, int x, int y, int w, int h,
     dst_obj.width = pDst->drawable.width;
     dst_obj.height = pDst->drawable.height;
     dst_obj.bpp = bpp;
-    dst_obj.domain = RADEON_GEM_DOMAIN_VRAM;
+    dst_obj.domain = radeon_get_pixmap_domain(pDst);
     dst_obj.bo = radeon_get_pixmap_bo(pDst);
+    dst_obj.offset = radeon_get_pixmap_offset(pDst);
     dst_obj.tiling_flags = radeon_get_pixmap_tiling(pDst);
     dst_obj.surface = radeon_get_pixmap_surface(pDst);
 
@@ -1599,7 +1665,7 @@ copy:
     size = w * bpp / 8;
     dst = copy_dst->ptr;
     if (copy_dst == driver_priv->bo)
-	dst += y * copy_pitch + x * bpp / 8;
+	dst += driver_priv->offset + y * copy_pitch + x * bpp / 8;
     for (i = 0; i < h; i++) {
         memcpy(dst + i * copy_pitch, src, size);
         src += src_pitch;
@@ -1650,6 +1716,7 @@ R600DownloadFromScreenCS(PixmapPtr pSrc, int x, int y, int w,
     driver_priv = exaGetPixmapDriverPrivate(pSrc);
     if (!driver_priv || !driver_priv->bo)
 	return FALSE;
+    radeon_pixmap_transfer(pSrc, w * h * (bpp / 8), FALSE);
 
     /* If we know the BO won't end up in VRAM anyway, don't bother with a scratch */
     copy_src = driver_priv->bo;
@@ -1697,6 +1764,7 @@ R600DownloadFromScreenCS(PixmapPtr pSrc, int x, int y, int w,
     src_obj.bpp = bpp;
     src_obj.domain = RADEON_GEM_DOMAIN_VRAM | RADEON_GEM_DOMAIN_GTT;
     src_obj.bo = radeon_get_pixmap_bo(pSrc);
+    src_obj.offset = radeon_get_pixmap_offset(pSrc);
     src_obj.tiling_flags = radeon_get_pixmap_tiling(pSrc);
     src_obj.surface = radeon_get_pixmap_surface(pSrc);
 
@@ -1704,6 +1772,7 @@ R600DownloadFromScreenCS(PixmapPtr pSrc, int x, int y, int w,
     dst_obj.width = w;
     dst_obj.height = h;
     dst_obj.bo = scratch;
+    dst_obj.offset = 0;
     dst_obj.bpp = bpp;
     dst_obj.domain = RADEON_GEM_DOMAIN_GTT;
     dst_obj.tiling_flags = 0;
@@ -1739,7 +1808,7 @@ copy:
     r = TRUE;
     w *= bpp / 8;
     if (copy_src == driver_priv->bo)
-	size = y * copy_pitch + x * bpp / 8;
+	size = driver_priv->offset + y * copy_pitch + x * bpp / 8;
     else
 	size = 0;
     while (h--) {
@@ -1778,73 +1847,23 @@ R600Sync(ScreenPtr pScreen, int marker)
 
 }
 
-static Bool
-R600AllocShaders(ScrnInfoPtr pScrn, ScreenPtr pScreen)
-{
-    RADEONInfoPtr info = RADEONPTR(pScrn);
-    struct radeon_accel_state *accel_state = info->accel_state;
-
-    /* 512 bytes per shader for now */
-    int size = 512 * 9;
-
-    accel_state->shaders_bo = radeon_bo_open(info->bufmgr, 0, size, 0,
-					     RADEON_GEM_DOMAIN_VRAM, 0);
-    if (accel_state->shaders_bo == NULL) {
-        ErrorF("Allocating shader failed\n");
-	return FALSE;
-    }
-    return TRUE;
-}
-
 Bool
 R600LoadShaders(ScrnInfoPtr pScrn)
 {
-    RADEONInfoPtr info = RADEONPTR(pScrn);
-    struct radeon_accel_state *accel_state = info->accel_state;
-    RADEONChipFamily ChipSet = info->ChipFamily;
-    uint32_t *shader;
-    int ret;
-
-    ret = radeon_bo_map(accel_state->shaders_bo, 1);
-    if (ret) {
-        FatalError("failed to map shader %d\n", ret);
+    struct radeon_accel_state *accel_state = RADEONPTR(pScrn)->accel_state;
+
+    if (!radeon_shader_get(pScrn, R600_solid_vs, 0, &accel_state->solid_vs_offset) ||
+	!radeon_shader_get(pScrn, R600_solid_ps, 0, &accel_state->solid_ps_offset) ||
+	!radeon_shader_get(pScrn, R600_copy_vs, 0, &accel_state->copy_vs_offset) ||
+	!radeon_shader_get(pScrn, R600_copy_ps, 0, &accel_state->copy_ps_offset) ||
+	!radeon_shader_get(pScrn, R600_comp_vs, 0, &accel_state->comp_vs_offset) ||
+	!radeon_shader_get(pScrn, R600_comp_ps, 0, &accel_state->comp_ps_offset) ||
+	!radeon_shader_get(pScrn, R600_xv_vs, 0, &accel_state->xv_vs_offset) ||
+	!radeon_shader_get(pScrn, R600_xv_ps, 0, &accel_state->xv_ps_offset) ||
+	!radeon_shader_get(pScrn, R600_xv_bicubic_ps, 0, &accel_state->xv_bicubic_ps_offset)) {
+	ErrorF("Generating shaders failed\n");
 	return FALSE;
     }
-    shader = accel_state->shaders_bo->ptr;
-
-    /*  solid vs --------------------------------------- */
-    accel_state->solid_vs_offset = 0;
-    R600_solid_vs(ChipSet, shader + accel_state->solid_vs_offset / 4);
-
-    /*  solid ps --------------------------------------- */
-    accel_state->solid_ps_offset = 512;
-    R600_solid_ps(ChipSet, shader + accel_state->solid_ps_offset / 4);
-
-    /*  copy vs --------------------------------------- */
-    accel_state->copy_vs_offset = 1024;
-    R600_copy_vs(ChipSet, shader + accel_state->copy_vs_offset / 4);
-
-    /*  copy ps --------------------------------------- */
-    accel_state->copy_ps_offset = 1536;
-    R600_copy_ps(ChipSet, shader + accel_state->copy_ps_offset / 4);
-
-    /*  comp vs --------------------------------------- */
-    accel_state->comp_vs_offset = 2048;
-    R600_comp_vs(ChipSet, shader + accel_state->comp_vs_offset / 4);
-
-    /*  comp ps --------------------------------------- */
-    accel_state->comp_ps_offset = 2560;
-    R600_comp_ps(ChipSet, shader + accel_state->comp_ps_offset / 4);
-
-    /*  xv vs --------------------------------------- */
-    accel_state->xv_vs_offset = 3072;
-    R600_xv_vs(ChipSet, shader + accel_state->xv_vs_offset / 4);
-
-    /*  xv ps --------------------------------------- */
-    accel_state->xv_ps_offset = 3584;
-    R600_xv_ps(ChipSet, shader + accel_state->xv_ps_offset / 4);
-
-    radeon_bo_unmap(accel_state->shaders_bo);
     return TRUE;
 }
 
@@ -1923,7 +1942,7 @@ R600DrawInit(ScreenPtr pScreen)
 
     radeon_vbo_init_lists(pScrn);
 
-    if (!R600AllocShaders(pScrn, pScreen))
+    if (!radeon_shader_cache_init(pScrn))
 	return FALSE;
 
     if (!R600LoadShaders(pScrn))
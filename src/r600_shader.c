@@ -35,13 +35,13 @@
 #include "r600_reg.h"
 
 /* solid vs --------------------------------------- */
-int R600_solid_vs(RADEONChipFamily ChipSet, uint32_t* shader)
+int R600_solid_vs(RADEONChipFamily ChipSet, uint32_t *shader, uint32_t variant, int max)
 {
     int i = 0;
 
     /* 0 */
-    shader[i++] = CF_DWORD0(ADDR(4));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(4));
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
 			    CF_CONST(0),
 			    COND(SQ_CF_COND_ACTIVE),
 			    I_COUNT(1),
@@ -52,13 +52,13 @@ int R600_solid_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 			    WHOLE_QUAD_MODE(0),
 			    BARRIER(1));
     /* 1 */
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(CF_POS0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(CF_POS0),
 					  TYPE(SQ_EXPORT_POS),
 					  RW_GPR(1),
 					  RW_REL(ABSOLUTE),
 					  INDEX_GPR(0),
 					  ELEM_SIZE(0));
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
 					       SRC_SEL_Y(SQ_SEL_Y),
 					       SRC_SEL_Z(SQ_SEL_Z),
 					       SRC_SEL_W(SQ_SEL_W),
@@ -70,13 +70,13 @@ int R600_solid_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 					       WHOLE_QUAD_MODE(0),
 					       BARRIER(1));
     /* 2 - always export a param whether it's used or not */
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(0),
 					  TYPE(SQ_EXPORT_PARAM),
 					  RW_GPR(0),
 					  RW_REL(ABSOLUTE),
 					  INDEX_GPR(0),
 					  ELEM_SIZE(0));
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
 					       SRC_SEL_Y(SQ_SEL_Y),
 					       SRC_SEL_Z(SQ_SEL_Z),
 					       SRC_SEL_W(SQ_SEL_W),
@@ -88,10 +88,10 @@ int R600_solid_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 					       WHOLE_QUAD_MODE(0),
 					       BARRIER(0));
     /* 3 - padding */
-    shader[i++] = 0x00000000;
-    shader[i++] = 0x00000000;
+    shader[RADEON_SHADER_DW(i, max)] = 0x00000000;
+    shader[RADEON_SHADER_DW(i, max)] = 0x00000000;
     /* 4/5 */
-    shader[i++] = VTX_DWORD0(VTX_INST(SQ_VTX_INST_FETCH),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD0(VTX_INST(SQ_VTX_INST_FETCH),
 			     FETCH_TYPE(SQ_VTX_FETCH_VERTEX_DATA),
 			     FETCH_WHOLE_QUAD(0),
 			     BUFFER_ID(0),
@@ -99,7 +99,7 @@ int R600_solid_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 			     SRC_REL(ABSOLUTE),
 			     SRC_SEL_X(SQ_SEL_X),
 			     MEGA_FETCH_COUNT(8));
-    shader[i++] = VTX_DWORD1_GPR(DST_GPR(1),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD1_GPR(DST_GPR(1),
 				 DST_REL(0),
 				 DST_SEL_X(SQ_SEL_X),
 				 DST_SEL_Y(SQ_SEL_Y),
@@ -110,7 +110,7 @@ int R600_solid_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 				 NUM_FORMAT_ALL(SQ_NUM_FORMAT_SCALED),
 				 FORMAT_COMP_ALL(SQ_FORMAT_COMP_SIGNED),
 				 SRF_MODE_ALL(SRF_MODE_ZERO_CLAMP_MINUS_ONE));
-    shader[i++] = VTX_DWORD2(OFFSET(0),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD2(OFFSET(0),
 #if X_BYTE_ORDER == X_BIG_ENDIAN
 			     ENDIAN_SWAP(SQ_ENDIAN_8IN32),
 #else
@@ -118,22 +118,22 @@ int R600_solid_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 #endif
 			     CONST_BUF_NO_STRIDE(0),
 			     MEGA_FETCH(1));
-    shader[i++] = VTX_DWORD_PAD;
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD_PAD;
 
     return i;
 }
 
 /* solid ps --------------------------------------- */
-int R600_solid_ps(RADEONChipFamily ChipSet, uint32_t* shader)
+int R600_solid_ps(RADEONChipFamily ChipSet, uint32_t *shader, uint32_t variant, int max)
 {
     int i = 0;
 
     /* 0 */
-    shader[i++] = CF_ALU_DWORD0(ADDR(2),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD0(ADDR(2),
 				KCACHE_BANK0(0),
 				KCACHE_BANK1(0),
 				KCACHE_MODE0(SQ_CF_KCACHE_NOP));
-    shader[i++] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
 				KCACHE_ADDR0(0),
 				KCACHE_ADDR1(0),
 				I_COUNT(4),
@@ -142,13 +142,13 @@ int R600_solid_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 				WHOLE_QUAD_MODE(0),
 				BARRIER(1));
     /* 1 */
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(CF_PIXEL_MRT0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(CF_PIXEL_MRT0),
 					  TYPE(SQ_EXPORT_PIXEL),
 					  RW_GPR(0),
 					  RW_REL(ABSOLUTE),
 					  INDEX_GPR(0),
 					  ELEM_SIZE(1));
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
 					       SRC_SEL_Y(SQ_SEL_Y),
 					       SRC_SEL_Z(SQ_SEL_Z),
 					       SRC_SEL_W(SQ_SEL_W),
@@ -161,7 +161,7 @@ int R600_solid_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 					       BARRIER(1));
 
     /* 2 */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_CFILE_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_CFILE_BASE + 0),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_X),
 			     SRC0_NEG(0),
@@ -172,7 +172,7 @@ int R600_solid_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     INDEX_MODE(SQ_INDEX_AR_X),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(ChipSet,
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(ChipSet,
 				 SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
@@ -187,7 +187,7 @@ int R600_solid_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 				 DST_ELEM(ELEM_X),
 				 CLAMP(1));
     /* 3 */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_CFILE_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_CFILE_BASE + 0),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_Y),
 			     SRC0_NEG(0),
@@ -198,7 +198,7 @@ int R600_solid_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     INDEX_MODE(SQ_INDEX_AR_X),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(ChipSet,
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(ChipSet,
 				 SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
@@ -213,7 +213,7 @@ int R600_solid_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 				 DST_ELEM(ELEM_Y),
 				 CLAMP(1));
     /* 4 */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_CFILE_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_CFILE_BASE + 0),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_Z),
 			     SRC0_NEG(0),
@@ -224,7 +224,7 @@ int R600_solid_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     INDEX_MODE(SQ_INDEX_AR_X),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(ChipSet,
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(ChipSet,
 				 SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
@@ -239,7 +239,7 @@ int R600_solid_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 				 DST_ELEM(ELEM_Z),
 				 CLAMP(1));
     /* 5 */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_CFILE_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_CFILE_BASE + 0),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_W),
 			     SRC0_NEG(0),
@@ -250,7 +250,7 @@ int R600_solid_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     INDEX_MODE(SQ_INDEX_AR_X),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(1));
-    shader[i++] = ALU_DWORD1_OP2(ChipSet,
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(ChipSet,
 				 SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
@@ -269,13 +269,13 @@ int R600_solid_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 }
 
 /* copy vs --------------------------------------- */
-int R600_copy_vs(RADEONChipFamily ChipSet, uint32_t* shader)
+int R600_copy_vs(RADEONChipFamily ChipSet, uint32_t *shader, uint32_t variant, int max)
 {
     int i = 0;
 
     /* 0 */
-    shader[i++] = CF_DWORD0(ADDR(4));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(4));
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
 			    CF_CONST(0),
 			    COND(SQ_CF_COND_ACTIVE),
 			    I_COUNT(2),
@@ -286,13 +286,13 @@ int R600_copy_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 			    WHOLE_QUAD_MODE(0),
 			    BARRIER(1));
     /* 1 */
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(CF_POS0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(CF_POS0),
 					  TYPE(SQ_EXPORT_POS),
 					  RW_GPR(1),
 					  RW_REL(ABSOLUTE),
 					  INDEX_GPR(0),
 					  ELEM_SIZE(0));
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
 					       SRC_SEL_Y(SQ_SEL_Y),
 					       SRC_SEL_Z(SQ_SEL_Z),
 					       SRC_SEL_W(SQ_SEL_W),
@@ -304,13 +304,13 @@ int R600_copy_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 					       WHOLE_QUAD_MODE(0),
 					       BARRIER(1));
     /* 2 */
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(0),
 					  TYPE(SQ_EXPORT_PARAM),
 					  RW_GPR(0),
 					  RW_REL(ABSOLUTE),
 					  INDEX_GPR(0),
 					  ELEM_SIZE(0));
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
 					       SRC_SEL_Y(SQ_SEL_Y),
 					       SRC_SEL_Z(SQ_SEL_Z),
 					       SRC_SEL_W(SQ_SEL_W),
@@ -322,10 +322,10 @@ int R600_copy_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 					       WHOLE_QUAD_MODE(0),
 					       BARRIER(0));
     /* 3 */
-    shader[i++] = 0x00000000;
-    shader[i++] = 0x00000000;
+    shader[RADEON_SHADER_DW(i, max)] = 0x00000000;
+    shader[RADEON_SHADER_DW(i, max)] = 0x00000000;
     /* 4/5 */
-    shader[i++] = VTX_DWORD0(VTX_INST(SQ_VTX_INST_FETCH),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD0(VTX_INST(SQ_VTX_INST_FETCH),
 			     FETCH_TYPE(SQ_VTX_FETCH_VERTEX_DATA),
 			     FETCH_WHOLE_QUAD(0),
 			     BUFFER_ID(0),
@@ -333,7 +333,7 @@ int R600_copy_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 			     SRC_REL(ABSOLUTE),
 			     SRC_SEL_X(SQ_SEL_X),
 			     MEGA_FETCH_COUNT(16));
-    shader[i++] = VTX_DWORD1_GPR(DST_GPR(1),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD1_GPR(DST_GPR(1),
 				 DST_REL(0),
 				 DST_SEL_X(SQ_SEL_X),
 				 DST_SEL_Y(SQ_SEL_Y),
@@ -344,7 +344,7 @@ int R600_copy_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 				 NUM_FORMAT_ALL(SQ_NUM_FORMAT_SCALED),
 				 FORMAT_COMP_ALL(SQ_FORMAT_COMP_SIGNED),
 				 SRF_MODE_ALL(SRF_MODE_ZERO_CLAMP_MINUS_ONE));
-    shader[i++] = VTX_DWORD2(OFFSET(0),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD2(OFFSET(0),
 #if X_BYTE_ORDER == X_BIG_ENDIAN
 			     ENDIAN_SWAP(SQ_ENDIAN_8IN32),
 #else
@@ -352,9 +352,9 @@ int R600_copy_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 #endif
 			     CONST_BUF_NO_STRIDE(0),
 			     MEGA_FETCH(1));
-    shader[i++] = VTX_DWORD_PAD;
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD_PAD;
     /* 6/7 */
-    shader[i++] = VTX_DWORD0(VTX_INST(SQ_VTX_INST_FETCH),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD0(VTX_INST(SQ_VTX_INST_FETCH),
 			     FETCH_TYPE(SQ_VTX_FETCH_VERTEX_DATA),
 			     FETCH_WHOLE_QUAD(0),
 			     BUFFER_ID(0),
@@ -362,7 +362,7 @@ int R600_copy_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 			     SRC_REL(ABSOLUTE),
 			     SRC_SEL_X(SQ_SEL_X),
 			     MEGA_FETCH_COUNT(8));
-    shader[i++] = VTX_DWORD1_GPR(DST_GPR(0),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD1_GPR(DST_GPR(0),
 				 DST_REL(0),
 				 DST_SEL_X(SQ_SEL_X),
 				 DST_SEL_Y(SQ_SEL_Y),
@@ -373,7 +373,7 @@ int R600_copy_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 				 NUM_FORMAT_ALL(SQ_NUM_FORMAT_SCALED),
 				 FORMAT_COMP_ALL(SQ_FORMAT_COMP_SIGNED),
 				 SRF_MODE_ALL(SRF_MODE_ZERO_CLAMP_MINUS_ONE));
-    shader[i++] = VTX_DWORD2(OFFSET(8),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD2(OFFSET(8),
 #if X_BYTE_ORDER == X_BIG_ENDIAN
                              ENDIAN_SWAP(SQ_ENDIAN_8IN32),
 #else
@@ -381,19 +381,19 @@ int R600_copy_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 #endif
 			     CONST_BUF_NO_STRIDE(0),
 			     MEGA_FETCH(0));
-    shader[i++] = VTX_DWORD_PAD;
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD_PAD;
 
     return i;
 }
 
 /* copy ps --------------------------------------- */
-int R600_copy_ps(RADEONChipFamily ChipSet, uint32_t* shader)
+int R600_copy_ps(RADEONChipFamily ChipSet, uint32_t *shader, uint32_t variant, int max)
 {
     int i=0;
 
     /* CF INST 0 */
-    shader[i++] = CF_DWORD0(ADDR(2));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(2));
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
 			    CF_CONST(0),
 			    COND(SQ_CF_COND_ACTIVE),
 			    I_COUNT(1),
@@ -404,13 +404,13 @@ int R600_copy_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			    WHOLE_QUAD_MODE(0),
 			    BARRIER(1));
     /* CF INST 1 */
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(CF_PIXEL_MRT0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(CF_PIXEL_MRT0),
 					  TYPE(SQ_EXPORT_PIXEL),
 					  RW_GPR(0),
 					  RW_REL(ABSOLUTE),
 					  INDEX_GPR(0),
 					  ELEM_SIZE(1));
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
 					       SRC_SEL_Y(SQ_SEL_Y),
 					       SRC_SEL_Z(SQ_SEL_Z),
 					       SRC_SEL_W(SQ_SEL_W),
@@ -422,14 +422,14 @@ int R600_copy_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 					       WHOLE_QUAD_MODE(0),
 					       BARRIER(1));
     /* TEX INST 0 */
-    shader[i++] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
 			     BC_FRAC_MODE(0),
 			     FETCH_WHOLE_QUAD(0),
 			     RESOURCE_ID(0),
 			     SRC_GPR(0),
 			     SRC_REL(ABSOLUTE),
 			     R7xx_ALT_CONST(0));
-    shader[i++] = TEX_DWORD1(DST_GPR(0),
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD1(DST_GPR(0),
 			     DST_REL(ABSOLUTE),
 			     DST_SEL_X(SQ_SEL_X), /* R */
 			     DST_SEL_Y(SQ_SEL_Y), /* G */
@@ -440,7 +440,7 @@ int R600_copy_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     COORD_TYPE_Y(TEX_UNNORMALIZED),
 			     COORD_TYPE_Z(TEX_UNNORMALIZED),
 			     COORD_TYPE_W(TEX_UNNORMALIZED));
-    shader[i++] = TEX_DWORD2(OFFSET_X(0),
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD2(OFFSET_X(0),
 			     OFFSET_Y(0),
 			     OFFSET_Z(0),
 			     SAMPLER_ID(0),
@@ -448,7 +448,7 @@ int R600_copy_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     SRC_SEL_Y(SQ_SEL_Y),
 			     SRC_SEL_Z(SQ_SEL_0),
 			     SRC_SEL_W(SQ_SEL_1));
-    shader[i++] = TEX_DWORD_PAD;
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD_PAD;
 
     return i;
 }
@@ -464,13 +464,13 @@ int R600_copy_ps(RADEONChipFamily ChipSet, uint32_t* shader)
  * 02 EXP_DONE: PARAM0, R0  NO_BARRIER 
  * END_OF_PROGRAM
  */
-int R600_xv_vs(RADEONChipFamily ChipSet, uint32_t* shader)
+int R600_xv_vs(RADEONChipFamily ChipSet, uint32_t *shader, uint32_t variant, int max)
 {
     int i = 0;
 
     /* 0 */
-    shader[i++] = CF_DWORD0(ADDR(6));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(6));
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
                             CF_CONST(0),
                             COND(SQ_CF_COND_ACTIVE),
                             I_COUNT(2),
@@ -482,11 +482,11 @@ int R600_xv_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                             BARRIER(1));
 
     /* 1 - ALU */
-    shader[i++] = CF_ALU_DWORD0(ADDR(4),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD0(ADDR(4),
 				KCACHE_BANK0(0),
 				KCACHE_BANK1(0),
 				KCACHE_MODE0(SQ_CF_KCACHE_NOP));
-    shader[i++] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
 				KCACHE_ADDR0(0),
 				KCACHE_ADDR1(0),
 				I_COUNT(2),
@@ -496,13 +496,13 @@ int R600_xv_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 				BARRIER(1));
 
     /* 2 */
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(CF_POS0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(CF_POS0),
                                           TYPE(SQ_EXPORT_POS),
                                           RW_GPR(1),
                                           RW_REL(ABSOLUTE),
                                           INDEX_GPR(0),
                                           ELEM_SIZE(3));
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
                                                SRC_SEL_Y(SQ_SEL_Y),
                                                SRC_SEL_Z(SQ_SEL_Z),
                                                SRC_SEL_W(SQ_SEL_W),
@@ -514,13 +514,13 @@ int R600_xv_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                                WHOLE_QUAD_MODE(0),
                                                BARRIER(1));
     /* 3 */
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(0),
                                           TYPE(SQ_EXPORT_PARAM),
                                           RW_GPR(0),
                                           RW_REL(ABSOLUTE),
                                           INDEX_GPR(0),
                                           ELEM_SIZE(3));
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
                                                SRC_SEL_Y(SQ_SEL_Y),
                                                SRC_SEL_Z(SQ_SEL_Z),
                                                SRC_SEL_W(SQ_SEL_W),
@@ -534,7 +534,7 @@ int R600_xv_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 
 
     /* 4 texX / w */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_X),
                              SRC0_NEG(0),
@@ -545,7 +545,7 @@ int R600_xv_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_AR_X),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(ChipSet,
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(ChipSet,
                                  SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
@@ -561,7 +561,7 @@ int R600_xv_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 5 texY / h */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_Y),
                              SRC0_NEG(0),
@@ -572,7 +572,7 @@ int R600_xv_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_AR_X),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(1));
-    shader[i++] = ALU_DWORD1_OP2(ChipSet,
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(ChipSet,
                                  SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
@@ -588,7 +588,7 @@ int R600_xv_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 6/7 */
-    shader[i++] = VTX_DWORD0(VTX_INST(SQ_VTX_INST_FETCH),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD0(VTX_INST(SQ_VTX_INST_FETCH),
                              FETCH_TYPE(SQ_VTX_FETCH_VERTEX_DATA),
                              FETCH_WHOLE_QUAD(0),
                              BUFFER_ID(0),
@@ -596,7 +596,7 @@ int R600_xv_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              SRC_REL(ABSOLUTE),
                              SRC_SEL_X(SQ_SEL_X),
                              MEGA_FETCH_COUNT(16));
-    shader[i++] = VTX_DWORD1_GPR(DST_GPR(1),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD1_GPR(DST_GPR(1),
                                  DST_REL(ABSOLUTE),
                                  DST_SEL_X(SQ_SEL_X),
                                  DST_SEL_Y(SQ_SEL_Y),
@@ -607,7 +607,7 @@ int R600_xv_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  NUM_FORMAT_ALL(SQ_NUM_FORMAT_SCALED),
                                  FORMAT_COMP_ALL(SQ_FORMAT_COMP_SIGNED),
                                  SRF_MODE_ALL(SRF_MODE_ZERO_CLAMP_MINUS_ONE));
-    shader[i++] = VTX_DWORD2(OFFSET(0),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD2(OFFSET(0),
 #if X_BYTE_ORDER == X_BIG_ENDIAN
                              ENDIAN_SWAP(SQ_ENDIAN_8IN32),
 #else
@@ -615,9 +615,9 @@ int R600_xv_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 #endif
                              CONST_BUF_NO_STRIDE(0),
                              MEGA_FETCH(1));
-    shader[i++] = VTX_DWORD_PAD;
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD_PAD;
     /* 8/9 */
-    shader[i++] = VTX_DWORD0(VTX_INST(SQ_VTX_INST_FETCH),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD0(VTX_INST(SQ_VTX_INST_FETCH),
                              FETCH_TYPE(SQ_VTX_FETCH_VERTEX_DATA),
                              FETCH_WHOLE_QUAD(0),
                              BUFFER_ID(0),
@@ -625,7 +625,7 @@ int R600_xv_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              SRC_REL(ABSOLUTE),
                              SRC_SEL_X(SQ_SEL_X),
                              MEGA_FETCH_COUNT(8));
-    shader[i++] = VTX_DWORD1_GPR(DST_GPR(0),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD1_GPR(DST_GPR(0),
                                  DST_REL(ABSOLUTE),
                                  DST_SEL_X(SQ_SEL_X),
                                  DST_SEL_Y(SQ_SEL_Y),
@@ -636,7 +636,7 @@ int R600_xv_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  NUM_FORMAT_ALL(SQ_NUM_FORMAT_SCALED),
                                  FORMAT_COMP_ALL(SQ_FORMAT_COMP_SIGNED),
                                  SRF_MODE_ALL(SRF_MODE_ZERO_CLAMP_MINUS_ONE));
-    shader[i++] = VTX_DWORD2(OFFSET(8),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD2(OFFSET(8),
 #if X_BYTE_ORDER == X_BIG_ENDIAN
                              ENDIAN_SWAP(SQ_ENDIAN_8IN32),
 #else
@@ -644,18 +644,18 @@ int R600_xv_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 #endif
                              CONST_BUF_NO_STRIDE(0),
                              MEGA_FETCH(0));
-    shader[i++] = VTX_DWORD_PAD;
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD_PAD;
 
     return i;
 }
 
-int R600_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader)
+int R600_xv_ps(RADEONChipFamily ChipSet, uint32_t *shader, uint32_t variant, int max)
 {
     int i = 0;
 
     /* 0 */
-    shader[i++] = CF_DWORD0(ADDR(16));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(18));
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
                             CF_CONST(0),
                             COND(SQ_CF_COND_BOOL),
                             I_COUNT(0),
@@ -666,8 +666,8 @@ int R600_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader)
                             WHOLE_QUAD_MODE(0),
                             BARRIER(0));
     /* 1 */
-    shader[i++] = CF_DWORD0(ADDR(24));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(26));
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
                             CF_CONST(0),
                             COND(SQ_CF_COND_NOT_BOOL),
                             I_COUNT(0),
@@ -678,11 +678,11 @@ int R600_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader)
                             WHOLE_QUAD_MODE(0),
                             BARRIER(0));
     /* 2 */
-    shader[i++] = CF_ALU_DWORD0(ADDR(4),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD0(ADDR(6),
                                 KCACHE_BANK0(0),
                                 KCACHE_BANK1(0),
                                 KCACHE_MODE0(SQ_CF_KCACHE_NOP));
-    shader[i++] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
                                 KCACHE_ADDR0(0),
                                 KCACHE_ADDR1(0),
                                 I_COUNT(12),
@@ -690,14 +690,38 @@ int R600_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader)
                                 CF_INST(SQ_CF_INST_ALU),
                                 WHOLE_QUAD_MODE(0),
                                 BARRIER(1));
-    /* 3 */
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(CF_PIXEL_MRT0),
+    /* 3 - gamma correction, bool 1 */
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(30));
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
+                            CF_CONST(1),
+                            COND(SQ_CF_COND_BOOL),
+                            I_COUNT(0),
+                            CALL_COUNT(0),
+                            END_OF_PROGRAM(0),
+                            VALID_PIXEL_MODE(0),
+                            CF_INST(SQ_CF_INST_CALL),
+                            WHOLE_QUAD_MODE(0),
+                            BARRIER(0));
+    /* 4 */
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(0));
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
+                            CF_CONST(0),
+                            COND(SQ_CF_COND_ACTIVE),
+                            I_COUNT(0),
+                            CALL_COUNT(0),
+                            END_OF_PROGRAM(0),
+                            VALID_PIXEL_MODE(0),
+                            CF_INST(SQ_CF_INST_NOP),
+                            WHOLE_QUAD_MODE(0),
+                            BARRIER(1));
+    /* 5 */
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(CF_PIXEL_MRT0),
                                           TYPE(SQ_EXPORT_PIXEL),
                                           RW_GPR(2),
                                           RW_REL(ABSOLUTE),
                                           INDEX_GPR(0),
                                           ELEM_SIZE(3));
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
                                                SRC_SEL_Y(SQ_SEL_Y),
                                                SRC_SEL_Z(SQ_SEL_Z),
                                                SRC_SEL_W(SQ_SEL_W),
@@ -708,9 +732,9 @@ int R600_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader)
                                                CF_INST(SQ_CF_INST_EXPORT_DONE),
                                                WHOLE_QUAD_MODE(0),
                                                BARRIER(1));
-    /* 4,5,6,7 */
+    /* 6,7,8,9 */
     /* r2.x = MAD(c0.w, r1.x, c0.x) */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_CFILE_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_CFILE_BASE + 0),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_W),
                              SRC0_NEG(0),
@@ -721,7 +745,7 @@ int R600_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP3(SRC2_SEL(ALU_SRC_CFILE_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(ALU_SRC_CFILE_BASE + 0),
                                  SRC2_REL(ABSOLUTE),
                                  SRC2_ELEM(ELEM_X),
                                  SRC2_NEG(0),
@@ -732,7 +756,7 @@ int R600_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader)
                                  DST_ELEM(ELEM_X),
                                  CLAMP(0));
     /* r2.y = MAD(c0.w, r1.x, c0.y) */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_CFILE_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_CFILE_BASE + 0),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_W),
                              SRC0_NEG(0),
@@ -743,7 +767,7 @@ int R600_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP3(SRC2_SEL(ALU_SRC_CFILE_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(ALU_SRC_CFILE_BASE + 0),
                                  SRC2_REL(ABSOLUTE),
                                  SRC2_ELEM(ELEM_Y),
                                  SRC2_NEG(0),
@@ -754,7 +778,7 @@ int R600_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader)
                                  DST_ELEM(ELEM_Y),
                                  CLAMP(0));
     /* r2.z = MAD(c0.w, r1.x, c0.z) */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_CFILE_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_CFILE_BASE + 0),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_W),
                              SRC0_NEG(0),
@@ -765,7 +789,7 @@ int R600_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP3(SRC2_SEL(ALU_SRC_CFILE_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(ALU_SRC_CFILE_BASE + 0),
                                  SRC2_REL(ABSOLUTE),
                                  SRC2_ELEM(ELEM_Z),
                                  SRC2_NEG(0),
@@ -776,7 +800,7 @@ int R600_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader)
                                  DST_ELEM(ELEM_Z),
                                  CLAMP(0));
     /* r2.w = MAD(0, 0, 1) */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(SQ_ALU_SRC_0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(SQ_ALU_SRC_0),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_X),
                              SRC0_NEG(0),
@@ -787,7 +811,7 @@ int R600_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(1));
-    shader[i++] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_1),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_1),
                                  SRC2_REL(ABSOLUTE),
                                  SRC2_ELEM(ELEM_X),
                                  SRC2_NEG(0),
@@ -798,9 +822,9 @@ int R600_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader)
                                  DST_ELEM(ELEM_W),
                                  CLAMP(0));
 
-    /* 8,9,10,11 */
+    /* 10,11,12,13 */
     /* r2.x = MAD(c1.x, r1.y, pv.x) */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_CFILE_BASE + 1),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_CFILE_BASE + 1),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_X),
                              SRC0_NEG(0),
@@ -811,7 +835,162 @@ int R600_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_PV),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_PV),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_X),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_X),
+                                 CLAMP(0));
+    /* r2.y = MAD(c1.y, r1.y, pv.y) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_CFILE_BASE + 1),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Y),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 1),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Y),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_PV),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_Y),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Y),
+                                 CLAMP(0));
+    /* r2.z = MAD(c1.z, r1.y, pv.z) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_CFILE_BASE + 1),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Z),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 1),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Y),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_PV),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_Z),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Z),
+                                 CLAMP(0));
+    /* r2.w = MAD(0, 0, 1) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(SQ_ALU_SRC_0),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(SQ_ALU_SRC_0),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_X),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_1),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_W),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_W),
+                                 CLAMP(0));
+    /* 14,15,16,17 */
+    /* r2.x = MAD(c2.x, r1.z, pv.x) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_CFILE_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 1),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Z),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_PV),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_X),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_X),
+                                 CLAMP(1));
+    /* r2.y = MAD(c2.y, r1.z, pv.y) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_CFILE_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Y),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 1),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Z),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_PV),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_Y),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Y),
+                                 CLAMP(1));
+    /* r2.z = MAD(c2.z, r1.z, pv.z) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_CFILE_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Z),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 1),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Z),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_PV),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_Z),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Z),
+                                 CLAMP(1));
+    /* r2.w = MAD(0, 0, 1) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(SQ_ALU_SRC_0),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(SQ_ALU_SRC_0),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_X),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_1),
                                  SRC2_REL(ABSOLUTE),
                                  SRC2_ELEM(ELEM_X),
                                  SRC2_NEG(0),
@@ -819,336 +998,1610 @@ int R600_xv_ps(RADEONChipFamily ChipSet, uint32_t* shader)
                                  BANK_SWIZZLE(SQ_ALU_VEC_012),
                                  DST_GPR(2),
                                  DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_W),
+                                 CLAMP(1));
+
+    /* 18 */
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(20));
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
+                            CF_CONST(0),
+                            COND(SQ_CF_COND_ACTIVE),
+                            I_COUNT(3),
+                            CALL_COUNT(0),
+                            END_OF_PROGRAM(0),
+                            VALID_PIXEL_MODE(0),
+                            CF_INST(SQ_CF_INST_TEX),
+                            WHOLE_QUAD_MODE(0),
+                            BARRIER(1));
+    /* 19 */
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(0));
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
+			    CF_CONST(0),
+			    COND(SQ_CF_COND_ACTIVE),
+			    I_COUNT(0),
+			    CALL_COUNT(0),
+			    END_OF_PROGRAM(0),
+			    VALID_PIXEL_MODE(0),
+			    CF_INST(SQ_CF_INST_RETURN),
+			    WHOLE_QUAD_MODE(0),
+			    BARRIER(1));
+    /* 20/21 */
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
+                             BC_FRAC_MODE(0),
+                             FETCH_WHOLE_QUAD(0),
+                             RESOURCE_ID(0),
+                             SRC_GPR(0),
+                             SRC_REL(ABSOLUTE),
+                             R7xx_ALT_CONST(0));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD1(DST_GPR(1),
+                             DST_REL(ABSOLUTE),
+                             DST_SEL_X(SQ_SEL_X),
+                             DST_SEL_Y(SQ_SEL_MASK),
+                             DST_SEL_Z(SQ_SEL_MASK),
+                             DST_SEL_W(SQ_SEL_1),
+                             LOD_BIAS(0),
+                             COORD_TYPE_X(TEX_NORMALIZED),
+                             COORD_TYPE_Y(TEX_NORMALIZED),
+                             COORD_TYPE_Z(TEX_NORMALIZED),
+                             COORD_TYPE_W(TEX_NORMALIZED));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD2(OFFSET_X(0),
+                             OFFSET_Y(0),
+                             OFFSET_Z(0),
+                             SAMPLER_ID(0),
+                             SRC_SEL_X(SQ_SEL_X),
+                             SRC_SEL_Y(SQ_SEL_Y),
+                             SRC_SEL_Z(SQ_SEL_0),
+                             SRC_SEL_W(SQ_SEL_1));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD_PAD;
+    /* 22/23 */
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
+                             BC_FRAC_MODE(0),
+                             FETCH_WHOLE_QUAD(0),
+                             RESOURCE_ID(1),
+                             SRC_GPR(0),
+                             SRC_REL(ABSOLUTE),
+                             R7xx_ALT_CONST(0));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD1(DST_GPR(1),
+                             DST_REL(ABSOLUTE),
+                             DST_SEL_X(SQ_SEL_MASK),
+                             DST_SEL_Y(SQ_SEL_MASK),
+                             DST_SEL_Z(SQ_SEL_X),
+                             DST_SEL_W(SQ_SEL_MASK),
+                             LOD_BIAS(0),
+                             COORD_TYPE_X(TEX_NORMALIZED),
+                             COORD_TYPE_Y(TEX_NORMALIZED),
+                             COORD_TYPE_Z(TEX_NORMALIZED),
+                             COORD_TYPE_W(TEX_NORMALIZED));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD2(OFFSET_X(0),
+                             OFFSET_Y(0),
+                             OFFSET_Z(0),
+                             SAMPLER_ID(1),
+                             SRC_SEL_X(SQ_SEL_X),
+                             SRC_SEL_Y(SQ_SEL_Y),
+                             SRC_SEL_Z(SQ_SEL_0),
+                             SRC_SEL_W(SQ_SEL_1));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD_PAD;
+    /* 24/25 */
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
+                             BC_FRAC_MODE(0),
+                             FETCH_WHOLE_QUAD(0),
+                             RESOURCE_ID(2),
+                             SRC_GPR(0),
+                             SRC_REL(ABSOLUTE),
+                             R7xx_ALT_CONST(0));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD1(DST_GPR(1),
+                             DST_REL(ABSOLUTE),
+                             DST_SEL_X(SQ_SEL_MASK),
+                             DST_SEL_Y(SQ_SEL_X),
+                             DST_SEL_Z(SQ_SEL_MASK),
+                             DST_SEL_W(SQ_SEL_MASK),
+                             LOD_BIAS(0),
+                             COORD_TYPE_X(TEX_NORMALIZED),
+                             COORD_TYPE_Y(TEX_NORMALIZED),
+                             COORD_TYPE_Z(TEX_NORMALIZED),
+                             COORD_TYPE_W(TEX_NORMALIZED));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD2(OFFSET_X(0),
+                             OFFSET_Y(0),
+                             OFFSET_Z(0),
+                             SAMPLER_ID(2),
+                             SRC_SEL_X(SQ_SEL_X),
+                             SRC_SEL_Y(SQ_SEL_Y),
+                             SRC_SEL_Z(SQ_SEL_0),
+                             SRC_SEL_W(SQ_SEL_1));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD_PAD;
+    /* 26 */
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(28));
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
+                            CF_CONST(0),
+                            COND(SQ_CF_COND_ACTIVE),
+                            I_COUNT(1),
+                            CALL_COUNT(0),
+                            END_OF_PROGRAM(0),
+                            VALID_PIXEL_MODE(0),
+                            CF_INST(SQ_CF_INST_TEX),
+                            WHOLE_QUAD_MODE(0),
+                            BARRIER(1));
+    /* 27 */
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(0));
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
+			    CF_CONST(0),
+			    COND(SQ_CF_COND_ACTIVE),
+			    I_COUNT(0),
+			    CALL_COUNT(0),
+			    END_OF_PROGRAM(0),
+			    VALID_PIXEL_MODE(0),
+			    CF_INST(SQ_CF_INST_RETURN),
+			    WHOLE_QUAD_MODE(0),
+			    BARRIER(1));
+    /* 28/29 */
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
+                             BC_FRAC_MODE(0),
+                             FETCH_WHOLE_QUAD(0),
+                             RESOURCE_ID(0),
+                             SRC_GPR(0),
+                             SRC_REL(ABSOLUTE),
+                             R7xx_ALT_CONST(0));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD1(DST_GPR(1),
+                             DST_REL(ABSOLUTE),
+                             DST_SEL_X(SQ_SEL_X),
+                             DST_SEL_Y(SQ_SEL_Y),
+                             DST_SEL_Z(SQ_SEL_Z),
+                             DST_SEL_W(SQ_SEL_1),
+                             LOD_BIAS(0),
+                             COORD_TYPE_X(TEX_NORMALIZED),
+                             COORD_TYPE_Y(TEX_NORMALIZED),
+                             COORD_TYPE_Z(TEX_NORMALIZED),
+                             COORD_TYPE_W(TEX_NORMALIZED));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD2(OFFSET_X(0),
+                             OFFSET_Y(0),
+                             OFFSET_Z(0),
+                             SAMPLER_ID(0),
+                             SRC_SEL_X(SQ_SEL_X),
+                             SRC_SEL_Y(SQ_SEL_Y),
+                             SRC_SEL_Z(SQ_SEL_0),
+                             SRC_SEL_W(SQ_SEL_1));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD_PAD;
+
+    /* 30 - gamma: r2.xyz = 2 ^ (log2(r2.xyz) * c1.w) */
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD0(ADDR(32),
+                                KCACHE_BANK0(0),
+                                KCACHE_BANK1(0),
+                                KCACHE_MODE0(SQ_CF_KCACHE_NOP));
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
+                                KCACHE_ADDR0(0),
+                                KCACHE_ADDR1(0),
+                                I_COUNT(9),
+                                USES_WATERFALL(0),
+                                CF_INST(SQ_CF_INST_ALU),
+                                WHOLE_QUAD_MODE(0),
+                                BARRIER(1));
+    /* 31 */
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(0));
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
+                            CF_CONST(0),
+                            COND(SQ_CF_COND_ACTIVE),
+                            I_COUNT(0),
+                            CALL_COUNT(0),
+                            END_OF_PROGRAM(0),
+                            VALID_PIXEL_MODE(0),
+                            CF_INST(SQ_CF_INST_RETURN),
+                            WHOLE_QUAD_MODE(0),
+                            BARRIER(1));
+    /* 32 */
+    /* r2.x = LOG_CLAMPED(r2.x) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_X),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(ChipSet,
+                                 SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(1),
+                                 FOG_MERGE(0),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_LOG_CLAMPED),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_X),
+                                 CLAMP(0));
+    /* 33 */
+    /* r2.y = LOG_CLAMPED(r2.y) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Y),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Y),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(ChipSet,
+                                 SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(1),
+                                 FOG_MERGE(0),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_LOG_CLAMPED),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Y),
+                                 CLAMP(0));
+    /* 34 */
+    /* r2.z = LOG_CLAMPED(r2.z) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Z),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Z),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(ChipSet,
+                                 SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(1),
+                                 FOG_MERGE(0),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_LOG_CLAMPED),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Z),
+                                 CLAMP(0));
+    /* 35,36,37 */
+    /* r2.x = MUL(r2.x, c1.w) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_CFILE_BASE + 1),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_W),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(ChipSet,
+                                 SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(1),
+                                 FOG_MERGE(0),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_MUL),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_X),
+                                 CLAMP(0));
+    /* r2.y = MUL(r2.y, c1.w) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Y),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_CFILE_BASE + 1),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_W),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(ChipSet,
+                                 SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(1),
+                                 FOG_MERGE(0),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_MUL),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Y),
+                                 CLAMP(0));
+    /* r2.z = MUL(r2.z, c1.w) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Z),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_CFILE_BASE + 1),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_W),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(ChipSet,
+                                 SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(1),
+                                 FOG_MERGE(0),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_MUL),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Z),
+                                 CLAMP(0));
+    /* 38 */
+    /* r2.x = EXP_IEEE(r2.x) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_X),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(ChipSet,
+                                 SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(1),
+                                 FOG_MERGE(0),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_EXP_IEEE),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_X),
+                                 CLAMP(1));
+    /* 39 */
+    /* r2.y = EXP_IEEE(r2.y) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Y),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Y),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(ChipSet,
+                                 SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(1),
+                                 FOG_MERGE(0),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_EXP_IEEE),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Y),
+                                 CLAMP(1));
+    /* 40 */
+    /* r2.z = EXP_IEEE(r2.z) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Z),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Z),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(ChipSet,
+                                 SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(1),
+                                 FOG_MERGE(0),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_EXP_IEEE),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Z),
+                                 CLAMP(1));
+
+    return i;
+}
+
+/*
+ * xv bicubic ps: planar sources only.  Luma is filtered with four
+ * bilinear fetches placed and weighted from the bicubic lookup table
+ * (resource 3), chroma is sampled bilinearly as in the xv ps.
+ * c3 = { width, height, 1 / width, 1 / height } of the luma plane.
+ */
+int R600_xv_bicubic_ps(RADEONChipFamily ChipSet, uint32_t *shader, uint32_t variant, int max)
+{
+    int i = 0;
+
+    /* 0 */
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD0(ADDR(8),
+                                KCACHE_BANK0(0),
+                                KCACHE_BANK1(0),
+                                KCACHE_MODE0(SQ_CF_KCACHE_NOP));
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
+                                KCACHE_ADDR0(0),
+                                KCACHE_ADDR1(0),
+                                I_COUNT(2),
+                                USES_WATERFALL(0),
+                                CF_INST(SQ_CF_INST_ALU),
+                                WHOLE_QUAD_MODE(0),
+                                BARRIER(1));
+    /* 1 */
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(32));
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
+                            CF_CONST(0),
+                            COND(SQ_CF_COND_ACTIVE),
+                            I_COUNT(4),
+                            CALL_COUNT(0),
+                            END_OF_PROGRAM(0),
+                            VALID_PIXEL_MODE(0),
+                            CF_INST(SQ_CF_INST_TEX),
+                            WHOLE_QUAD_MODE(0),
+                            BARRIER(1));
+    /* 2 */
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD0(ADDR(10),
+                                KCACHE_BANK0(0),
+                                KCACHE_BANK1(0),
+                                KCACHE_MODE0(SQ_CF_KCACHE_NOP));
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
+                                KCACHE_ADDR0(0),
+                                KCACHE_ADDR1(0),
+                                I_COUNT(4),
+                                USES_WATERFALL(0),
+                                CF_INST(SQ_CF_INST_ALU),
+                                WHOLE_QUAD_MODE(0),
+                                BARRIER(1));
+    /* 3 */
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(40));
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
+                            CF_CONST(0),
+                            COND(SQ_CF_COND_ACTIVE),
+                            I_COUNT(4),
+                            CALL_COUNT(0),
+                            END_OF_PROGRAM(0),
+                            VALID_PIXEL_MODE(0),
+                            CF_INST(SQ_CF_INST_TEX),
+                            WHOLE_QUAD_MODE(0),
+                            BARRIER(1));
+    /* 4 */
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD0(ADDR(14),
+                                KCACHE_BANK0(0),
+                                KCACHE_BANK1(0),
+                                KCACHE_MODE0(SQ_CF_KCACHE_NOP));
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
+                                KCACHE_ADDR0(0),
+                                KCACHE_ADDR1(0),
+                                I_COUNT(18),
+                                USES_WATERFALL(0),
+                                CF_INST(SQ_CF_INST_ALU),
+                                WHOLE_QUAD_MODE(0),
+                                BARRIER(1));
+    /* 5 - gamma correction, bool 1 */
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(48));
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
+                            CF_CONST(1),
+                            COND(SQ_CF_COND_BOOL),
+                            I_COUNT(0),
+                            CALL_COUNT(0),
+                            END_OF_PROGRAM(0),
+                            VALID_PIXEL_MODE(0),
+                            CF_INST(SQ_CF_INST_CALL),
+                            WHOLE_QUAD_MODE(0),
+                            BARRIER(0));
+    /* 6 */
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(0));
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
+                            CF_CONST(0),
+                            COND(SQ_CF_COND_ACTIVE),
+                            I_COUNT(0),
+                            CALL_COUNT(0),
+                            END_OF_PROGRAM(0),
+                            VALID_PIXEL_MODE(0),
+                            CF_INST(SQ_CF_INST_NOP),
+                            WHOLE_QUAD_MODE(0),
+                            BARRIER(1));
+    /* 7 */
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(CF_PIXEL_MRT0),
+                                          TYPE(SQ_EXPORT_PIXEL),
+                                          RW_GPR(2),
+                                          RW_REL(ABSOLUTE),
+                                          INDEX_GPR(0),
+                                          ELEM_SIZE(3));
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
+                                               SRC_SEL_Y(SQ_SEL_Y),
+                                               SRC_SEL_Z(SQ_SEL_Z),
+                                               SRC_SEL_W(SQ_SEL_W),
+                                               R6xx_ELEM_LOOP(0),
+                                               BURST_COUNT(1),
+                                               END_OF_PROGRAM(1),
+                                               VALID_PIXEL_MODE(0),
+                                               CF_INST(SQ_CF_INST_EXPORT_DONE),
+                                               WHOLE_QUAD_MODE(0),
+                                               BARRIER(1));
+    /* 8,9 */
+    /* r3.x = MAD(r0.x, c3.x, 0.5) - texel position, fraction indexes the filter table */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_CFILE_BASE + 3),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_X),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_0_5),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_X),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(3),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_X),
+                                 CLAMP(0));
+    /* r3.y = MAD(r0.y, c3.y, 0.5) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Y),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_CFILE_BASE + 3),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Y),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_0_5),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_X),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(3),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Y),
+                                 CLAMP(0));
+    /* 10 */
+    /* r6.x = MAD(r4.x, c3.z, r0.x) - left column */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 4),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_CFILE_BASE + 3),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Z),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(ALU_SRC_GPR_BASE + 0),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_X),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(6),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_X),
+                                 CLAMP(0));
+    /* 11 */
+    /* r6.y = MAD(r5.x, c3.w, r0.y) - top row */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 5),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_CFILE_BASE + 3),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_W),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(ALU_SRC_GPR_BASE + 0),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_Y),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(6),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Y),
+                                 CLAMP(0));
+    /* 12 */
+    /* r6.z = MAD(r4.y, c3.z, r0.x) - right column */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 4),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Y),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_CFILE_BASE + 3),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Z),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(ALU_SRC_GPR_BASE + 0),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_X),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(6),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Z),
+                                 CLAMP(0));
+    /* 13 */
+    /* r6.w = MAD(r5.y, c3.w, r0.y) - bottom row */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 5),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Y),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_CFILE_BASE + 3),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_W),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(ALU_SRC_GPR_BASE + 0),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_Y),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(6),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_W),
+                                 CLAMP(0));
+    /* 14,15 */
+    /* r8.x = ADD(r7.x, -r7.y) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 7),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 7),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Y),
+                             SRC1_NEG(1),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(ChipSet,
+                                 SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(1),
+                                 FOG_MERGE(0),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_ADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(8),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_X),
+                                 CLAMP(0));
+    /* r8.y = ADD(r7.z, -r7.w) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 7),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Z),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 7),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_W),
+                             SRC1_NEG(1),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(ChipSet,
+                                 SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(1),
+                                 FOG_MERGE(0),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_ADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(8),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Y),
+                                 CLAMP(0));
+    /* 16,17 */
+    /* r8.x = MAD(r8.x, r4.z, r7.y) - horizontal blend, top */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 8),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 4),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Z),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(ALU_SRC_GPR_BASE + 7),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_Y),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(8),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_X),
+                                 CLAMP(0));
+    /* r8.y = MAD(r8.y, r4.z, r7.w) - horizontal blend, bottom */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 8),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Y),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 4),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Z),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(ALU_SRC_GPR_BASE + 7),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_W),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(8),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Y),
+                                 CLAMP(0));
+    /* 18 */
+    /* r8.z = ADD(r8.x, -r8.y) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 8),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 8),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Y),
+                             SRC1_NEG(1),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(ChipSet,
+                                 SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(1),
+                                 FOG_MERGE(0),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_ADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(8),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Z),
+                                 CLAMP(0));
+    /* 19 */
+    /* r1.x = MAD(r8.z, r5.z, r8.y) - vertical blend, filtered Y */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 8),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Z),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 5),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Z),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(ALU_SRC_GPR_BASE + 8),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_Y),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(1),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_X),
+                                 CLAMP(0));
+    /* 20,21,22,23 */
+    /* r2.x = MAD(c0.w, r1.x, c0.x) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_CFILE_BASE + 0),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_W),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 1),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_X),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(ALU_SRC_CFILE_BASE + 0),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_X),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_X),
+                                 CLAMP(0));
+    /* r2.y = MAD(c0.w, r1.x, c0.y) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_CFILE_BASE + 0),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_W),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 1),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_X),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(ALU_SRC_CFILE_BASE + 0),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_Y),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Y),
+                                 CLAMP(0));
+    /* r2.z = MAD(c0.w, r1.x, c0.z) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_CFILE_BASE + 0),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_W),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 1),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_X),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(ALU_SRC_CFILE_BASE + 0),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_Z),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Z),
+                                 CLAMP(0));
+    /* r2.w = MAD(0, 0, 1) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(SQ_ALU_SRC_0),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(SQ_ALU_SRC_0),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_X),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_1),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_X),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_W),
+                                 CLAMP(0));
+    /* 24,25,26,27 */
+    /* r2.x = MAD(c1.x, r1.y, pv.x) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_CFILE_BASE + 1),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 1),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Y),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_PV),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_X),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_X),
+                                 CLAMP(0));
+    /* r2.y = MAD(c1.y, r1.y, pv.y) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_CFILE_BASE + 1),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Y),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 1),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Y),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_PV),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_Y),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Y),
+                                 CLAMP(0));
+    /* r2.z = MAD(c1.z, r1.y, pv.z) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_CFILE_BASE + 1),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Z),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 1),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Y),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_PV),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_Z),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Z),
+                                 CLAMP(0));
+    /* r2.w = MAD(0, 0, 1) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(SQ_ALU_SRC_0),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(SQ_ALU_SRC_0),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_X),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_1),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_X),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_W),
+                                 CLAMP(0));
+    /* 28,29,30,31 */
+    /* r2.x = MAD(c2.x, r1.z, pv.x) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_CFILE_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 1),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Z),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_PV),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_X),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_X),
+                                 CLAMP(1));
+    /* r2.y = MAD(c2.y, r1.z, pv.y) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_CFILE_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Y),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 1),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Z),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_PV),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_Y),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Y),
+                                 CLAMP(1));
+    /* r2.z = MAD(c2.z, r1.z, pv.z) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_CFILE_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Z),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 1),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Z),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_PV),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_Z),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Z),
+                                 CLAMP(1));
+    /* r2.w = MAD(0, 0, 1) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(SQ_ALU_SRC_0),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(SQ_ALU_SRC_0),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_X),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_1),
+                                 SRC2_REL(ABSOLUTE),
+                                 SRC2_ELEM(ELEM_X),
+                                 SRC2_NEG(0),
+                                 ALU_INST(SQ_OP3_INST_MULADD),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_W),
+                                 CLAMP(1));
+    /* 32/33 - filter weights and offsets for x */
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
+                             BC_FRAC_MODE(0),
+                             FETCH_WHOLE_QUAD(0),
+                             RESOURCE_ID(3),
+                             SRC_GPR(3),
+                             SRC_REL(ABSOLUTE),
+                             R7xx_ALT_CONST(0));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD1(DST_GPR(4),
+                             DST_REL(ABSOLUTE),
+                             DST_SEL_X(SQ_SEL_X),
+                             DST_SEL_Y(SQ_SEL_Y),
+                             DST_SEL_Z(SQ_SEL_Z),
+                             DST_SEL_W(SQ_SEL_MASK),
+                             LOD_BIAS(0),
+                             COORD_TYPE_X(TEX_NORMALIZED),
+                             COORD_TYPE_Y(TEX_NORMALIZED),
+                             COORD_TYPE_Z(TEX_NORMALIZED),
+                             COORD_TYPE_W(TEX_NORMALIZED));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD2(OFFSET_X(0),
+                             OFFSET_Y(0),
+                             OFFSET_Z(0),
+                             SAMPLER_ID(3),
+                             SRC_SEL_X(SQ_SEL_X),
+                             SRC_SEL_Y(SQ_SEL_0),
+                             SRC_SEL_Z(SQ_SEL_0),
+                             SRC_SEL_W(SQ_SEL_1));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD_PAD;
+    /* 34/35 - filter weights and offsets for y */
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
+                             BC_FRAC_MODE(0),
+                             FETCH_WHOLE_QUAD(0),
+                             RESOURCE_ID(3),
+                             SRC_GPR(3),
+                             SRC_REL(ABSOLUTE),
+                             R7xx_ALT_CONST(0));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD1(DST_GPR(5),
+                             DST_REL(ABSOLUTE),
+                             DST_SEL_X(SQ_SEL_X),
+                             DST_SEL_Y(SQ_SEL_Y),
+                             DST_SEL_Z(SQ_SEL_Z),
+                             DST_SEL_W(SQ_SEL_MASK),
+                             LOD_BIAS(0),
+                             COORD_TYPE_X(TEX_NORMALIZED),
+                             COORD_TYPE_Y(TEX_NORMALIZED),
+                             COORD_TYPE_Z(TEX_NORMALIZED),
+                             COORD_TYPE_W(TEX_NORMALIZED));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD2(OFFSET_X(0),
+                             OFFSET_Y(0),
+                             OFFSET_Z(0),
+                             SAMPLER_ID(3),
+                             SRC_SEL_X(SQ_SEL_Y),
+                             SRC_SEL_Y(SQ_SEL_0),
+                             SRC_SEL_Z(SQ_SEL_0),
+                             SRC_SEL_W(SQ_SEL_1));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD_PAD;
+    /* 36/37 - V */
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
+                             BC_FRAC_MODE(0),
+                             FETCH_WHOLE_QUAD(0),
+                             RESOURCE_ID(1),
+                             SRC_GPR(0),
+                             SRC_REL(ABSOLUTE),
+                             R7xx_ALT_CONST(0));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD1(DST_GPR(1),
+                             DST_REL(ABSOLUTE),
+                             DST_SEL_X(SQ_SEL_MASK),
+                             DST_SEL_Y(SQ_SEL_MASK),
+                             DST_SEL_Z(SQ_SEL_X),
+                             DST_SEL_W(SQ_SEL_MASK),
+                             LOD_BIAS(0),
+                             COORD_TYPE_X(TEX_NORMALIZED),
+                             COORD_TYPE_Y(TEX_NORMALIZED),
+                             COORD_TYPE_Z(TEX_NORMALIZED),
+                             COORD_TYPE_W(TEX_NORMALIZED));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD2(OFFSET_X(0),
+                             OFFSET_Y(0),
+                             OFFSET_Z(0),
+                             SAMPLER_ID(1),
+                             SRC_SEL_X(SQ_SEL_X),
+                             SRC_SEL_Y(SQ_SEL_Y),
+                             SRC_SEL_Z(SQ_SEL_0),
+                             SRC_SEL_W(SQ_SEL_1));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD_PAD;
+    /* 38/39 - U */
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
+                             BC_FRAC_MODE(0),
+                             FETCH_WHOLE_QUAD(0),
+                             RESOURCE_ID(2),
+                             SRC_GPR(0),
+                             SRC_REL(ABSOLUTE),
+                             R7xx_ALT_CONST(0));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD1(DST_GPR(1),
+                             DST_REL(ABSOLUTE),
+                             DST_SEL_X(SQ_SEL_MASK),
+                             DST_SEL_Y(SQ_SEL_X),
+                             DST_SEL_Z(SQ_SEL_MASK),
+                             DST_SEL_W(SQ_SEL_MASK),
+                             LOD_BIAS(0),
+                             COORD_TYPE_X(TEX_NORMALIZED),
+                             COORD_TYPE_Y(TEX_NORMALIZED),
+                             COORD_TYPE_Z(TEX_NORMALIZED),
+                             COORD_TYPE_W(TEX_NORMALIZED));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD2(OFFSET_X(0),
+                             OFFSET_Y(0),
+                             OFFSET_Z(0),
+                             SAMPLER_ID(2),
+                             SRC_SEL_X(SQ_SEL_X),
+                             SRC_SEL_Y(SQ_SEL_Y),
+                             SRC_SEL_Z(SQ_SEL_0),
+                             SRC_SEL_W(SQ_SEL_1));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD_PAD;
+    /* 40/41 - Y top left */
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
+                             BC_FRAC_MODE(0),
+                             FETCH_WHOLE_QUAD(0),
+                             RESOURCE_ID(0),
+                             SRC_GPR(6),
+                             SRC_REL(ABSOLUTE),
+                             R7xx_ALT_CONST(0));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD1(DST_GPR(7),
+                             DST_REL(ABSOLUTE),
+                             DST_SEL_X(SQ_SEL_X),
+                             DST_SEL_Y(SQ_SEL_MASK),
+                             DST_SEL_Z(SQ_SEL_MASK),
+                             DST_SEL_W(SQ_SEL_MASK),
+                             LOD_BIAS(0),
+                             COORD_TYPE_X(TEX_NORMALIZED),
+                             COORD_TYPE_Y(TEX_NORMALIZED),
+                             COORD_TYPE_Z(TEX_NORMALIZED),
+                             COORD_TYPE_W(TEX_NORMALIZED));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD2(OFFSET_X(0),
+                             OFFSET_Y(0),
+                             OFFSET_Z(0),
+                             SAMPLER_ID(0),
+                             SRC_SEL_X(SQ_SEL_X),
+                             SRC_SEL_Y(SQ_SEL_Y),
+                             SRC_SEL_Z(SQ_SEL_0),
+                             SRC_SEL_W(SQ_SEL_1));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD_PAD;
+    /* 42/43 - Y top right */
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
+                             BC_FRAC_MODE(0),
+                             FETCH_WHOLE_QUAD(0),
+                             RESOURCE_ID(0),
+                             SRC_GPR(6),
+                             SRC_REL(ABSOLUTE),
+                             R7xx_ALT_CONST(0));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD1(DST_GPR(7),
+                             DST_REL(ABSOLUTE),
+                             DST_SEL_X(SQ_SEL_MASK),
+                             DST_SEL_Y(SQ_SEL_X),
+                             DST_SEL_Z(SQ_SEL_MASK),
+                             DST_SEL_W(SQ_SEL_MASK),
+                             LOD_BIAS(0),
+                             COORD_TYPE_X(TEX_NORMALIZED),
+                             COORD_TYPE_Y(TEX_NORMALIZED),
+                             COORD_TYPE_Z(TEX_NORMALIZED),
+                             COORD_TYPE_W(TEX_NORMALIZED));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD2(OFFSET_X(0),
+                             OFFSET_Y(0),
+                             OFFSET_Z(0),
+                             SAMPLER_ID(0),
+                             SRC_SEL_X(SQ_SEL_Z),
+                             SRC_SEL_Y(SQ_SEL_Y),
+                             SRC_SEL_Z(SQ_SEL_0),
+                             SRC_SEL_W(SQ_SEL_1));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD_PAD;
+    /* 44/45 - Y bottom left */
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
+                             BC_FRAC_MODE(0),
+                             FETCH_WHOLE_QUAD(0),
+                             RESOURCE_ID(0),
+                             SRC_GPR(6),
+                             SRC_REL(ABSOLUTE),
+                             R7xx_ALT_CONST(0));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD1(DST_GPR(7),
+                             DST_REL(ABSOLUTE),
+                             DST_SEL_X(SQ_SEL_MASK),
+                             DST_SEL_Y(SQ_SEL_MASK),
+                             DST_SEL_Z(SQ_SEL_X),
+                             DST_SEL_W(SQ_SEL_MASK),
+                             LOD_BIAS(0),
+                             COORD_TYPE_X(TEX_NORMALIZED),
+                             COORD_TYPE_Y(TEX_NORMALIZED),
+                             COORD_TYPE_Z(TEX_NORMALIZED),
+                             COORD_TYPE_W(TEX_NORMALIZED));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD2(OFFSET_X(0),
+                             OFFSET_Y(0),
+                             OFFSET_Z(0),
+                             SAMPLER_ID(0),
+                             SRC_SEL_X(SQ_SEL_X),
+                             SRC_SEL_Y(SQ_SEL_W),
+                             SRC_SEL_Z(SQ_SEL_0),
+                             SRC_SEL_W(SQ_SEL_1));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD_PAD;
+    /* 46/47 - Y bottom right */
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
+                             BC_FRAC_MODE(0),
+                             FETCH_WHOLE_QUAD(0),
+                             RESOURCE_ID(0),
+                             SRC_GPR(6),
+                             SRC_REL(ABSOLUTE),
+                             R7xx_ALT_CONST(0));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD1(DST_GPR(7),
+                             DST_REL(ABSOLUTE),
+                             DST_SEL_X(SQ_SEL_MASK),
+                             DST_SEL_Y(SQ_SEL_MASK),
+                             DST_SEL_Z(SQ_SEL_MASK),
+                             DST_SEL_W(SQ_SEL_X),
+                             LOD_BIAS(0),
+                             COORD_TYPE_X(TEX_NORMALIZED),
+                             COORD_TYPE_Y(TEX_NORMALIZED),
+                             COORD_TYPE_Z(TEX_NORMALIZED),
+                             COORD_TYPE_W(TEX_NORMALIZED));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD2(OFFSET_X(0),
+                             OFFSET_Y(0),
+                             OFFSET_Z(0),
+                             SAMPLER_ID(0),
+                             SRC_SEL_X(SQ_SEL_Z),
+                             SRC_SEL_Y(SQ_SEL_W),
+                             SRC_SEL_Z(SQ_SEL_0),
+                             SRC_SEL_W(SQ_SEL_1));
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD_PAD;
+
+    /* 48 - gamma: r2.xyz = 2 ^ (log2(r2.xyz) * c1.w) */
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD0(ADDR(50),
+                                KCACHE_BANK0(0),
+                                KCACHE_BANK1(0),
+                                KCACHE_MODE0(SQ_CF_KCACHE_NOP));
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
+                                KCACHE_ADDR0(0),
+                                KCACHE_ADDR1(0),
+                                I_COUNT(9),
+                                USES_WATERFALL(0),
+                                CF_INST(SQ_CF_INST_ALU),
+                                WHOLE_QUAD_MODE(0),
+                                BARRIER(1));
+    /* 49 */
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(0));
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
+                            CF_CONST(0),
+                            COND(SQ_CF_COND_ACTIVE),
+                            I_COUNT(0),
+                            CALL_COUNT(0),
+                            END_OF_PROGRAM(0),
+                            VALID_PIXEL_MODE(0),
+                            CF_INST(SQ_CF_INST_RETURN),
+                            WHOLE_QUAD_MODE(0),
+                            BARRIER(1));
+    /* 50 */
+    /* r2.x = LOG_CLAMPED(r2.x) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_X),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(ChipSet,
+                                 SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(1),
+                                 FOG_MERGE(0),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_LOG_CLAMPED),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_X),
+                                 CLAMP(0));
+    /* 51 */
+    /* r2.y = LOG_CLAMPED(r2.y) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Y),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Y),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(ChipSet,
+                                 SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(1),
+                                 FOG_MERGE(0),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_LOG_CLAMPED),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Y),
+                                 CLAMP(0));
+    /* 52 */
+    /* r2.z = LOG_CLAMPED(r2.z) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_Z),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_Z),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(ChipSet,
+                                 SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(1),
+                                 FOG_MERGE(0),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_LOG_CLAMPED),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
+                                 DST_ELEM(ELEM_Z),
+                                 CLAMP(0));
+    /* 53,54,55 */
+    /* r2.x = MUL(r2.x, c1.w) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+                             SRC0_REL(ABSOLUTE),
+                             SRC0_ELEM(ELEM_X),
+                             SRC0_NEG(0),
+                             SRC1_SEL(ALU_SRC_CFILE_BASE + 1),
+                             SRC1_REL(ABSOLUTE),
+                             SRC1_ELEM(ELEM_W),
+                             SRC1_NEG(0),
+                             INDEX_MODE(SQ_INDEX_LOOP),
+                             PRED_SEL(SQ_PRED_SEL_OFF),
+                             LAST(0));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(ChipSet,
+                                 SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(1),
+                                 FOG_MERGE(0),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_MUL),
+                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
+                                 DST_GPR(2),
+                                 DST_REL(ABSOLUTE),
                                  DST_ELEM(ELEM_X),
                                  CLAMP(0));
-    /* r2.y = MAD(c1.y, r1.y, pv.y) */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_CFILE_BASE + 1),
+    /* r2.y = MUL(r2.y, c1.w) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_Y),
                              SRC0_NEG(0),
-                             SRC1_SEL(ALU_SRC_GPR_BASE + 1),
+                             SRC1_SEL(ALU_SRC_CFILE_BASE + 1),
                              SRC1_REL(ABSOLUTE),
-                             SRC1_ELEM(ELEM_Y),
+                             SRC1_ELEM(ELEM_W),
                              SRC1_NEG(0),
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_PV),
-                                 SRC2_REL(ABSOLUTE),
-                                 SRC2_ELEM(ELEM_Y),
-                                 SRC2_NEG(0),
-                                 ALU_INST(SQ_OP3_INST_MULADD),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(ChipSet,
+                                 SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(1),
+                                 FOG_MERGE(0),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_MUL),
                                  BANK_SWIZZLE(SQ_ALU_VEC_012),
                                  DST_GPR(2),
                                  DST_REL(ABSOLUTE),
                                  DST_ELEM(ELEM_Y),
                                  CLAMP(0));
-    /* r2.z = MAD(c1.z, r1.y, pv.z) */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_CFILE_BASE + 1),
+    /* r2.z = MUL(r2.z, c1.w) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_Z),
                              SRC0_NEG(0),
-                             SRC1_SEL(ALU_SRC_GPR_BASE + 1),
+                             SRC1_SEL(ALU_SRC_CFILE_BASE + 1),
                              SRC1_REL(ABSOLUTE),
-                             SRC1_ELEM(ELEM_Y),
+                             SRC1_ELEM(ELEM_W),
                              SRC1_NEG(0),
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
-                             LAST(0));
-    shader[i++] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_PV),
-                                 SRC2_REL(ABSOLUTE),
-                                 SRC2_ELEM(ELEM_Z),
-                                 SRC2_NEG(0),
-                                 ALU_INST(SQ_OP3_INST_MULADD),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(ChipSet,
+                                 SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(1),
+                                 FOG_MERGE(0),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_MUL),
                                  BANK_SWIZZLE(SQ_ALU_VEC_012),
                                  DST_GPR(2),
                                  DST_REL(ABSOLUTE),
                                  DST_ELEM(ELEM_Z),
                                  CLAMP(0));
-    /* r2.w = MAD(0, 0, 1) */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(SQ_ALU_SRC_0),
+    /* 56 */
+    /* r2.x = EXP_IEEE(r2.x) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_X),
                              SRC0_NEG(0),
-                             SRC1_SEL(SQ_ALU_SRC_0),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 2),
                              SRC1_REL(ABSOLUTE),
                              SRC1_ELEM(ELEM_X),
                              SRC1_NEG(0),
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(1));
-    shader[i++] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_1),
-                                 SRC2_REL(ABSOLUTE),
-                                 SRC2_ELEM(ELEM_W),
-                                 SRC2_NEG(0),
-                                 ALU_INST(SQ_OP3_INST_MULADD),
-                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
-                                 DST_GPR(2),
-                                 DST_REL(ABSOLUTE),
-                                 DST_ELEM(ELEM_W),
-                                 CLAMP(0));
-    /* 12,13,14,15 */
-    /* r2.x = MAD(c2.x, r1.z, pv.x) */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_CFILE_BASE + 2),
-                             SRC0_REL(ABSOLUTE),
-                             SRC0_ELEM(ELEM_X),
-                             SRC0_NEG(0),
-                             SRC1_SEL(ALU_SRC_GPR_BASE + 1),
-                             SRC1_REL(ABSOLUTE),
-                             SRC1_ELEM(ELEM_Z),
-                             SRC1_NEG(0),
-                             INDEX_MODE(SQ_INDEX_LOOP),
-                             PRED_SEL(SQ_PRED_SEL_OFF),
-                             LAST(0));
-    shader[i++] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_PV),
-                                 SRC2_REL(ABSOLUTE),
-                                 SRC2_ELEM(ELEM_X),
-                                 SRC2_NEG(0),
-                                 ALU_INST(SQ_OP3_INST_MULADD),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(ChipSet,
+                                 SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(1),
+                                 FOG_MERGE(0),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_EXP_IEEE),
                                  BANK_SWIZZLE(SQ_ALU_VEC_012),
                                  DST_GPR(2),
                                  DST_REL(ABSOLUTE),
                                  DST_ELEM(ELEM_X),
                                  CLAMP(1));
-    /* r2.y = MAD(c2.y, r1.z, pv.y) */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_CFILE_BASE + 2),
+    /* 57 */
+    /* r2.y = EXP_IEEE(r2.y) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_Y),
                              SRC0_NEG(0),
-                             SRC1_SEL(ALU_SRC_GPR_BASE + 1),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 2),
                              SRC1_REL(ABSOLUTE),
-                             SRC1_ELEM(ELEM_Z),
+                             SRC1_ELEM(ELEM_Y),
                              SRC1_NEG(0),
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
-                             LAST(0));
-    shader[i++] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_PV),
-                                 SRC2_REL(ABSOLUTE),
-                                 SRC2_ELEM(ELEM_Y),
-                                 SRC2_NEG(0),
-                                 ALU_INST(SQ_OP3_INST_MULADD),
+                             LAST(1));
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(ChipSet,
+                                 SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(1),
+                                 FOG_MERGE(0),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_EXP_IEEE),
                                  BANK_SWIZZLE(SQ_ALU_VEC_012),
                                  DST_GPR(2),
                                  DST_REL(ABSOLUTE),
                                  DST_ELEM(ELEM_Y),
                                  CLAMP(1));
-    /* r2.z = MAD(c2.z, r1.z, pv.z) */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_CFILE_BASE + 2),
+    /* 58 */
+    /* r2.z = EXP_IEEE(r2.z) */
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_Z),
                              SRC0_NEG(0),
-                             SRC1_SEL(ALU_SRC_GPR_BASE + 1),
+                             SRC1_SEL(ALU_SRC_GPR_BASE + 2),
                              SRC1_REL(ABSOLUTE),
                              SRC1_ELEM(ELEM_Z),
                              SRC1_NEG(0),
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
-                             LAST(0));
-    shader[i++] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_PV),
-                                 SRC2_REL(ABSOLUTE),
-                                 SRC2_ELEM(ELEM_Z),
-                                 SRC2_NEG(0),
-                                 ALU_INST(SQ_OP3_INST_MULADD),
-                                 BANK_SWIZZLE(SQ_ALU_VEC_012),
-                                 DST_GPR(2),
-                                 DST_REL(ABSOLUTE),
-                                 DST_ELEM(ELEM_Z),
-                                 CLAMP(1));
-    /* r2.w = MAD(0, 0, 1) */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(SQ_ALU_SRC_0),
-                             SRC0_REL(ABSOLUTE),
-                             SRC0_ELEM(ELEM_X),
-                             SRC0_NEG(0),
-                             SRC1_SEL(SQ_ALU_SRC_0),
-                             SRC1_REL(ABSOLUTE),
-                             SRC1_ELEM(ELEM_X),
-                             SRC1_NEG(0),
-                             INDEX_MODE(SQ_INDEX_LOOP),
-                             PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(1));
-    shader[i++] = ALU_DWORD1_OP3(SRC2_SEL(SQ_ALU_SRC_1),
-                                 SRC2_REL(ABSOLUTE),
-                                 SRC2_ELEM(ELEM_X),
-                                 SRC2_NEG(0),
-                                 ALU_INST(SQ_OP3_INST_MULADD),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(ChipSet,
+                                 SRC0_ABS(0),
+                                 SRC1_ABS(0),
+                                 UPDATE_EXECUTE_MASK(0),
+                                 UPDATE_PRED(0),
+                                 WRITE_MASK(1),
+                                 FOG_MERGE(0),
+                                 OMOD(SQ_ALU_OMOD_OFF),
+                                 ALU_INST(SQ_OP2_INST_EXP_IEEE),
                                  BANK_SWIZZLE(SQ_ALU_VEC_012),
                                  DST_GPR(2),
                                  DST_REL(ABSOLUTE),
-                                 DST_ELEM(ELEM_W),
+                                 DST_ELEM(ELEM_Z),
                                  CLAMP(1));
 
-    /* 16 */
-    shader[i++] = CF_DWORD0(ADDR(18));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
-                            CF_CONST(0),
-                            COND(SQ_CF_COND_ACTIVE),
-                            I_COUNT(3),
-                            CALL_COUNT(0),
-                            END_OF_PROGRAM(0),
-                            VALID_PIXEL_MODE(0),
-                            CF_INST(SQ_CF_INST_TEX),
-                            WHOLE_QUAD_MODE(0),
-                            BARRIER(1));
-    /* 17 */
-    shader[i++] = CF_DWORD0(ADDR(0));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
-			    CF_CONST(0),
-			    COND(SQ_CF_COND_ACTIVE),
-			    I_COUNT(0),
-			    CALL_COUNT(0),
-			    END_OF_PROGRAM(0),
-			    VALID_PIXEL_MODE(0),
-			    CF_INST(SQ_CF_INST_RETURN),
-			    WHOLE_QUAD_MODE(0),
-			    BARRIER(1));
-    /* 18/19 */
-    shader[i++] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
-                             BC_FRAC_MODE(0),
-                             FETCH_WHOLE_QUAD(0),
-                             RESOURCE_ID(0),
-                             SRC_GPR(0),
-                             SRC_REL(ABSOLUTE),
-                             R7xx_ALT_CONST(0));
-    shader[i++] = TEX_DWORD1(DST_GPR(1),
-                             DST_REL(ABSOLUTE),
-                             DST_SEL_X(SQ_SEL_X),
-                             DST_SEL_Y(SQ_SEL_MASK),
-                             DST_SEL_Z(SQ_SEL_MASK),
-                             DST_SEL_W(SQ_SEL_1),
-                             LOD_BIAS(0),
-                             COORD_TYPE_X(TEX_NORMALIZED),
-                             COORD_TYPE_Y(TEX_NORMALIZED),
-                             COORD_TYPE_Z(TEX_NORMALIZED),
-                             COORD_TYPE_W(TEX_NORMALIZED));
-    shader[i++] = TEX_DWORD2(OFFSET_X(0),
-                             OFFSET_Y(0),
-                             OFFSET_Z(0),
-                             SAMPLER_ID(0),
-                             SRC_SEL_X(SQ_SEL_X),
-                             SRC_SEL_Y(SQ_SEL_Y),
-                             SRC_SEL_Z(SQ_SEL_0),
-                             SRC_SEL_W(SQ_SEL_1));
-    shader[i++] = TEX_DWORD_PAD;
-    /* 20/21 */
-    shader[i++] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
-                             BC_FRAC_MODE(0),
-                             FETCH_WHOLE_QUAD(0),
-                             RESOURCE_ID(1),
-                             SRC_GPR(0),
-                             SRC_REL(ABSOLUTE),
-                             R7xx_ALT_CONST(0));
-    shader[i++] = TEX_DWORD1(DST_GPR(1),
-                             DST_REL(ABSOLUTE),
-                             DST_SEL_X(SQ_SEL_MASK),
-                             DST_SEL_Y(SQ_SEL_MASK),
-                             DST_SEL_Z(SQ_SEL_X),
-                             DST_SEL_W(SQ_SEL_MASK),
-                             LOD_BIAS(0),
-                             COORD_TYPE_X(TEX_NORMALIZED),
-                             COORD_TYPE_Y(TEX_NORMALIZED),
-                             COORD_TYPE_Z(TEX_NORMALIZED),
-                             COORD_TYPE_W(TEX_NORMALIZED));
-    shader[i++] = TEX_DWORD2(OFFSET_X(0),
-                             OFFSET_Y(0),
-                             OFFSET_Z(0),
-                             SAMPLER_ID(1),
-                             SRC_SEL_X(SQ_SEL_X),
-                             SRC_SEL_Y(SQ_SEL_Y),
-                             SRC_SEL_Z(SQ_SEL_0),
-                             SRC_SEL_W(SQ_SEL_1));
-    shader[i++] = TEX_DWORD_PAD;
-    /* 22/23 */
-    shader[i++] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
-                             BC_FRAC_MODE(0),
-                             FETCH_WHOLE_QUAD(0),
-                             RESOURCE_ID(2),
-                             SRC_GPR(0),
-                             SRC_REL(ABSOLUTE),
-                             R7xx_ALT_CONST(0));
-    shader[i++] = TEX_DWORD1(DST_GPR(1),
-                             DST_REL(ABSOLUTE),
-                             DST_SEL_X(SQ_SEL_MASK),
-                             DST_SEL_Y(SQ_SEL_X),
-                             DST_SEL_Z(SQ_SEL_MASK),
-                             DST_SEL_W(SQ_SEL_MASK),
-                             LOD_BIAS(0),
-                             COORD_TYPE_X(TEX_NORMALIZED),
-                             COORD_TYPE_Y(TEX_NORMALIZED),
-                             COORD_TYPE_Z(TEX_NORMALIZED),
-                             COORD_TYPE_W(TEX_NORMALIZED));
-    shader[i++] = TEX_DWORD2(OFFSET_X(0),
-                             OFFSET_Y(0),
-                             OFFSET_Z(0),
-                             SAMPLER_ID(2),
-                             SRC_SEL_X(SQ_SEL_X),
-                             SRC_SEL_Y(SQ_SEL_Y),
-                             SRC_SEL_Z(SQ_SEL_0),
-                             SRC_SEL_W(SQ_SEL_1));
-    shader[i++] = TEX_DWORD_PAD;
-    /* 24 */
-    shader[i++] = CF_DWORD0(ADDR(26));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
-                            CF_CONST(0),
-                            COND(SQ_CF_COND_ACTIVE),
-                            I_COUNT(1),
-                            CALL_COUNT(0),
-                            END_OF_PROGRAM(0),
-                            VALID_PIXEL_MODE(0),
-                            CF_INST(SQ_CF_INST_TEX),
-                            WHOLE_QUAD_MODE(0),
-                            BARRIER(1));
-    /* 25 */
-    shader[i++] = CF_DWORD0(ADDR(0));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
-			    CF_CONST(0),
-			    COND(SQ_CF_COND_ACTIVE),
-			    I_COUNT(0),
-			    CALL_COUNT(0),
-			    END_OF_PROGRAM(0),
-			    VALID_PIXEL_MODE(0),
-			    CF_INST(SQ_CF_INST_RETURN),
-			    WHOLE_QUAD_MODE(0),
-			    BARRIER(1));
-    /* 26/27 */
-    shader[i++] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
-                             BC_FRAC_MODE(0),
-                             FETCH_WHOLE_QUAD(0),
-                             RESOURCE_ID(0),
-                             SRC_GPR(0),
-                             SRC_REL(ABSOLUTE),
-                             R7xx_ALT_CONST(0));
-    shader[i++] = TEX_DWORD1(DST_GPR(1),
-                             DST_REL(ABSOLUTE),
-                             DST_SEL_X(SQ_SEL_X),
-                             DST_SEL_Y(SQ_SEL_Y),
-                             DST_SEL_Z(SQ_SEL_Z),
-                             DST_SEL_W(SQ_SEL_1),
-                             LOD_BIAS(0),
-                             COORD_TYPE_X(TEX_NORMALIZED),
-                             COORD_TYPE_Y(TEX_NORMALIZED),
-                             COORD_TYPE_Z(TEX_NORMALIZED),
-                             COORD_TYPE_W(TEX_NORMALIZED));
-    shader[i++] = TEX_DWORD2(OFFSET_X(0),
-                             OFFSET_Y(0),
-                             OFFSET_Z(0),
-                             SAMPLER_ID(0),
-                             SRC_SEL_X(SQ_SEL_X),
-                             SRC_SEL_Y(SQ_SEL_Y),
-                             SRC_SEL_Z(SQ_SEL_0),
-                             SRC_SEL_W(SQ_SEL_1));
-    shader[i++] = TEX_DWORD_PAD;
-
     return i;
 }
 
 /* comp vs --------------------------------------- */
-int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
+int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t *shader, uint32_t variant, int max)
 {
     int i = 0;
 
     /* 0 */
-    shader[i++] = CF_DWORD0(ADDR(3));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(3));
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
                             CF_CONST(0),
                             COND(SQ_CF_COND_BOOL),
                             I_COUNT(0),
@@ -1159,8 +2612,8 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                             WHOLE_QUAD_MODE(0),
                             BARRIER(0));
     /* 1 */
-    shader[i++] = CF_DWORD0(ADDR(9));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(9));
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
                             CF_CONST(0),
                             COND(SQ_CF_COND_NOT_BOOL),
                             I_COUNT(0),
@@ -1171,8 +2624,8 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                             WHOLE_QUAD_MODE(0),
                             BARRIER(0));
     /* 2 */
-    shader[i++] = CF_DWORD0(ADDR(0));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(0));
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
                             CF_CONST(0),
                             COND(SQ_CF_COND_ACTIVE),
                             I_COUNT(0),
@@ -1183,8 +2636,8 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                             WHOLE_QUAD_MODE(0),
                             BARRIER(1));
     /* 3 - mask sub */
-    shader[i++] = CF_DWORD0(ADDR(44));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(44));
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
 			    CF_CONST(0),
 			    COND(SQ_CF_COND_ACTIVE),
 			    I_COUNT(3),
@@ -1196,11 +2649,11 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 			    BARRIER(1));
 
     /* 4 - ALU */
-    shader[i++] = CF_ALU_DWORD0(ADDR(14),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD0(ADDR(14),
 				KCACHE_BANK0(0),
 				KCACHE_BANK1(0),
 				KCACHE_MODE0(SQ_CF_KCACHE_NOP));
-    shader[i++] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
 				KCACHE_ADDR0(0),
 				KCACHE_ADDR1(0),
 				I_COUNT(20),
@@ -1210,13 +2663,13 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 				BARRIER(1));
 
     /* 5 - dst */
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(CF_POS0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(CF_POS0),
 					  TYPE(SQ_EXPORT_POS),
 					  RW_GPR(2),
 					  RW_REL(ABSOLUTE),
 					  INDEX_GPR(0),
 					  ELEM_SIZE(0));
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
 					       SRC_SEL_Y(SQ_SEL_Y),
 					       SRC_SEL_Z(SQ_SEL_0),
 					       SRC_SEL_W(SQ_SEL_1),
@@ -1228,13 +2681,13 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 					       WHOLE_QUAD_MODE(0),
 					       BARRIER(1));
     /* 6 - src */
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(0),
 					  TYPE(SQ_EXPORT_PARAM),
 					  RW_GPR(1),
 					  RW_REL(ABSOLUTE),
 					  INDEX_GPR(0),
 					  ELEM_SIZE(0));
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
 					       SRC_SEL_Y(SQ_SEL_Y),
 					       SRC_SEL_Z(SQ_SEL_0),
 					       SRC_SEL_W(SQ_SEL_1),
@@ -1246,13 +2699,13 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 					       WHOLE_QUAD_MODE(0),
 					       BARRIER(0));
     /* 7 - mask */
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(1),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(1),
 					  TYPE(SQ_EXPORT_PARAM),
 					  RW_GPR(0),
 					  RW_REL(ABSOLUTE),
 					  INDEX_GPR(0),
 					  ELEM_SIZE(0));
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
 					       SRC_SEL_Y(SQ_SEL_Y),
 					       SRC_SEL_Z(SQ_SEL_0),
 					       SRC_SEL_W(SQ_SEL_1),
@@ -1264,8 +2717,8 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 					       WHOLE_QUAD_MODE(0),
 					       BARRIER(0));
     /* 8 */
-    shader[i++] = CF_DWORD0(ADDR(0));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(0));
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
 			    CF_CONST(0),
 			    COND(SQ_CF_COND_ACTIVE),
 			    I_COUNT(0),
@@ -1276,8 +2729,8 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 			    WHOLE_QUAD_MODE(0),
 			    BARRIER(1));
     /* 9 - non-mask sub */
-    shader[i++] = CF_DWORD0(ADDR(50));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(50));
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
 			    CF_CONST(0),
 			    COND(SQ_CF_COND_ACTIVE),
 			    I_COUNT(2),
@@ -1289,11 +2742,11 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 			    BARRIER(1));
 
     /* 10 - ALU */
-    shader[i++] = CF_ALU_DWORD0(ADDR(34),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD0(ADDR(34),
 				KCACHE_BANK0(0),
 				KCACHE_BANK1(0),
 				KCACHE_MODE0(SQ_CF_KCACHE_NOP));
-    shader[i++] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
 				KCACHE_ADDR0(0),
 				KCACHE_ADDR1(0),
 				I_COUNT(10),
@@ -1303,13 +2756,13 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 				BARRIER(1));
 
     /* 11 - dst */
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(CF_POS0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(CF_POS0),
 					  TYPE(SQ_EXPORT_POS),
 					  RW_GPR(1),
 					  RW_REL(ABSOLUTE),
 					  INDEX_GPR(0),
 					  ELEM_SIZE(0));
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
 					       SRC_SEL_Y(SQ_SEL_Y),
 					       SRC_SEL_Z(SQ_SEL_0),
 					       SRC_SEL_W(SQ_SEL_1),
@@ -1321,13 +2774,13 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 					       WHOLE_QUAD_MODE(0),
 					       BARRIER(1));
     /* 12 - src */
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(0),
 					  TYPE(SQ_EXPORT_PARAM),
 					  RW_GPR(0),
 					  RW_REL(ABSOLUTE),
 					  INDEX_GPR(0),
 					  ELEM_SIZE(0));
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
 					       SRC_SEL_Y(SQ_SEL_Y),
 					       SRC_SEL_Z(SQ_SEL_0),
 					       SRC_SEL_W(SQ_SEL_1),
@@ -1339,8 +2792,8 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 					       WHOLE_QUAD_MODE(0),
 					       BARRIER(0));
     /* 13 */
-    shader[i++] = CF_DWORD0(ADDR(0));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(0));
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
 			    CF_CONST(0),
 			    COND(SQ_CF_COND_ACTIVE),
 			    I_COUNT(0),
@@ -1353,7 +2806,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 
 
     /* 14 srcX.x DOT4 - mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 1),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 1),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_X),
                              SRC0_NEG(0),
@@ -1364,7 +2817,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(ChipSet,
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(ChipSet,
                                  SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
@@ -1380,7 +2833,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 15 srcX.y DOT4 - mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 1),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 1),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_Y),
                              SRC0_NEG(0),
@@ -1391,7 +2844,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(ChipSet,
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(ChipSet,
                                  SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
@@ -1407,7 +2860,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 16 srcX.z DOT4 - mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 1),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 1),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_Z),
                              SRC0_NEG(0),
@@ -1418,7 +2871,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(ChipSet,
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(ChipSet,
                                  SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
@@ -1434,7 +2887,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 17 srcX.w DOT4 - mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 1),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 1),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_W),
                              SRC0_NEG(0),
@@ -1445,7 +2898,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(1));
-    shader[i++] = ALU_DWORD1_OP2(ChipSet,
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(ChipSet,
                                  SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
@@ -1461,7 +2914,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 18 srcY.x DOT4 - mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 1),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 1),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_X),
                              SRC0_NEG(0),
@@ -1472,7 +2925,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(ChipSet,
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(ChipSet,
                                  SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
@@ -1488,7 +2941,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 19 srcY.y DOT4 - mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 1),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 1),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_Y),
                              SRC0_NEG(0),
@@ -1499,7 +2952,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(ChipSet,
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(ChipSet,
                                  SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
@@ -1515,7 +2968,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 20 srcY.z DOT4 - mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 1),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 1),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_Z),
                              SRC0_NEG(0),
@@ -1526,7 +2979,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(ChipSet,
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(ChipSet,
                                  SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
@@ -1542,7 +2995,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 21 srcY.w DOT4 - mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 1),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 1),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_W),
                              SRC0_NEG(0),
@@ -1553,7 +3006,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(1));
-    shader[i++] = ALU_DWORD1_OP2(ChipSet,
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(ChipSet,
                                  SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
@@ -1569,7 +3022,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 22 maskX.x DOT4 - mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_X),
                              SRC0_NEG(0),
@@ -1580,7 +3033,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(ChipSet,
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(ChipSet,
                                  SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
@@ -1596,7 +3049,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 23 maskX.y DOT4 - mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_Y),
                              SRC0_NEG(0),
@@ -1607,7 +3060,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(ChipSet,
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(ChipSet,
                                  SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
@@ -1623,7 +3076,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 24 maskX.z DOT4 - mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_Z),
                              SRC0_NEG(0),
@@ -1634,7 +3087,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(ChipSet,
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(ChipSet,
                                  SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
@@ -1650,7 +3103,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 25 maskX.w DOT4 - mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_W),
                              SRC0_NEG(0),
@@ -1661,7 +3114,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(1));
-    shader[i++] = ALU_DWORD1_OP2(ChipSet,
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(ChipSet,
                                  SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
@@ -1677,7 +3130,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 26 maskY.x DOT4 - mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_X),
                              SRC0_NEG(0),
@@ -1688,7 +3141,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(ChipSet,
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(ChipSet,
                                  SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
@@ -1704,7 +3157,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 27 maskY.y DOT4 - mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_Y),
                              SRC0_NEG(0),
@@ -1715,7 +3168,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(ChipSet,
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(ChipSet,
                                  SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
@@ -1731,7 +3184,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 28 maskY.z DOT4 - mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_Z),
                              SRC0_NEG(0),
@@ -1742,7 +3195,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(ChipSet,
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(ChipSet,
                                  SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
@@ -1758,7 +3211,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 29 maskY.w DOT4 - mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_W),
                              SRC0_NEG(0),
@@ -1769,7 +3222,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(1));
-    shader[i++] = ALU_DWORD1_OP2(ChipSet,
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(ChipSet,
                                  SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
@@ -1785,7 +3238,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 30 srcX / w */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 3),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 3),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_X),
                              SRC0_NEG(0),
@@ -1796,7 +3249,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_AR_X),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(1));
-    shader[i++] = ALU_DWORD1_OP2(ChipSet,
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(ChipSet,
                                  SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
@@ -1812,7 +3265,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 31 srcY / h */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 3),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 3),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_Y),
                              SRC0_NEG(0),
@@ -1823,7 +3276,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_AR_X),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(1));
-    shader[i++] = ALU_DWORD1_OP2(ChipSet,
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(ChipSet,
                                  SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
@@ -1839,7 +3292,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 32 maskX / w */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 4),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 4),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_X),
                              SRC0_NEG(0),
@@ -1850,7 +3303,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_AR_X),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(1));
-    shader[i++] = ALU_DWORD1_OP2(ChipSet,
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(ChipSet,
                                  SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
@@ -1866,7 +3319,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 33 maskY / h */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 4),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 4),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_Y),
                              SRC0_NEG(0),
@@ -1877,7 +3330,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_AR_X),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(1));
-    shader[i++] = ALU_DWORD1_OP2(ChipSet,
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(ChipSet,
                                  SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
@@ -1893,7 +3346,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 34 srcX.x DOT4 - non-mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_X),
                              SRC0_NEG(0),
@@ -1904,7 +3357,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(ChipSet,
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(ChipSet,
                                  SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
@@ -1920,7 +3373,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 35 srcX.y DOT4 - non-mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_Y),
                              SRC0_NEG(0),
@@ -1931,7 +3384,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(ChipSet,
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(ChipSet,
                                  SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
@@ -1947,7 +3400,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 36 srcX.z DOT4 - non-mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_Z),
                              SRC0_NEG(0),
@@ -1958,7 +3411,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(ChipSet,
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(ChipSet,
                                  SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
@@ -1974,7 +3427,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 37 srcX.w DOT4 - non-mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_W),
                              SRC0_NEG(0),
@@ -1985,7 +3438,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(1));
-    shader[i++] = ALU_DWORD1_OP2(ChipSet,
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(ChipSet,
                                  SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
@@ -2001,7 +3454,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 38 srcY.x DOT4 - non-mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_X),
                              SRC0_NEG(0),
@@ -2012,7 +3465,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(ChipSet,
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(ChipSet,
                                  SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
@@ -2028,7 +3481,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 39 srcY.y DOT4 - non-mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_Y),
                              SRC0_NEG(0),
@@ -2039,7 +3492,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(ChipSet,
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(ChipSet,
                                  SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
@@ -2055,7 +3508,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 40 srcY.z DOT4 - non-mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_Z),
                              SRC0_NEG(0),
@@ -2066,7 +3519,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(ChipSet,
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(ChipSet,
                                  SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
@@ -2082,7 +3535,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 41 srcY.w DOT4 - non-mask */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 0),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_W),
                              SRC0_NEG(0),
@@ -2093,7 +3546,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_LOOP),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(1));
-    shader[i++] = ALU_DWORD1_OP2(ChipSet,
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(ChipSet,
                                  SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
@@ -2109,7 +3562,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 42 srcX / w */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_X),
                              SRC0_NEG(0),
@@ -2120,7 +3573,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_AR_X),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(1));
-    shader[i++] = ALU_DWORD1_OP2(ChipSet,
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(ChipSet,
                                  SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
@@ -2136,7 +3589,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 43 srcY / h */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 2),
                              SRC0_REL(ABSOLUTE),
                              SRC0_ELEM(ELEM_Y),
                              SRC0_NEG(0),
@@ -2147,7 +3600,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                              INDEX_MODE(SQ_INDEX_AR_X),
                              PRED_SEL(SQ_PRED_SEL_OFF),
                              LAST(1));
-    shader[i++] = ALU_DWORD1_OP2(ChipSet,
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(ChipSet,
                                  SRC0_ABS(0),
                                  SRC1_ABS(0),
                                  UPDATE_EXECUTE_MASK(0),
@@ -2163,7 +3616,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
                                  CLAMP(0));
 
     /* 44/45 - dst - mask */
-    shader[i++] = VTX_DWORD0(VTX_INST(SQ_VTX_INST_FETCH),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD0(VTX_INST(SQ_VTX_INST_FETCH),
 			     FETCH_TYPE(SQ_VTX_FETCH_VERTEX_DATA),
 			     FETCH_WHOLE_QUAD(0),
 			     BUFFER_ID(0),
@@ -2171,7 +3624,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 			     SRC_REL(ABSOLUTE),
 			     SRC_SEL_X(SQ_SEL_X),
 			     MEGA_FETCH_COUNT(24));
-    shader[i++] = VTX_DWORD1_GPR(DST_GPR(2),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD1_GPR(DST_GPR(2),
 				 DST_REL(0),
 				 DST_SEL_X(SQ_SEL_X),
 				 DST_SEL_Y(SQ_SEL_Y),
@@ -2182,7 +3635,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 				 NUM_FORMAT_ALL(SQ_NUM_FORMAT_SCALED),
 				 FORMAT_COMP_ALL(SQ_FORMAT_COMP_SIGNED),
 				 SRF_MODE_ALL(SRF_MODE_ZERO_CLAMP_MINUS_ONE));
-    shader[i++] = VTX_DWORD2(OFFSET(0),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD2(OFFSET(0),
 #if X_BYTE_ORDER == X_BIG_ENDIAN
                              ENDIAN_SWAP(SQ_ENDIAN_8IN32),
 #else
@@ -2190,9 +3643,9 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 #endif
 			     CONST_BUF_NO_STRIDE(0),
 			     MEGA_FETCH(1));
-    shader[i++] = VTX_DWORD_PAD;
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD_PAD;
     /* 46/47 - src */
-    shader[i++] = VTX_DWORD0(VTX_INST(SQ_VTX_INST_FETCH),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD0(VTX_INST(SQ_VTX_INST_FETCH),
 			     FETCH_TYPE(SQ_VTX_FETCH_VERTEX_DATA),
 			     FETCH_WHOLE_QUAD(0),
 			     BUFFER_ID(0),
@@ -2200,7 +3653,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 			     SRC_REL(ABSOLUTE),
 			     SRC_SEL_X(SQ_SEL_X),
 			     MEGA_FETCH_COUNT(8));
-    shader[i++] = VTX_DWORD1_GPR(DST_GPR(1),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD1_GPR(DST_GPR(1),
 				 DST_REL(0),
 				 DST_SEL_X(SQ_SEL_X),
 				 DST_SEL_Y(SQ_SEL_Y),
@@ -2211,7 +3664,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 				 NUM_FORMAT_ALL(SQ_NUM_FORMAT_SCALED),
 				 FORMAT_COMP_ALL(SQ_FORMAT_COMP_SIGNED),
 				 SRF_MODE_ALL(SRF_MODE_ZERO_CLAMP_MINUS_ONE));
-    shader[i++] = VTX_DWORD2(OFFSET(8),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD2(OFFSET(8),
 #if X_BYTE_ORDER == X_BIG_ENDIAN
                              ENDIAN_SWAP(SQ_ENDIAN_8IN32),
 #else
@@ -2219,9 +3672,9 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 #endif
 			     CONST_BUF_NO_STRIDE(0),
 			     MEGA_FETCH(0));
-    shader[i++] = VTX_DWORD_PAD;
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD_PAD;
     /* 48/49 - mask */
-    shader[i++] = VTX_DWORD0(VTX_INST(SQ_VTX_INST_FETCH),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD0(VTX_INST(SQ_VTX_INST_FETCH),
 			     FETCH_TYPE(SQ_VTX_FETCH_VERTEX_DATA),
 			     FETCH_WHOLE_QUAD(0),
 			     BUFFER_ID(0),
@@ -2229,7 +3682,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 			     SRC_REL(ABSOLUTE),
 			     SRC_SEL_X(SQ_SEL_X),
 			     MEGA_FETCH_COUNT(8));
-    shader[i++] = VTX_DWORD1_GPR(DST_GPR(0),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD1_GPR(DST_GPR(0),
 				 DST_REL(0),
 				 DST_SEL_X(SQ_SEL_X),
 				 DST_SEL_Y(SQ_SEL_Y),
@@ -2240,7 +3693,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 				 NUM_FORMAT_ALL(SQ_NUM_FORMAT_SCALED),
 				 FORMAT_COMP_ALL(SQ_FORMAT_COMP_SIGNED),
 				 SRF_MODE_ALL(SRF_MODE_ZERO_CLAMP_MINUS_ONE));
-    shader[i++] = VTX_DWORD2(OFFSET(16),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD2(OFFSET(16),
 #if X_BYTE_ORDER == X_BIG_ENDIAN
                              ENDIAN_SWAP(SQ_ENDIAN_8IN32),
 #else
@@ -2248,10 +3701,10 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 #endif
 			     CONST_BUF_NO_STRIDE(0),
 			     MEGA_FETCH(0));
-    shader[i++] = VTX_DWORD_PAD;
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD_PAD;
 
     /* 50/51 - dst - non-mask */
-    shader[i++] = VTX_DWORD0(VTX_INST(SQ_VTX_INST_FETCH),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD0(VTX_INST(SQ_VTX_INST_FETCH),
 			     FETCH_TYPE(SQ_VTX_FETCH_VERTEX_DATA),
 			     FETCH_WHOLE_QUAD(0),
 			     BUFFER_ID(0),
@@ -2259,7 +3712,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 			     SRC_REL(ABSOLUTE),
 			     SRC_SEL_X(SQ_SEL_X),
 			     MEGA_FETCH_COUNT(16));
-    shader[i++] = VTX_DWORD1_GPR(DST_GPR(1),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD1_GPR(DST_GPR(1),
 				 DST_REL(0),
 				 DST_SEL_X(SQ_SEL_X),
 				 DST_SEL_Y(SQ_SEL_Y),
@@ -2270,7 +3723,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 				 NUM_FORMAT_ALL(SQ_NUM_FORMAT_SCALED),
 				 FORMAT_COMP_ALL(SQ_FORMAT_COMP_SIGNED),
 				 SRF_MODE_ALL(SRF_MODE_ZERO_CLAMP_MINUS_ONE));
-    shader[i++] = VTX_DWORD2(OFFSET(0),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD2(OFFSET(0),
 #if X_BYTE_ORDER == X_BIG_ENDIAN
                              ENDIAN_SWAP(SQ_ENDIAN_8IN32),
 #else
@@ -2278,9 +3731,9 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 #endif
 			     CONST_BUF_NO_STRIDE(0),
 			     MEGA_FETCH(1));
-    shader[i++] = VTX_DWORD_PAD;
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD_PAD;
     /* 52/53 - src */
-    shader[i++] = VTX_DWORD0(VTX_INST(SQ_VTX_INST_FETCH),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD0(VTX_INST(SQ_VTX_INST_FETCH),
 			     FETCH_TYPE(SQ_VTX_FETCH_VERTEX_DATA),
 			     FETCH_WHOLE_QUAD(0),
 			     BUFFER_ID(0),
@@ -2288,7 +3741,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 			     SRC_REL(ABSOLUTE),
 			     SRC_SEL_X(SQ_SEL_X),
 			     MEGA_FETCH_COUNT(8));
-    shader[i++] = VTX_DWORD1_GPR(DST_GPR(0),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD1_GPR(DST_GPR(0),
 				 DST_REL(0),
 				 DST_SEL_X(SQ_SEL_X),
 				 DST_SEL_Y(SQ_SEL_Y),
@@ -2299,7 +3752,7 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 				 NUM_FORMAT_ALL(SQ_NUM_FORMAT_SCALED),
 				 FORMAT_COMP_ALL(SQ_FORMAT_COMP_SIGNED),
 				 SRF_MODE_ALL(SRF_MODE_ZERO_CLAMP_MINUS_ONE));
-    shader[i++] = VTX_DWORD2(OFFSET(8),
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD2(OFFSET(8),
 #if X_BYTE_ORDER == X_BIG_ENDIAN
                              ENDIAN_SWAP(SQ_ENDIAN_8IN32),
 #else
@@ -2307,19 +3760,30 @@ int R600_comp_vs(RADEONChipFamily ChipSet, uint32_t* shader)
 #endif
 			     CONST_BUF_NO_STRIDE(0),
 			     MEGA_FETCH(0));
-    shader[i++] = VTX_DWORD_PAD;
+    shader[RADEON_SHADER_DW(i, max)] = VTX_DWORD_PAD;
+
+    if (variant & RADEON_COMP_STATIC) {
+	/* mask or non-mask sub, then the end of the program */
+	static const int mask_cf[] = { 3, 5, 2, 1 };
+	static const int non_mask_cf[] = { 9, 4, 2, 1 };
+
+	if (variant & RADEON_COMP_MASK_TEX)
+	    radeon_shader_flatten(shader, mask_cf, 2);
+	else
+	    radeon_shader_flatten(shader, non_mask_cf, 2);
+    }
 
     return i;
 }
 
 /* comp ps --------------------------------------- */
-int R600_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
+int R600_comp_ps(RADEONChipFamily ChipSet, uint32_t *shader, uint32_t variant, int max)
 {
     int i = 0;
 
     /* 0 */
-    shader[i++] = CF_DWORD0(ADDR(3));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(3));
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
                             CF_CONST(0),
                             COND(SQ_CF_COND_BOOL),
                             I_COUNT(0),
@@ -2330,8 +3794,8 @@ int R600_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
                             WHOLE_QUAD_MODE(0),
                             BARRIER(0));
     /* 1 */
-    shader[i++] = CF_DWORD0(ADDR(7));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(7));
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
                             CF_CONST(0),
                             COND(SQ_CF_COND_NOT_BOOL),
                             I_COUNT(0),
@@ -2342,8 +3806,8 @@ int R600_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
                             WHOLE_QUAD_MODE(0),
                             BARRIER(0));
     /* 2 */
-    shader[i++] = CF_DWORD0(ADDR(0));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(0));
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
                             CF_CONST(0),
                             COND(SQ_CF_COND_ACTIVE),
                             I_COUNT(0),
@@ -2355,8 +3819,8 @@ int R600_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
                             BARRIER(1));
 
     /* 3 - mask sub */
-    shader[i++] = CF_DWORD0(ADDR(14));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(14));
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
 			    CF_CONST(0),
 			    COND(SQ_CF_COND_ACTIVE),
 			    I_COUNT(2),
@@ -2368,11 +3832,11 @@ int R600_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			    BARRIER(1));
 
     /* 4 */
-    shader[i++] = CF_ALU_DWORD0(ADDR(10),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD0(ADDR(10),
 				KCACHE_BANK0(0),
 				KCACHE_BANK1(0),
 				KCACHE_MODE0(SQ_CF_KCACHE_NOP));
-    shader[i++] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALU_DWORD1(KCACHE_MODE1(SQ_CF_KCACHE_NOP),
 				KCACHE_ADDR0(0),
 				KCACHE_ADDR1(0),
 				I_COUNT(4),
@@ -2382,13 +3846,13 @@ int R600_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 				BARRIER(1));
 
     /* 5 */
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(CF_PIXEL_MRT0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(CF_PIXEL_MRT0),
 					  TYPE(SQ_EXPORT_PIXEL),
 					  RW_GPR(2),
 					  RW_REL(ABSOLUTE),
 					  INDEX_GPR(0),
 					  ELEM_SIZE(1));
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
 					       SRC_SEL_Y(SQ_SEL_Y),
 					       SRC_SEL_Z(SQ_SEL_Z),
 					       SRC_SEL_W(SQ_SEL_W),
@@ -2400,8 +3864,8 @@ int R600_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 					       WHOLE_QUAD_MODE(0),
 					       BARRIER(1));
     /* 6 */
-    shader[i++] = CF_DWORD0(ADDR(0));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(0));
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
 			    CF_CONST(0),
 			    COND(SQ_CF_COND_ACTIVE),
 			    I_COUNT(0),
@@ -2413,8 +3877,8 @@ int R600_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			    BARRIER(1));
 
     /* 7 non-mask sub */
-    shader[i++] = CF_DWORD0(ADDR(18));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(18));
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
 			    CF_CONST(0),
 			    COND(SQ_CF_COND_ACTIVE),
 			    I_COUNT(1),
@@ -2425,13 +3889,13 @@ int R600_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			    WHOLE_QUAD_MODE(0),
 			    BARRIER(1));
     /* 8 */
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(CF_PIXEL_MRT0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD0(ARRAY_BASE(CF_PIXEL_MRT0),
 					  TYPE(SQ_EXPORT_PIXEL),
 					  RW_GPR(0),
 					  RW_REL(ABSOLUTE),
 					  INDEX_GPR(0),
 					  ELEM_SIZE(1));
-    shader[i++] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
+    shader[RADEON_SHADER_DW(i, max)] = CF_ALLOC_IMP_EXP_DWORD1_SWIZ(SRC_SEL_X(SQ_SEL_X),
 					       SRC_SEL_Y(SQ_SEL_Y),
 					       SRC_SEL_Z(SQ_SEL_Z),
 					       SRC_SEL_W(SQ_SEL_W),
@@ -2443,8 +3907,8 @@ int R600_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 					       WHOLE_QUAD_MODE(0),
 					       BARRIER(1));
     /* 9 */
-    shader[i++] = CF_DWORD0(ADDR(0));
-    shader[i++] = CF_DWORD1(POP_COUNT(0),
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD0(ADDR(0));
+    shader[RADEON_SHADER_DW(i, max)] = CF_DWORD1(POP_COUNT(0),
 			    CF_CONST(0),
 			    COND(SQ_CF_COND_ACTIVE),
 			    I_COUNT(0),
@@ -2457,7 +3921,7 @@ int R600_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 
     /* 10 - alu 0 */
     /* MUL gpr[2].x gpr[1].x gpr[0].x */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 1),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 1),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_X),
 			     SRC0_NEG(0),
@@ -2468,7 +3932,7 @@ int R600_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     INDEX_MODE(SQ_INDEX_LOOP),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(ChipSet,
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(ChipSet,
 				 SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
@@ -2484,7 +3948,7 @@ int R600_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 				 CLAMP(1));
     /* 11 - alu 1 */
     /* MUL gpr[2].y gpr[1].y gpr[0].y */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 1),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 1),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_Y),
 			     SRC0_NEG(0),
@@ -2495,7 +3959,7 @@ int R600_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     INDEX_MODE(SQ_INDEX_LOOP),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(ChipSet,
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(ChipSet,
 				 SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
@@ -2511,7 +3975,7 @@ int R600_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 				 CLAMP(1));
     /* 12 - alu 2 */
     /* MUL gpr[2].z gpr[1].z gpr[0].z */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 1),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 1),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_Z),
 			     SRC0_NEG(0),
@@ -2522,7 +3986,7 @@ int R600_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     INDEX_MODE(SQ_INDEX_LOOP),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(0));
-    shader[i++] = ALU_DWORD1_OP2(ChipSet,
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(ChipSet,
 				 SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
@@ -2538,7 +4002,7 @@ int R600_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 				 CLAMP(1));
     /* 13 - alu 3 */
     /* MUL gpr[2].w gpr[1].w gpr[0].w */
-    shader[i++] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 1),
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD0(SRC0_SEL(ALU_SRC_GPR_BASE + 1),
 			     SRC0_REL(ABSOLUTE),
 			     SRC0_ELEM(ELEM_W),
 			     SRC0_NEG(0),
@@ -2549,7 +4013,7 @@ int R600_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     INDEX_MODE(SQ_INDEX_LOOP),
 			     PRED_SEL(SQ_PRED_SEL_OFF),
 			     LAST(1));
-    shader[i++] = ALU_DWORD1_OP2(ChipSet,
+    shader[RADEON_SHADER_DW(i, max)] = ALU_DWORD1_OP2(ChipSet,
 				 SRC0_ABS(0),
 				 SRC1_ABS(0),
 				 UPDATE_EXECUTE_MASK(0),
@@ -2565,14 +4029,14 @@ int R600_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 				 CLAMP(1));
 
     /* 14/15 - src - mask */
-    shader[i++] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
 			     BC_FRAC_MODE(0),
 			     FETCH_WHOLE_QUAD(0),
 			     RESOURCE_ID(0),
 			     SRC_GPR(0),
 			     SRC_REL(ABSOLUTE),
 			     R7xx_ALT_CONST(0));
-    shader[i++] = TEX_DWORD1(DST_GPR(0),
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD1(DST_GPR(0),
 			     DST_REL(ABSOLUTE),
 			     DST_SEL_X(SQ_SEL_X),
 			     DST_SEL_Y(SQ_SEL_Y),
@@ -2583,7 +4047,7 @@ int R600_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     COORD_TYPE_Y(TEX_NORMALIZED),
 			     COORD_TYPE_Z(TEX_NORMALIZED),
 			     COORD_TYPE_W(TEX_NORMALIZED));
-    shader[i++] = TEX_DWORD2(OFFSET_X(0),
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD2(OFFSET_X(0),
 			     OFFSET_Y(0),
 			     OFFSET_Z(0),
 			     SAMPLER_ID(0),
@@ -2591,16 +4055,16 @@ int R600_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     SRC_SEL_Y(SQ_SEL_Y),
 			     SRC_SEL_Z(SQ_SEL_0),
 			     SRC_SEL_W(SQ_SEL_1));
-    shader[i++] = TEX_DWORD_PAD;
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD_PAD;
     /* 16/17 - mask */
-    shader[i++] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
 			     BC_FRAC_MODE(0),
 			     FETCH_WHOLE_QUAD(0),
 			     RESOURCE_ID(1),
 			     SRC_GPR(1),
 			     SRC_REL(ABSOLUTE),
 			     R7xx_ALT_CONST(0));
-    shader[i++] = TEX_DWORD1(DST_GPR(1),
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD1(DST_GPR(1),
 			     DST_REL(ABSOLUTE),
 			     DST_SEL_X(SQ_SEL_X),
 			     DST_SEL_Y(SQ_SEL_Y),
@@ -2611,7 +4075,7 @@ int R600_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     COORD_TYPE_Y(TEX_NORMALIZED),
 			     COORD_TYPE_Z(TEX_NORMALIZED),
 			     COORD_TYPE_W(TEX_NORMALIZED));
-    shader[i++] = TEX_DWORD2(OFFSET_X(0),
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD2(OFFSET_X(0),
 			     OFFSET_Y(0),
 			     OFFSET_Z(0),
 			     SAMPLER_ID(1),
@@ -2619,17 +4083,17 @@ int R600_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     SRC_SEL_Y(SQ_SEL_Y),
 			     SRC_SEL_Z(SQ_SEL_0),
 			     SRC_SEL_W(SQ_SEL_1));
-    shader[i++] = TEX_DWORD_PAD;
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD_PAD;
 
     /* 18/19 - src - non-mask */
-    shader[i++] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD0(TEX_INST(SQ_TEX_INST_SAMPLE),
 			     BC_FRAC_MODE(0),
 			     FETCH_WHOLE_QUAD(0),
 			     RESOURCE_ID(0),
 			     SRC_GPR(0),
 			     SRC_REL(ABSOLUTE),
 			     R7xx_ALT_CONST(0));
-    shader[i++] = TEX_DWORD1(DST_GPR(0),
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD1(DST_GPR(0),
 			     DST_REL(ABSOLUTE),
 			     DST_SEL_X(SQ_SEL_X),
 			     DST_SEL_Y(SQ_SEL_Y),
@@ -2640,7 +4104,7 @@ int R600_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     COORD_TYPE_Y(TEX_NORMALIZED),
 			     COORD_TYPE_Z(TEX_NORMALIZED),
 			     COORD_TYPE_W(TEX_NORMALIZED));
-    shader[i++] = TEX_DWORD2(OFFSET_X(0),
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD2(OFFSET_X(0),
 			     OFFSET_Y(0),
 			     OFFSET_Z(0),
 			     SAMPLER_ID(0),
@@ -2648,7 +4112,18 @@ int R600_comp_ps(RADEONChipFamily ChipSet, uint32_t* shader)
 			     SRC_SEL_Y(SQ_SEL_Y),
 			     SRC_SEL_Z(SQ_SEL_0),
 			     SRC_SEL_W(SQ_SEL_1));
-    shader[i++] = TEX_DWORD_PAD;
+    shader[RADEON_SHADER_DW(i, max)] = TEX_DWORD_PAD;
+
+    if (variant & RADEON_COMP_STATIC) {
+	/* mask or non-mask sub, then the end of the program */
+	static const int mask_cf[] = { 3, 3, 2, 1 };
+	static const int non_mask_cf[] = { 7, 2, 2, 1 };
+
+	if (variant & RADEON_COMP_MASK_TEX)
+	    radeon_shader_flatten(shader, mask_cf, 2);
+	else
+	    radeon_shader_flatten(shader, non_mask_cf, 2);
+    }
 
     return i;
 }
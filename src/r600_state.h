@@ -312,6 +312,12 @@ R600SetAccelState(ScrnInfoPtr pScrn,
 		  uint32_t vs_offset, uint32_t ps_offset,
 		  int rop, Pixel planemask);
 
+Bool
+R600CopyRect(ScrnInfoPtr pScrn,
+	     struct r600_accel_object *src_obj,
+	     struct r600_accel_object *dst_obj,
+	     int srcX, int srcY, int dstX, int dstY, int w, int h);
+
 extern Bool RADEONPrepareAccess_CS(PixmapPtr pPix, int index);
 extern void RADEONFinishAccess_CS(PixmapPtr pPix, int index);
 extern void *RADEONEXACreatePixmap(ScreenPtr pScreen, int size, int align);
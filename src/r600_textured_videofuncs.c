@@ -48,14 +48,20 @@
 #include "radeon_exa_shared.h"
 #include "radeon_vbo.h"
 
-/* Parameters for ITU-R BT.601 and ITU-R BT.709 colour spaces
-   note the difference to the parameters used in overlay are due
-   to 10bit vs. float calcs */
-static REF_TRANSFORM trans[2] =
+/* Sample a plane the port keeps tiled in VRAM */
+static void
+R600VideoPlaneTexture(tex_resource_t *tex_res, RADEONVideoPlaneRec *plane)
 {
-    {1.1643, 0.0, 1.5960, -0.3918, -0.8129, 2.0172, 0.0}, /* BT.601 */
-    {1.1643, 0.0, 1.7927, -0.2132, -0.5329, 2.1124, 0.0}  /* BT.709 */
-};
+    tex_res->w                   = plane->w;
+    tex_res->h                   = plane->h;
+    tex_res->pitch               = plane->pitch;
+    tex_res->base                = 0;
+    tex_res->mip_base            = 0;
+    tex_res->size                = plane->surface.bo_size;
+    tex_res->bo                  = plane->bo;
+    tex_res->mip_bo              = plane->bo;
+    tex_res->surface             = &plane->surface;
+}
 
 void
 R600DisplayTexturedVideo(ScrnInfoPtr pScrn, RADEONPortPrivPtr pPriv)
@@ -66,7 +72,9 @@ R600DisplayTexturedVideo(ScrnInfoPtr pScrn, RADEONPortPrivPtr pPriv)
     BoxPtr pBox = REGION_RECTS(&pPriv->clip);
     int nBox = REGION_NUM_RECTS(&pPriv->clip);
     int dstxoff, dstyoff;
-    struct r600_accel_object src_obj, dst_obj;
+    int bpc;
+    Bool tiled = RADEONVideoTiled(pPriv);
+    struct r600_accel_object src_obj, dst_obj, bicubic_obj;
     cb_config_t     cb_conf;
     tex_resource_t  tex_res;
     tex_sampler_t   tex_samp;
@@ -98,53 +106,20 @@ R600DisplayTexturedVideo(ScrnInfoPtr pScrn, RADEONPortPrivPtr pPriv)
      * temp = MAD(uco, yuv.uuuu, temp)
      * result = MAD(vco, yuv.vvvv, temp)
      */
-    /* TODO: calc consts in the shader */
-    const float Loff = -0.0627;
-    const float Coff = -0.502;
-    float uvcosf, uvsinf;
-    float yco;
-    float uco[3], vco[3], off[3];
-    float bright, cont, gamma;
-    int ref = pPriv->transform_index;
-    float ps_alu_consts[12];
+    /* cached per port, see RADEONTexturedVideoCSC() */
+    const float *csc = RADEONTexturedVideoCSC(pPriv);
+    Bool needgamma = pPriv->gamma != 1000;
+    float ps_alu_consts[16];
     float vs_alu_consts[4];
 
-    cont = RTFContrast(pPriv->contrast);
-    bright = RTFBrightness(pPriv->brightness);
-    gamma = (float)pPriv->gamma / 1000.0;
-    uvcosf = RTFSaturation(pPriv->saturation) * cos(RTFHue(pPriv->hue));
-    uvsinf = RTFSaturation(pPriv->saturation) * sin(RTFHue(pPriv->hue));
-    /* overlay video also does pre-gamma contrast/sat adjust, should we? */
-
-    yco = trans[ref].RefLuma * cont;
-    uco[0] = -trans[ref].RefRCr * uvsinf;
-    uco[1] = trans[ref].RefGCb * uvcosf - trans[ref].RefGCr * uvsinf;
-    uco[2] = trans[ref].RefBCb * uvcosf;
-    vco[0] = trans[ref].RefRCr * uvcosf;
-    vco[1] = trans[ref].RefGCb * uvsinf + trans[ref].RefGCr * uvcosf;
-    vco[2] = trans[ref].RefBCb * uvsinf;
-    off[0] = Loff * yco + Coff * (uco[0] + vco[0]) + bright;
-    off[1] = Loff * yco + Coff * (uco[1] + vco[1]) + bright;
-    off[2] = Loff * yco + Coff * (uco[2] + vco[2]) + bright;
-
-    // XXX
-    gamma = 1.0;
-
     /* setup the ps consts */
-    ps_alu_consts[0] = off[0];
-    ps_alu_consts[1] = off[1];
-    ps_alu_consts[2] = off[2];
-    ps_alu_consts[3] = yco;
-
-    ps_alu_consts[4] = uco[0];
-    ps_alu_consts[5] = uco[1];
-    ps_alu_consts[6] = uco[2];
-    ps_alu_consts[7] = gamma;
+    memcpy(ps_alu_consts, csc, 12 * sizeof(float));
 
-    ps_alu_consts[8] = vco[0];
-    ps_alu_consts[9] = vco[1];
-    ps_alu_consts[10] = vco[2];
-    ps_alu_consts[11] = 0.0;
+    /* luma plane size for the bicubic shader */
+    ps_alu_consts[12] = pPriv->w;
+    ps_alu_consts[13] = pPriv->h;
+    ps_alu_consts[14] = 1.0 / pPriv->w;
+    ps_alu_consts[15] = 1.0 / pPriv->h;
 
     CLEAR (cb_conf);
     CLEAR (tex_res);
@@ -153,6 +128,7 @@ R600DisplayTexturedVideo(ScrnInfoPtr pScrn, RADEONPortPrivPtr pPriv)
     CLEAR (ps_conf);
 
     dst_obj.bo = radeon_get_pixmap_bo(pPixmap);
+    dst_obj.offset = radeon_get_pixmap_offset(pPixmap);
     dst_obj.tiling_flags = radeon_get_pixmap_tiling(pPixmap);
     dst_obj.surface = radeon_get_pixmap_surface(pPixmap);
 
@@ -163,23 +139,47 @@ R600DisplayTexturedVideo(ScrnInfoPtr pScrn, RADEONPortPrivPtr pPriv)
     src_obj.height = pPriv->h;
     src_obj.bpp = 16;
     src_obj.domain = RADEON_GEM_DOMAIN_VRAM | RADEON_GEM_DOMAIN_GTT;
-    src_obj.bo = pPriv->src_bo[pPriv->currentBuffer];
+    src_obj.bo = RADEONVideoSourceBO(pPriv);
+    src_obj.offset = 0;
     src_obj.tiling_flags = 0;
     src_obj.surface = NULL;
 
     dst_obj.width = pPixmap->drawable.width;
     dst_obj.height = pPixmap->drawable.height;
     dst_obj.bpp = pPixmap->drawable.bitsPerPixel;
-    dst_obj.domain = RADEON_GEM_DOMAIN_VRAM;
+    dst_obj.domain = radeon_pixmap_write_domain(pPixmap);
+
+    /* 128x1 table of bicubic offsets and weights, 4 half floats each */
+    bicubic_obj.pitch = 128;
+    bicubic_obj.width = 128;
+    bicubic_obj.height = 1;
+    bicubic_obj.bpp = 64;
+    bicubic_obj.domain = RADEON_GEM_DOMAIN_VRAM;
+    bicubic_obj.bo = info->bicubic_bo;
+    bicubic_obj.offset = 0;
+    bicubic_obj.tiling_flags = 0;
+    bicubic_obj.surface = NULL;
 
     if (!R600SetAccelState(pScrn,
 			   &src_obj,
-			   NULL,
+			   pPriv->bicubic_enabled ? &bicubic_obj : NULL,
 			   &dst_obj,
-			   accel_state->xv_vs_offset, accel_state->xv_ps_offset,
+			   accel_state->xv_vs_offset,
+			   pPriv->bicubic_enabled ?
+			   accel_state->xv_bicubic_ps_offset : accel_state->xv_ps_offset,
 			   3, 0xffffffff))
 	return;
 
+    /* the chroma planes live in BOs of their own */
+    if (tiled) {
+	radeon_cs_space_add_persistent_bo(info->cs, pPriv->planes[1].bo,
+					  RADEON_GEM_DOMAIN_VRAM, 0);
+	radeon_cs_space_add_persistent_bo(info->cs, pPriv->planes[2].bo,
+					  RADEON_GEM_DOMAIN_VRAM, 0);
+	if (radeon_cs_space_check(info->cs))
+	    return;
+    }
+
 #ifdef COMPOSITE
     dstxoff = -pPixmap->screen_x + pPixmap->drawable.x;
     dstyoff = -pPixmap->screen_y + pPixmap->drawable.y;
@@ -201,12 +201,14 @@ R600DisplayTexturedVideo(ScrnInfoPtr pScrn, RADEONPortPrivPtr pPriv)
     switch(pPriv->id) {
     case FOURCC_YV12:
     case FOURCC_I420:
-	r600_set_bool_consts(pScrn, SQ_BOOL_CONST_ps, (1 << 0));
+    case FOURCC_NV12:
+    case FOURCC_P010:
+	r600_set_bool_consts(pScrn, SQ_BOOL_CONST_ps, (1 << 0) | (needgamma << 1));
 	break;
     case FOURCC_UYVY:
     case FOURCC_YUY2:
     default:
-	r600_set_bool_consts(pScrn, SQ_BOOL_CONST_ps, (0 << 0));
+	r600_set_bool_consts(pScrn, SQ_BOOL_CONST_ps, (0 << 0) | (needgamma << 1));
 	break;
     }
 
@@ -220,7 +222,7 @@ R600DisplayTexturedVideo(ScrnInfoPtr pScrn, RADEONPortPrivPtr pPriv)
 
     ps_conf.shader_addr         = accel_state->ps_mc_addr;
     ps_conf.shader_size         = accel_state->ps_size;
-    ps_conf.num_gprs            = 3;
+    ps_conf.num_gprs            = pPriv->bicubic_enabled ? 9 : 3;
     ps_conf.stack_size          = 1;
     ps_conf.uncached_first_inst = 1;
     ps_conf.clamp_consts        = 0;
@@ -265,6 +267,8 @@ R600DisplayTexturedVideo(ScrnInfoPtr pScrn, RADEONPortPrivPtr pPriv)
 	tex_res.interlaced          = 0;
 	if (accel_state->src_obj[0].tiling_flags == 0)
 	    tex_res.tile_mode           = 1;
+	if (tiled)
+	    R600VideoPlaneTexture(&tex_res, &pPriv->planes[0]);
 	r600_set_tex_resource(pScrn, &tex_res, accel_state->src_obj[0].domain);
 
 	/* Y sampler */
@@ -273,7 +277,6 @@ R600DisplayTexturedVideo(ScrnInfoPtr pScrn, RADEONPortPrivPtr pPriv)
 	tex_samp.clamp_y            = SQ_TEX_CLAMP_LAST_TEXEL;
 	tex_samp.clamp_z            = SQ_TEX_WRAP;
 
-	/* xxx: switch to bicubic */
 	tex_samp.xy_mag_filter      = SQ_TEX_XY_FILTER_BILINEAR;
 	tex_samp.xy_min_filter      = SQ_TEX_XY_FILTER_BILINEAR;
 
@@ -286,7 +289,7 @@ R600DisplayTexturedVideo(ScrnInfoPtr pScrn, RADEONPortPrivPtr pPriv)
 	tex_res.format              = FMT_8;
 	tex_res.w                   = accel_state->src_obj[0].width >> 1;
 	tex_res.h                   = accel_state->src_obj[0].height >> 1;
-	tex_res.pitch               = RADEON_ALIGN(accel_state->src_obj[0].pitch >> 1, pPriv->hw_align);
+	tex_res.pitch               = pPriv->src_pitch2;
 	tex_res.dst_sel_x           = SQ_SEL_X; /* V or U */
 	tex_res.dst_sel_y           = SQ_SEL_1;
 	tex_res.dst_sel_z           = SQ_SEL_1;
@@ -298,6 +301,8 @@ R600DisplayTexturedVideo(ScrnInfoPtr pScrn, RADEONPortPrivPtr pPriv)
 	tex_res.size                = tex_res.pitch * (pPriv->h >> 1);
 	if (accel_state->src_obj[0].tiling_flags == 0)
 	    tex_res.tile_mode           = 1;
+	if (tiled)
+	    R600VideoPlaneTexture(&tex_res, &pPriv->planes[2]);
 	r600_set_tex_resource(pScrn, &tex_res, accel_state->src_obj[0].domain);
 
 	/* U or V sampler */
@@ -309,7 +314,7 @@ R600DisplayTexturedVideo(ScrnInfoPtr pScrn, RADEONPortPrivPtr pPriv)
 	tex_res.format              = FMT_8;
 	tex_res.w                   = accel_state->src_obj[0].width >> 1;
 	tex_res.h                   = accel_state->src_obj[0].height >> 1;
-	tex_res.pitch               = RADEON_ALIGN(accel_state->src_obj[0].pitch >> 1, pPriv->hw_align);
+	tex_res.pitch               = pPriv->src_pitch2;
 	tex_res.dst_sel_x           = SQ_SEL_X; /* V or U */
 	tex_res.dst_sel_y           = SQ_SEL_1;
 	tex_res.dst_sel_z           = SQ_SEL_1;
@@ -321,12 +326,99 @@ R600DisplayTexturedVideo(ScrnInfoPtr pScrn, RADEONPortPrivPtr pPriv)
 	tex_res.size                = tex_res.pitch * (pPriv->h >> 1);
 	if (accel_state->src_obj[0].tiling_flags == 0)
 	    tex_res.tile_mode           = 1;
+	if (tiled)
+	    R600VideoPlaneTexture(&tex_res, &pPriv->planes[1]);
 	r600_set_tex_resource(pScrn, &tex_res, accel_state->src_obj[0].domain);
 
 	/* UV sampler */
 	tex_samp.id                 = 2;
 	r600_set_tex_sampler(pScrn, &tex_samp);
 	break;
+    case FOURCC_NV12:
+    case FOURCC_P010:
+	/*
+	 * Semi-planar: the chroma plane is bound twice with the same layout,
+	 * the destination swizzle picking V for texture 1 and U for texture 2
+	 * so the planar shader path is used unchanged. P010 samples are
+	 * 16 bit unorm with the 10 significant bits at the top.
+	 */
+	bpc = (pPriv->id == FOURCC_P010) ? 2 : 1;
+	accel_state->src_size[0] = pPriv->src_pitch * pPriv->h;
+
+	/* Y texture */
+	tex_res.id                  = 0;
+	tex_res.w                   = accel_state->src_obj[0].width;
+	tex_res.h                   = accel_state->src_obj[0].height;
+	tex_res.pitch               = pPriv->src_pitch / bpc;
+	tex_res.depth               = 0;
+	tex_res.dim                 = SQ_TEX_DIM_2D;
+	tex_res.base                = 0;
+	tex_res.mip_base            = 0;
+	tex_res.size                = accel_state->src_size[0];
+	tex_res.bo                  = accel_state->src_obj[0].bo;
+	tex_res.mip_bo              = accel_state->src_obj[0].bo;
+	tex_res.surface             = NULL;
+
+	tex_res.format              = (bpc == 2) ? FMT_16 : FMT_8;
+	tex_res.dst_sel_x           = SQ_SEL_X; /* Y */
+	tex_res.dst_sel_y           = SQ_SEL_1;
+	tex_res.dst_sel_z           = SQ_SEL_1;
+	tex_res.dst_sel_w           = SQ_SEL_1;
+
+	tex_res.request_size        = 1;
+	tex_res.base_level          = 0;
+	tex_res.last_level          = 0;
+	tex_res.perf_modulation     = 0;
+	tex_res.interlaced          = 0;
+	if (accel_state->src_obj[0].tiling_flags == 0)
+	    tex_res.tile_mode           = 1;
+	r600_set_tex_resource(pScrn, &tex_res, accel_state->src_obj[0].domain);
+
+	/* Y sampler */
+	tex_samp.id                 = 0;
+	tex_samp.clamp_x            = SQ_TEX_CLAMP_LAST_TEXEL;
+	tex_samp.clamp_y            = SQ_TEX_CLAMP_LAST_TEXEL;
+	tex_samp.clamp_z            = SQ_TEX_WRAP;
+
+	tex_samp.xy_mag_filter      = SQ_TEX_XY_FILTER_BILINEAR;
+	tex_samp.xy_min_filter      = SQ_TEX_XY_FILTER_BILINEAR;
+
+	tex_samp.z_filter           = SQ_TEX_Z_FILTER_NONE;
+	tex_samp.mip_filter         = 0;			/* no mipmap */
+	r600_set_tex_sampler(pScrn, &tex_samp);
+
+	/* V texture */
+	tex_res.id                  = 1;
+	tex_res.format              = (bpc == 2) ? FMT_16_16 : FMT_8_8;
+	tex_res.w                   = accel_state->src_obj[0].width >> 1;
+	tex_res.h                   = accel_state->src_obj[0].height >> 1;
+	tex_res.pitch               = pPriv->src_pitch / (2 * bpc);
+	tex_res.dst_sel_x           = SQ_SEL_Y; /* V */
+	tex_res.dst_sel_y           = SQ_SEL_1;
+	tex_res.dst_sel_z           = SQ_SEL_1;
+	tex_res.dst_sel_w           = SQ_SEL_1;
+	tex_res.interlaced          = 0;
+
+	tex_res.base                = pPriv->planeu_offset;
+	tex_res.mip_base            = pPriv->planeu_offset;
+	tex_res.size                = pPriv->src_pitch * (pPriv->h >> 1);
+	if (accel_state->src_obj[0].tiling_flags == 0)
+	    tex_res.tile_mode           = 1;
+	r600_set_tex_resource(pScrn, &tex_res, accel_state->src_obj[0].domain);
+
+	/* V sampler */
+	tex_samp.id                 = 1;
+	r600_set_tex_sampler(pScrn, &tex_samp);
+
+	/* U texture */
+	tex_res.id                  = 2;
+	tex_res.dst_sel_x           = SQ_SEL_X; /* U */
+	r600_set_tex_resource(pScrn, &tex_res, accel_state->src_obj[0].domain);
+
+	/* U sampler */
+	tex_samp.id                 = 2;
+	r600_set_tex_sampler(pScrn, &tex_samp);
+	break;
     case FOURCC_UYVY:
     case FOURCC_YUY2:
     default:
@@ -380,10 +472,53 @@ R600DisplayTexturedVideo(ScrnInfoPtr pScrn, RADEONPortPrivPtr pPriv)
 	break;
     }
 
+    if (pPriv->bicubic_enabled) {
+	/* Bicubic filter table */
+	CLEAR (tex_res);
+	tex_res.id                  = 3;
+	tex_res.w                   = accel_state->src_obj[1].width;
+	tex_res.h                   = accel_state->src_obj[1].height;
+	tex_res.pitch               = accel_state->src_obj[1].pitch;
+	tex_res.depth               = 0;
+	tex_res.dim                 = SQ_TEX_DIM_2D;
+	tex_res.base                = 0;
+	tex_res.mip_base            = 0;
+	tex_res.size                = accel_state->src_size[1];
+	tex_res.bo                  = accel_state->src_obj[1].bo;
+	tex_res.mip_bo              = accel_state->src_obj[1].bo;
+	tex_res.surface             = NULL;
+
+	tex_res.format              = FMT_16_16_16_16_FLOAT;
+	tex_res.dst_sel_x           = SQ_SEL_X;
+	tex_res.dst_sel_y           = SQ_SEL_Y;
+	tex_res.dst_sel_z           = SQ_SEL_Z;
+	tex_res.dst_sel_w           = SQ_SEL_W;
+
+	tex_res.request_size        = 1;
+	tex_res.base_level          = 0;
+	tex_res.last_level          = 0;
+	tex_res.perf_modulation     = 0;
+	tex_res.interlaced          = 0;
+	tex_res.tile_mode           = 1;
+	r600_set_tex_resource(pScrn, &tex_res, accel_state->src_obj[1].domain);
+
+	/* the fraction of the texel position selects the table entry */
+	CLEAR (tex_samp);
+	tex_samp.id                 = 3;
+	tex_samp.clamp_x            = SQ_TEX_WRAP;
+	tex_samp.clamp_y            = SQ_TEX_CLAMP_LAST_TEXEL;
+	tex_samp.clamp_z            = SQ_TEX_WRAP;
+	tex_samp.xy_mag_filter      = SQ_TEX_XY_FILTER_POINT;
+	tex_samp.xy_min_filter      = SQ_TEX_XY_FILTER_POINT;
+	tex_samp.z_filter           = SQ_TEX_Z_FILTER_NONE;
+	tex_samp.mip_filter         = 0;			/* no mipmap */
+	r600_set_tex_sampler(pScrn, &tex_samp);
+    }
+
     cb_conf.id = 0;
     cb_conf.w = accel_state->dst_obj.pitch;
     cb_conf.h = accel_state->dst_obj.height;
-    cb_conf.base = 0;
+    cb_conf.base = accel_state->dst_obj.offset;
     cb_conf.bo = accel_state->dst_obj.bo;
     cb_conf.surface = accel_state->dst_obj.surface;
 
@@ -430,22 +565,8 @@ R600DisplayTexturedVideo(ScrnInfoPtr pScrn, RADEONPortPrivPtr pPriv)
     r600_set_alu_consts(pScrn, SQ_ALU_CONSTANT_vs,
 			sizeof(vs_alu_consts) / SQ_ALU_CONSTANT_offset, vs_alu_consts);
 
-    if (pPriv->vsync) {
-	xf86CrtcPtr crtc;
-	if (pPriv->desired_crtc)
-	    crtc = pPriv->desired_crtc;
-	else
-	    crtc = radeon_pick_best_crtc(pScrn, FALSE,
-					 pPriv->drw_x,
-					 pPriv->drw_x + pPriv->dst_w,
-					 pPriv->drw_y,
-					 pPriv->drw_y + pPriv->dst_h);
-	if (crtc)
-	    r600_cp_wait_vline_sync(pScrn, pPixmap,
-				    crtc,
-				    pPriv->drw_y - crtc->y,
-				    (pPriv->drw_y - crtc->y) + pPriv->dst_h);
-    }
+    if (pPriv->vsync)
+	RADEONTexturedVideoWaitVLine(pScrn, pPriv, pPixmap);
 
     while (nBox--) {
 	float srcX, srcY, srcw, srch;
@@ -762,16 +762,20 @@ r600_set_default_state(ScrnInfoPtr pScrn)
     tex_resource_t tex_res;
     shader_config_t fs_conf;
     sq_config_t sq_conf;
-    int i;
+    int i, start;
     RADEONInfoPtr info = RADEONPTR(pScrn);
     struct radeon_accel_state *accel_state = info->accel_state;
 
     if (accel_state->XInited3D)
 	return;
 
+    if (radeon_default_state_replay(pScrn))
+	return;
+
     memset(&tex_res, 0, sizeof(tex_resource_t));
     memset(&fs_conf, 0, sizeof(shader_config_t));
 
+    start = radeon_default_state_begin(pScrn);
     accel_state->XInited3D = TRUE;
 
     r600_start_3d(pScrn);
@@ -1118,6 +1122,8 @@ r600_set_default_state(ScrnInfoPtr pScrn)
     EREG(VGT_STRMOUT_BUFFER_EN,               0);
     EREG(SX_MISC,                             0);
     END_BATCH();
+
+    radeon_default_state_end(pScrn, start);
 }
 
 
@@ -148,7 +148,10 @@ typedef enum {
     OPTION_ACCELMETHOD,
     OPTION_EXA_VSYNC,
     OPTION_ZAPHOD_HEADS,
-    OPTION_SWAPBUFFERS_WAIT
+    OPTION_SWAPBUFFERS_WAIT,
+    OPTION_TEXTURED_VIDEO_BATCH,
+    OPTION_ASYNC_DMA,
+    OPTION_TEXTURED_VIDEO_TILING
 } RADEONOpts;
 
 
@@ -247,11 +250,25 @@ struct radeon_exa_pixmap_priv {
     struct radeon_surface surface;
     Bool bo_mapped;
     Bool shared;
+    Bool reusable;		/* bo was allocated for and only held by this pixmap */
+    struct drmmode_fb *fb;	/* scanout fb wrapping bo, created on demand */
+    struct radeon_slab *slab;	/* slab the pixmap was suballocated from */
+    uint32_t offset;		/* of the pixmap in bo, non-zero only in slabs */
+    /* residency */
+    int pixmap_class;
+    uint32_t domain;		/* preferred write domain */
+    uint32_t size;		/* bytes accounted for the pixmap */
+    unsigned cpu_access;	/* PrepareAccess, UTS and DFS, decaying */
+    unsigned gpu_access;	/* accelerated ops writing it, decaying */
+    int retile_hint;		/* usage_hint of the layout to convert to */
+    Bool retile_queued;
 };
 
 #define RADEON_2D_EXA_COPY 1
 #define RADEON_2D_EXA_SOLID 2
 
+#define RADEON_2D_BATCH_SIZE 32		/* rects queued by Solid/Copy */
+
 struct radeon_2d_state {
     int op; //
     uint32_t dst_pitch_offset;
@@ -267,6 +284,8 @@ struct radeon_2d_state {
     uint32_t dst_domain;
     struct radeon_bo *dst_bo;
     struct radeon_bo *src_bo;
+    int num_rects;
+    uint32_t rects[RADEON_2D_BATCH_SIZE][3]; /* SRC_Y_X, DST_Y_X, DST_HEIGHT_WIDTH */
 };
     
 #define DMA_BO_FREE_TIME 1000
@@ -277,7 +296,84 @@ struct radeon_dma_bo {
     int expire_counter;
 };
 
+/* Pixmap BOs kept after their pixmap is destroyed, see radeon_bo_helper.c */
+#define RADEON_BO_CACHE_MAX_SIZE (8 * 1024 * 1024)
+#define RADEON_BO_CACHE_BUCKETS 45	/* one page, then 4 size classes per power of two */
+#define RADEON_BO_CACHE_TIME 100	/* flushes an unused BO stays cached */
+#define RADEON_BO_CACHE_PROBES 4	/* busy BOs skipped before allocating */
+#define RADEON_SURFACE_CACHE_SIZE 64
+
+struct radeon_bo_cache_entry {
+    struct radeon_bo_cache_entry *next, *prev;
+    struct radeon_bo *bo;
+    uint32_t alignment;
+    uint32_t domain;
+    uint32_t tiling;
+    int expire_counter;
+};
+
+struct radeon_surface_cache_entry {
+    /* radeon_surface_best/init input */
+    uint32_t npix_x, npix_y, bpe;
+    uint64_t flags;
+    Bool valid;
+    struct radeon_surface surface;
+};
+
+/* Small linear pixmaps share slab BOs, see radeon_bo_helper.c */
+#define RADEON_SLAB_SIZE (64 * 1024)
+#define RADEON_SLAB_MIN_CHUNK 256	/* CB/texture base alignment */
+#define RADEON_SLAB_CLASSES 4		/* 256 to 2048 byte chunks */
+#define RADEON_SLAB_MAX_SIZE (RADEON_SLAB_MIN_CHUNK << (RADEON_SLAB_CLASSES - 1))
+#define RADEON_SLAB_MASK_WORDS (RADEON_SLAB_SIZE / RADEON_SLAB_MIN_CHUNK / 32)
+
+struct radeon_slab {
+    struct radeon_slab *next, *prev;
+    struct radeon_bo *bo;
+    uint32_t chunk_size;
+    int used;
+    int pending;		/* freed, but maybe still read by the GPU */
+    int expire_counter;		/* once empty */
+    uint32_t free_mask[RADEON_SLAB_MASK_WORDS];
+    uint32_t pending_mask[RADEON_SLAB_MASK_WORDS];
+};
+
+struct radeon_bo_cache {
+    struct radeon_bo_cache_entry buckets[RADEON_BO_CACHE_BUCKETS];
+    struct radeon_slab slabs[RADEON_SLAB_CLASSES];
+    int expire_counter;
+    uint64_t size;		/* bytes held by the buckets */
+    uint64_t budget;
+    struct radeon_surface_cache_entry surfaces[RADEON_SURFACE_CACHE_SIZE];
+};
+
+/* Residency manager, see radeon_bo_helper.c */
+enum radeon_pixmap_class {
+    RADEON_PIXMAP_CLASS_OFFSCREEN,
+    RADEON_PIXMAP_CLASS_DRI2,
+    RADEON_PIXMAP_CLASS_XV,
+    RADEON_PIXMAP_CLASSES
+};
+
+#define RADEON_RESIDENCY_SAMPLES 32	/* accesses between placement decisions */
+#define RADEON_RETILE_QUEUE_SIZE 8
+#define RADEON_RETILE_MIN_SIZE 64	/* in both dimensions */
+
+struct radeon_residency {
+    int64_t vram[RADEON_PIXMAP_CLASSES];	/* bytes placed in VRAM */
+    int64_t gtt[RADEON_PIXMAP_CLASSES];	/* bytes placed in GTT */
+    int64_t vram_limit;			/* left after front and cursors */
+    unsigned long gtt_allocs;		/* pixmaps created in GTT */
+    unsigned long demotions;		/* VRAM -> GTT */
+    unsigned long promotions;		/* GTT -> VRAM */
+    unsigned long tiled;		/* pixmaps converted to tiled */
+    unsigned long untiled;		/* pixmaps converted to linear */
+    uint64_t uts_bytes;			/* copied by UploadToScreen */
+    uint64_t dfs_bytes;			/* copied by DownloadFromScreen */
+};
+
 struct r600_accel_object {
+    uint32_t offset;
     uint32_t pitch;
     uint32_t width;
     uint32_t height;
@@ -298,6 +394,55 @@ struct radeon_vbo_object {
     unsigned          verts_per_op;
 };
 
+#define RADEON_SOLID_CACHE_SIZE 16
+
+/* R600+ shader programs, generated on first use into shaders_bo */
+#define RADEON_SHADER_ALIGN 256		/* SQ_PGM_START_* are in 256 byte units */
+#define RADEON_SHADER_MAX_DWORDS 1024	/* longer programs are refused */
+#define RADEON_SHADER_CACHE_SIZE 64
+#define RADEON_SHADER_BO_SIZE (8 * 1024)	/* initial, doubled when full */
+
+/* R600+ default 3D state, recorded the first time it's emitted */
+#define RADEON_DEFAULT_STATE_DWORDS 1024	/* more than any family emits */
+#define RADEON_DEFAULT_STATE_RELOCS 8
+
+/*
+ * A generator stores its program in shader through RADEON_SHADER_DW and
+ * returns the dwords it needed.  Stores past max all go to shader[max],
+ * so shader has to hold max + 1 dwords and a program longer than max is
+ * only counted.
+ */
+#define RADEON_SHADER_DW(i, max) ((i) < (max) ? (i)++ : ((i)++, (max)))
+
+typedef int (*radeon_shader_gen)(RADEONChipFamily ChipSet, uint32_t *shader,
+				 uint32_t variant, int max);
+
+struct radeon_shader_cache_entry {
+    radeon_shader_gen gen;
+    uint32_t variant;
+    uint32_t offset;		/* in shaders_bo */
+};
+
+/*
+ * comp_vs/comp_ps variants.  0 is the generic program, which picks its
+ * inputs with the bool consts at run time; RADEON_COMP_STATIC programs
+ * have that choice made when they're generated and run straight through.
+ * That saves 3 CF instructions per vertex, and per fragment 3 on R6xx/R7xx
+ * and 6 to 8 on Evergreen/Cayman, where the variants without a mask also
+ * run 4 instead of 12 ALU slots.  Fetches stay the same.
+ */
+#define RADEON_COMP_STATIC	(1 << 0)
+#define RADEON_COMP_SRC_TEX	(1 << 1)	/* else solid src from consts */
+#define RADEON_COMP_MASK	(1 << 2)
+#define RADEON_COMP_MASK_TEX	(1 << 3)	/* else solid mask from consts */
+#define RADEON_COMP_VS_KEY	(RADEON_COMP_STATIC | RADEON_COMP_MASK_TEX)
+
+struct radeon_solid_cache_entry {
+    PixmapPtr pixmap;
+    uint32_t color;
+    unsigned last_use;
+};
+
 struct radeon_accel_state {
 
 				/* Saved values for ScreenToScreenCopy */
@@ -330,6 +475,8 @@ struct radeon_accel_state {
     PixmapPtr         src_pix;
     Bool              is_transform[2];
     PictTransform     *transform[2];
+    /* pre-R600: picture transform scaled to normalised texcoords */
+    float             texcoord_xform[2][9];
     /* Whether we are tiling horizontally and vertically */
     Bool              need_src_tile_x;
     Bool              need_src_tile_y;
@@ -353,6 +500,13 @@ struct radeon_accel_state {
     void (*finish_op)(ScrnInfoPtr, int);
     // shader storage
     struct radeon_bo  *shaders_bo;
+    uint32_t          shaders_size;	/* bytes used in shaders_bo */
+    struct radeon_shader_cache_entry shaders[RADEON_SHADER_CACHE_SIZE];
+    int               num_shaders;
+    uint32_t          *default_state;
+    int               default_state_ndw;
+    int               default_state_relocs[RADEON_DEFAULT_STATE_RELOCS]; /* dword index */
+    int               num_default_state_relocs;
     uint32_t          solid_vs_offset;
     uint32_t          solid_ps_offset;
     uint32_t          copy_vs_offset;
@@ -361,6 +515,7 @@ struct radeon_accel_state {
     uint32_t          comp_ps_offset;
     uint32_t          xv_vs_offset;
     uint32_t          xv_ps_offset;
+    uint32_t          xv_bicubic_ps_offset;
     // shader consts
     uint32_t          solid_vs_const_offset;
     uint32_t          solid_ps_const_offset;
@@ -394,6 +549,12 @@ struct radeon_accel_state {
     // composite
     Bool              component_alpha;
     Bool              src_alpha;
+    /* pixmaps to convert to another layout from the BlockHandler */
+    PixmapPtr         retile_queue[RADEON_RETILE_QUEUE_SIZE];
+    int               retile_count;
+    /* 1x1 pixmaps for solid Render sources, LRU keyed by colour */
+    struct radeon_solid_cache_entry solid_cache[RADEON_SOLID_CACHE_SIZE];
+    unsigned          solid_cache_tick;
     // vline
     xf86CrtcPtr       vline_crtc;
     int               vline_y1;
@@ -435,6 +596,10 @@ typedef struct {
 
     unsigned int xv_max_width;
     unsigned int xv_max_height;
+    Bool xv_batch; /* defer textured video to the block handler */
+    Bool xv_tiling; /* blit textured video planes to tiled VRAM */
+    XF86VideoAdaptorPtr textured_adaptor;
+    Bool dma_copy; /* big linear transfers on the async DMA ring */
 
     /* general */
     OptionInfoPtr     Options;
@@ -453,8 +618,11 @@ typedef struct {
     struct radeon_2d_state state_2d;
     struct radeon_bo *front_bo;
     struct radeon_bo_manager *bufmgr;
+    struct radeon_bo_cache *bo_cache;
+    struct radeon_residency residency;
     struct radeon_cs_manager *csm;
     struct radeon_cs *cs;
+    unsigned int cs_serial;	/* bumped when the CS is submitted or dropped */
 
     struct radeon_bo *cursor_bo[32];
     uint64_t vram_size;
@@ -474,6 +642,9 @@ typedef struct {
     /* Xv bicubic filtering */
     struct radeon_bo *bicubic_bo;
 
+    /* XvMC surfaces handed out to clients */
+    struct radeon_xvmc_surface *xvmc_surfaces;
+
     /* kms pageflipping */
     Bool allowPageFlip;
 
@@ -514,11 +685,25 @@ extern Bool EVERGREENDrawInit(ScreenPtr pScreen);
 extern Bool RADEONGetDatatypeBpp(int bpp, uint32_t *type);
 extern Bool RADEONGetPixmapOffsetPitch(PixmapPtr pPix,
 				       uint32_t *pitch_offset);
+extern Bool RADEONEXAPixmapOwnBO(PixmapPtr pPix);
+extern void RADEONEXARetilePixmaps(ScreenPtr pScreen, Bool convert);
+
+/* radeon_exa_shared.c */
+extern void RADEONSolidPixmapCacheFini(ScreenPtr pScreen);
+extern Bool radeon_shader_cache_init(ScrnInfoPtr pScrn);
+extern void radeon_shader_cache_fini(ScrnInfoPtr pScrn);
+extern Bool radeon_shader_get(ScrnInfoPtr pScrn, radeon_shader_gen gen,
+			      uint32_t variant, uint32_t *offset);
+extern void radeon_shader_flatten(uint32_t *shader, const int *cf, int n);
+extern int radeon_default_state_begin(ScrnInfoPtr pScrn);
+extern void radeon_default_state_end(ScrnInfoPtr pScrn, int start);
+extern Bool radeon_default_state_replay(ScrnInfoPtr pScrn);
 
 /* radeon_video.c */
 extern void RADEONInitVideo(ScreenPtr pScreen);
 extern void RADEONResetVideo(ScrnInfoPtr pScrn);
 extern Bool radeon_load_bicubic_texture(ScrnInfoPtr pScrn);
+extern void RADEONFlushTexturedVideo(ScrnInfoPtr pScrn);
 extern xf86CrtcPtr radeon_pick_best_crtc(ScrnInfoPtr pScrn,
 					 Bool consider_disabled,
 					 int x1, int x2, int y1, int y2);
@@ -556,6 +741,27 @@ static inline struct radeon_surface *radeon_get_pixmap_surface(PixmapPtr pPix)
 }
 
 uint32_t radeon_get_pixmap_tiling(PixmapPtr pPix);
+uint32_t radeon_pixmap_write_domain(PixmapPtr pPix);
+void radeon_pixmap_transfer(PixmapPtr pPix, uint32_t bytes, Bool upload);
+
+/* radeon_bo_helper.c */
+extern void radeon_slab_free(ScrnInfoPtr pScrn, struct radeon_slab *slab,
+			     uint32_t offset);
+
+static inline uint32_t radeon_get_pixmap_offset(PixmapPtr pPix)
+{
+#ifdef USE_GLAMOR
+    RADEONInfoPtr info = RADEONPTR(xf86ScreenToScrn(pPix->drawable.pScreen));
+
+    if (info->use_glamor)
+	return 0;
+#endif
+    {
+	struct radeon_exa_pixmap_priv *driver_priv;
+	driver_priv = exaGetPixmapDriverPrivate(pPix);
+	return driver_priv ? driver_priv->offset : 0;
+    }
+}
 
 static inline void radeon_set_pixmap_bo(PixmapPtr pPix, struct radeon_bo *bo)
 {
@@ -576,6 +782,8 @@ static inline void radeon_set_pixmap_bo(PixmapPtr pPix, struct radeon_bo *bo)
 	    if (priv->bo)
 		radeon_bo_unref(priv->bo);
 
+	    drmmode_fb_reference(info->drmmode.fd, &priv->fb, NULL);
+
 	    if (!bo) {
 		free(priv);
 		priv = NULL;
@@ -607,11 +815,25 @@ out:
 	if (driver_priv) {
 	    uint32_t pitch;
 
+	    if (driver_priv->bo != bo) {
+		RADEONInfoPtr info = RADEONPTR(xf86ScreenToScrn(pPix->drawable.pScreen));
+
+		drmmode_fb_reference(info->drmmode.fd, &driver_priv->fb, NULL);
+	    }
+
 	    if (driver_priv->bo)
 		radeon_bo_unref(driver_priv->bo);
 
+	    if (driver_priv->slab) {
+		radeon_slab_free(xf86ScreenToScrn(pPix->drawable.pScreen),
+				 driver_priv->slab, driver_priv->offset);
+		driver_priv->slab = NULL;
+		driver_priv->offset = 0;
+	    }
+
 	    radeon_bo_ref(bo);
 	    driver_priv->bo = bo;
+	    driver_priv->reusable = FALSE;
 
 	    radeon_bo_get_tiling(bo, &driver_priv->tiling_flags, &pitch);
 	}
@@ -638,6 +860,26 @@ static inline struct radeon_bo *radeon_get_pixmap_bo(PixmapPtr pPix)
     return NULL;
 }
 
+static inline struct drmmode_fb **radeon_pixmap_get_fb_ptr(PixmapPtr pPix)
+{
+#ifdef USE_GLAMOR
+    RADEONInfoPtr info = RADEONPTR(xf86ScreenToScrn(pPix->drawable.pScreen));
+
+    if (info->use_glamor) {
+	struct radeon_pixmap *priv;
+	priv = radeon_get_pixmap_private(pPix);
+	return priv ? &priv->fb : NULL;
+    } else
+#endif
+    {
+	struct radeon_exa_pixmap_priv *driver_priv;
+	driver_priv = exaGetPixmapDriverPrivate(pPix);
+	return driver_priv ? &driver_priv->fb : NULL;
+    }
+
+    return NULL;
+}
+
 static inline Bool radeon_get_pixmap_shared(PixmapPtr pPix)
 {
 #ifdef USE_GLAMOR
@@ -656,6 +898,14 @@ static inline Bool radeon_get_pixmap_shared(PixmapPtr pPix)
     return FALSE;
 }
 
+static inline uint32_t radeon_get_pixmap_domain(PixmapPtr pPix)
+{
+    struct radeon_exa_pixmap_priv *driver_priv;
+
+    driver_priv = exaGetPixmapDriverPrivate(pPix);
+    return driver_priv ? driver_priv->domain : RADEON_GEM_DOMAIN_VRAM;
+}
+
 #define CP_PACKET0(reg, n)						\
 	(RADEON_CP_PACKET0 | ((n) << 16) | ((reg) >> 2))
 #define CP_PACKET1(reg0, reg1)						\
@@ -768,7 +1018,7 @@ do {									\
     } while(0)
 
 #define EMIT_READ_OFFSET(reg, value, pPix) EMIT_OFFSET(reg, value, pPix, (RADEON_GEM_DOMAIN_VRAM | RADEON_GEM_DOMAIN_GTT), 0)
-#define EMIT_WRITE_OFFSET(reg, value, pPix) EMIT_OFFSET(reg, value, pPix, 0, RADEON_GEM_DOMAIN_VRAM)
+#define EMIT_WRITE_OFFSET(reg, value, pPix) EMIT_OFFSET(reg, value, pPix, 0, radeon_get_pixmap_domain(pPix))
 
 #define OUT_TEXTURE_REG(reg, offset, bo) do {   \
     OUT_RING_REG((reg), (offset));                                   \
@@ -778,7 +1028,7 @@ do {									\
 #define EMIT_COLORPITCH(reg, value, pPix) do {			\
     driver_priv = exaGetPixmapDriverPrivate(pPix);			\
     OUT_RING_REG((reg), value);					\
-    OUT_RING_RELOC(driver_priv->bo, 0, RADEON_GEM_DOMAIN_VRAM);		\
+    OUT_RING_RELOC(driver_priv->bo, 0, driver_priv->domain);		\
 } while(0)
 
 static __inline__ void RADEON_SYNC(RADEONInfoPtr info, ScrnInfoPtr pScrn)
@@ -788,6 +1038,7 @@ static __inline__ void RADEON_SYNC(RADEONInfoPtr info, ScrnInfoPtr pScrn)
 }
 
 enum {
+    RADEON_CREATE_PIXMAP_GTT = 0x04000000,
     RADEON_CREATE_PIXMAP_DRI2 = 0x08000000,
     RADEON_CREATE_PIXMAP_TILING_MACRO = 0x10000000,
     RADEON_CREATE_PIXMAP_TILING_MICRO = 0x20000000,
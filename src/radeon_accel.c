@@ -79,6 +79,7 @@
 				/* Driver data structures */
 #include "radeon.h"
 #include "radeon_reg.h"
+#include "radeon_bo_helper.h"
 #include "r600_reg.h"
 #include "radeon_probe.h"
 #include "radeon_version.h"
@@ -198,6 +199,9 @@ Bool RADEONAccelInit(ScreenPtr pScreen)
 		if (!RADEONDrawInit(pScreen))
 		    return FALSE;
 	    }
+
+	if (!info->use_glamor)
+	    radeon_bo_cache_init(pScrn);
     }
     return TRUE;
 }
@@ -24,11 +24,11 @@
 # include "config.h"
 #endif
 
-#include "radeon.h"
+#include <errno.h>
 
-#ifdef RADEON_PIXMAP_SHARING
+#include "radeon.h"
 #include "radeon_bo_gem.h"
-#endif
+#include "radeon_bo_helper.h"
 
 static const unsigned MicroBlockTable[5][3][2] = {
     /*linear  tiled   square-tiled */
@@ -61,13 +61,378 @@ static Bool RADEONMacroSwitch(int width, int height, int bpp,
     }
 }
 
+/* Pixmap BO cache
+ *
+ * Freed pixmap BOs go into buckets by size class, oldest first, and are
+ * handed to new pixmaps of the same class and domain once the GPU is done
+ * with them.  BOs are allocated with their class size so that any request
+ * in the class fits.  Unused BOs expire after RADEON_BO_CACHE_TIME flushes
+ * and the oldest are dropped when the cache holds more than its budget.
+ */
+
+static int radeon_bo_cache_bucket(uint32_t size, uint32_t *class_size)
+{
+    uint32_t base, step;
+    int n, q;
+
+    if (size <= RADEON_GPU_PAGE_SIZE) {
+	*class_size = RADEON_GPU_PAGE_SIZE;
+	return 0;
+    }
+
+    n = RADEONLog2(size - 1);
+    base = 1 << n;
+    step = base >> 2;
+    q = (size - base + step - 1) / step;
+    *class_size = base + q * step;
+    return 1 + (n - 12) * 4 + q - 1;
+}
+
+static void radeon_bo_cache_evict(struct radeon_bo_cache *cache,
+				  struct radeon_bo_cache_entry *entry)
+{
+    remove_from_list(entry);
+    cache->size -= entry->bo->size;
+    radeon_bo_unref(entry->bo);
+    free(entry);
+}
+
+void radeon_bo_cache_init(ScrnInfoPtr pScrn)
+{
+    RADEONInfoPtr info = RADEONPTR(pScrn);
+    struct radeon_bo_cache *cache;
+    int i;
+
+    cache = calloc(1, sizeof(struct radeon_bo_cache));
+    if (!cache)
+	return;
+
+    for (i = 0; i < RADEON_BO_CACHE_BUCKETS; i++)
+	make_empty_list(&cache->buckets[i]);
+    for (i = 0; i < RADEON_SLAB_CLASSES; i++)
+	make_empty_list(&cache->slabs[i]);
+    cache->budget = min(info->vram_size / 32, 32 * 1024 * 1024);
+
+    info->bo_cache = cache;
+}
+
+void radeon_bo_cache_fini(ScrnInfoPtr pScrn)
+{
+    RADEONInfoPtr info = RADEONPTR(pScrn);
+    struct radeon_bo_cache *cache = info->bo_cache;
+    struct radeon_bo_cache_entry *entry, *temp;
+    struct radeon_slab *slab, *slab_temp;
+    int i;
+
+    if (!cache)
+	return;
+
+    for (i = 0; i < RADEON_BO_CACHE_BUCKETS; i++) {
+	foreach_s(entry, temp, &cache->buckets[i])
+	    radeon_bo_cache_evict(cache, entry);
+    }
+
+    /* slabs still in use are freed with their last pixmap */
+    for (i = 0; i < RADEON_SLAB_CLASSES; i++) {
+	foreach_s(slab, slab_temp, &cache->slabs[i]) {
+	    remove_from_list(slab);
+	    if (slab->used) {
+		make_empty_list(slab);
+		continue;
+	    }
+	    radeon_bo_unref(slab->bo);
+	    free(slab);
+	}
+    }
+
+    free(cache);
+    info->bo_cache = NULL;
+}
+
+/* Called after each CS flush, drops the BOs that went unused too long */
+void radeon_bo_cache_flush(ScrnInfoPtr pScrn)
+{
+    RADEONInfoPtr info = RADEONPTR(pScrn);
+    struct radeon_bo_cache *cache = info->bo_cache;
+    struct radeon_bo_cache_entry *entry, *temp;
+    struct radeon_slab *slab, *slab_temp;
+    int i;
+
+    if (!cache)
+	return;
+
+    cache->expire_counter++;
+
+    for (i = 0; i < RADEON_BO_CACHE_BUCKETS; i++) {
+	foreach_s(entry, temp, &cache->buckets[i]) {
+	    if (entry->expire_counter - cache->expire_counter > 0)
+		break;
+	    radeon_bo_cache_evict(cache, entry);
+	}
+    }
+
+    for (i = 0; i < RADEON_SLAB_CLASSES; i++) {
+	foreach_s(slab, slab_temp, &cache->slabs[i]) {
+	    if (slab->used ||
+		slab->expire_counter - cache->expire_counter > 0)
+		continue;
+	    remove_from_list(slab);
+	    radeon_bo_unref(slab->bo);
+	    free(slab);
+	}
+    }
+}
+
+static struct radeon_bo *
+radeon_bo_cache_get(RADEONInfoPtr info, uint32_t size, uint32_t alignment,
+		    uint32_t domain)
+{
+    struct radeon_bo_cache *cache = info->bo_cache;
+    struct radeon_bo_cache_entry *entry, *temp;
+    struct radeon_bo *bo;
+    uint32_t class_size, busy_domain;
+    int probes = 0;
+
+    if (!cache->size)
+	return NULL;
+
+    foreach_s(entry, temp,
+	      &cache->buckets[radeon_bo_cache_bucket(size, &class_size)]) {
+	if (entry->domain != domain || entry->alignment % alignment)
+	    continue;
+
+	if (radeon_bo_is_referenced_by_cs(entry->bo, info->cs) ||
+	    radeon_bo_is_busy(entry->bo, &busy_domain) == -EBUSY) {
+	    if (++probes == RADEON_BO_CACHE_PROBES)
+		return NULL;
+	    continue;
+	}
+
+	bo = entry->bo;
+	if (entry->tiling)
+	    radeon_bo_set_tiling(bo, 0, 0);
+	remove_from_list(entry);
+	cache->size -= bo->size;
+	free(entry);
+	return bo;
+    }
+
+    return NULL;
+}
+
+/* Take over the last reference to a pixmap BO, or drop it */
+void radeon_bo_cache_put(ScrnInfoPtr pScrn, struct radeon_bo *bo,
+			 struct radeon_surface *surface, uint32_t tiling)
+{
+    RADEONInfoPtr info = RADEONPTR(pScrn);
+    struct radeon_bo_cache *cache = info->bo_cache;
+    struct radeon_bo_cache_entry *entry, *oldest;
+    uint32_t class_size, alignment;
+    int i;
+
+    if (!cache || bo->size > RADEON_BO_CACHE_MAX_SIZE ||
+	bo->size > cache->budget || radeon_gem_name_bo(bo))
+	goto out_unref;
+
+    if (info->ChipFamily < CHIP_FAMILY_R600)
+	alignment = RADEON_GPU_PAGE_SIZE;
+    else if (info->surf_man && surface->bo_size)
+	alignment = surface->bo_alignment;
+    else
+	goto out_unref;
+
+    /* only BOs allocated with their class size can serve the whole class */
+    radeon_bo_cache_bucket(bo->size, &class_size);
+    if (class_size != bo->size)
+	goto out_unref;
+
+    entry = calloc(1, sizeof(struct radeon_bo_cache_entry));
+    if (!entry)
+	goto out_unref;
+
+    while (cache->size + bo->size > cache->budget) {
+	oldest = NULL;
+	for (i = 0; i < RADEON_BO_CACHE_BUCKETS; i++) {
+	    if (is_empty_list(&cache->buckets[i]))
+		continue;
+	    if (!oldest ||
+		first_elem(&cache->buckets[i])->expire_counter <
+		oldest->expire_counter)
+		oldest = first_elem(&cache->buckets[i]);
+	}
+	radeon_bo_cache_evict(cache, oldest);
+    }
+
+    entry->bo = bo;
+    entry->alignment = alignment;
+    entry->domain = RADEON_GEM_DOMAIN_VRAM;
+    entry->tiling = tiling;
+    entry->expire_counter = cache->expire_counter + RADEON_BO_CACHE_TIME;
+    insert_at_tail(&cache->buckets[radeon_bo_cache_bucket(bo->size, &class_size)],
+		   entry);
+    cache->size += bo->size;
+    return;
+
+out_unref:
+    radeon_bo_unref(bo);
+}
+
+/* Slab suballocator
+ *
+ * Small linear pixmaps on R600 and newer get a chunk of a shared
+ * RADEON_SLAB_SIZE BO instead of a BO of their own; each slab hands out
+ * chunks of one power of two size.  The pixmap keeps a reference to the
+ * slab BO and its offset in it.  Older chips aren't handled: their 2D
+ * engine wants offsets page aligned, more than the largest chunk.
+ * Freed chunks are only handed out again once the slab BO is idle, and
+ * empty slabs are freed after RADEON_BO_CACHE_TIME flushes.
+ */
+
+static Bool radeon_slab_reclaim(RADEONInfoPtr info, struct radeon_slab *slab)
+{
+    uint32_t domain;
+    int i;
+
+    if (!slab->pending ||
+	radeon_bo_is_referenced_by_cs(slab->bo, info->cs) ||
+	radeon_bo_is_busy(slab->bo, &domain) == -EBUSY)
+	return FALSE;
+
+    for (i = 0; i < RADEON_SLAB_MASK_WORDS; i++) {
+	slab->free_mask[i] |= slab->pending_mask[i];
+	slab->pending_mask[i] = 0;
+    }
+    slab->pending = 0;
+    return TRUE;
+}
+
+static struct radeon_bo *
+radeon_slab_alloc(RADEONInfoPtr info, uint32_t size, uint32_t alignment,
+		  struct radeon_slab **new_slab, uint32_t *new_offset)
+{
+    struct radeon_bo_cache *cache = info->bo_cache;
+    struct radeon_slab *list, *slab;
+    uint32_t chunk_size = RADEON_SLAB_MIN_CHUNK;
+    int chunks, i, bit;
+
+    while (chunk_size < size || chunk_size % alignment)
+	chunk_size <<= 1;
+    if (chunk_size > RADEON_SLAB_MAX_SIZE)
+	return NULL;
+
+    chunks = RADEON_SLAB_SIZE / chunk_size;
+    list = &cache->slabs[RADEONLog2(chunk_size / RADEON_SLAB_MIN_CHUNK)];
+
+    foreach(slab, list) {
+	if (slab->used + slab->pending < chunks ||
+	    radeon_slab_reclaim(info, slab))
+	    break;
+    }
+
+    if (at_end(list, slab)) {
+	slab = calloc(1, sizeof(struct radeon_slab));
+	if (!slab)
+	    return NULL;
+
+	slab->bo = radeon_bo_open(info->bufmgr, 0, RADEON_SLAB_SIZE,
+				  RADEON_GPU_PAGE_SIZE,
+				  RADEON_GEM_DOMAIN_VRAM, 0);
+	if (!slab->bo) {
+	    free(slab);
+	    return NULL;
+	}
+
+	slab->chunk_size = chunk_size;
+	for (i = 0; i < chunks; i++)
+	    slab->free_mask[i / 32] |= 1U << (i % 32);
+	insert_at_head(list, slab);
+    }
+
+    for (i = 0; !slab->free_mask[i]; i++)
+	;
+    for (bit = 0; !(slab->free_mask[i] & (1U << bit)); bit++)
+	;
+    slab->free_mask[i] &= ~(1U << bit);
+    slab->used++;
+
+    *new_slab = slab;
+    *new_offset = (i * 32 + bit) * chunk_size;
+    radeon_bo_ref(slab->bo);
+    return slab->bo;
+}
+
+void radeon_slab_free(ScrnInfoPtr pScrn, struct radeon_slab *slab,
+		      uint32_t offset)
+{
+    RADEONInfoPtr info = RADEONPTR(pScrn);
+    int i = offset / slab->chunk_size;
+
+    slab->pending_mask[i / 32] |= 1U << (i % 32);
+    slab->pending++;
+    if (--slab->used)
+	return;
+
+    if (info->bo_cache) {
+	slab->expire_counter = info->bo_cache->expire_counter +
+	    RADEON_BO_CACHE_TIME;
+	return;
+    }
+
+    remove_from_list(slab);
+    radeon_bo_unref(slab->bo);
+    free(slab);
+}
+
+/* radeon_surface_best/init for a pixmap, remembering the layouts of
+ * recently seen sizes
+ */
+static int radeon_surface_layout(RADEONInfoPtr info,
+				 struct radeon_surface *surface)
+{
+    struct radeon_surface_cache_entry *entry = NULL;
+    uint64_t flags = surface->flags;
+
+    if (info->bo_cache) {
+	uint32_t hash = (surface->npix_x * 31 + surface->npix_y) * 31 +
+	    surface->bpe + (uint32_t)(flags >> 8);
+
+	entry = &info->bo_cache->surfaces[hash % RADEON_SURFACE_CACHE_SIZE];
+	if (entry->valid &&
+	    entry->npix_x == surface->npix_x &&
+	    entry->npix_y == surface->npix_y &&
+	    entry->bpe == surface->bpe &&
+	    entry->flags == flags) {
+	    *surface = entry->surface;
+	    return 0;
+	}
+    }
+
+    if (radeon_surface_best(info->surf_man, surface) ||
+	radeon_surface_init(info->surf_man, surface))
+	return -1;
+
+    if (entry) {
+	entry->npix_x = surface->npix_x;
+	entry->npix_y = surface->npix_y;
+	entry->bpe = surface->bpe;
+	entry->flags = flags;
+	entry->valid = TRUE;
+	entry->surface = *surface;
+    }
+
+    return 0;
+}
+
 /* Calculate appropriate tiling and pitch for a pixmap and allocate a BO that
- * can hold it.
+ * can hold it.  If new_slab is given, small linear pixmaps may be placed at
+ * *new_offset in a slab BO.
  */
 struct radeon_bo*
-radeon_alloc_pixmap_bo(ScrnInfoPtr pScrn, int width, int height, int depth,
-		       int usage_hint, int bitsPerPixel, int *new_pitch,
-		       struct radeon_surface *new_surface, uint32_t *new_tiling)
+radeon_alloc_pixmap_slab_bo(ScrnInfoPtr pScrn, int width, int height,
+			    int depth, int usage_hint, int bitsPerPixel,
+			    int *new_pitch, struct radeon_surface *new_surface,
+			    uint32_t *new_tiling, struct radeon_slab **new_slab,
+			    uint32_t *new_offset)
 {
     RADEONInfoPtr info = RADEONPTR(pScrn);
     int pitch, base_align;
@@ -93,6 +458,10 @@ radeon_alloc_pixmap_bo(ScrnInfoPtr pScrn, int width, int height, int depth,
 		domain = RADEON_GEM_DOMAIN_GTT;
 	}
 #endif
+	if (usage_hint & RADEON_CREATE_PIXMAP_GTT) {
+		tiling = 0;
+		domain = RADEON_GEM_DOMAIN_GTT;
+	}
     }
 
     /* Small pixmaps must not be macrotiled on R300, hw cannot sample them
@@ -148,10 +517,7 @@ radeon_alloc_pixmap_bo(ScrnInfoPtr pScrn, int width, int height, int depth,
 				surface.flags |= RADEON_SURF_ZBUFFER;
 				surface.flags |= RADEON_SURF_SBUFFER;
 			}
-			if (radeon_surface_best(info->surf_man, &surface)) {
-				return NULL;
-			}
-			if (radeon_surface_init(info->surf_man, &surface)) {
+			if (radeon_surface_layout(info, &surface)) {
 				return NULL;
 			}
 			size = surface.bo_size;
@@ -176,8 +542,35 @@ radeon_alloc_pixmap_bo(ScrnInfoPtr pScrn, int width, int height, int depth,
 		}
 	}
 
-    bo = radeon_bo_open(info->bufmgr, 0, size, base_align,
-			domain, 0);
+    bo = NULL;
+    if (new_slab && info->bo_cache && domain == RADEON_GEM_DOMAIN_VRAM &&
+	!tiling && !(usage_hint & RADEON_CREATE_PIXMAP_DRI2) &&
+	info->ChipFamily >= CHIP_FAMILY_R600 && surface.bo_size) {
+	uint32_t slab_size = surface.bo_size;
+
+	if (slab_size <= RADEON_SLAB_MAX_SIZE) {
+	    bo = radeon_slab_alloc(info, slab_size, base_align, new_slab,
+				   new_offset);
+	    if (bo) {
+		*new_surface = surface;
+		*new_pitch = pitch;
+		return bo;
+	    }
+	}
+    }
+
+    if (info->bo_cache && domain == RADEON_GEM_DOMAIN_VRAM &&
+	size <= RADEON_BO_CACHE_MAX_SIZE) {
+	uint32_t class_size;
+
+	radeon_bo_cache_bucket(size, &class_size);
+	bo = radeon_bo_cache_get(info, size, base_align, domain);
+	size = class_size;
+    }
+
+    if (!bo)
+	bo = radeon_bo_open(info->bufmgr, 0, size, base_align,
+			    domain, 0);
 
     if (bo && tiling && radeon_bo_set_tiling(bo, tiling, pitch) == 0)
 	*new_tiling = tiling;
@@ -187,6 +580,77 @@ radeon_alloc_pixmap_bo(ScrnInfoPtr pScrn, int width, int height, int depth,
     return bo;
 }
 
+struct radeon_bo*
+radeon_alloc_pixmap_bo(ScrnInfoPtr pScrn, int width, int height, int depth,
+		       int usage_hint, int bitsPerPixel, int *new_pitch,
+		       struct radeon_surface *new_surface, uint32_t *new_tiling)
+{
+    return radeon_alloc_pixmap_slab_bo(pScrn, width, height, depth, usage_hint,
+				       bitsPerPixel, new_pitch, new_surface,
+				       new_tiling, NULL, NULL);
+}
+
+/*
+ * Residency manager: the driver keeps count of the bytes it placed in VRAM
+ * and GTT per class of pixmap, so linear offscreen pixmaps can be created
+ * in GTT when VRAM runs short, and moved between domains by how they are
+ * used, see radeon_exa.c.  The counts follow the domains the driver asks
+ * for; the kernel may still evict VRAM BOs behind its back.
+ */
+
+void radeon_residency_account(ScrnInfoPtr pScrn, int pixmap_class,
+			      uint32_t domain, int64_t size)
+{
+    struct radeon_residency *residency = &RADEONPTR(pScrn)->residency;
+
+    if (domain == RADEON_GEM_DOMAIN_VRAM)
+	residency->vram[pixmap_class] += size;
+    else
+	residency->gtt[pixmap_class] += size;
+}
+
+/* Whether size more bytes fit below the VRAM usage limit */
+Bool radeon_residency_vram_fits(ScrnInfoPtr pScrn, uint32_t size)
+{
+    struct radeon_residency *residency = &RADEONPTR(pScrn)->residency;
+    int64_t used = size;
+    int i;
+
+    if (!residency->vram_limit)
+	return TRUE;
+
+    for (i = 0; i < RADEON_PIXMAP_CLASSES; i++)
+	used += residency->vram[i];
+
+    return used <= residency->vram_limit;
+}
+
+void radeon_residency_report(ScrnInfoPtr pScrn)
+{
+    struct radeon_residency *residency = &RADEONPTR(pScrn)->residency;
+    static const char *names[RADEON_PIXMAP_CLASSES] = {
+	"offscreen", "DRI2", "Xv"
+    };
+    int i;
+
+    for (i = 0; i < RADEON_PIXMAP_CLASSES; i++)
+	xf86DrvMsg(pScrn->scrnIndex, X_INFO,
+		   "%s pixmaps: %lldK in VRAM, %lldK in GTT\n", names[i],
+		   (long long)(residency->vram[i] / 1024),
+		   (long long)(residency->gtt[i] / 1024));
+    xf86DrvMsg(pScrn->scrnIndex, X_INFO,
+	       "%lu pixmaps created in GTT, %lu moved to GTT, "
+	       "%lu moved to VRAM\n", residency->gtt_allocs,
+	       residency->demotions, residency->promotions);
+    xf86DrvMsg(pScrn->scrnIndex, X_INFO,
+	       "%lu pixmaps converted to tiled, %lu to linear\n",
+	       residency->tiled, residency->untiled);
+    xf86DrvMsg(pScrn->scrnIndex, X_INFO,
+	       "%lluK uploaded to and %lluK downloaded from pixmaps\n",
+	       (unsigned long long)(residency->uts_bytes / 1024),
+	       (unsigned long long)(residency->dfs_bytes / 1024));
+}
+
 #ifdef RADEON_PIXMAP_SHARING
 
 Bool radeon_share_pixmap_backing(struct radeon_bo *bo, void **handle_p)
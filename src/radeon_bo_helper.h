@@ -28,6 +28,36 @@ radeon_alloc_pixmap_bo(ScrnInfoPtr pScrn, int width, int height, int depth,
 		       int usage_hint, int bitsPerPixel, int *new_pitch,
 		       struct radeon_surface *new_surface, uint32_t *new_tiling);
 
+extern struct radeon_bo*
+radeon_alloc_pixmap_slab_bo(ScrnInfoPtr pScrn, int width, int height,
+			    int depth, int usage_hint, int bitsPerPixel,
+			    int *new_pitch, struct radeon_surface *new_surface,
+			    uint32_t *new_tiling, struct radeon_slab **new_slab,
+			    uint32_t *new_offset);
+
+extern void
+radeon_bo_cache_init(ScrnInfoPtr pScrn);
+
+extern void
+radeon_bo_cache_fini(ScrnInfoPtr pScrn);
+
+extern void
+radeon_bo_cache_flush(ScrnInfoPtr pScrn);
+
+extern void
+radeon_bo_cache_put(ScrnInfoPtr pScrn, struct radeon_bo *bo,
+		    struct radeon_surface *surface, uint32_t tiling);
+
+extern void
+radeon_residency_account(ScrnInfoPtr pScrn, int pixmap_class,
+			 uint32_t domain, int64_t size);
+
+extern Bool
+radeon_residency_vram_fits(ScrnInfoPtr pScrn, uint32_t size);
+
+extern void
+radeon_residency_report(ScrnInfoPtr pScrn);
+
 extern Bool
 radeon_share_pixmap_backing(struct radeon_bo *bo, void **handle_p);
 
@@ -50,6 +50,7 @@
 #define xorg_list_add			list_add
 #define xorg_list_del			list_del
 #define xorg_list_for_each_entry	list_for_each_entry
+#define xorg_list_for_each_entry_safe	list_for_each_entry_safe
 #endif
 #endif
 
@@ -305,6 +306,8 @@ radeon_dri2_create_buffer2(ScreenPtr pScreen,
 
 	if (is_glamor_pixmap)
 	    pixmap = fixup_glamor(drawable, pixmap);
+	else if (!info->use_glamor && !RADEONEXAPixmapOwnBO(pixmap))
+	    goto error;
 	bo = radeon_get_pixmap_bo(pixmap);
 	if (!bo || radeon_gem_get_kernel_name(bo, &buffers->name) != 0)
 	    goto error;
@@ -512,8 +515,30 @@ typedef struct _DRI2FrameEvent {
     Bool valid;
 
     struct xorg_list link;
+    struct xorg_list vblank_link;
 } DRI2FrameEventRec, *DRI2FrameEventPtr;
 
+/*
+ * Kernel vblank event armed on behalf of all DRI2FrameEvents which target
+ * the same vblank of the same CRTC. Clients synchronised to one display
+ * mostly target the same MSC, so they share a single kernel event which is
+ * fanned out in radeon_dri2_frame_event_handler.
+ */
+typedef struct _DRI2VblankEvent {
+    drmmode_vblank_event_rec base;
+    xf86CrtcPtr crtc;
+    uint32_t sequence;		/* kernel vblank sequence it fires at */
+    struct xorg_list frame_events;
+    struct xorg_list link;
+} DRI2VblankEventRec, *DRI2VblankEventPtr;
+
+/* Armed vblank events, ordered by sequence for each CRTC. Shared by all
+ * screens, so it is initialised statically rather than per screen.
+ */
+static struct xorg_list radeon_dri2_vblank_events = {
+    &radeon_dri2_vblank_events, &radeon_dri2_vblank_events
+};
+
 typedef struct _DRI2ClientEvents {
     struct xorg_list   reference_list;
 } DRI2ClientEventsRec, *DRI2ClientEventsPtr;
@@ -633,7 +658,6 @@ radeon_dri2_schedule_flip(ScrnInfoPtr scrn, ClientPtr client,
 			  void *data, unsigned int target_msc)
 {
     struct dri2_buffer_priv *back_priv;
-    struct radeon_bo *bo;
     DRI2FrameEventPtr flip_info;
     /* Main crtc for this drawable shall finally deliver pageflip event. */
     xf86CrtcPtr crtc = radeon_dri2_drawable_crtc(draw, FALSE);
@@ -656,9 +680,8 @@ radeon_dri2_schedule_flip(ScrnInfoPtr scrn, ClientPtr client,
 
     /* Page flip the full screen buffer */
     back_priv = back->driverPrivate;
-    bo = radeon_get_pixmap_bo(back_priv->pixmap);
 
-    return radeon_do_pageflip(scrn, bo, flip_info, ref_crtc_hw_id);
+    return radeon_do_pageflip(scrn, back_priv->pixmap, flip_info, ref_crtc_hw_id);
 }
 
 static Bool
@@ -673,8 +696,13 @@ update_front(DrawablePtr draw, DRI2BufferPtr front)
     pixmap = get_drawable_pixmap(draw);
     pixmap->refcnt++;
 
-    if (!info->use_glamor)
+    if (!info->use_glamor) {
 	exaMoveInPixmap(pixmap);
+	if (!RADEONEXAPixmapOwnBO(pixmap)) {
+	    (*draw->pScreen->DestroyPixmap)(pixmap);
+	    return FALSE;
+	}
+    }
     bo = radeon_get_pixmap_bo(pixmap);
     r = radeon_gem_get_kernel_name(bo, &front->name);
     if (r) {
@@ -737,12 +765,32 @@ can_flip(ScrnInfoPtr pScrn, DrawablePtr draw,
 	   can_exchange(pScrn, draw, front, back);
 }
 
+static void
+radeon_dri2_fb_reference(RADEONInfoPtr info, struct drmmode_fb **fb,
+			 PixmapPtr pixmap)
+{
+    struct drmmode_fb **fb_ptr = radeon_pixmap_get_fb_ptr(pixmap);
+
+    drmmode_fb_reference(info->drmmode.fd, fb, fb_ptr ? *fb_ptr : NULL);
+}
+
+static void
+radeon_dri2_set_pixmap_fb(RADEONInfoPtr info, PixmapPtr pixmap,
+			  struct drmmode_fb *fb)
+{
+    struct drmmode_fb **fb_ptr = radeon_pixmap_get_fb_ptr(pixmap);
+
+    if (fb_ptr)
+	drmmode_fb_reference(info->drmmode.fd, fb_ptr, fb);
+}
+
 static void
 radeon_dri2_exchange_buffers(DrawablePtr draw, DRI2BufferPtr front, DRI2BufferPtr back)
 {
     struct dri2_buffer_priv *front_priv = front->driverPrivate;
     struct dri2_buffer_priv *back_priv = back->driverPrivate;
     struct radeon_bo *front_bo, *back_bo;
+    struct drmmode_fb *front_fb = NULL, *back_fb = NULL;
     ScreenPtr screen;
     RADEONInfoPtr info;
     RegionRec region;
@@ -759,31 +807,44 @@ radeon_dri2_exchange_buffers(DrawablePtr draw, DRI2BufferPtr front, DRI2BufferPt
     front->name = back->name;
     back->name = tmp;
 
-    /* Swap pixmap bos */
+    screen = draw->pScreen;
+    info = RADEONPTR(xf86ScreenToScrn(screen));
+
+    /* Swap pixmap bos, keeping the cached fbs with their bos */
     front_bo = radeon_get_pixmap_bo(front_priv->pixmap);
     back_bo = radeon_get_pixmap_bo(back_priv->pixmap);
+    radeon_dri2_fb_reference(info, &front_fb, front_priv->pixmap);
+    radeon_dri2_fb_reference(info, &back_fb, back_priv->pixmap);
     radeon_set_pixmap_bo(front_priv->pixmap, back_bo);
     radeon_set_pixmap_bo(back_priv->pixmap, front_bo);
+    radeon_dri2_set_pixmap_fb(info, front_priv->pixmap, back_fb);
+    radeon_dri2_set_pixmap_fb(info, back_priv->pixmap, front_fb);
 
     /* Do we need to update the Screen? */
-    screen = draw->pScreen;
-    info = RADEONPTR(xf86ScreenToScrn(screen));
     if (front_bo == info->front_bo) {
+	PixmapPtr screen_pixmap = screen->GetScreenPixmap(screen);
+
 	radeon_bo_ref(back_bo);
 	radeon_bo_unref(info->front_bo);
 	info->front_bo = back_bo;
-	radeon_set_pixmap_bo(screen->GetScreenPixmap(screen), back_bo);
+	if (radeon_get_pixmap_bo(screen_pixmap) != back_bo) {
+	    radeon_set_pixmap_bo(screen_pixmap, back_bo);
+	    radeon_dri2_set_pixmap_fb(info, screen_pixmap, back_fb);
+	}
     }
 
+    drmmode_fb_reference(info->drmmode.fd, &front_fb, NULL);
+    drmmode_fb_reference(info->drmmode.fd, &back_fb, NULL);
+
     radeon_glamor_exchange_buffers(front_priv->pixmap, back_priv->pixmap);
 
     DamageRegionProcessPending(&front_priv->pixmap->drawable);
 }
 
-void radeon_dri2_frame_event_handler(unsigned int frame, unsigned int tv_sec,
-                                     unsigned int tv_usec, void *event_data)
+static void
+radeon_dri2_frame_event_complete(unsigned int frame, unsigned int tv_sec,
+				 unsigned int tv_usec, DRI2FrameEventPtr event)
 {
-    DRI2FrameEventPtr event = event_data;
     DrawablePtr drawable;
     ScreenPtr screen;
     ScrnInfoPtr scrn;
@@ -859,6 +920,97 @@ cleanup:
     free(event);
 }
 
+void radeon_dri2_frame_event_handler(unsigned int frame, unsigned int tv_sec,
+                                     unsigned int tv_usec, void *event_data)
+{
+    DRI2VblankEventPtr vblank = event_data;
+    DRI2FrameEventPtr event, tmp;
+
+    /* Every delivered vblank refines the CRTC's timing model */
+    drmmode_crtc_vblank_sample(vblank->crtc, frame, tv_sec, tv_usec);
+
+    /* Unlink first, so nothing new can join while we complete */
+    xorg_list_del(&vblank->link);
+
+    xorg_list_for_each_entry_safe(event, tmp, &vblank->frame_events,
+				  vblank_link) {
+	xorg_list_del(&event->vblank_link);
+	radeon_dri2_frame_event_complete(frame, tv_sec, tv_usec, event);
+    }
+
+    free(vblank);
+}
+
+static void
+radeon_dri2_insert_vblank_event(DRI2VblankEventPtr new_vblank)
+{
+    DRI2VblankEventPtr vblank;
+
+    xorg_list_for_each_entry(vblank, &radeon_dri2_vblank_events, link) {
+	if (vblank->crtc == new_vblank->crtc &&
+	    (int32_t)(vblank->sequence - new_vblank->sequence) > 0)
+	    break;
+    }
+
+    /* Before the first later event of the CRTC, or at the tail */
+    xorg_list_add(&new_vblank->link, vblank->link.prev);
+}
+
+/*
+ * Queue a frame event for the vblank described by vbl, an absolute
+ * DRM_VBLANK_EVENT request on the event's CRTC. If a kernel event is
+ * already armed for that vblank and it is still in the future, the frame
+ * event joins it instead of arming another one. Like drmWaitVBlank,
+ * returns non-zero and sets errno on failure, and fills in
+ * vbl->reply.sequence.
+ */
+static int
+radeon_dri2_queue_vblank_event(RADEONInfoPtr info, DRI2FrameEventPtr event,
+			       CARD64 current_msc, drmVBlank *vbl)
+{
+    xf86CrtcPtr crtc = event->crtc;
+    uint32_t current_seq = current_msc - radeon_get_interpolated_vblanks(crtc);
+    uint32_t seq = vbl->request.sequence;
+    DRI2VblankEventPtr vblank;
+    int ret;
+
+    if ((int32_t)(seq - current_seq) > 0) {
+	xorg_list_for_each_entry(vblank, &radeon_dri2_vblank_events, link) {
+	    if (vblank->crtc != crtc)
+		continue;
+	    if (vblank->sequence == seq)
+		goto queue;
+	    if ((int32_t)(vblank->sequence - seq) > 0)
+		break;
+	}
+    }
+
+    vblank = calloc(1, sizeof(DRI2VblankEventRec));
+    if (!vblank) {
+	errno = ENOMEM;
+	return -1;
+    }
+    vblank->base.handler = radeon_dri2_frame_event_handler;
+
+    vbl->request.signal = (unsigned long)vblank;
+    ret = drmWaitVBlank(info->dri2.drm_fd, vbl);
+    if (ret) {
+	free(vblank);
+	return ret;
+    }
+
+    vblank->crtc = crtc;
+    vblank->sequence = vbl->reply.sequence;
+    xorg_list_init(&vblank->frame_events);
+    radeon_dri2_insert_vblank_event(vblank);
+
+queue:
+    /* Complete in the order the frame events were queued */
+    xorg_list_add(&event->vblank_link, vblank->frame_events.prev);
+    vbl->reply.sequence = vblank->sequence;
+    return 0;
+}
+
 drmVBlankSeqType radeon_populate_vbl_request_type(xf86CrtcPtr crtc)
 {
     drmVBlankSeqType type = 0;
@@ -879,6 +1031,49 @@ drmVBlankSeqType radeon_populate_vbl_request_type(xf86CrtcPtr crtc)
     return type; 
 }
 
+/*
+ * Get the current vblank counter and timestamp of a running CRTC. The
+ * CRTC's vblank timing model answers if it can, the kernel otherwise.
+ */
+static Bool
+radeon_dri2_get_crtc_msc(xf86CrtcPtr crtc, CARD64 *ust, CARD64 *msc)
+{
+    drmmode_crtc_private_ptr drmmode_crtc = crtc->driver_private;
+    ScrnInfoPtr scrn = crtc->scrn;
+    RADEONInfoPtr info = RADEONPTR(scrn);
+    drmVBlank vbl;
+    CARD64 now;
+    uint32_t seq;
+    int ret;
+
+    if (drmmode_get_current_ust(info->dri2.drm_fd, &now) == 0 &&
+	drmmode_vblank_model_predict(&drmmode_crtc->vblank_model, now,
+				     &seq, ust)) {
+	*msc = seq + radeon_get_interpolated_vblanks(crtc);
+	*msc &= 0xffffffff;
+	return TRUE;
+    }
+
+    vbl.request.type = DRM_VBLANK_RELATIVE;
+    vbl.request.type |= radeon_populate_vbl_request_type(crtc);
+    vbl.request.sequence = 0;
+
+    ret = drmWaitVBlank(info->dri2.drm_fd, &vbl);
+    if (ret) {
+	xf86DrvMsg(scrn->scrnIndex, X_WARNING,
+		   "get vblank counter failed: %s\n", strerror(errno));
+	return FALSE;
+    }
+
+    drmmode_crtc_vblank_sample(crtc, vbl.reply.sequence,
+			       vbl.reply.tval_sec, vbl.reply.tval_usec);
+
+    *ust = ((CARD64)vbl.reply.tval_sec * 1000000) + vbl.reply.tval_usec;
+    *msc = vbl.reply.sequence + radeon_get_interpolated_vblanks(crtc);
+    *msc &= 0xffffffff;
+    return TRUE;
+}
+
 /*
  * This function should be called on a disabled CRTC only (i.e., CRTC
  * in DPMS-off state). It will calculate the delay necessary to reach
@@ -889,19 +1084,14 @@ CARD32 radeon_dri2_extrapolate_msc_delay(xf86CrtcPtr crtc, CARD64 *target_msc,
 					 CARD64 divisor, CARD64 remainder)
 {
     drmmode_crtc_private_ptr drmmode_crtc = crtc->driver_private;
+    drmmode_vblank_model_ptr model = &drmmode_crtc->vblank_model;
     ScrnInfoPtr pScrn = crtc->scrn;
     RADEONInfoPtr info = RADEONPTR(pScrn);
-    int nominal_frame_rate = drmmode_crtc->dpms_last_fps;
-    CARD64 last_vblank_ust = drmmode_crtc->dpms_last_ust;
-    int last_vblank_seq = drmmode_crtc->dpms_last_seq;
-    int interpolated_vblanks = drmmode_crtc->interpolated_vblanks;
-    int target_seq;
-    CARD64 now, target_time, delta_t;
-    int64_t d, delta_seq;
+    uint32_t interpolated_vblanks = drmmode_crtc->interpolated_vblanks;
+    CARD64 now, target_time;
     int ret;
-    CARD32 d_ms;
 
-    if (!last_vblank_ust) {
+    if (!model->last_ust) {
 	*target_msc = 0;
 	return FALLBACK_SWAP_DELAY;
     }
@@ -912,47 +1102,30 @@ CARD32 radeon_dri2_extrapolate_msc_delay(xf86CrtcPtr crtc, CARD64 *target_msc,
 	*target_msc = 0;
 	return FALLBACK_SWAP_DELAY;
     }
-    target_seq = (int)*target_msc - interpolated_vblanks;
-    delta_seq = (int64_t)target_seq - (int64_t)last_vblank_seq;
-    delta_seq *= 1000000;
-    target_time = last_vblank_ust;
-    target_time += delta_seq / nominal_frame_rate;
-    d = target_time - now;
-    if (d < 0) {
+    target_time = drmmode_vblank_model_ust(model, (uint32_t)*target_msc -
+					   interpolated_vblanks);
+    if (target_time < now) {
 	/* we missed the event, adjust target_msc, do the divisor magic */
 	CARD64 current_msc;
-	current_msc = last_vblank_seq + interpolated_vblanks;
-	delta_t = now - last_vblank_ust;
-	delta_seq = delta_t * nominal_frame_rate;
-	current_msc += delta_seq / 1000000;
+	current_msc = drmmode_vblank_model_seq(model, now);
+	current_msc += interpolated_vblanks;
 	current_msc &= 0xffffffff;
 	if (divisor == 0) {
 	    *target_msc = current_msc;
-	    d = 0;
-	} else {
-	    *target_msc = current_msc - (current_msc % divisor) + remainder;
-	    if ((current_msc % divisor) >= remainder)
-		*target_msc += divisor;
-	    *target_msc &= 0xffffffff;
-	    target_seq = (int)*target_msc - interpolated_vblanks;
-	    delta_seq = (int64_t)target_seq - (int64_t)last_vblank_seq;
-	    delta_seq *= 1000000;
-	    target_time = last_vblank_ust;
-	    target_time += delta_seq / nominal_frame_rate;
-	    d = target_time - now;
+	    return 0;
 	}
+	*target_msc = current_msc - (current_msc % divisor) + remainder;
+	if ((current_msc % divisor) >= remainder)
+	    *target_msc += divisor;
+	*target_msc &= 0xffffffff;
+	target_time = drmmode_vblank_model_ust(model, (uint32_t)*target_msc -
+					       interpolated_vblanks);
     }
     /*
-     * convert delay to milliseconds and add margin to prevent the client
-     * from coming back early (due to timer granularity and rounding
-     * errors) and getting the same MSC it just got
+     * Round up to whole milliseconds for the timer; if it still fires
+     * early, radeon_dri2_deferred_event re-arms it for the remainder
      */
-    d_ms = (CARD32)d / 1000;
-    if ((CARD32)d - d_ms * 1000 > 0)
-	d_ms += 2;
-    else
-	d_ms++;
-    return d_ms;
+    return (CARD32)((target_time - now + 999) / 1000);
 }
 
 /*
@@ -964,7 +1137,6 @@ static int radeon_dri2_get_msc(DrawablePtr draw, CARD64 *ust, CARD64 *msc)
     ScreenPtr screen = draw->pScreen;
     ScrnInfoPtr scrn = xf86ScreenToScrn(screen);
     RADEONInfoPtr info = RADEONPTR(scrn);
-    drmVBlank vbl;
     int ret;
     xf86CrtcPtr crtc = radeon_dri2_drawable_crtc(draw, TRUE);
 
@@ -976,26 +1148,15 @@ static int radeon_dri2_get_msc(DrawablePtr draw, CARD64 *ust, CARD64 *msc)
     }
     if (radeon_crtc_is_enabled(crtc)) {
 	/* CRTC is running, read vblank counter and timestamp */
-	vbl.request.type = DRM_VBLANK_RELATIVE;
-	vbl.request.type |= radeon_populate_vbl_request_type(crtc);
-	vbl.request.sequence = 0;
-
-	ret = drmWaitVBlank(info->dri2.drm_fd, &vbl);
-	if (ret) {
-	    xf86DrvMsg(scrn->scrnIndex, X_WARNING,
-		       "get vblank counter failed: %s\n", strerror(errno));
-	    return FALSE;
-	}
-
-	*ust = ((CARD64)vbl.reply.tval_sec * 1000000) + vbl.reply.tval_usec;
-	*msc = vbl.reply.sequence + radeon_get_interpolated_vblanks(crtc);
-	*msc &= 0xffffffff;
+	return radeon_dri2_get_crtc_msc(crtc, ust, msc);
     } else {
 	/* CRTC is not running, extrapolate MSC and timestamp */
 	drmmode_crtc_private_ptr drmmode_crtc = crtc->driver_private;
-	CARD64 now, delta_t, delta_seq;
+	drmmode_vblank_model_ptr model = &drmmode_crtc->vblank_model;
+	CARD64 now;
+	uint32_t seq;
 
-	if (!drmmode_crtc->dpms_last_ust)
+	if (!model->last_ust)
 	    return FALSE;
 	ret = drmmode_get_current_ust(info->dri2.drm_fd, &now);
 	if (ret) {
@@ -1003,16 +1164,10 @@ static int radeon_dri2_get_msc(DrawablePtr draw, CARD64 *ust, CARD64 *msc)
 		       "%s cannot get current time\n", __func__);
 	    return FALSE;
 	}
-	delta_t = now - drmmode_crtc->dpms_last_ust;
-	delta_seq = delta_t * drmmode_crtc->dpms_last_fps;
-	delta_seq /= 1000000;
-	*ust = drmmode_crtc->dpms_last_ust;
-	delta_t = delta_seq * 1000000;
-	delta_t /= drmmode_crtc->dpms_last_fps;
-	*ust += delta_t;
-	*msc = drmmode_crtc->dpms_last_seq;
+	seq = drmmode_vblank_model_seq(model, now);
+	*ust = drmmode_vblank_model_ust(model, seq);
+	*msc = seq;
 	*msc += drmmode_crtc->interpolated_vblanks;
-	*msc += delta_seq;
 	*msc &= 0xffffffff;
     }
     return TRUE;
@@ -1027,12 +1182,12 @@ CARD32 radeon_dri2_deferred_event(OsTimerPtr timer, CARD32 now, pointer data)
     ScrnInfoPtr scrn;
     RADEONInfoPtr info;
     int status;
-    CARD64 drm_now;
+    CARD64 drm_now, ust;
     int ret;
     unsigned int tv_sec, tv_usec;
-    CARD64 delta_t, delta_seq, frame;
+    uint32_t frame, target;
     drmmode_crtc_private_ptr drmmode_crtc;
-    TimerFree(timer);
+    drmmode_vblank_model_ptr model;
 
     /*
      * This is emulated event, so its time is current time, which we
@@ -1043,14 +1198,16 @@ CARD32 radeon_dri2_deferred_event(OsTimerPtr timer, CARD32 now, pointer data)
      */
     if (!event_info->crtc) {
 	ErrorF("%s no crtc\n", __func__);
-	radeon_dri2_frame_event_handler(0, 0, 0, data);
+	TimerFree(timer);
+	radeon_dri2_frame_event_complete(0, 0, 0, event_info);
 	return 0;
     }
     status = dixLookupDrawable(&drawable, event_info->drawable_id, serverClient,
 			       M_ANY, DixWriteAccess);
     if (status != Success) {
 	ErrorF("%s cannot lookup drawable\n", __func__);
-	radeon_dri2_frame_event_handler(0, 0, 0, data);
+	TimerFree(timer);
+	radeon_dri2_frame_event_complete(0, 0, 0, event_info);
 	return 0;
     }
     screen = drawable->pScreen;
@@ -1060,22 +1217,36 @@ CARD32 radeon_dri2_deferred_event(OsTimerPtr timer, CARD32 now, pointer data)
     if (ret) {
 	xf86DrvMsg(scrn->scrnIndex, X_ERROR,
 		   "%s cannot get current time\n", __func__);
-	radeon_dri2_frame_event_handler(0, 0, 0, data);
+	TimerFree(timer);
+	radeon_dri2_frame_event_complete(0, 0, 0, event_info);
 	return 0;
     }
-    tv_sec = (unsigned int)(drm_now / 1000000);
-    tv_usec = (unsigned int)(drm_now - (CARD64)tv_sec * 1000000);
     /*
      * calculate the frame number from current time
      * that would come from CRTC if it were running
      */
     drmmode_crtc = event_info->crtc->driver_private;
-    delta_t = drm_now - (CARD64)drmmode_crtc->dpms_last_ust;
-    delta_seq = delta_t * drmmode_crtc->dpms_last_fps;
-    delta_seq /= 1000000;
-    frame = (CARD64)drmmode_crtc->dpms_last_seq + delta_seq;
-    frame &= 0xffffffff;
-    radeon_dri2_frame_event_handler((unsigned int)frame, tv_sec, tv_usec, data);
+    model = &drmmode_crtc->vblank_model;
+    frame = drmmode_vblank_model_seq(model, drm_now);
+
+    /* Timers have millisecond granularity, wait out the rest if early */
+    if (model->last_ust && event_info->frame) {
+	target = event_info->frame - drmmode_crtc->interpolated_vblanks;
+	if ((int32_t)(target - frame) > 0) {
+	    ust = drmmode_vblank_model_ust(model, target);
+	    /* rounding in the model may put it at or before now */
+	    if (ust > drm_now)
+		return (CARD32)((ust - drm_now + 999) / 1000);
+	    frame = target;
+	}
+    }
+    TimerFree(timer);
+
+    /* Report the extrapolated time of the vblank, not of the timer */
+    ust = model->last_ust ? drmmode_vblank_model_ust(model, frame) : drm_now;
+    tv_sec = (unsigned int)(ust / 1000000);
+    tv_usec = (unsigned int)(ust - (CARD64)tv_sec * 1000000);
+    radeon_dri2_frame_event_complete(frame, tv_sec, tv_usec, event_info);
     return 0;
 }
 
@@ -1087,7 +1258,10 @@ void radeon_dri2_schedule_event(CARD32 delay, pointer arg)
     timer = TimerSet(NULL, 0, delay, radeon_dri2_deferred_event, arg);
     if (delay == 0) {
 	CARD32 now = GetTimeInMillis();
-	radeon_dri2_deferred_event(timer, now, arg);
+
+	delay = radeon_dri2_deferred_event(timer, now, arg);
+	if (delay)
+	    TimerSet(timer, 0, delay, radeon_dri2_deferred_event, arg);
     }
 }
 
@@ -1108,7 +1282,7 @@ static int radeon_dri2_schedule_wait_msc(ClientPtr client, DrawablePtr draw,
     xf86CrtcPtr crtc = radeon_dri2_drawable_crtc(draw, TRUE);
     drmVBlank vbl;
     int ret;
-    CARD64 current_msc;
+    CARD64 current_msc, current_ust;
 
     /* Truncate to match kernel interfaces; means occasional overflow
      * misses, but that's generally not a big deal */
@@ -1153,18 +1327,8 @@ static int radeon_dri2_schedule_wait_msc(ClientPtr client, DrawablePtr draw,
     }
 
     /* Get current count */
-    vbl.request.type = DRM_VBLANK_RELATIVE;
-    vbl.request.type |= radeon_populate_vbl_request_type(crtc);
-    vbl.request.sequence = 0;
-    ret = drmWaitVBlank(info->dri2.drm_fd, &vbl);
-    if (ret) {
-        xf86DrvMsg(scrn->scrnIndex, X_WARNING,
-                "get vblank counter failed: %s\n", strerror(errno));
+    if (!radeon_dri2_get_crtc_msc(crtc, &current_ust, &current_msc))
         goto out_complete;
-    }
-
-    current_msc = vbl.reply.sequence + radeon_get_interpolated_vblanks(crtc);
-    current_msc &= 0xffffffff;
 
     /*
      * If divisor is zero, or current_msc is smaller than target_msc,
@@ -1184,8 +1348,8 @@ static int radeon_dri2_schedule_wait_msc(ClientPtr client, DrawablePtr draw,
 	vbl.request.type |= radeon_populate_vbl_request_type(crtc);
         vbl.request.sequence = target_msc;
 	vbl.request.sequence -= radeon_get_interpolated_vblanks(crtc);
-        vbl.request.signal = (unsigned long)wait_info;
-        ret = drmWaitVBlank(info->dri2.drm_fd, &vbl);
+        ret = radeon_dri2_queue_vblank_event(info, wait_info, current_msc,
+                                             &vbl);
         if (ret) {
             xf86DrvMsg(scrn->scrnIndex, X_WARNING,
                     "get vblank counter failed: %s\n", strerror(errno));
@@ -1218,8 +1382,7 @@ static int radeon_dri2_schedule_wait_msc(ClientPtr client, DrawablePtr draw,
         vbl.request.sequence += divisor;
     vbl.request.sequence -= radeon_get_interpolated_vblanks(crtc);
 
-    vbl.request.signal = (unsigned long)wait_info;
-    ret = drmWaitVBlank(info->dri2.drm_fd, &vbl);
+    ret = radeon_dri2_queue_vblank_event(info, wait_info, current_msc, &vbl);
     if (ret) {
         xf86DrvMsg(scrn->scrnIndex, X_WARNING,
                 "get vblank counter failed: %s\n", strerror(errno));
@@ -1333,7 +1496,7 @@ static int radeon_dri2_schedule_swap(ClientPtr client, DrawablePtr draw,
     int ret, flip = 0;
     DRI2FrameEventPtr swap_info = NULL;
     enum DRI2FrameEventType swap_type = DRI2_SWAP;
-    CARD64 current_msc;
+    CARD64 current_msc, current_ust;
     BoxRec box;
     RegionRec region;
 
@@ -1389,22 +1552,12 @@ static int radeon_dri2_schedule_swap(ClientPtr client, DrawablePtr draw,
     }
 
     /* Get current count */
-    vbl.request.type = DRM_VBLANK_RELATIVE;
-    vbl.request.type |= radeon_populate_vbl_request_type(crtc);
-    vbl.request.sequence = 0;
-    ret = drmWaitVBlank(info->dri2.drm_fd, &vbl);
-    if (ret) {
-        xf86DrvMsg(scrn->scrnIndex, X_WARNING,
-                "first get vblank counter failed: %s\n",
-                strerror(errno));
+    if (!radeon_dri2_get_crtc_msc(crtc, &current_ust, &current_msc)) {
 	*target_msc = 0;
 	radeon_dri2_schedule_event(FALLBACK_SWAP_DELAY, swap_info);
 	return TRUE;
     }
 
-    current_msc = vbl.reply.sequence + radeon_get_interpolated_vblanks(crtc);
-    current_msc &= 0xffffffff;
-
     /* Flips need to be submitted one frame before */
     if (can_flip(scrn, draw, front, back)) {
 	swap_type = DRI2_FLIP;
@@ -1444,8 +1597,8 @@ static int radeon_dri2_schedule_swap(ClientPtr client, DrawablePtr draw,
 
         vbl.request.sequence = *target_msc;
 	vbl.request.sequence -= radeon_get_interpolated_vblanks(crtc);
-        vbl.request.signal = (unsigned long)swap_info;
-        ret = drmWaitVBlank(info->dri2.drm_fd, &vbl);
+        ret = radeon_dri2_queue_vblank_event(info, swap_info, current_msc,
+                                             &vbl);
         if (ret) {
             xf86DrvMsg(scrn->scrnIndex, X_WARNING,
                     "divisor 0 get vblank counter failed: %s\n",
@@ -1493,8 +1646,7 @@ static int radeon_dri2_schedule_swap(ClientPtr client, DrawablePtr draw,
     /* Account for 1 frame extra pageflip delay if flip > 0 */
     vbl.request.sequence -= flip;
 
-    vbl.request.signal = (unsigned long)swap_info;
-    ret = drmWaitVBlank(info->dri2.drm_fd, &vbl);
+    ret = radeon_dri2_queue_vblank_event(info, swap_info, current_msc, &vbl);
     if (ret) {
         xf86DrvMsg(scrn->scrnIndex, X_WARNING,
                 "final get vblank counter failed: %s\n",
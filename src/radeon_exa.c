@@ -37,6 +37,7 @@
 #include "radeon_reg.h"
 #include "r600_reg.h"
 #include "radeon_drm.h"
+#include "radeon_bo_gem.h"
 #include "radeon_bo_helper.h"
 #include "radeon_probe.h"
 #include "radeon_version.h"
@@ -157,6 +158,320 @@ Bool radeon_transform_is_affine_or_scaled(PictTransformPtr t)
 	return t->matrix[2][0] == 0 && t->matrix[2][1] == 0 && t->matrix[2][2] == IntToxFixed(1);
 }
 
+/* Give the pixmap a copy of its contents in a new BO allocated with
+ * usage_hint
+ */
+static Bool RADEONEXAPixmapCopyBO(PixmapPtr pPix, int usage_hint)
+{
+    ScrnInfoPtr pScrn = xf86ScreenToScrn(pPix->drawable.pScreen);
+    RADEONInfoPtr info = RADEONPTR(pScrn);
+    struct radeon_exa_pixmap_priv *driver_priv;
+    struct radeon_surface surface;
+    struct radeon_bo *bo;
+    uint32_t tiling = 0;
+    int pitch;
+
+    driver_priv = exaGetPixmapDriverPrivate(pPix);
+
+    bo = radeon_alloc_pixmap_bo(pScrn, pPix->drawable.width,
+				pPix->drawable.height, pPix->drawable.depth,
+				usage_hint, pPix->drawable.bitsPerPixel, &pitch,
+				&surface, &tiling);
+    if (!bo)
+	return FALSE;
+
+    if (pitch != pPix->devKind || tiling)
+	goto fail;
+
+    if (radeon_bo_is_referenced_by_cs(driver_priv->bo, info->cs))
+	radeon_cs_flush_indirect(pScrn);
+
+    if (radeon_bo_map(bo, 1))
+	goto fail;
+    if (radeon_bo_map(driver_priv->bo, 0)) {
+	radeon_bo_unmap(bo);
+	goto fail;
+    }
+    memcpy(bo->ptr, (uint8_t*)driver_priv->bo->ptr + driver_priv->offset,
+	   pitch * pPix->drawable.height);
+    radeon_bo_unmap(driver_priv->bo);
+    radeon_bo_unmap(bo);
+
+    radeon_set_pixmap_bo(pPix, bo);
+    driver_priv->surface = surface;
+    radeon_bo_unref(bo);
+
+    if (driver_priv->size) {
+	radeon_residency_account(pScrn, driver_priv->pixmap_class,
+				 driver_priv->domain, -(int64_t)driver_priv->size);
+	driver_priv->size = driver_priv->bo->size;
+	radeon_residency_account(pScrn, driver_priv->pixmap_class,
+				 driver_priv->domain, driver_priv->size);
+    }
+    return TRUE;
+
+fail:
+    radeon_bo_unref(bo);
+    return FALSE;
+}
+
+extern Bool
+R600CopyRect(ScrnInfoPtr pScrn,
+	     struct r600_accel_object *src_obj,
+	     struct r600_accel_object *dst_obj,
+	     int srcX, int srcY, int dstX, int dstY, int w, int h);
+extern Bool
+EVERGREENCopyRect(ScrnInfoPtr pScrn,
+		  struct r600_accel_object *src_obj,
+		  struct r600_accel_object *dst_obj,
+		  int srcX, int srcY, int dstX, int dstY, int w, int h);
+
+/* Convert the pixmap to the layout and domain allocated for usage_hint,
+ * with a single blit.  R600 and up only.
+ */
+static Bool RADEONEXAPixmapRetile(PixmapPtr pPix, int usage_hint)
+{
+    ScreenPtr pScreen = pPix->drawable.pScreen;
+    ScrnInfoPtr pScrn = xf86ScreenToScrn(pScreen);
+    RADEONInfoPtr info = RADEONPTR(pScrn);
+    struct radeon_exa_pixmap_priv *driver_priv;
+    struct r600_accel_object src_obj, dst_obj;
+    struct radeon_surface surface;
+    struct radeon_bo *bo;
+    uint32_t tiling = 0;
+    uint32_t domain = (usage_hint & RADEON_CREATE_PIXMAP_GTT) ?
+	RADEON_GEM_DOMAIN_GTT : RADEON_GEM_DOMAIN_VRAM;
+    int cpp = pPix->drawable.bitsPerPixel / 8;
+    int pitch;
+    Bool ret;
+
+    driver_priv = exaGetPixmapDriverPrivate(pPix);
+    if (!driver_priv || !driver_priv->bo || driver_priv->bo_mapped ||
+	driver_priv->fb || driver_priv->shared ||
+	radeon_gem_name_bo(driver_priv->bo))
+	return FALSE;
+
+    bo = radeon_alloc_pixmap_bo(pScrn, pPix->drawable.width,
+				pPix->drawable.height, pPix->drawable.depth,
+				usage_hint, pPix->drawable.bitsPerPixel, &pitch,
+				&surface, &tiling);
+    if (!bo)
+	return FALSE;
+
+    /* the allocator may have decided against tiling */
+    if (tiling == driver_priv->tiling_flags)
+	goto fail;
+
+    src_obj.pitch = pPix->devKind / cpp;
+    src_obj.width = pPix->drawable.width;
+    src_obj.height = pPix->drawable.height;
+    src_obj.bpp = pPix->drawable.bitsPerPixel;
+    src_obj.domain = RADEON_GEM_DOMAIN_VRAM | RADEON_GEM_DOMAIN_GTT;
+    src_obj.bo = driver_priv->bo;
+    src_obj.offset = driver_priv->offset;
+    src_obj.tiling_flags = driver_priv->tiling_flags;
+    src_obj.surface = &driver_priv->surface;
+
+    dst_obj.pitch = pitch / cpp;
+    dst_obj.width = pPix->drawable.width;
+    dst_obj.height = pPix->drawable.height;
+    dst_obj.bpp = pPix->drawable.bitsPerPixel;
+    dst_obj.domain = domain;
+    dst_obj.bo = bo;
+    dst_obj.offset = 0;
+    dst_obj.tiling_flags = tiling;
+    dst_obj.surface = &surface;
+
+    if (IS_EVERGREEN_3D)
+	ret = EVERGREENCopyRect(pScrn, &src_obj, &dst_obj, 0, 0, 0, 0,
+				pPix->drawable.width, pPix->drawable.height);
+    else
+	ret = R600CopyRect(pScrn, &src_obj, &dst_obj, 0, 0, 0, 0,
+			   pPix->drawable.width, pPix->drawable.height);
+    if (!ret)
+	goto fail;
+
+    radeon_residency_account(pScrn, driver_priv->pixmap_class,
+			     driver_priv->domain, -(int64_t)driver_priv->size);
+    radeon_set_pixmap_bo(pPix, bo);
+    driver_priv->surface = surface;
+    driver_priv->domain = domain;
+    driver_priv->size = bo->size;
+    radeon_residency_account(pScrn, driver_priv->pixmap_class,
+			     driver_priv->domain, driver_priv->size);
+    radeon_bo_unref(bo);
+
+    pScreen->ModifyPixmapHeader(pPix, 0, 0, 0, 0, pitch, NULL);
+    return TRUE;
+
+fail:
+    radeon_bo_unref(bo);
+    return FALSE;
+}
+
+/* Hold a reference to pPix until the next BlockHandler converts it, where
+ * no accelerated operation is being set up
+ */
+static void radeon_pixmap_queue_retile(ScrnInfoPtr pScrn, PixmapPtr pPix,
+				       int usage_hint)
+{
+    struct radeon_accel_state *accel_state = RADEONPTR(pScrn)->accel_state;
+    struct radeon_exa_pixmap_priv *driver_priv;
+
+    driver_priv = exaGetPixmapDriverPrivate(pPix);
+    if (driver_priv->retile_queued ||
+	accel_state->retile_count == RADEON_RETILE_QUEUE_SIZE)
+	return;
+
+    driver_priv->retile_hint = usage_hint;
+    driver_priv->retile_queued = TRUE;
+    pPix->refcnt++;
+    accel_state->retile_queue[accel_state->retile_count++] = pPix;
+}
+
+void RADEONEXARetilePixmaps(ScreenPtr pScreen, Bool convert)
+{
+    ScrnInfoPtr pScrn = xf86ScreenToScrn(pScreen);
+    RADEONInfoPtr info = RADEONPTR(pScrn);
+    struct radeon_accel_state *accel_state = info->accel_state;
+    struct radeon_exa_pixmap_priv *driver_priv;
+    PixmapPtr pPix;
+    int i;
+
+    for (i = 0; i < accel_state->retile_count; i++) {
+	pPix = accel_state->retile_queue[i];
+	driver_priv = exaGetPixmapDriverPrivate(pPix);
+	driver_priv->retile_queued = FALSE;
+
+	/* not worth it for pixmaps nobody else holds anymore */
+	if (convert && pPix->refcnt > 1 &&
+	    RADEONEXAPixmapRetile(pPix, driver_priv->retile_hint)) {
+	    if (driver_priv->tiling_flags)
+		info->residency.tiled++;
+	    else
+		info->residency.untiled++;
+	}
+
+	pScreen->DestroyPixmap(pPix);
+    }
+    accel_state->retile_count = 0;
+}
+
+/* Whether a linear pixmap rendered to a lot should get tiled */
+static Bool radeon_pixmap_want_tiling(RADEONInfoPtr info, PixmapPtr pPix,
+				      struct radeon_exa_pixmap_priv *driver_priv)
+{
+    return IS_R600_3D && info->allowColorTiling && info->surf_man &&
+	!driver_priv->slab &&
+	driver_priv->domain == RADEON_GEM_DOMAIN_VRAM &&
+	RADEONCheckBPP(pPix->drawable.bitsPerPixel) &&
+	pPix->drawable.width >= RADEON_RETILE_MIN_SIZE &&
+	pPix->drawable.height >= RADEON_RETILE_MIN_SIZE;
+}
+
+/*
+ * Residency and layout, driven by how each pixmap is accessed:
+ *
+ * A linear offscreen pixmap the CPU keeps accessing is better off in GTT,
+ * where PrepareAccess can map it instead of EXA going through
+ * DownloadFromScreen/UploadToScreen, so it gets copied to a GTT BO.  One
+ * the GPU mostly renders to is wanted back in VRAM if there's room; the
+ * kernel moves it there with the next CS writing it.  Write domains of a
+ * BO must agree within a CS, so that only happens while the current CS
+ * doesn't reference it.
+ *
+ * Once it's in VRAM and still mostly rendered to, it is converted to a
+ * tiled layout for the bandwidth.  A tiled pixmap can't be mapped at all,
+ * so one the CPU keeps accessing goes back to linear GTT.  Both
+ * conversions are a blit done from the BlockHandler.
+ */
+static void radeon_pixmap_residency(ScrnInfoPtr pScrn, PixmapPtr pPix,
+				    Bool cpu)
+{
+    RADEONInfoPtr info = RADEONPTR(pScrn);
+    struct radeon_exa_pixmap_priv *driver_priv;
+    unsigned samples;
+    Bool cpu_bound, gpu_bound;
+
+    driver_priv = exaGetPixmapDriverPrivate(pPix);
+    if (!driver_priv || !driver_priv->size ||
+	driver_priv->pixmap_class != RADEON_PIXMAP_CLASS_OFFSCREEN ||
+	driver_priv->shared || driver_priv->fb ||
+	radeon_gem_name_bo(driver_priv->bo))
+	return;
+
+    if (cpu)
+	driver_priv->cpu_access++;
+    else
+	driver_priv->gpu_access++;
+
+    samples = driver_priv->cpu_access + driver_priv->gpu_access;
+    if (samples < RADEON_RESIDENCY_SAMPLES)
+	return;
+
+    cpu_bound = driver_priv->cpu_access * 4 >= samples * 3;
+    gpu_bound = driver_priv->gpu_access * 4 >= samples * 3;
+
+    if (driver_priv->tiling_flags) {
+	if (cpu_bound && IS_R600_3D)
+	    radeon_pixmap_queue_retile(pScrn, pPix, RADEON_CREATE_PIXMAP_GTT);
+    } else if (driver_priv->domain == RADEON_GEM_DOMAIN_VRAM) {
+	if (cpu && cpu_bound && !driver_priv->bo_mapped &&
+	    RADEONEXAPixmapCopyBO(pPix, RADEON_CREATE_PIXMAP_GTT)) {
+	    radeon_residency_account(pScrn, driver_priv->pixmap_class,
+				     RADEON_GEM_DOMAIN_VRAM,
+				     -(int64_t)driver_priv->size);
+	    radeon_residency_account(pScrn, driver_priv->pixmap_class,
+				     RADEON_GEM_DOMAIN_GTT, driver_priv->size);
+	    driver_priv->domain = RADEON_GEM_DOMAIN_GTT;
+	    info->residency.demotions++;
+	} else if (gpu_bound &&
+		   radeon_pixmap_want_tiling(info, pPix, driver_priv)) {
+	    radeon_pixmap_queue_retile(pScrn, pPix,
+				       info->allowColorTiling2D ?
+				       RADEON_CREATE_PIXMAP_TILING_MACRO :
+				       RADEON_CREATE_PIXMAP_TILING_MICRO);
+	}
+    } else if (gpu_bound &&
+	       !radeon_bo_is_referenced_by_cs(driver_priv->bo, info->cs) &&
+	       radeon_residency_vram_fits(pScrn, driver_priv->size)) {
+	radeon_residency_account(pScrn, driver_priv->pixmap_class,
+				 RADEON_GEM_DOMAIN_GTT,
+				 -(int64_t)driver_priv->size);
+	radeon_residency_account(pScrn, driver_priv->pixmap_class,
+				 RADEON_GEM_DOMAIN_VRAM, driver_priv->size);
+	driver_priv->domain = RADEON_GEM_DOMAIN_VRAM;
+	info->residency.promotions++;
+    }
+
+    driver_priv->cpu_access /= 2;
+    driver_priv->gpu_access /= 2;
+}
+
+/* The domain the GPU should write pPix in, for the Prepare hooks of
+ * accelerated operations rendering to it
+ */
+uint32_t radeon_pixmap_write_domain(PixmapPtr pPix)
+{
+    radeon_pixmap_residency(xf86ScreenToScrn(pPix->drawable.pScreen), pPix,
+			    FALSE);
+    return radeon_get_pixmap_domain(pPix);
+}
+
+/* Account for an UploadToScreen or DownloadFromScreen of pPix */
+void radeon_pixmap_transfer(PixmapPtr pPix, uint32_t bytes, Bool upload)
+{
+    RADEONInfoPtr info = RADEONPTR(xf86ScreenToScrn(pPix->drawable.pScreen));
+    struct radeon_exa_pixmap_priv *driver_priv;
+
+    driver_priv = exaGetPixmapDriverPrivate(pPix);
+    if (upload)
+	info->residency.uts_bytes += bytes;
+    else
+	info->residency.dfs_bytes += bytes;
+    driver_priv->cpu_access++;
+}
+
 Bool RADEONPrepareAccess_CS(PixmapPtr pPix, int index)
 {
     ScreenPtr pScreen = pPix->drawable.pScreen;
@@ -180,6 +495,8 @@ Bool RADEONPrepareAccess_CS(PixmapPtr pPix, int index)
     if (!driver_priv)
       return FALSE;
 
+    radeon_pixmap_residency(pScrn, pPix, TRUE);
+
     /* untile in DFS/UTS */
     if (driver_priv->tiling_flags & (RADEON_TILING_MACRO | RADEON_TILING_MICRO))
 	return FALSE;
@@ -217,7 +534,7 @@ Bool RADEONPrepareAccess_CS(PixmapPtr pPix, int index)
     }
     driver_priv->bo_mapped = TRUE;
 
-    pPix->devPrivate.ptr = driver_priv->bo->ptr;
+    pPix->devPrivate.ptr = (uint8_t*)driver_priv->bo->ptr + driver_priv->offset;
 
     return TRUE;
 }
@@ -249,6 +566,7 @@ void *RADEONEXACreatePixmap(ScreenPtr pScreen, int size, int align)
     new_priv = calloc(1, sizeof(struct radeon_exa_pixmap_priv));
     if (!new_priv)
 	return NULL;
+    new_priv->domain = RADEON_GEM_DOMAIN_VRAM;
 
     if (size == 0)
 	return new_priv;
@@ -281,45 +599,107 @@ void *RADEONEXACreatePixmap2(ScreenPtr pScreen, int width, int height,
     if (!new_priv) {
 	return NULL;
     }
+    new_priv->domain = RADEON_GEM_DOMAIN_VRAM;
 
     if (width == 0 || height == 0) {
 	return new_priv;
     }
 
-    new_priv->bo = radeon_alloc_pixmap_bo(pScrn, width, height, depth,
-					  usage_hint, bitsPerPixel, new_pitch,
-					  &new_priv->surface,
-					  &new_priv->tiling_flags);
+    if (usage_hint & RADEON_CREATE_PIXMAP_DRI2) {
+	new_priv->pixmap_class = RADEON_PIXMAP_CLASS_DRI2;
+    } else if ((usage_hint & 0xffff) != CREATE_PIXMAP_USAGE_GLYPH_PICTURE &&
+	       (usage_hint & 0xffff) != CREATE_PIXMAP_USAGE_BACKING_PIXMAP &&
+	       !radeon_residency_vram_fits(pScrn, width * height *
+					   (bitsPerPixel / 8))) {
+	/* VRAM is short, leave it to pixmaps which get sampled a lot */
+	usage_hint |= RADEON_CREATE_PIXMAP_GTT;
+	new_priv->domain = RADEON_GEM_DOMAIN_GTT;
+	info->residency.gtt_allocs++;
+    }
+
+    new_priv->bo = radeon_alloc_pixmap_slab_bo(pScrn, width, height, depth,
+					       usage_hint, bitsPerPixel,
+					       new_pitch, &new_priv->surface,
+					       &new_priv->tiling_flags,
+					       &new_priv->slab,
+					       &new_priv->offset);
     if (!new_priv->bo) {
 	free(new_priv);
 	ErrorF("Failed to alloc memory\n");
 	return NULL;
     }
+    new_priv->reusable = !new_priv->slab &&
+	new_priv->domain == RADEON_GEM_DOMAIN_VRAM;
+
+    new_priv->size = new_priv->slab ? new_priv->slab->chunk_size :
+	new_priv->bo->size;
+    radeon_residency_account(pScrn, new_priv->pixmap_class, new_priv->domain,
+			     new_priv->size);
 
     return new_priv;
 }
 
 void RADEONEXADestroyPixmap(ScreenPtr pScreen, void *driverPriv)
 {
+    RADEONInfoPtr info = RADEONPTR(xf86ScreenToScrn(pScreen));
     struct radeon_exa_pixmap_priv *driver_priv = driverPriv;
 
     if (!driverPriv)
       return;
 
-    if (driver_priv->bo)
-	radeon_bo_unref(driver_priv->bo);
+    /* a BO that was scanned out or handed to others can't be recycled */
+    if (driver_priv->fb || driver_priv->shared)
+	driver_priv->reusable = FALSE;
+
+    radeon_residency_account(xf86ScreenToScrn(pScreen),
+			     driver_priv->pixmap_class, driver_priv->domain,
+			     -(int64_t)driver_priv->size);
+
+    drmmode_fb_reference(info->drmmode.fd, &driver_priv->fb, NULL);
+    if (driver_priv->bo) {
+	if (driver_priv->reusable)
+	    radeon_bo_cache_put(xf86ScreenToScrn(pScreen), driver_priv->bo,
+				&driver_priv->surface, driver_priv->tiling_flags);
+	else
+	    radeon_bo_unref(driver_priv->bo);
+    }
+    if (driver_priv->slab)
+	radeon_slab_free(xf86ScreenToScrn(pScreen), driver_priv->slab,
+			 driver_priv->offset);
     free(driverPriv);
 }
 
+/* Give a pixmap living in a slab a BO of its own, for consumers which only
+ * deal in whole BOs, like DRI2 and buffer sharing.
+ */
+Bool RADEONEXAPixmapOwnBO(PixmapPtr pPix)
+{
+    struct radeon_exa_pixmap_priv *driver_priv;
+
+    driver_priv = exaGetPixmapDriverPrivate(pPix);
+    if (!driver_priv || !driver_priv->slab)
+	return TRUE;
+
+    return RADEONEXAPixmapCopyBO(pPix, 0);
+}
+
 #ifdef RADEON_PIXMAP_SHARING
 Bool RADEONEXASharePixmapBacking(PixmapPtr ppix, ScreenPtr slave, void **fd_handle)
 {
     struct radeon_exa_pixmap_priv *driver_priv = exaGetPixmapDriverPrivate(ppix);
 
-    if (!radeon_share_pixmap_backing(driver_priv->bo, fd_handle))
+    if (!RADEONEXAPixmapOwnBO(ppix) ||
+	!radeon_share_pixmap_backing(driver_priv->bo, fd_handle))
 	return FALSE;
 
     driver_priv->shared = TRUE;
+    radeon_residency_account(xf86ScreenToScrn(ppix->drawable.pScreen),
+			     driver_priv->pixmap_class, driver_priv->domain,
+			     -(int64_t)driver_priv->size);
+    driver_priv->domain = RADEON_GEM_DOMAIN_GTT;
+    radeon_residency_account(xf86ScreenToScrn(ppix->drawable.pScreen),
+			     driver_priv->pixmap_class, driver_priv->domain,
+			     driver_priv->size);
     return TRUE;
 }
 
@@ -330,7 +710,13 @@ Bool RADEONEXASetSharedPixmapBacking(PixmapPtr ppix, void *fd_handle)
     if (!radeon_set_shared_pixmap_backing(ppix, fd_handle, &driver_priv->surface))
 	return FALSE;
 
+    /* the imported BO isn't accounted for */
+    radeon_residency_account(xf86ScreenToScrn(ppix->drawable.pScreen),
+			     driver_priv->pixmap_class, driver_priv->domain,
+			     -(int64_t)driver_priv->size);
+    driver_priv->size = 0;
     driver_priv->shared = TRUE;
+    driver_priv->domain = RADEON_GEM_DOMAIN_GTT;
     driver_priv->tiling_flags = 0;
     return TRUE;
 }
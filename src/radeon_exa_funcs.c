@@ -94,9 +94,9 @@ static void Emit2DState(ScrnInfoPtr pScrn, int op)
 }
 
 static void
-RADEONFlush2D(PixmapPtr pPix)
+RADEONFlush2D(ScrnInfoPtr pScrn)
 {
-    RINFO_FROM_SCREEN(pPix->drawable.pScreen);
+    RADEONInfoPtr info = RADEONPTR(pScrn);
 
     TRACE;
 
@@ -107,13 +107,67 @@ RADEONFlush2D(PixmapPtr pPix)
     ADVANCE_RING();
 }
 
+/*
+ * Solid and Copy queue their rects and write them out together.  SRC_Y_X,
+ * DST_Y_X and DST_HEIGHT_WIDTH are consecutive, so each rect is a single
+ * packet0 ending in DST_HEIGHT_WIDTH, which starts the blit.  (The CS
+ * checker doesn't take the PAINT_MULTI/BITBLT_MULTI packets.)
+ */
+static void
+RADEONEmitRects(ScrnInfoPtr pScrn)
+{
+    RADEONInfoPtr info = RADEONPTR(pScrn);
+    struct radeon_2d_state *state = &info->state_2d;
+    Bool copy = state->op == RADEON_2D_EXA_COPY;
+    int i;
+
+    if (!state->num_rects)
+	return;
+
+    BEGIN_RING(state->num_rects * (copy ? 4 : 3));
+    for (i = 0; i < state->num_rects; i++) {
+	if (copy) {
+	    OUT_RING(CP_PACKET0(RADEON_SRC_Y_X, 2));
+	    OUT_RING(state->rects[i][0]);
+	} else
+	    OUT_RING(CP_PACKET0(RADEON_DST_Y_X, 1));
+	OUT_RING(state->rects[i][1]);
+	OUT_RING(state->rects[i][2]);
+    }
+    ADVANCE_RING();
+
+    state->num_rects = 0;
+}
+
+static void
+RADEONQueueRect(ScrnInfoPtr pScrn, uint32_t src_y_x, uint32_t dst_y_x,
+		uint32_t height_width)
+{
+    RADEONInfoPtr info = RADEONPTR(pScrn);
+    struct radeon_2d_state *state = &info->state_2d;
+
+    if (state->num_rects == RADEON_2D_BATCH_SIZE)
+	RADEONEmitRects(pScrn);
+
+    state->rects[state->num_rects][0] = src_y_x;
+    state->rects[state->num_rects][1] = dst_y_x;
+    state->rects[state->num_rects][2] = height_width;
+    state->num_rects++;
+
+    /* a vline wait only holds off the blit right after it */
+    if (info->accel_state->vsync)
+	RADEONEmitRects(pScrn);
+}
+
 static void
 RADEONDone2D(PixmapPtr pPix)
 {
     RINFO_FROM_SCREEN(pPix->drawable.pScreen);
+
+    RADEONEmitRects(pScrn);
     info->state_2d.op = 0;
 
-    RADEONFlush2D(pPix);
+    RADEONFlush2D(pScrn);
 }
 
 static Bool
@@ -138,7 +192,8 @@ RADEONPrepareSolid(PixmapPtr pPix, int alu, Pixel pm, Pixel fg)
     radeon_cs_space_reset_bos(info->cs);
 
     driver_priv = exaGetPixmapDriverPrivate(pPix);
-    radeon_cs_space_add_persistent_bo(info->cs, driver_priv->bo, 0, RADEON_GEM_DOMAIN_VRAM);
+    radeon_cs_space_add_persistent_bo(info->cs, driver_priv->bo, 0,
+				      radeon_pixmap_write_domain(pPix));
 
     ret = radeon_cs_space_check(info->cs);
     if (ret)
@@ -147,7 +202,7 @@ RADEONPrepareSolid(PixmapPtr pPix, int alu, Pixel pm, Pixel fg)
     driver_priv = exaGetPixmapDriverPrivate(pPix);
     if (driver_priv) {
 	info->state_2d.dst_bo = driver_priv->bo;
- 	info->state_2d.dst_domain = driver_priv->shared ? RADEON_GEM_DOMAIN_GTT : RADEON_GEM_DOMAIN_VRAM;
+ 	info->state_2d.dst_domain = driver_priv->domain;
     }
 
     info->state_2d.default_sc_bottom_right = (RADEON_DEFAULT_SC_RIGHT_MAX |
@@ -184,7 +239,8 @@ RADEONSolid(PixmapPtr pPix, int x1, int y1, int x2, int y2)
     TRACE;
 
     if (CS_FULL(info->cs)) {
-	RADEONFlush2D(info->accel_state->dst_pix);
+	RADEONEmitRects(pScrn);
+	RADEONFlush2D(pScrn);
 	radeon_cs_flush_indirect(pScrn);
     }
 
@@ -193,10 +249,7 @@ RADEONSolid(PixmapPtr pPix, int x1, int y1, int x2, int y2)
 			   radeon_pick_best_crtc(pScrn, FALSE, x1, x2, y1, y2),
 			   y1, y2);
 
-    BEGIN_RING(2*2);
-    OUT_RING_REG(RADEON_DST_Y_X, (y1 << 16) | x1);
-    OUT_RING_REG(RADEON_DST_HEIGHT_WIDTH, ((y2 - y1) << 16) | (x2 - x1));
-    ADVANCE_RING();
+    RADEONQueueRect(pScrn, 0, (y1 << 16) | x1, ((y2 - y1) << 16) | (x2 - x1));
 }
 
 static void
@@ -261,7 +314,7 @@ RADEONPrepareCopy(PixmapPtr pSrc,   PixmapPtr pDst,
 
     driver_priv = exaGetPixmapDriverPrivate(pDst);
     info->state_2d.dst_bo = driver_priv->bo;
-    info->state_2d.dst_domain = driver_priv->shared ? RADEON_GEM_DOMAIN_GTT : RADEON_GEM_DOMAIN_VRAM;
+    info->state_2d.dst_domain = radeon_pixmap_write_domain(pDst);
     radeon_cs_space_add_persistent_bo(info->cs, driver_priv->bo, 0, info->state_2d.dst_domain);
 
     ret = radeon_cs_space_check(info->cs);
@@ -289,7 +342,8 @@ RADEONCopy(PixmapPtr pDst,
     TRACE;
 
     if (CS_FULL(info->cs)) {
-        RADEONFlush2D(info->accel_state->dst_pix);
+	RADEONEmitRects(pScrn);
+	RADEONFlush2D(pScrn);
 	radeon_cs_flush_indirect(pScrn);
     }
 
@@ -307,13 +361,8 @@ RADEONCopy(PixmapPtr pDst,
 			   radeon_pick_best_crtc(pScrn, FALSE, dstX, dstX + w, dstY, dstY + h),
 			   dstY, dstY + h);
 
-    BEGIN_RING(2*3);
-
-    OUT_RING_REG(RADEON_SRC_Y_X,	   (srcY << 16) | srcX);
-    OUT_RING_REG(RADEON_DST_Y_X,	   (dstY << 16) | dstX);
-    OUT_RING_REG(RADEON_DST_HEIGHT_WIDTH, (h  << 16) | w);
-
-    ADVANCE_RING();
+    RADEONQueueRect(pScrn, (srcY << 16) | srcX, (dstY << 16) | dstX,
+		    (h << 16) | w);
 }
 
 /* Emit blit with arbitrary source and destination offsets and pitches */
@@ -327,11 +376,11 @@ RADEONBlitChunk(ScrnInfoPtr pScrn, struct radeon_bo *src_bo,
     RADEONInfoPtr info = RADEONPTR(pScrn);
 
     if (src_bo && dst_bo) {
-        BEGIN_ACCEL_RELOC(6, 2);
+        BEGIN_ACCEL_RELOC(5, 2);
     } else if (src_bo && dst_bo == NULL) {
-        BEGIN_ACCEL_RELOC(6, 1);
+        BEGIN_ACCEL_RELOC(5, 1);
     } else {
-        BEGIN_RING(2*6);
+        BEGIN_RING(2*5);
     }
     OUT_RING_REG(RADEON_DP_GUI_MASTER_CNTL,
 		  RADEON_GMC_DST_PITCH_OFFSET_CNTL |
@@ -351,14 +400,10 @@ RADEONBlitChunk(ScrnInfoPtr pScrn, struct radeon_bo *src_bo,
     if (dst_bo) {
 	OUT_RING_RELOC(dst_bo, 0, dst_domain);
     }
-    OUT_RING_REG(RADEON_SRC_Y_X, (srcY << 16) | srcX);
-    OUT_RING_REG(RADEON_DST_Y_X, (dstY << 16) | dstX);
-    OUT_RING_REG(RADEON_DST_HEIGHT_WIDTH, (h << 16) | w);
-    ADVANCE_RING();
-    BEGIN_RING(2*2);
-    OUT_RING_REG(RADEON_DSTCACHE_CTLSTAT, RADEON_RB2D_DC_FLUSH_ALL);
-    OUT_RING_REG(RADEON_WAIT_UNTIL,
-                  RADEON_WAIT_2D_IDLECLEAN | RADEON_WAIT_DMA_GUI_IDLE);
+    OUT_RING(CP_PACKET0(RADEON_SRC_Y_X, 2));
+    OUT_RING((srcY << 16) | srcX);
+    OUT_RING((dstY << 16) | dstX);
+    OUT_RING((h << 16) | w);
     ADVANCE_RING();
 }
 
@@ -391,6 +436,7 @@ RADEONUploadToScreenCS(PixmapPtr pDst, int x, int y, int w, int h,
     driver_priv = exaGetPixmapDriverPrivate(pDst);
     if (!driver_priv || !driver_priv->bo)
 	return FALSE;
+    radeon_pixmap_transfer(pDst, w * h * (bpp / 8), TRUE);
 
 #if X_BYTE_ORDER == X_BIG_ENDIAN
     switch (bpp) {
@@ -423,7 +469,7 @@ RADEONUploadToScreenCS(PixmapPtr pDst, int x, int y, int w, int h,
 	goto copy;
     }
     radeon_cs_space_reset_bos(info->cs);
-    radeon_add_pixmap(info->cs, pDst, 0, RADEON_GEM_DOMAIN_VRAM);
+    radeon_add_pixmap(info->cs, pDst, 0, radeon_get_pixmap_domain(pDst));
     radeon_cs_space_add_persistent_bo(info->cs, scratch, RADEON_GEM_DOMAIN_GTT, 0);
     ret = radeon_cs_space_check(info->cs);
     if (ret) {
@@ -460,6 +506,7 @@ copy:
 	RADEONBlitChunk(pScrn, scratch, driver_priv->bo, datatype, scratch_pitch << 16,
 			dst_pitch_offset, 0, 0, x, y, w, h,
 			RADEON_GEM_DOMAIN_GTT, RADEON_GEM_DOMAIN_VRAM);
+	RADEONFlush2D(pScrn);
     }
 
 out:
@@ -494,6 +541,7 @@ RADEONDownloadFromScreenCS(PixmapPtr pSrc, int x, int y, int w,
     driver_priv = exaGetPixmapDriverPrivate(pSrc);
     if (!driver_priv || !driver_priv->bo)
 	return FALSE;
+    radeon_pixmap_transfer(pSrc, w * h * (bpp / 8), FALSE);
 
 #if X_BYTE_ORDER == X_BIG_ENDIAN
     switch (bpp) {
@@ -544,6 +592,7 @@ RADEONDownloadFromScreenCS(PixmapPtr pSrc, int x, int y, int w,
                     scratch_pitch << 16, x, y, 0, 0, w, h,
                     RADEON_GEM_DOMAIN_VRAM | RADEON_GEM_DOMAIN_GTT,
                     RADEON_GEM_DOMAIN_GTT);
+    RADEONFlush2D(pScrn);
     copy_src = scratch;
     copy_pitch = scratch_pitch;
     flush = TRUE;
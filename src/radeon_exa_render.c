@@ -299,6 +299,31 @@ static Bool RADEONSetupSourceTile(PicturePtr pPict,
     return TRUE;
 }
 
+/* Fold the picture transform (unless the VAP applies it) and the texture
+ * size into one float matrix, so RadeonCompositeTile can produce normalised
+ * texture coordinates without going through PictureTransformPoint.
+ */
+static void RADEONSetupTexCoordXform(RADEONInfoPtr info, int unit)
+{
+    struct radeon_accel_state *accel_state = info->accel_state;
+    float *m = accel_state->texcoord_xform[unit];
+    int i;
+
+    if (accel_state->is_transform[unit] &&
+	(info->ChipFamily < CHIP_FAMILY_R300 || !accel_state->has_tcl)) {
+	for (i = 0; i < 9; i++)
+	    m[i] = xFixedToFloat(accel_state->transform[unit]->matrix[i / 3][i % 3]);
+    } else {
+	for (i = 0; i < 9; i++)
+	    m[i] = (i % 4) ? 0.0 : 1.0;
+    }
+
+    for (i = 0; i < 3; i++) {
+	m[i] /= accel_state->texW[unit];
+	m[3 + i] /= accel_state->texH[unit];
+    }
+}
+
 /* R100-specific code */
 
 static Bool R100CheckCompositeTexture(PicturePtr pPict,
@@ -457,6 +482,7 @@ static Bool R100TextureSetup(PicturePtr pPict, PixmapPtr pPix,
     } else {
 	info->accel_state->is_transform[unit] = FALSE;
     }
+    RADEONSetupTexCoordXform(info, unit);
 
     return TRUE;
 }
@@ -560,7 +586,7 @@ RADEONPrepareCompositeCS(int op, PicturePtr pSrcPicture, PicturePtr pMaskPicture
     if (pMask)
 	radeon_add_pixmap(info->cs, pMask, RADEON_GEM_DOMAIN_GTT | RADEON_GEM_DOMAIN_VRAM, 0);
 
-    radeon_add_pixmap(info->cs, pDst, 0, RADEON_GEM_DOMAIN_VRAM);
+    radeon_add_pixmap(info->cs, pDst, 0, radeon_pixmap_write_domain(pDst));
 
     ret = radeon_cs_space_check(info->cs);
     if (ret)
@@ -854,6 +880,7 @@ static Bool R200TextureSetup(PicturePtr pPict, PixmapPtr pPix,
     } else {
 	info->accel_state->is_transform[unit] = FALSE;
     }
+    RADEONSetupTexCoordXform(info, unit);
 
     return TRUE;
 }
@@ -1325,6 +1352,7 @@ static Bool R300TextureSetup(PicturePtr pPict, PixmapPtr pPix,
 	    info->accel_state->texH[unit] = h;
 	}
     }
+    RADEONSetupTexCoordXform(info, unit);
 
     return TRUE;
 }
@@ -2154,33 +2182,25 @@ static void RadeonDoneComposite(PixmapPtr pDst)
 	pScreen->DestroyPixmap(accel_state->msk_pix);
 }
 
-#define VTX_OUT_MASK(_dstX, _dstY, _srcX, _srcY, _maskX, _maskY)	\
-do {								\
-    OUT_RING(F_TO_DW(_dstX));						\
-    OUT_RING(F_TO_DW(_dstY));						\
-    OUT_RING(F_TO_DW(_srcX));						\
-    OUT_RING(F_TO_DW(_srcY));						\
-    OUT_RING(F_TO_DW(_maskX));						\
-    OUT_RING(F_TO_DW(_maskY));						\
-} while (0)
-
-#define VTX_OUT(_dstX, _dstY, _srcX, _srcY)	\
-do {								\
-    OUT_RING(F_TO_DW(_dstX));						\
-    OUT_RING(F_TO_DW(_dstY));						\
-    OUT_RING(F_TO_DW(_srcX));						\
-    OUT_RING(F_TO_DW(_srcY));						\
-} while (0)
-
-static inline void transformPoint(PictTransform *transform, xPointFixed *point)
+/* Corners of a w x h rect at (x, y) in TL, BL, BR, TR order, pushed through
+ * the 3x3 matrix m.  Plain float math over all four corners at once, which
+ * the compiler can keep in vector registers; q is exactly 1 for affine
+ * transforms and untransformed rects.
+ */
+static inline void RadeonTransformCorners(const float *m,
+					  int x, int y, int w, int h,
+					  float *s, float *t)
 {
-    PictVector v;
-    v.vector[0] = point->x;
-    v.vector[1] = point->y;
-    v.vector[2] = xFixed1;
-    PictureTransformPoint(transform, &v);
-    point->x = v.vector[0];
-    point->y = v.vector[1];
+    const float cx[4] = { x, x, x + w, x + w };
+    const float cy[4] = { y, y + h, y + h, y };
+    int i;
+
+    for (i = 0; i < 4; i++) {
+	float q = m[6] * cx[i] + m[7] * cy[i] + m[8];
+
+	s[i] = (m[0] * cx[i] + m[1] * cy[i] + m[2]) / q;
+	t[i] = (m[3] * cx[i] + m[4] * cy[i] + m[5]) / q;
+    }
 }
 
 static void RadeonCompositeTile(ScrnInfoPtr pScrn,
@@ -2191,9 +2211,10 @@ static void RadeonCompositeTile(ScrnInfoPtr pScrn,
 					   int dstX, int dstY,
 					   int w, int h)
 {
-    int vtx_count;
-    xPointFixed srcTopLeft, srcTopRight, srcBottomLeft, srcBottomRight;
-    static xPointFixed maskTopLeft, maskTopRight, maskBottomLeft, maskBottomRight;
+    static const float identity[9] = { 1, 0, 0, 0, 1, 0, 0, 0, 1 };
+    float dst_x[4], dst_y[4], src_s[4], src_t[4], mask_s[4], mask_t[4];
+    float vtx[4 * 6];
+    int i, vtx_count, first;
 
     ENTER_DRAW(0);
 
@@ -2212,43 +2233,13 @@ static void RadeonCompositeTile(ScrnInfoPtr pScrn,
 						 info->accel_state->dst_pix);
     }
 
-    srcTopLeft.x     = IntToxFixed(srcX);
-    srcTopLeft.y     = IntToxFixed(srcY);
-    srcTopRight.x    = IntToxFixed(srcX + w);
-    srcTopRight.y    = IntToxFixed(srcY);
-    srcBottomLeft.x  = IntToxFixed(srcX);
-    srcBottomLeft.y  = IntToxFixed(srcY + h);
-    srcBottomRight.x = IntToxFixed(srcX + w);
-    srcBottomRight.y = IntToxFixed(srcY + h);
-
-    if (info->accel_state->is_transform[0]) {
-	if ((info->ChipFamily < CHIP_FAMILY_R300) || !info->accel_state->has_tcl) {
-	    transformPoint(info->accel_state->transform[0], &srcTopLeft);
-	    transformPoint(info->accel_state->transform[0], &srcTopRight);
-	    transformPoint(info->accel_state->transform[0], &srcBottomLeft);
-	    transformPoint(info->accel_state->transform[0], &srcBottomRight);
-	}
-    }
+    RadeonTransformCorners(identity, dstX, dstY, w, h, dst_x, dst_y);
+    RadeonTransformCorners(info->accel_state->texcoord_xform[0],
+			   srcX, srcY, w, h, src_s, src_t);
 
     if (info->accel_state->msk_pic) {
-	maskTopLeft.x     = IntToxFixed(maskX);
-	maskTopLeft.y     = IntToxFixed(maskY);
-	maskTopRight.x    = IntToxFixed(maskX + w);
-	maskTopRight.y    = IntToxFixed(maskY);
-	maskBottomLeft.x  = IntToxFixed(maskX);
-	maskBottomLeft.y  = IntToxFixed(maskY + h);
-	maskBottomRight.x = IntToxFixed(maskX + w);
-	maskBottomRight.y = IntToxFixed(maskY + h);
-
-	if (info->accel_state->is_transform[1]) {
-	    if ((info->ChipFamily < CHIP_FAMILY_R300) || !info->accel_state->has_tcl) {
-		transformPoint(info->accel_state->transform[1], &maskTopLeft);
-		transformPoint(info->accel_state->transform[1], &maskTopRight);
-		transformPoint(info->accel_state->transform[1], &maskBottomLeft);
-		transformPoint(info->accel_state->transform[1], &maskBottomRight);
-	    }
-	}
-
+	RadeonTransformCorners(info->accel_state->texcoord_xform[1],
+			       maskX, maskY, w, h, mask_s, mask_t);
 	vtx_count = 6;
     } else
 	vtx_count = 4;
@@ -2323,40 +2314,29 @@ static void RadeonCompositeTile(ScrnInfoPtr pScrn,
 	BEGIN_RING(3 * vtx_count);
     }
 
-    if (info->accel_state->msk_pic) {
-	if (IS_R300_3D || IS_R500_3D) {
-	    VTX_OUT_MASK((float)dstX,                                      (float)dstY,
-			 xFixedToFloat(srcTopLeft.x) / info->accel_state->texW[0],      xFixedToFloat(srcTopLeft.y) / info->accel_state->texH[0],
-			 xFixedToFloat(maskTopLeft.x) / info->accel_state->texW[1],     xFixedToFloat(maskTopLeft.y) / info->accel_state->texH[1]);
-	}
-	VTX_OUT_MASK((float)dstX,                                      (float)(dstY + h),
-		xFixedToFloat(srcBottomLeft.x) / info->accel_state->texW[0],   xFixedToFloat(srcBottomLeft.y) / info->accel_state->texH[0],
-		xFixedToFloat(maskBottomLeft.x) / info->accel_state->texW[1],  xFixedToFloat(maskBottomLeft.y) / info->accel_state->texH[1]);
-	VTX_OUT_MASK((float)(dstX + w),                                (float)(dstY + h),
-		xFixedToFloat(srcBottomRight.x) / info->accel_state->texW[0],  xFixedToFloat(srcBottomRight.y) / info->accel_state->texH[0],
-		xFixedToFloat(maskBottomRight.x) / info->accel_state->texW[1], xFixedToFloat(maskBottomRight.y) / info->accel_state->texH[1]);
-	VTX_OUT_MASK((float)(dstX + w),                                (float)dstY,
-		xFixedToFloat(srcTopRight.x) / info->accel_state->texW[0],     xFixedToFloat(srcTopRight.y) / info->accel_state->texH[0],
-		xFixedToFloat(maskTopRight.x) / info->accel_state->texW[1],    xFixedToFloat(maskTopRight.y) / info->accel_state->texH[1]);
-    } else {
-	if (IS_R300_3D || IS_R500_3D) {
-	    VTX_OUT((float)dstX,                                      (float)dstY,
-		    xFixedToFloat(srcTopLeft.x) / info->accel_state->texW[0],      xFixedToFloat(srcTopLeft.y) / info->accel_state->texH[0]);
+    for (i = 0; i < 4; i++) {
+	float *v = &vtx[i * vtx_count];
+
+	v[0] = dst_x[i];
+	v[1] = dst_y[i];
+	v[2] = src_s[i];
+	v[3] = src_t[i];
+	if (vtx_count == 6) {
+	    v[4] = mask_s[i];
+	    v[5] = mask_t[i];
 	}
-	VTX_OUT((float)dstX,                                      (float)(dstY + h),
-		xFixedToFloat(srcBottomLeft.x) / info->accel_state->texW[0],   xFixedToFloat(srcBottomLeft.y) / info->accel_state->texH[0]);
-	VTX_OUT((float)(dstX + w),                                (float)(dstY + h),
-		xFixedToFloat(srcBottomRight.x) / info->accel_state->texW[0],  xFixedToFloat(srcBottomRight.y) / info->accel_state->texH[0]);
-	VTX_OUT((float)(dstX + w),                                (float)dstY,
-		xFixedToFloat(srcTopRight.x) / info->accel_state->texW[0],     xFixedToFloat(srcTopRight.y) / info->accel_state->texH[0]);
     }
 
+    /* quads on R300/R500 start at the top left corner, rect lists at the
+     * bottom left one */
+    first = (IS_R300_3D || IS_R500_3D) ? 0 : 1;
+    radeon_cs_write_table(info->cs, &vtx[first * vtx_count],
+			  (4 - first) * vtx_count);
+
     ADVANCE_RING();
 
     LEAVE_DRAW(0);
 }
-#undef VTX_OUT
-#undef VTX_OUT_MASK
 
 static void RadeonComposite(PixmapPtr pDst,
 				       int srcX, int srcY,
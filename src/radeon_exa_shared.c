@@ -35,6 +35,7 @@
 #endif
 
 #include "radeon.h"
+#include "radeon_reg.h"
 #include "radeon_probe.h"
 #include "radeon_version.h"
 #include "radeon_vbo.h"
@@ -123,10 +124,13 @@ Bool RADEONCheckBPP(int bpp)
 	return FALSE;
 }
 
-PixmapPtr RADEONSolidPixmap(ScreenPtr pScreen, uint32_t solid)
+static PixmapPtr RADEONCreateSolidPixmap(ScreenPtr pScreen, uint32_t solid)
 {
     PixmapPtr pPix = pScreen->CreatePixmap(pScreen, 1, 1, 32, 0);
     struct radeon_bo *bo;
+
+    if (!pPix)
+	return NULL;
     exaMoveInPixmap(pPix);
 
     bo = radeon_get_pixmap_bo(pPix);
@@ -136,12 +140,270 @@ PixmapPtr RADEONSolidPixmap(ScreenPtr pScreen, uint32_t solid)
 	return NULL;
     }
 
-    memcpy(bo->ptr, &solid, 4);
+    memcpy((uint8_t*)bo->ptr + radeon_get_pixmap_offset(pPix), &solid, 4);
     radeon_bo_unmap(bo);
 
     return pPix;
 }
 
+/* Solid pixmaps are never written again once created, so a cached one can
+ * be handed out while the GPU still reads it.  The cache holds one
+ * reference and each caller gets its own, which the callers drop with
+ * DestroyPixmap as before.
+ */
+PixmapPtr RADEONSolidPixmap(ScreenPtr pScreen, uint32_t solid)
+{
+    ScrnInfoPtr pScrn = xf86ScreenToScrn(pScreen);
+    struct radeon_accel_state *accel_state = RADEONPTR(pScrn)->accel_state;
+    struct radeon_solid_cache_entry *entry, *lru = &accel_state->solid_cache[0];
+    PixmapPtr pPix;
+    int i;
+
+    for (i = 0; i < RADEON_SOLID_CACHE_SIZE; i++) {
+	entry = &accel_state->solid_cache[i];
+
+	if (entry->pixmap && entry->color == solid) {
+	    entry->last_use = ++accel_state->solid_cache_tick;
+	    entry->pixmap->refcnt++;
+	    return entry->pixmap;
+	}
+
+	if (lru->pixmap && (!entry->pixmap || entry->last_use < lru->last_use))
+	    lru = entry;
+    }
+
+    pPix = RADEONCreateSolidPixmap(pScreen, solid);
+    if (!pPix)
+	return NULL;
+
+    if (lru->pixmap)
+	pScreen->DestroyPixmap(lru->pixmap);
+    lru->pixmap = pPix;
+    lru->color = solid;
+    lru->last_use = ++accel_state->solid_cache_tick;
+    pPix->refcnt++;
+
+    return pPix;
+}
+
+void RADEONSolidPixmapCacheFini(ScreenPtr pScreen)
+{
+    ScrnInfoPtr pScrn = xf86ScreenToScrn(pScreen);
+    struct radeon_accel_state *accel_state = RADEONPTR(pScrn)->accel_state;
+    int i;
+
+    for (i = 0; i < RADEON_SOLID_CACHE_SIZE; i++) {
+	if (!accel_state->solid_cache[i].pixmap)
+	    continue;
+	pScreen->DestroyPixmap(accel_state->solid_cache[i].pixmap);
+	accel_state->solid_cache[i].pixmap = NULL;
+    }
+}
+
+/*
+ * Shader cache: each program, identified by its generator and variant, is
+ * generated the first time it's asked for and appended to shaders_bo.
+ * The BO stays mapped, so appending doesn't wait for the GPU, and programs
+ * never move or get overwritten while a CS may reference them.  When it's
+ * full, the programs are copied to a BO twice the size at the same offsets;
+ * CS already emitted keep the old one alive.
+ */
+
+static Bool radeon_shader_cache_grow(ScrnInfoPtr pScrn, uint32_t size)
+{
+    RADEONInfoPtr info = RADEONPTR(pScrn);
+    struct radeon_accel_state *accel_state = info->accel_state;
+    struct radeon_bo *bo;
+
+    bo = radeon_bo_open(info->bufmgr, 0, size, RADEON_SHADER_ALIGN,
+			RADEON_GEM_DOMAIN_VRAM, 0);
+    if (!bo)
+	return FALSE;
+
+    if (radeon_bo_map(bo, 1)) {
+	radeon_bo_unref(bo);
+	return FALSE;
+    }
+
+    if (accel_state->shaders_bo) {
+	memcpy(bo->ptr, accel_state->shaders_bo->ptr, accel_state->shaders_size);
+	radeon_bo_unmap(accel_state->shaders_bo);
+	radeon_bo_unref(accel_state->shaders_bo);
+    }
+    accel_state->shaders_bo = bo;
+    return TRUE;
+}
+
+Bool radeon_shader_cache_init(ScrnInfoPtr pScrn)
+{
+    struct radeon_accel_state *accel_state = RADEONPTR(pScrn)->accel_state;
+
+    accel_state->num_shaders = 0;
+    accel_state->shaders_size = 0;
+    if (!radeon_shader_cache_grow(pScrn, RADEON_SHADER_BO_SIZE)) {
+	ErrorF("Allocating shader failed\n");
+	return FALSE;
+    }
+    return TRUE;
+}
+
+void radeon_shader_cache_fini(ScrnInfoPtr pScrn)
+{
+    struct radeon_accel_state *accel_state = RADEONPTR(pScrn)->accel_state;
+
+    if (!accel_state->shaders_bo)
+	return;
+
+    radeon_bo_unmap(accel_state->shaders_bo);
+    radeon_bo_unref(accel_state->shaders_bo);
+    accel_state->shaders_bo = NULL;
+}
+
+/* Offset in shaders_bo of the program gen emits for variant */
+Bool radeon_shader_get(ScrnInfoPtr pScrn, radeon_shader_gen gen,
+		       uint32_t variant, uint32_t *offset)
+{
+    RADEONInfoPtr info = RADEONPTR(pScrn);
+    struct radeon_accel_state *accel_state = info->accel_state;
+    struct radeon_shader_cache_entry *entry;
+    static uint32_t shader[RADEON_SHADER_MAX_DWORDS + 1];
+    uint32_t size, bo_size;
+    int i, n;
+
+    for (i = 0; i < accel_state->num_shaders; i++) {
+	entry = &accel_state->shaders[i];
+	if (entry->gen == gen && entry->variant == variant) {
+	    *offset = entry->offset;
+	    return TRUE;
+	}
+    }
+
+    if (accel_state->num_shaders == RADEON_SHADER_CACHE_SIZE)
+	return FALSE;
+
+    /* callers fall back to the generic programs like for a full cache */
+    n = gen(info->ChipFamily, shader, variant, RADEON_SHADER_MAX_DWORDS);
+    if (n > RADEON_SHADER_MAX_DWORDS) {
+	xf86DrvMsgVerb(pScrn->scrnIndex, X_WARNING, RADEON_LOGLEVEL_DEBUG,
+		       "Shader variant 0x%x needs %d dwords, more than %d\n",
+		       variant, n, RADEON_SHADER_MAX_DWORDS);
+	return FALSE;
+    }
+
+    size = n * 4;
+    bo_size = accel_state->shaders_bo->size;
+    while (accel_state->shaders_size + size > bo_size)
+	bo_size *= 2;
+    if (bo_size != accel_state->shaders_bo->size &&
+	!radeon_shader_cache_grow(pScrn, bo_size))
+	return FALSE;
+
+    entry = &accel_state->shaders[accel_state->num_shaders++];
+    entry->gen = gen;
+    entry->variant = variant;
+    entry->offset = accel_state->shaders_size;
+    memcpy((uint8_t*)accel_state->shaders_bo->ptr + entry->offset, shader, size);
+    accel_state->shaders_size += RADEON_ALIGN(size, RADEON_SHADER_ALIGN);
+
+    *offset = entry->offset;
+    return TRUE;
+}
+
+/*
+ * Make a program that only calls subroutines run straight through: the
+ * n CF slot ranges in cf[] (first slot, count) are copied in order over
+ * the start of the program, the last one ending it.  Clause addresses are
+ * absolute, so the clauses themselves stay where they are.
+ */
+void radeon_shader_flatten(uint32_t *shader, const int *cf, int n)
+{
+    uint32_t prog[2 * 16];
+    int i, slots = 0;
+
+    for (i = 0; i < n; i++) {
+	memcpy(&prog[2 * slots], &shader[2 * cf[2 * i]], 8 * cf[2 * i + 1]);
+	slots += cf[2 * i + 1];
+    }
+    memcpy(shader, prog, 8 * slots);
+}
+
+/*
+ * The default 3D state is the same every time it's emitted except for the
+ * reloc indices, so the first *_set_default_state records what it emits
+ * and later ones copy that into the CS in one go, redoing the relocs.
+ * They're all dummies against shaders_bo (unused DB, cleared FS).  The
+ * kernel doesn't accept IB chaining from us on these families, so a copy
+ * per CS is as cheap as it gets.
+ */
+int radeon_default_state_begin(ScrnInfoPtr pScrn)
+{
+    RADEONInfoPtr info = RADEONPTR(pScrn);
+
+    /* a flush in the middle would cut the recording short */
+    if (info->cs->cdw + RADEON_DEFAULT_STATE_DWORDS > info->cs->ndw)
+	radeon_cs_flush_indirect(pScrn);
+    return info->cs->cdw;
+}
+
+void radeon_default_state_end(ScrnInfoPtr pScrn, int start)
+{
+    RADEONInfoPtr info = RADEONPTR(pScrn);
+    struct radeon_accel_state *accel_state = info->accel_state;
+    uint32_t *state = &info->cs->packets[start];
+    int ndw = (int)info->cs->cdw - start;
+    int i, n = 0;
+
+    if (accel_state->default_state ||
+	ndw <= 0 || ndw > RADEON_DEFAULT_STATE_DWORDS)
+	return;
+
+    for (i = 0; i < ndw;
+	 i += ((state[i] & RADEON_CP_PACKET_COUNT_MASK) >> 16) + 2) {
+	if ((state[i] & RADEON_CP_PACKET_MASK) != RADEON_CP_PACKET3)
+	    return;
+	if (state[i] == RADEON_CP_PACKET3_NOP) {
+	    if (n == RADEON_DEFAULT_STATE_RELOCS)
+		return;
+	    accel_state->default_state_relocs[n++] = i;
+	}
+    }
+
+    accel_state->default_state = malloc(ndw * 4);
+    if (!accel_state->default_state)
+	return;
+    memcpy(accel_state->default_state, state, ndw * 4);
+    accel_state->default_state_ndw = ndw;
+    accel_state->num_default_state_relocs = n;
+}
+
+Bool radeon_default_state_replay(ScrnInfoPtr pScrn)
+{
+    RADEONInfoPtr info = RADEONPTR(pScrn);
+    struct radeon_accel_state *accel_state = info->accel_state;
+    uint32_t *state = accel_state->default_state;
+    int i, reloc, start = 0;
+
+    if (!state)
+	return FALSE;
+
+    radeon_ddx_cs_start(pScrn, accel_state->default_state_ndw,
+			__FILE__, __func__, __LINE__);
+    accel_state->XInited3D = TRUE;
+
+    for (i = 0; i < accel_state->num_default_state_relocs; i++) {
+	reloc = accel_state->default_state_relocs[i];
+	radeon_cs_write_table(info->cs, &state[start], reloc - start);
+	radeon_cs_write_reloc(info->cs, accel_state->shaders_bo,
+			      RADEON_GEM_DOMAIN_VRAM, 0, 0);
+	start = reloc + 2;
+    }
+    radeon_cs_write_table(info->cs, &state[start],
+			  accel_state->default_state_ndw - start);
+
+    radeon_cs_end(info->cs, __FILE__, __func__, __LINE__);
+    return TRUE;
+}
+
 int radeon_cp_start(ScrnInfoPtr pScrn)
 {
     RADEONInfoPtr info = RADEONPTR(pScrn);
@@ -199,6 +461,7 @@ void radeon_ib_discard(ScrnInfoPtr pScrn)
 	return;
     }
     radeon_cs_erase(info->cs);
+    info->cs_serial++;
     ret = radeon_cs_space_check_with_bo(info->cs,
 					info->accel_state->vbo.vb_bo,
 					RADEON_GEM_DOMAIN_GTT, 0);
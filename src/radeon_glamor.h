@@ -49,6 +49,7 @@ struct radeon_pixmap {
 
 	uint32_t tiling_flags;
 	int stride;
+	struct drmmode_fb *fb;
 };
 
 #if HAS_DEVPRIVATEKEYREC
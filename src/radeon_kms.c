@@ -54,6 +54,7 @@
 #include "radeon_bo_gem.h"
 #include "radeon_cs_gem.h"
 #include "radeon_vbo.h"
+#include "radeon_bo_helper.h"
 
 extern SymTabRec RADEONChipsets[];
 static Bool radeon_setup_kernel_mem(ScreenPtr pScreen);
@@ -74,6 +75,9 @@ const OptionInfoRec RADEONOptions_KMS[] = {
     { OPTION_ZAPHOD_HEADS,   "ZaphodHeads",      OPTV_STRING,  {0}, FALSE },
     { OPTION_PAGE_FLIP,      "EnablePageFlip",   OPTV_BOOLEAN, {0}, FALSE },
     { OPTION_SWAPBUFFERS_WAIT,"SwapbuffersWait", OPTV_BOOLEAN, {0}, FALSE },
+    { OPTION_TEXTURED_VIDEO_BATCH,"TexturedVideoBatch", OPTV_BOOLEAN, {0}, FALSE },
+    { OPTION_ASYNC_DMA,      "AsyncDMA",         OPTV_BOOLEAN, {0}, FALSE },
+    { OPTION_TEXTURED_VIDEO_TILING,"TexturedVideoTiling", OPTV_BOOLEAN, {0}, FALSE },
     { -1,                    NULL,               OPTV_NONE,    {0}, FALSE }
 };
 
@@ -102,10 +106,13 @@ void radeon_cs_flush_indirect(ScrnInfoPtr pScrn)
 
     radeon_cs_emit(info->cs);
     radeon_cs_erase(info->cs);
+    info->cs_serial++;
 
     if (accel_state->use_vbos)
         radeon_vbo_flush_bos(pScrn);
 
+    radeon_bo_cache_flush(pScrn);
+
     ret = radeon_cs_space_check_with_bo(info->cs,
 					accel_state->vbo.vb_bo,
 					RADEON_GEM_DOMAIN_GTT, 0);
@@ -291,6 +298,12 @@ static void RADEONBlockHandler_KMS(BLOCKHANDLER_ARGS_DECL)
     ScrnInfoPtr    pScrn   = xf86ScreenToScrn(pScreen);
     RADEONInfoPtr  info    = RADEONPTR(pScrn);
 
+    if (info->xv_batch)
+	RADEONFlushTexturedVideo(pScrn);
+
+    if (info->accel_state->retile_count)
+	RADEONEXARetilePixmaps(pScreen, TRUE);
+
     pScreen->BlockHandler = info->BlockHandler;
     (*pScreen->BlockHandler) (BLOCKHANDLER_ARGS);
     pScreen->BlockHandler = RADEONBlockHandler_KMS;
@@ -913,6 +926,28 @@ Bool RADEONPreInit_KMS(ScrnInfoPtr pScrn, int flags)
     xf86DrvMsg(pScrn->scrnIndex, X_INFO,
 	       "SwapBuffers wait for vsync: %sabled\n", info->swapBuffersWait ? "en" : "dis");
 
+    info->xv_batch = xf86ReturnOptValBool(info->Options,
+					  OPTION_TEXTURED_VIDEO_BATCH, FALSE);
+    if (info->xv_batch)
+	xf86DrvMsg(pScrn->scrnIndex, X_CONFIG, "Textured video batching enabled\n");
+
+    if (info->ChipFamily >= CHIP_FAMILY_R600 &&
+	xf86ReturnOptValBool(info->Options, OPTION_TEXTURED_VIDEO_TILING, FALSE)) {
+	info->xv_tiling = TRUE;
+	xf86DrvMsg(pScrn->scrnIndex, X_CONFIG, "Textured video tiling enabled\n");
+    }
+
+    if (info->ChipFamily >= CHIP_FAMILY_CEDAR && !info->use_glamor &&
+	!info->r600_shadow_fb &&
+	xf86ReturnOptValBool(info->Options, OPTION_ASYNC_DMA, FALSE)) {
+	if (info->dri2.pKernelDRMVersion->version_minor >= 27) {
+	    info->dma_copy = TRUE;
+	    xf86DrvMsg(pScrn->scrnIndex, X_CONFIG, "Async DMA transfers enabled\n");
+	} else
+	    xf86DrvMsg(pScrn->scrnIndex, X_INFO,
+		       "Async DMA transfers require radeon drm 2.27.0 or newer\n");
+    }
+
     if (drmmode_pre_init(pScrn, &info->drmmode, pScrn->bitsPerPixel / 8) == FALSE) {
 	xf86DrvMsg(pScrn->scrnIndex, X_ERROR, "Kernel modesetting setup failed\n");
 	goto fail;
@@ -1114,14 +1149,22 @@ static Bool RADEONCloseScreen_KMS(CLOSE_SCREEN_ARGS_DECL)
     DeleteCallback(&FlushCallback, radeon_flush_callback, pScrn);
 
     if (info->accel_state->exa) {
+	radeon_residency_report(pScrn);
+	RADEONEXARetilePixmaps(pScreen, FALSE);
+	RADEONSolidPixmapCacheFini(pScreen);
 	exaDriverFini(pScreen);
 	free(info->accel_state->exa);
 	info->accel_state->exa = NULL;
+	radeon_shader_cache_fini(pScrn);
+	free(info->accel_state->default_state);
+	info->accel_state->default_state = NULL;
     }
 
     if (info->accel_state->use_vbos)
         radeon_vbo_free_lists(pScrn);
 
+    radeon_bo_cache_fini(pScrn);
+
     drmDropMaster(info->dri2.drm_fd);
 
     drmmode_fini(pScrn, &info->drmmode);
@@ -1422,6 +1465,9 @@ void RADEONLeaveVT_KMS(VT_FUNC_ARGS_DECL)
     info->accel_state->XInited3D = FALSE;
     info->accel_state->engineMode = EXA_ENGINEMODE_UNKNOWN;
 
+    if (info->accel_state->exa)
+	radeon_residency_report(pScrn);
+
     xf86DrvMsgVerb(pScrn->scrnIndex, X_INFO, RADEON_LOGLEVEL_DEBUG,
 		   "Ok, leaving now...\n");
 }
@@ -1613,6 +1659,7 @@ void radeon_kms_update_vram_limit(ScrnInfoPtr pScrn, int new_fb_size)
     remain_size_bytes = info->vram_size - new_fb_size;
     remain_size_bytes = (remain_size_bytes / 10) * 9;
     radeon_cs_set_limit(info->cs, RADEON_GEM_DOMAIN_VRAM, remain_size_bytes);
+    info->residency.vram_limit = remain_size_bytes;
 
     xf86DrvMsg(pScrn->scrnIndex, X_INFO, "VRAM usage limit set to %dK\n", remain_size_bytes / 1024);
 }
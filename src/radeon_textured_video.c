@@ -38,6 +38,8 @@
 #include "radeon_reg.h"
 #include "radeon_probe.h"
 #include "radeon_video.h"
+#include "radeon_bo_helper.h"
+#include "dixstruct.h"
 
 #include <X11/extensions/Xv.h>
 #include "fourcc.h"
@@ -48,6 +50,41 @@ R600DisplayTexturedVideo(ScrnInfoPtr pScrn, RADEONPortPrivPtr pPriv);
 extern void
 EVERGREENDisplayTexturedVideo(ScrnInfoPtr pScrn, RADEONPortPrivPtr pPriv);
 
+extern void
+r600_cp_wait_vline_sync(ScrnInfoPtr pScrn, PixmapPtr pPix, xf86CrtcPtr crtc, int start, int stop);
+
+extern void
+evergreen_cp_wait_vline_sync(ScrnInfoPtr pScrn, PixmapPtr pPix, xf86CrtcPtr crtc, int start, int stop);
+
+extern Bool
+evergreen_dma_wanted(ScrnInfoPtr pScrn, uint32_t line_bytes, int h, Bool vsync);
+
+extern Bool
+evergreen_dma_copy(ScrnInfoPtr pScrn,
+		   struct radeon_bo *dst_bo, uint32_t dst_domain,
+		   uint32_t dst_offset, uint32_t dst_pitch,
+		   struct radeon_bo *src_bo, uint32_t src_domain,
+		   uint32_t src_offset, uint32_t src_pitch,
+		   uint32_t line_bytes, int h);
+
+extern Bool
+R600CopyRect(ScrnInfoPtr pScrn,
+	     struct r600_accel_object *src_obj,
+	     struct r600_accel_object *dst_obj,
+	     int srcX, int srcY, int dstX, int dstY, int w, int h);
+
+extern Bool
+EVERGREENCopyRect(ScrnInfoPtr pScrn,
+		  struct r600_accel_object *src_obj,
+		  struct r600_accel_object *dst_obj,
+		  int srcX, int srcY, int dstX, int dstY, int w, int h);
+
+static void
+RADEONDisplayTexturedVideoPort(ScrnInfoPtr pScrn, RADEONPortPrivPtr pPriv);
+
+static void
+RADEONCancelVideoVblank(ScrnInfoPtr pScrn, RADEONPortPrivPtr pPriv);
+
 
 #define IMAGE_MAX_WIDTH		2048
 #define IMAGE_MAX_HEIGHT	2048
@@ -112,15 +149,83 @@ static __inline__ uint32_t float4touint(float fr, float fg, float fb, float fa)
     return (ua << 24) | (ur << 16) | (ug << 8) | ub;
 }
 
-/* Parameters for ITU-R BT.601 and ITU-R BT.709 colour spaces
+/* Parameters for ITU-R BT.601, BT.709 and BT.2020 (non-constant
+   luminance) colour spaces
    note the difference to the parameters used in overlay are due
    to 10bit vs. float calcs */
-static REF_TRANSFORM trans[2] =
+static REF_TRANSFORM trans[RADEON_VIDEO_NUM_TRANSFORMS] =
 {
     {1.1643, 0.0, 1.5960, -0.3918, -0.8129, 2.0172, 0.0}, /* BT.601 */
-    {1.1643, 0.0, 1.7927, -0.2132, -0.5329, 2.1124, 0.0}  /* BT.709 */
+    {1.1643, 0.0, 1.7927, -0.2132, -0.5329, 2.1124, 0.0}, /* BT.709 */
+    {1.1643, 0.0, 1.6787, -0.1873, -0.6504, 2.1418, 0.0}  /* BT.2020 */
 };
 
+/*
+ * Colour conversion constants for the R300+ video shaders:
+ *   csc[0..3]  = off.rgb, yco
+ *   csc[4..7]  = uco.rgb, gamma
+ *   csc[8..11] = vco.rgb, 0
+ * Kept per port and only recomputed when one of the attributes they
+ * depend on changes, so the trig is not redone for every frame.
+ */
+const float *
+RADEONTexturedVideoCSC(RADEONPortPrivPtr pPriv)
+{
+    const float Loff = -0.0627;
+    const float Coff = -0.502;
+    float uvcosf, uvsinf;
+    float yco;
+    float uco[3], vco[3];
+    float bright, cont;
+    int ref = pPriv->transform_index;
+    int key[RADEON_VIDEO_CSC_KEYS];
+    float *csc = pPriv->csc;
+
+    key[0] = pPriv->transform_index;
+    key[1] = pPriv->gamma;
+    key[2] = pPriv->brightness;
+    key[3] = pPriv->contrast;
+    key[4] = pPriv->saturation;
+    key[5] = pPriv->hue;
+
+    if (pPriv->csc_valid && !memcmp(key, pPriv->csc_key, sizeof(key)))
+	return csc;
+
+    cont = RTFContrast(pPriv->contrast);
+    bright = RTFBrightness(pPriv->brightness);
+    uvcosf = RTFSaturation(pPriv->saturation) * cos(RTFHue(pPriv->hue));
+    uvsinf = RTFSaturation(pPriv->saturation) * sin(RTFHue(pPriv->hue));
+    /* overlay video also does pre-gamma contrast/sat adjust, should we? */
+
+    yco = trans[ref].RefLuma * cont;
+    uco[0] = -trans[ref].RefRCr * uvsinf;
+    uco[1] = trans[ref].RefGCb * uvcosf - trans[ref].RefGCr * uvsinf;
+    uco[2] = trans[ref].RefBCb * uvcosf;
+    vco[0] = trans[ref].RefRCr * uvcosf;
+    vco[1] = trans[ref].RefGCb * uvsinf + trans[ref].RefGCr * uvcosf;
+    vco[2] = trans[ref].RefBCb * uvsinf;
+
+    csc[0] = Loff * yco + Coff * (uco[0] + vco[0]) + bright;
+    csc[1] = Loff * yco + Coff * (uco[1] + vco[1]) + bright;
+    csc[2] = Loff * yco + Coff * (uco[2] + vco[2]) + bright;
+    csc[3] = yco;
+
+    csc[4] = uco[0];
+    csc[5] = uco[1];
+    csc[6] = uco[2];
+    csc[7] = (float)pPriv->gamma / 1000.0;
+
+    csc[8] = vco[0];
+    csc[9] = vco[1];
+    csc[10] = vco[2];
+    csc[11] = 0.0;
+
+    memcpy(pPriv->csc_key, key, sizeof(key));
+    pPriv->csc_valid = TRUE;
+
+    return csc;
+}
+
 
 /* Allocates memory, either by resizing the allocation pointed to by mem_struct,
  * or by freeing mem_struct (if non-NULL) and allocating a new space.  The size
@@ -150,19 +255,169 @@ radeon_allocate_video_bo(ScrnInfoPtr pScrn,
     return TRUE;
 }
 
+static void
+RADEONFreeVideoPlanes(ScrnInfoPtr pScrn, RADEONPortPrivPtr pPriv)
+{
+    int i;
+
+    for (i = 0; i < 3; i++) {
+	if (pPriv->planes[i].bo) {
+	    radeon_residency_account(pScrn, RADEON_PIXMAP_CLASS_XV,
+				     RADEON_GEM_DOMAIN_VRAM,
+				     -(int64_t)pPriv->planes[i].bo->size);
+	    radeon_bo_unref(pPriv->planes[i].bo);
+	}
+	memset(&pPriv->planes[i], 0, sizeof(RADEONVideoPlaneRec));
+    }
+    pPriv->tiled_buffer = -1;
+}
+
 static void
 RADEONFreeVideoMemory(ScrnInfoPtr pScrn, RADEONPortPrivPtr pPriv)
 {
+    int i;
+
+    free(pPriv->band_hash);
+    free(pPriv->band_gen);
+    pPriv->band_hash = NULL;
+    pPriv->band_gen = NULL;
+    pPriv->num_bands = 0;
+    pPriv->band_nlines = 0;
+    pPriv->displayed = FALSE;
+
     if (pPriv->video_memory != NULL) {
+	if (pPriv->textured) {
+	    for (i = 0; i < RADEON_VIDEO_STAGING_BUFFERS; i++) {
+		if (!pPriv->src_bo[i])
+		    continue;
+		/* drop the mapping held since allocation */
+		radeon_bo_unmap(pPriv->src_bo[i]);
+		radeon_residency_account(pScrn, RADEON_PIXMAP_CLASS_XV,
+					 RADEON_GEM_DOMAIN_GTT,
+					 -(int64_t)pPriv->src_bo[i]->size);
+		if (i > 0)
+		    radeon_bo_unref(pPriv->src_bo[i]);
+		pPriv->src_bo[i] = NULL;
+	    }
+	}
+
 	radeon_bo_unref(pPriv->video_memory);
 	pPriv->video_memory = NULL;
+    }
 
-	if (pPriv->textured) {
-	    pPriv->src_bo[0] = NULL;
-	    radeon_bo_unref(pPriv->src_bo[1]);
-	    pPriv->src_bo[1] = NULL;
+    if (pPriv->dma_bo) {
+	radeon_bo_unref(pPriv->dma_bo);
+	pPriv->dma_bo = NULL;
+    }
+    pPriv->dma_buffer = -1;
+
+    RADEONFreeVideoPlanes(pScrn, pPriv);
+}
+
+/*
+ * Allocate the upload buffers of a textured port. Each stays mapped for
+ * its whole lifetime, so a frame upload doesn't mmap and fault in the
+ * buffer pages again.
+ */
+static Bool
+RADEONAllocateStagingBuffers(ScrnInfoPtr pScrn, RADEONPortPrivPtr pPriv,
+			     int size)
+{
+    int i;
+
+    if (!radeon_allocate_video_bo(pScrn, &pPriv->video_memory, size,
+				  pPriv->hw_align, RADEON_GEM_DOMAIN_GTT))
+	return FALSE;
+
+    if (radeon_bo_map(pPriv->video_memory, 1)) {
+	radeon_bo_unref(pPriv->video_memory);
+	pPriv->video_memory = NULL;
+	return FALSE;
+    }
+    pPriv->src_bo[0] = pPriv->video_memory;
+    radeon_residency_account(pScrn, RADEON_PIXMAP_CLASS_XV,
+			     RADEON_GEM_DOMAIN_GTT, pPriv->src_bo[0]->size);
+
+    /* The others are optional, uploads just stall more often without them */
+    for (i = 1; i < RADEON_VIDEO_STAGING_BUFFERS; i++) {
+	pPriv->src_bo[i] = NULL;
+	if (!radeon_allocate_video_bo(pScrn, &pPriv->src_bo[i], size,
+				      pPriv->hw_align, RADEON_GEM_DOMAIN_GTT))
+	    break;
+	if (radeon_bo_map(pPriv->src_bo[i], 1)) {
+	    radeon_bo_unref(pPriv->src_bo[i]);
+	    pPriv->src_bo[i] = NULL;
+	    break;
 	}
+	radeon_residency_account(pScrn, RADEON_PIXMAP_CLASS_XV,
+				 RADEON_GEM_DOMAIN_GTT, pPriv->src_bo[i]->size);
+    }
+
+    return TRUE;
+}
+
+/*
+ * Pick the upload buffer for the next frame, preferring one the GPU has
+ * finished reading so that we don't have to wait for it. Returns the index
+ * of a buffer that is idle and safe to overwrite.
+ */
+static int
+RADEONNextStagingBuffer(ScrnInfoPtr pScrn, RADEONPortPrivPtr pPriv)
+{
+    RADEONInfoPtr info = RADEONPTR(pScrn);
+    uint32_t domain;
+    int i, next = -1;
+
+    for (i = 1; i <= RADEON_VIDEO_STAGING_BUFFERS; i++) {
+	int idx = (pPriv->currentBuffer + i) % RADEON_VIDEO_STAGING_BUFFERS;
+	struct radeon_bo *bo = pPriv->src_bo[idx];
+
+	if (!bo)
+	    continue;
+	if (next < 0)
+	    next = idx;
+	if (!radeon_bo_is_referenced_by_cs(bo, info->cs) &&
+	    !radeon_bo_is_busy(bo, &domain))
+	    return idx;
+    }
+
+    /* All busy: submit any commands still reading the oldest one and wait
+     * for the GPU to finish with it. The buffers stay mapped, so
+     * radeon_bo_map won't do the idle wait for us.
+     */
+    if (radeon_bo_is_referenced_by_cs(pPriv->src_bo[next], info->cs))
+	radeon_cs_flush_indirect(pScrn);
+    if (radeon_bo_is_busy(pPriv->src_bo[next], &domain))
+	radeon_bo_wait(pPriv->src_bo[next]);
+
+    return next;
+}
+
+/* Drop a frame deferred to the block handler */
+static void
+RADEONCancelTexturedVideo(ScrnInfoPtr pScrn, RADEONPortPrivPtr pPriv)
+{
+    ScreenPtr pScreen = pScrn->pScreen;
+
+    pPriv->pending = FALSE;
+    pPriv->vline_leader = -1;
+    pPriv->vline_emitted = FALSE;
+    if (pPriv->pending_pixmap) {
+	(*pScreen->DestroyPixmap)(pPriv->pending_pixmap);
+	pPriv->pending_pixmap = NULL;
+    }
+}
+
+/* Defer drawing to the block handler, keeping the target pixmap alive */
+static void
+RADEONQueueTexturedVideo(ScrnInfoPtr pScrn, RADEONPortPrivPtr pPriv)
+{
+    if (pPriv->pending_pixmap != pPriv->pPixmap) {
+	RADEONCancelTexturedVideo(pScrn, pPriv);
+	pPriv->pending_pixmap = pPriv->pPixmap;
+	pPriv->pending_pixmap->refcnt++;
     }
+    pPriv->pending = TRUE;
 }
 
 static void
@@ -171,8 +426,21 @@ RADEONStopVideo(ScrnInfoPtr pScrn, pointer data, Bool cleanup)
   RADEONPortPrivPtr pPriv = (RADEONPortPrivPtr)data;
 
   if (pPriv->textured) {
+      RADEONCancelTexturedVideo(pScrn, pPriv);
+      RADEONCancelVideoVblank(pScrn, pPriv);
       if (cleanup) {
 	  RADEONFreeVideoMemory(pScrn, pPriv);
+	  if (pPriv->present_pixmap) {
+	      (*pScrn->pScreen->DestroyPixmap)(pPriv->present_pixmap);
+	      pPriv->present_pixmap = NULL;
+	  }
+	  /* free the rects, the port may be used again */
+	  REGION_UNINIT(pScrn->pScreen, &pPriv->present_clip);
+	  REGION_NULL(pScrn->pScreen, &pPriv->present_clip);
+	  if (pPriv->xvmc_bo) {
+	      radeon_bo_unref(pPriv->xvmc_bo);
+	      pPriv->xvmc_bo = NULL;
+	  }
       }
       return;
   }
@@ -180,35 +448,533 @@ RADEONStopVideo(ScrnInfoPtr pScrn, pointer data, Bool cleanup)
 
 #define OUT_ACCEL_REG_F(reg, val)	OUT_RING_REG(reg, F_TO_DW(val))
 
-#include "radeon_textured_videofuncs.c"
+#include "radeon_textured_videofuncs.c"
+
+#undef OUT_ACCEL_REG_F
+
+static void
+R600CopyData(
+    ScrnInfoPtr pScrn,
+    unsigned char *src,
+    unsigned char *dst,
+    unsigned int srcPitch,
+    unsigned int dstPitch,
+    unsigned int h,
+    unsigned int w,
+    unsigned int cpp
+){
+    if (cpp == 2) {
+	w *= 2;
+	cpp = 1;
+    }
+
+    if (srcPitch == dstPitch)
+        memcpy(dst, src, srcPitch * h);
+    else {
+	while (h--) {
+	    memcpy(dst, src, srcPitch);
+	    src += srcPitch;
+	    dst += dstPitch;
+	}
+    }
+}
+
+/* Copy source lines [top, top + nlines) into the mapped upload buffer */
+static void
+RADEONCopyImageLines(ScrnInfoPtr pScrn, RADEONPortPrivPtr pPriv, int id,
+		     unsigned char *buf, int width, int height,
+		     int srcPitch, int srcPitch2, int dstPitch, int dstPitch2,
+		     int top, int nlines)
+{
+    RADEONInfoPtr info = RADEONPTR(pScrn);
+    int s2offset, s3offset, tmp;
+    int d2line, d3line;
+
+    switch(id) {
+    case FOURCC_YV12:
+    case FOURCC_I420:
+	s2offset = srcPitch * (RADEON_ALIGN(height, 2));
+	s3offset = s2offset + (srcPitch2 * ((height + 1) >> 1));
+	s2offset += ((top >> 1) * srcPitch2);
+	s3offset += ((top >> 1) * srcPitch2);
+	if (pPriv->bicubic_state != BICUBIC_OFF && !IS_R600_3D) {
+	    if (id == FOURCC_I420) {
+		tmp = s2offset;
+		s2offset = s3offset;
+		s3offset = tmp;
+	    }
+	    RADEONCopyMungedData(pScrn, buf + (top * srcPitch),
+				 buf + s2offset, buf + s3offset, pPriv->src_addr + (top * dstPitch),
+				 srcPitch, srcPitch2, dstPitch, nlines, width);
+	} else {
+	    if (id == FOURCC_YV12) {
+		tmp = s2offset;
+		s2offset = s3offset;
+		s3offset = tmp;
+	    }
+	    d2line = pPriv->planeu_offset + ((top >> 1) * dstPitch2);
+	    d3line = pPriv->planev_offset + ((top >> 1) * dstPitch2);
+
+	    if (info->ChipFamily >= CHIP_FAMILY_R600) {
+		R600CopyData(pScrn, buf + (top * srcPitch), pPriv->src_addr + (top * dstPitch),
+			     srcPitch, dstPitch, nlines, width, 1);
+		R600CopyData(pScrn, buf + s2offset,  pPriv->src_addr + d2line,
+			     srcPitch2, dstPitch2, (nlines + 1) >> 1, width >> 1, 1);
+		R600CopyData(pScrn, buf + s3offset, pPriv->src_addr + d3line,
+			     srcPitch2, dstPitch2, (nlines + 1) >> 1, width >> 1, 1);
+	    } else {
+		RADEONCopyData(pScrn, buf + (top * srcPitch), pPriv->src_addr + (top * dstPitch),
+			       srcPitch, dstPitch, nlines, width, 1);
+		RADEONCopyData(pScrn, buf + s2offset,  pPriv->src_addr + d2line,
+			       srcPitch2, dstPitch2, (nlines + 1) >> 1, width >> 1, 1);
+		RADEONCopyData(pScrn, buf + s3offset, pPriv->src_addr + d3line,
+			       srcPitch2, dstPitch2, (nlines + 1) >> 1, width >> 1, 1);
+	    }
+	}
+	break;
+    case FOURCC_NV12:
+    case FOURCC_P010:
+	s2offset = srcPitch * RADEON_ALIGN(height, 2) + ((top >> 1) * srcPitch);
+	d2line = pPriv->planeu_offset + ((top >> 1) * dstPitch2);
+	R600CopyData(pScrn, buf + (top * srcPitch), pPriv->src_addr + (top * dstPitch),
+		     srcPitch, dstPitch, nlines, width, 1);
+	R600CopyData(pScrn, buf + s2offset, pPriv->src_addr + d2line,
+		     srcPitch, dstPitch2, (nlines + 1) >> 1, width, 1);
+	break;
+    case FOURCC_UYVY:
+    case FOURCC_YUY2:
+    default:
+	if (info->ChipFamily >= CHIP_FAMILY_R600)
+	    R600CopyData(pScrn, buf + (top * srcPitch),
+			 pPriv->src_addr + (top * dstPitch),
+			 srcPitch, dstPitch, nlines, width, 2);
+	else
+	    RADEONCopyData(pScrn, buf + (top * srcPitch),
+			   pPriv->src_addr + (top * dstPitch),
+			   srcPitch, dstPitch, nlines, width, 2);
+	break;
+    }
+}
+
+/*
+ * FNV-1a over 32 bit words, then over the remaining bytes. len is not
+ * always a multiple of 4, e.g. YUY2 with an odd width, nor is src always
+ * word aligned.
+ */
+static uint64_t
+RADEONHashBytes(uint64_t hash, const unsigned char *src, int len)
+{
+    uint32_t word;
+
+    for (; len >= 4; len -= 4, src += 4) {
+	memcpy(&word, src, 4);
+	hash = (hash ^ word) * 0x100000001b3ULL;
+    }
+
+    while (len--)
+	hash = (hash ^ *src++) * 0x100000001b3ULL;
+
+    return hash;
+}
+
+/* Hash the luma and chroma rows of source lines [top, top + nlines) */
+static uint64_t
+RADEONHashImageLines(int id, unsigned char *buf, int height,
+		     int srcPitch, int srcPitch2, int top, int nlines)
+{
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    int ctop = top >> 1, clines = (nlines + 1) >> 1;
+    int s2offset, s3offset;
+
+    hash = RADEONHashBytes(hash, buf + top * srcPitch, nlines * srcPitch);
+
+    switch(id) {
+    case FOURCC_YV12:
+    case FOURCC_I420:
+	s2offset = srcPitch * RADEON_ALIGN(height, 2);
+	s3offset = s2offset + srcPitch2 * ((height + 1) >> 1);
+	hash = RADEONHashBytes(hash, buf + s2offset + ctop * srcPitch2,
+			       clines * srcPitch2);
+	hash = RADEONHashBytes(hash, buf + s3offset + ctop * srcPitch2,
+			       clines * srcPitch2);
+	break;
+    case FOURCC_NV12:
+    case FOURCC_P010:
+	s2offset = srcPitch * RADEON_ALIGN(height, 2);
+	hash = RADEONHashBytes(hash, buf + s2offset + ctop * srcPitch,
+			       clines * srcPitch);
+	break;
+    default:
+	break;
+    }
+
+    return hash;
+}
+
+/* Forget what the upload buffers hold, the next frame is copied in full */
+static void
+RADEONInvalidateImageBands(RADEONPortPrivPtr pPriv)
+{
+    pPriv->band_nlines = 0;
+    pPriv->displayed = FALSE;
+}
+
+/*
+ * Hash the visible source lines in bands of RADEON_VIDEO_BAND_LINES and
+ * stamp the bands that differ from the previous frame with a new frame
+ * generation. Each upload buffer remembers the generation it was last
+ * filled at, so only bands changed since then need copying into it.
+ *
+ * Content that changes all over every frame, i.e. most video, would pay
+ * for an extra pass over the source for nothing. After
+ * RADEON_VIDEO_HASH_BACKOFF such frames in a row, all bands are stamped as
+ * changed without hashing, except every RADEON_VIDEO_HASH_PROBE frames.
+ *
+ * Returns the number of changed bands, or -1 on allocation failure.
+ */
+static int
+RADEONUpdateImageBands(RADEONPortPrivPtr pPriv, int id, unsigned char *buf,
+		       int width, int height, int srcPitch, int srcPitch2,
+		       int top, int nlines)
+{
+    int first = top / RADEON_VIDEO_BAND_LINES;
+    int last = (top + nlines - 1) / RADEON_VIDEO_BAND_LINES;
+    int i, changed = 0;
+
+    if (++pPriv->frame_gen == 0) {
+	pPriv->frame_gen = 1;
+	pPriv->band_nlines = 0;
+    }
+
+    if (pPriv->band_nlines != nlines || pPriv->band_top != top ||
+	pPriv->id != id || pPriv->w != width || pPriv->h != height) {
+	int num_bands = (height + RADEON_VIDEO_BAND_LINES - 1) / RADEON_VIDEO_BAND_LINES;
+
+	if (num_bands > pPriv->num_bands) {
+	    free(pPriv->band_hash);
+	    free(pPriv->band_gen);
+	    pPriv->band_hash = malloc(num_bands * sizeof(*pPriv->band_hash));
+	    pPriv->band_gen = malloc(num_bands * sizeof(*pPriv->band_gen));
+	    if (!pPriv->band_hash || !pPriv->band_gen) {
+		free(pPriv->band_hash);
+		free(pPriv->band_gen);
+		pPriv->band_hash = NULL;
+		pPriv->band_gen = NULL;
+		pPriv->num_bands = 0;
+		pPriv->band_nlines = 0;
+		return -1;
+	    }
+	    pPriv->num_bands = num_bands;
+	}
+
+	memset(pPriv->band_gen, 0, pPriv->num_bands * sizeof(*pPriv->band_gen));
+	memset(pPriv->buffer_gen, 0, sizeof(pPriv->buffer_gen));
+	pPriv->band_top = top;
+	pPriv->band_nlines = nlines;
+    }
+
+    if (pPriv->busy_frames >= RADEON_VIDEO_HASH_BACKOFF &&
+	pPriv->frame_gen % RADEON_VIDEO_HASH_PROBE != 0) {
+	for (i = first; i <= last; i++)
+	    pPriv->band_gen[i] = pPriv->frame_gen;
+	return last - first + 1;
+    }
+
+    for (i = first; i <= last; i++) {
+	int y1 = MAX(top, i * RADEON_VIDEO_BAND_LINES);
+	int y2 = MIN(top + nlines, (i + 1) * RADEON_VIDEO_BAND_LINES);
+	uint64_t hash = RADEONHashImageLines(id, buf, height, srcPitch,
+					     srcPitch2, y1, y2 - y1);
+
+	if (pPriv->band_gen[i] == 0 || pPriv->band_hash[i] != hash) {
+	    pPriv->band_hash[i] = hash;
+	    pPriv->band_gen[i] = pPriv->frame_gen;
+	    changed++;
+	}
+    }
+
+    if (changed >= (last - first + 1) - (last - first + 1) / 8)
+	pPriv->busy_frames++;
+    else
+	pPriv->busy_frames = 0;
+
+    return changed;
+}
+
+/* Whether upload buffer idx lacks any band changed since it was filled */
+static Bool
+RADEONImageBufferStale(RADEONPortPrivPtr pPriv, int idx, int top, int nlines)
+{
+    int first = top / RADEON_VIDEO_BAND_LINES;
+    int last = (top + nlines - 1) / RADEON_VIDEO_BAND_LINES;
+    int i;
+
+    if (!pPriv->band_gen || pPriv->buffer_gen[idx] == 0)
+	return TRUE;
+
+    for (i = first; i <= last; i++) {
+	if (pPriv->band_gen[i] > pPriv->buffer_gen[idx])
+	    return TRUE;
+    }
+
+    return FALSE;
+}
+
+/*
+ * Bring upload buffer idx up to date, copying runs of bands it is
+ * missing. Falls back to a full copy when band tracking is unavailable.
+ */
+static void
+RADEONUploadImageBands(ScrnInfoPtr pScrn, RADEONPortPrivPtr pPriv, int idx,
+		       int id, unsigned char *buf, int width, int height,
+		       int srcPitch, int srcPitch2, int dstPitch, int dstPitch2,
+		       int top, int nlines)
+{
+    int first = top / RADEON_VIDEO_BAND_LINES;
+    int last = (top + nlines - 1) / RADEON_VIDEO_BAND_LINES;
+    int i, run = -1;
+
+    if (!pPriv->band_gen || pPriv->buffer_gen[idx] == 0) {
+	RADEONCopyImageLines(pScrn, pPriv, id, buf, width, height, srcPitch,
+			     srcPitch2, dstPitch, dstPitch2, top, nlines);
+	goto done;
+    }
+
+    for (i = first; i <= last + 1; i++) {
+	Bool stale = i <= last && pPriv->band_gen[i] > pPriv->buffer_gen[idx];
+
+	if (stale && run < 0)
+	    run = i;
+	else if (!stale && run >= 0) {
+	    int y1 = MAX(top, run * RADEON_VIDEO_BAND_LINES);
+	    int y2 = MIN(top + nlines, i * RADEON_VIDEO_BAND_LINES);
+
+	    RADEONCopyImageLines(pScrn, pPriv, id, buf, width, height,
+				 srcPitch, srcPitch2, dstPitch, dstPitch2,
+				 y1, y2 - y1);
+	    run = -1;
+	}
+    }
+
+done:
+    pPriv->buffer_gen[idx] = pPriv->band_gen ? pPriv->frame_gen : 0;
+}
+
+/*
+ * Show a frame an XvMC client decoded into one of our surfaces.  The
+ * surface is laid out like an upload buffer, so it is textured from
+ * directly and nothing is copied.
+ */
+static int
+RADEONPutXvMCSurface(ScrnInfoPtr pScrn, RADEONPortPrivPtr pPriv,
+		     unsigned char *buf,
+		     short src_x, short src_y,
+		     short drw_x, short drw_y,
+		     short src_w, short src_h,
+		     short drw_w, short drw_h,
+		     short width, short height,
+		     RegionPtr clipBoxes, DrawablePtr pDraw)
+{
+    ScreenPtr pScreen = pScrn->pScreen;
+    RADEONInfoPtr info = RADEONPTR(pScrn);
+    RADEONXvMCCommandPtr cmd = (RADEONXvMCCommandPtr)buf;
+    RADEONXvMCSurfacePtr surface;
+
+    surface = RADEONLookupXvMCSurface(pScrn, pPriv, pDraw, cmd->surface_id);
+    if (!surface || width > surface->width || height > surface->height)
+	return BadValue;
+
+    if (pPriv->bicubic_enabled && info->bicubic_bo == NULL)
+	pPriv->bicubic_enabled = FALSE;
+
+    if (pDraw->type == DRAWABLE_WINDOW)
+	pPriv->pPixmap = (*pScreen->GetWindowPixmap)((WindowPtr)pDraw);
+    else
+	pPriv->pPixmap = (PixmapPtr)pDraw;
+
+    info->exa_force_create = TRUE;
+    exaMoveInPixmap(pPriv->pPixmap);
+    info->exa_force_create = FALSE;
+
+    radeon_bo_ref(surface->bo);
+    if (pPriv->xvmc_bo)
+	radeon_bo_unref(pPriv->xvmc_bo);
+    pPriv->xvmc_bo = surface->bo;
+
+    pPriv->src_pitch = surface->pitch;
+    pPriv->src_pitch2 = RADEON_ALIGN(surface->pitch >> 1, pPriv->hw_align);
+    pPriv->planeu_offset = surface->planeu_offset;
+    pPriv->planev_offset = surface->planev_offset;
+
+    if (!REGION_EQUAL(pScreen, &pPriv->clip, clipBoxes))
+	REGION_COPY(pScreen, &pPriv->clip, clipBoxes);
+
+    pPriv->pDraw = pDraw;
+    pPriv->draw_serial = pDraw->serialNumber;
+    pPriv->id = FOURCC_YV12;
+    pPriv->src_w = src_w;
+    pPriv->src_h = src_h;
+    pPriv->src_x = src_x;
+    pPriv->src_y = src_y;
+    pPriv->drw_x = drw_x;
+    pPriv->drw_y = drw_y;
+    pPriv->dst_w = drw_w;
+    pPriv->dst_h = drw_h;
+    pPriv->w = width;
+    pPriv->h = height;
+
+    /* the upload buffers are not what is on screen now */
+    pPriv->displayed = FALSE;
+
+    if (info->xv_batch)
+	RADEONQueueTexturedVideo(pScrn, pPriv);
+    else
+	RADEONDisplayTexturedVideoPort(pScrn, pPriv);
+
+    return Success;
+}
+
+static Bool
+RADEONAllocVideoPlanes(ScrnInfoPtr pScrn, RADEONPortPrivPtr pPriv)
+{
+    int i;
+
+    if (pPriv->planes[0].bo &&
+	pPriv->planes[0].w == pPriv->w && pPriv->planes[0].h == pPriv->h)
+	return TRUE;
+
+    RADEONFreeVideoPlanes(pScrn, pPriv);
+
+    for (i = 0; i < 3; i++) {
+	RADEONVideoPlanePtr plane = &pPriv->planes[i];
+
+	plane->w = i ? (pPriv->w + 1) >> 1 : pPriv->w;
+	plane->h = i ? (pPriv->h + 1) >> 1 : pPriv->h;
+	plane->bo = radeon_alloc_pixmap_bo(pScrn, plane->w, plane->h, 8,
+					   RADEON_CREATE_PIXMAP_TILING_MICRO,
+					   8, &plane->pitch, &plane->surface,
+					   &plane->tiling);
+	if (!plane->bo) {
+	    RADEONFreeVideoPlanes(pScrn, pPriv);
+	    return FALSE;
+	}
+	radeon_residency_account(pScrn, RADEON_PIXMAP_CLASS_XV,
+				 RADEON_GEM_DOMAIN_VRAM, plane->bo->size);
+    }
+
+    return TRUE;
+}
+
+/*
+ * TexturedVideoTiling: when the texture gets fetched a lot, because the
+ * video is scaled up, filtered bicubic or drawn in many clip boxes, blit
+ * the planes once from the upload buffer into tiled VRAM and sample them
+ * from there.  The planar layout is then uploaded with the luma pitch for
+ * the chroma planes too, so the upload buffer reads as a single image.
+ * Returns whether the tiled planes hold the frame.
+ */
+static Bool
+RADEONTileVideoPlanes(ScrnInfoPtr pScrn, RADEONPortPrivPtr pPriv,
+		      RegionPtr clipBoxes, Bool upload)
+{
+    RADEONInfoPtr info = RADEONPTR(pScrn);
+    struct r600_accel_object src_obj, dst_obj;
+    int idx = pPriv->currentBuffer;
+    int row[3];
+    int i;
+
+    if (pPriv->src_pitch2 != pPriv->src_pitch ||
+	!(pPriv->bicubic_enabled ||
+	  pPriv->dst_w * pPriv->dst_h >= 2 * pPriv->src_w * pPriv->src_h ||
+	  REGION_NUM_RECTS(clipBoxes) > RADEON_VIDEO_TILED_MIN_BOXES)) {
+	pPriv->tiled_buffer = -1;
+	return FALSE;
+    }
+
+    if (!upload && pPriv->tiled_buffer == idx)
+	return TRUE;
+
+    pPriv->tiled_buffer = -1;
+    if (!RADEONAllocVideoPlanes(pScrn, pPriv))
+	return FALSE;
+
+    row[0] = 0;
+    row[1] = pPriv->planeu_offset / pPriv->src_pitch;
+    row[2] = pPriv->planev_offset / pPriv->src_pitch;
+
+    src_obj.pitch = pPriv->src_pitch;
+    src_obj.width = pPriv->src_pitch;
+    src_obj.height = row[2] + pPriv->planes[2].h;
+    src_obj.bpp = 8;
+    src_obj.domain = RADEON_GEM_DOMAIN_GTT;
+    src_obj.bo = pPriv->src_bo[idx];
+    src_obj.offset = 0;
+    src_obj.tiling_flags = 0;
+    src_obj.surface = NULL;
+
+    for (i = 0; i < 3; i++) {
+	RADEONVideoPlanePtr plane = &pPriv->planes[i];
+	Bool ret;
+
+	dst_obj.pitch = plane->pitch;
+	dst_obj.width = plane->w;
+	dst_obj.height = plane->h;
+	dst_obj.bpp = 8;
+	dst_obj.domain = RADEON_GEM_DOMAIN_VRAM;
+	dst_obj.bo = plane->bo;
+	dst_obj.offset = 0;
+	dst_obj.tiling_flags = plane->tiling;
+	dst_obj.surface = &plane->surface;
+
+	if (IS_EVERGREEN_3D)
+	    ret = EVERGREENCopyRect(pScrn, &src_obj, &dst_obj, 0, row[i], 0, 0,
+				    plane->w, plane->h);
+	else
+	    ret = R600CopyRect(pScrn, &src_obj, &dst_obj, 0, row[i], 0, 0,
+			       plane->w, plane->h);
+	if (!ret)
+	    return FALSE;
+    }
+
+    pPriv->tiled_buffer = idx;
+    return TRUE;
+}
+
+/*
+ * On Evergreen and later big frames are copied from the upload buffer to
+ * VRAM by the async DMA engine, so the 3D engine samples VRAM instead of
+ * reading the frame over the bus.
+ */
+static void
+RADEONUploadVideoDMA(ScrnInfoPtr pScrn, RADEONPortPrivPtr pPriv, Bool upload)
+{
+    RADEONInfoPtr info = RADEONPTR(pScrn);
+    int idx = pPriv->currentBuffer;
+
+    /* the copy goes to an offscreen BO, vsync only matters for the draw */
+    if (!IS_EVERGREEN_3D ||
+	!evergreen_dma_wanted(pScrn, pPriv->size, 1, FALSE)) {
+	pPriv->dma_buffer = -1;
+	return;
+    }
 
-#undef OUT_ACCEL_REG_F
+    if (!upload && pPriv->dma_buffer == idx)
+	return;
 
-static void
-R600CopyData(
-    ScrnInfoPtr pScrn,
-    unsigned char *src,
-    unsigned char *dst,
-    unsigned int srcPitch,
-    unsigned int dstPitch,
-    unsigned int h,
-    unsigned int w,
-    unsigned int cpp
-){
-    if (cpp == 2) {
-	w *= 2;
-	cpp = 1;
+    if (!pPriv->dma_bo &&
+	!radeon_allocate_video_bo(pScrn, &pPriv->dma_bo, pPriv->size,
+				  pPriv->hw_align, RADEON_GEM_DOMAIN_VRAM)) {
+	pPriv->dma_buffer = -1;
+	return;
     }
 
-    if (srcPitch == dstPitch)
-        memcpy(dst, src, srcPitch * h);
-    else {
-	while (h--) {
-	    memcpy(dst, src, srcPitch);
-	    src += srcPitch;
-	    dst += dstPitch;
-	}
-    }
+    if (evergreen_dma_copy(pScrn,
+			   pPriv->dma_bo, RADEON_GEM_DOMAIN_VRAM, 0, pPriv->size,
+			   pPriv->src_bo[idx], RADEON_GEM_DOMAIN_GTT, 0, pPriv->size,
+			   pPriv->size, 1))
+	pPriv->dma_buffer = idx;
+    else
+	pPriv->dma_buffer = -1;
 }
 
 static int
@@ -231,9 +997,10 @@ RADEONPutImageTextured(ScrnInfoPtr pScrn,
     RADEONPortPrivPtr pPriv = (RADEONPortPrivPtr)data;
     INT32 x1, x2, y1, y2;
     int srcPitch, srcPitch2, dstPitch, dstPitch2 = 0;
-    int s2offset, s3offset, tmp;
-    int d2line, d3line;
-    int top, nlines, size;
+    int tmp;
+    int top, nlines, size, changed;
+    Bool upload;
+    PixmapPtr pPixmap;
     BoxRec dstBox;
     int dst_width = width, dst_height = height;
     int aligned_height;
@@ -242,7 +1009,7 @@ RADEONPutImageTextured(ScrnInfoPtr pScrn,
     int ret;
 
     /* make the compiler happy */
-    s2offset = s3offset = srcPitch2 = 0;
+    srcPitch2 = 0;
 
     /* Clip */
     x1 = src_x;
@@ -263,10 +1030,13 @@ RADEONPutImageTextured(ScrnInfoPtr pScrn,
 
     /* Bicubic filter setup */
     pPriv->bicubic_enabled = (pPriv->bicubic_state != BICUBIC_OFF);
-    if (!(IS_R300_3D || IS_R500_3D)) {
+    if (!(IS_R300_3D || IS_R500_3D || IS_R600_3D)) {
 	pPriv->bicubic_enabled = FALSE;
 	pPriv->bicubic_state = BICUBIC_OFF;
     }
+    /* R600 and later filter the planes directly, packed formats stay bilinear */
+    if (IS_R600_3D && (id == FOURCC_UYVY || id == FOURCC_YUY2))
+	pPriv->bicubic_enabled = FALSE;
     if (pPriv->bicubic_enabled && (pPriv->bicubic_state == BICUBIC_AUTO)) {
 	/*
 	 * Applying the bicubic filter with a scale of less than 200%
@@ -281,6 +1051,17 @@ RADEONPutImageTextured(ScrnInfoPtr pScrn,
     else
 	pPriv->hw_align = 64;
 
+    if (id == FOURCC_XVMC)
+	return RADEONPutXvMCSurface(pScrn, pPriv, buf, src_x, src_y,
+				    drw_x, drw_y, src_w, src_h, drw_w, drw_h,
+				    width, height, clipBoxes, pDraw);
+
+    /* a regular image replaces the XvMC surface */
+    if (pPriv->xvmc_bo) {
+	radeon_bo_unref(pPriv->xvmc_bo);
+	pPriv->xvmc_bo = NULL;
+    }
+
     aligned_height = RADEON_ALIGN(dst_height, h_align);
 
     switch(id) {
@@ -288,14 +1069,29 @@ RADEONPutImageTextured(ScrnInfoPtr pScrn,
     case FOURCC_I420:
 	srcPitch = RADEON_ALIGN(width, 4);
 	srcPitch2 = RADEON_ALIGN(width >> 1, 4);
-        if (pPriv->bicubic_state != BICUBIC_OFF) {
+        if (pPriv->bicubic_state != BICUBIC_OFF && !IS_R600_3D) {
 	    dstPitch = RADEON_ALIGN(dst_width << 1, pPriv->hw_align);
 	    dstPitch2 = 0;
 	} else {
 	    dstPitch = RADEON_ALIGN(dst_width, pPriv->hw_align);
 	    dstPitch2 = RADEON_ALIGN(dstPitch >> 1, pPriv->hw_align);
+	    /* the planes are blitted out of the buffer as one image */
+	    if (IS_R600_3D && info->xv_tiling && info->surf_man)
+		dstPitch2 = dstPitch;
 	}
 	break;
+    case FOURCC_NV12:
+    case FOURCC_P010:
+	/* luma and chroma rows share a pitch valid for both texture formats */
+	tmp = (id == FOURCC_P010) ? 2 : 1;
+	/* matches the pitches RADEONQueryImageAttributes hands out */
+	srcPitch = (id == FOURCC_P010) ?
+	    RADEON_ALIGN(width, 2) << 1 : RADEON_ALIGN(width, 4);
+	dstPitch = RADEON_ALIGN(dst_width * tmp,
+				MAX(drmmode_get_pitch_align(pScrn, tmp, 0) * tmp,
+				    drmmode_get_pitch_align(pScrn, 2 * tmp, 0) * 2 * tmp));
+	dstPitch2 = dstPitch;
+	break;
     case FOURCC_UYVY:
     case FOURCC_YUY2:
     default:
@@ -305,7 +1101,10 @@ RADEONPutImageTextured(ScrnInfoPtr pScrn,
 	break;
     }
 
-    size = dstPitch * aligned_height + 2 * dstPitch2 * RADEON_ALIGN(((aligned_height + 1) >> 1), h_align);
+    if (id == FOURCC_NV12 || id == FOURCC_P010)
+	size = dstPitch * aligned_height + dstPitch2 * RADEON_ALIGN(((aligned_height + 1) >> 1), h_align);
+    else
+	size = dstPitch * aligned_height + 2 * dstPitch2 * RADEON_ALIGN(((aligned_height + 1) >> 1), h_align);
     size = RADEON_ALIGN(size, pPriv->hw_align);
 
     if (size != pPriv->size) {
@@ -313,18 +1112,8 @@ RADEONPutImageTextured(ScrnInfoPtr pScrn,
     }
 
     if (pPriv->video_memory == NULL) {
-      Bool ret;
-      ret = radeon_allocate_video_bo(pScrn,
-				     &pPriv->video_memory,
-				     size, pPriv->hw_align,
-				     RADEON_GEM_DOMAIN_GTT);
-      if (ret == FALSE)
+      if (!RADEONAllocateStagingBuffers(pScrn, pPriv, size))
 	  return BadAlloc;
-
-      pPriv->src_bo[0] = pPriv->video_memory;
-      radeon_allocate_video_bo(pScrn, (void*)&pPriv->src_bo[1], size,
-			       pPriv->hw_align,
-			       RADEON_GEM_DOMAIN_GTT);
     }
 
     /* Bicubic filter loading */
@@ -334,29 +1123,51 @@ RADEONPutImageTextured(ScrnInfoPtr pScrn,
     }
 
     if (pDraw->type == DRAWABLE_WINDOW)
-	pPriv->pPixmap = (*pScreen->GetWindowPixmap)((WindowPtr)pDraw);
+	pPixmap = (*pScreen->GetWindowPixmap)((WindowPtr)pDraw);
     else
-	pPriv->pPixmap = (PixmapPtr)pDraw;
+	pPixmap = (PixmapPtr)pDraw;
+
+    /* find the bands of the visible lines that changed since last frame */
+    top = (y1 >> 16) & ~1;
+    nlines = ((y2 + 0xffff) >> 16) - top;
+    changed = RADEONUpdateImageBands(pPriv, id, buf, width, height,
+				     srcPitch, srcPitch2, top, nlines);
+
+    /*
+     * Static content: nothing to upload and the last frame was drawn with
+     * the same geometry to the same place, so it is still on screen.
+     */
+    if (changed == 0 && pPriv->displayed &&
+	pPriv->pDraw == pDraw && pPriv->draw_serial == pDraw->serialNumber &&
+	pPriv->pPixmap == pPixmap &&
+	pPriv->src_x == src_x && pPriv->src_y == src_y &&
+	pPriv->src_w == src_w && pPriv->src_h == src_h &&
+	pPriv->drw_x == drw_x && pPriv->drw_y == drw_y &&
+	pPriv->dst_w == drw_w && pPriv->dst_h == drw_h &&
+	REGION_EQUAL(pScrn->pScreen, &pPriv->clip, clipBoxes))
+	return Success;
+
+    pPriv->pPixmap = pPixmap;
 
     /* Force the pixmap into framebuffer so we can draw to it. */
     info->exa_force_create = TRUE;
     exaMoveInPixmap(pPriv->pPixmap);
     info->exa_force_create = FALSE;
 
-    /* copy data */
-    top = (y1 >> 16) & ~1;
-    nlines = ((y2 + 0xffff) >> 16) - top;
+    /* the current buffer can be drawn again if it holds every band */
+    upload = RADEONImageBufferStale(pPriv, pPriv->currentBuffer, top, nlines);
+    if (upload) {
+	pPriv->currentBuffer = RADEONNextStagingBuffer(pScrn, pPriv);
+	src_bo = pPriv->src_bo[pPriv->currentBuffer];
 
-    pPriv->currentBuffer ^= 1;
-	
-    src_bo = pPriv->src_bo[pPriv->currentBuffer];
+	ret = radeon_bo_map(src_bo, 1);
+	if (ret)
+	    return BadAlloc;
 
-    ret = radeon_bo_map(src_bo, 1);
-    if (ret)
-	return BadAlloc;
-  
-    pPriv->src_addr = src_bo->ptr;
+	pPriv->src_addr = src_bo->ptr;
+    }
     pPriv->src_pitch = dstPitch;
+    pPriv->src_pitch2 = dstPitch2;
 
     pPriv->planeu_offset = dstPitch * aligned_height;
     pPriv->planeu_offset = RADEON_ALIGN(pPriv->planeu_offset, pPriv->hw_align);
@@ -365,62 +1176,12 @@ RADEONPutImageTextured(ScrnInfoPtr pScrn,
 
     pPriv->size = size;
     pPriv->pDraw = pDraw;
+    pPriv->draw_serial = pDraw->serialNumber;
 
-    switch(id) {
-    case FOURCC_YV12:
-    case FOURCC_I420:
-	s2offset = srcPitch * (RADEON_ALIGN(height, 2));
-	s3offset = s2offset + (srcPitch2 * ((height + 1) >> 1));
-	s2offset += ((top >> 1) * srcPitch2);
-	s3offset += ((top >> 1) * srcPitch2);
-	if (pPriv->bicubic_state != BICUBIC_OFF) {
-	    if (id == FOURCC_I420) {
-		tmp = s2offset;
-		s2offset = s3offset;
-		s3offset = tmp;
-	    }
-	    RADEONCopyMungedData(pScrn, buf + (top * srcPitch),
-				 buf + s2offset, buf + s3offset, pPriv->src_addr + (top * dstPitch),
-				 srcPitch, srcPitch2, dstPitch, nlines, width);
-	} else {
-	    if (id == FOURCC_YV12) {
-		tmp = s2offset;
-		s2offset = s3offset;
-		s3offset = tmp;
-	    }
-	    d2line = pPriv->planeu_offset + ((top >> 1) * dstPitch2);
-	    d3line = pPriv->planev_offset + ((top >> 1) * dstPitch2);
-
-	    if (info->ChipFamily >= CHIP_FAMILY_R600) {
-		R600CopyData(pScrn, buf + (top * srcPitch), pPriv->src_addr + (top * dstPitch),
-			     srcPitch, dstPitch, nlines, width, 1);
-		R600CopyData(pScrn, buf + s2offset,  pPriv->src_addr + d2line,
-			     srcPitch2, dstPitch2, (nlines + 1) >> 1, width >> 1, 1);
-		R600CopyData(pScrn, buf + s3offset, pPriv->src_addr + d3line,
-			     srcPitch2, dstPitch2, (nlines + 1) >> 1, width >> 1, 1);
-	    } else {
-		RADEONCopyData(pScrn, buf + (top * srcPitch), pPriv->src_addr + (top * dstPitch),
-			       srcPitch, dstPitch, nlines, width, 1);
-		RADEONCopyData(pScrn, buf + s2offset,  pPriv->src_addr + d2line,
-			       srcPitch2, dstPitch2, (nlines + 1) >> 1, width >> 1, 1);
-		RADEONCopyData(pScrn, buf + s3offset, pPriv->src_addr + d3line,
-			       srcPitch2, dstPitch2, (nlines + 1) >> 1, width >> 1, 1);
-	    }
-	}
-	break;
-    case FOURCC_UYVY:
-    case FOURCC_YUY2:
-    default:
-	if (info->ChipFamily >= CHIP_FAMILY_R600)
-	    R600CopyData(pScrn, buf + (top * srcPitch),
-			 pPriv->src_addr + (top * dstPitch),
-			 srcPitch, dstPitch, nlines, width, 2);
-	else
-	    RADEONCopyData(pScrn, buf + (top * srcPitch),
-			   pPriv->src_addr + (top * dstPitch),
-			   srcPitch, dstPitch, nlines, width, 2);
-	break;
-    }
+    if (upload)
+	RADEONUploadImageBands(pScrn, pPriv, pPriv->currentBuffer, id, buf,
+			       width, height, srcPitch, srcPitch2,
+			       dstPitch, dstPitch2, top, nlines);
 
     /* update cliplist */
     if (!REGION_EQUAL(pScrn->pScreen, &pPriv->clip, clipBoxes)) {
@@ -439,25 +1200,399 @@ RADEONPutImageTextured(ScrnInfoPtr pScrn,
     pPriv->w = width;
     pPriv->h = height;
 
-    radeon_bo_unmap(pPriv->src_bo[pPriv->currentBuffer]);
+    if (upload)
+	radeon_bo_unmap(pPriv->src_bo[pPriv->currentBuffer]);
+    if (!IS_R600_3D || (id != FOURCC_YV12 && id != FOURCC_I420) ||
+	!RADEONTileVideoPlanes(pScrn, pPriv, clipBoxes, upload))
+	RADEONUploadVideoDMA(pScrn, pPriv, upload);
+    pPriv->displayed = TRUE;
     if (info->directRenderingEnabled) {
-	if (IS_EVERGREEN_3D)
-	    EVERGREENDisplayTexturedVideo(pScrn, pPriv);
-	else if (IS_R600_3D)
-	    R600DisplayTexturedVideo(pScrn, pPriv);
-	else if (IS_R500_3D)
-	    R500DisplayTexturedVideo(pScrn, pPriv);
-	else if (IS_R300_3D)
-	    R300DisplayTexturedVideo(pScrn, pPriv);
-	else if (IS_R200_3D)
-	    R200DisplayTexturedVideo(pScrn, pPriv);
+	if (info->xv_batch)
+	    RADEONQueueTexturedVideo(pScrn, pPriv);
 	else
-	    RADEONDisplayTexturedVideo(pScrn, pPriv);
+	    RADEONDisplayTexturedVideoPort(pScrn, pPriv);
     }
 
     return Success;
 }
 
+static void
+RADEONDrawTexturedVideo(ScrnInfoPtr pScrn, RADEONPortPrivPtr pPriv)
+{
+    RADEONInfoPtr info = RADEONPTR(pScrn);
+
+    if (IS_EVERGREEN_3D)
+	EVERGREENDisplayTexturedVideo(pScrn, pPriv);
+    else if (IS_R600_3D)
+	R600DisplayTexturedVideo(pScrn, pPriv);
+    else if (IS_R500_3D)
+	R500DisplayTexturedVideo(pScrn, pPriv);
+    else if (IS_R300_3D)
+	R300DisplayTexturedVideo(pScrn, pPriv);
+    else if (IS_R200_3D)
+	R200DisplayTexturedVideo(pScrn, pPriv);
+    else
+	RADEONDisplayTexturedVideo(pScrn, pPriv);
+}
+
+static xf86CrtcPtr
+RADEONTexturedVideoCrtc(ScrnInfoPtr pScrn, RADEONPortPrivPtr pPriv)
+{
+    if (pPriv->desired_crtc)
+	return pPriv->desired_crtc;
+
+    return radeon_pick_best_crtc(pScrn, FALSE,
+				 pPriv->drw_x,
+				 pPriv->drw_x + pPriv->dst_w,
+				 pPriv->drw_y,
+				 pPriv->drw_y + pPriv->dst_h);
+}
+
+typedef struct radeon_video_vblank_event {
+    drmmode_vblank_event_rec base;
+    ScrnInfoPtr pScrn;
+    RADEONPortPrivPtr pPriv;	/* NULL once the port let go of it */
+} RADEONVideoVblankEventRec, *RADEONVideoVblankEventPtr;
+
+/* Copy the frame rendered ahead into the drawable it was meant for */
+static void
+RADEONPresentTexturedVideo(ScrnInfoPtr pScrn, RADEONPortPrivPtr pPriv)
+{
+    ScreenPtr pScreen = pScrn->pScreen;
+    RADEONInfoPtr info = RADEONPTR(pScrn);
+    PixmapPtr pPix = pPriv->present_pixmap;
+    DrawablePtr pDraw;
+    RegionPtr clip;
+    GCPtr gc;
+    Bool vsync;
+
+    if (!pPix ||
+	dixLookupDrawable(&pDraw, pPriv->present_drawable, serverClient,
+			  M_WINDOW, DixWriteAccess) != Success)
+	return;
+
+    /* The window moved or its clip changed since the frame was rendered,
+     * present_clip and present_x/y are stale. Drop the frame, the next
+     * PutImage renders for the new location.
+     */
+    if (pDraw->serialNumber != pPriv->present_serial)
+	return;
+
+    gc = GetScratchGC(pDraw->depth, pScreen);
+    if (!gc)
+	return;
+
+    clip = REGION_CREATE(pScreen, NULL, 0);
+    REGION_COPY(pScreen, clip, &pPriv->present_clip);
+    REGION_TRANSLATE(pScreen, clip, -pDraw->x, -pDraw->y);
+    (*gc->funcs->ChangeClip)(gc, CT_REGION, clip, 0);
+    ValidateGC(pDraw, gc);
+
+    /* we are at the vblank already, never make the CP wait for it */
+    vsync = info->accel_state->vsync;
+    info->accel_state->vsync = FALSE;
+
+    (*gc->ops->CopyArea)(&pPix->drawable, pDraw, gc, 0, 0,
+			 pPix->drawable.width, pPix->drawable.height,
+			 pPriv->present_x - pDraw->x,
+			 pPriv->present_y - pDraw->y);
+
+    info->accel_state->vsync = vsync;
+    FreeScratchGC(gc);
+
+    radeon_cs_flush_indirect(pScrn);
+}
+
+static void
+RADEONVideoVblankHandler(unsigned int frame, unsigned int tv_sec,
+			 unsigned int tv_usec, void *event_data)
+{
+    RADEONVideoVblankEventPtr event = event_data;
+    RADEONPortPrivPtr pPriv = event->pPriv;
+
+    if (pPriv) {
+	pPriv->present_event = NULL;
+	RADEONPresentTexturedVideo(event->pScrn, pPriv);
+    }
+
+    free(event);
+}
+
+/* The port no longer wants its pending frame, the event just gets freed */
+static void
+RADEONCancelVideoVblank(ScrnInfoPtr pScrn, RADEONPortPrivPtr pPriv)
+{
+    if (pPriv->present_event) {
+	pPriv->present_event->pPriv = NULL;
+	pPriv->present_event = NULL;
+    }
+}
+
+static Bool
+RADEONQueueVideoVblank(ScrnInfoPtr pScrn, RADEONPortPrivPtr pPriv,
+		       xf86CrtcPtr crtc)
+{
+    RADEONInfoPtr info = RADEONPTR(pScrn);
+    RADEONVideoVblankEventPtr event;
+    drmVBlank vbl;
+
+    event = calloc(1, sizeof(RADEONVideoVblankEventRec));
+    if (!event)
+	return FALSE;
+
+    event->base.handler = RADEONVideoVblankHandler;
+    event->pScrn = pScrn;
+    event->pPriv = pPriv;
+
+    vbl.request.type = DRM_VBLANK_RELATIVE | DRM_VBLANK_EVENT;
+    vbl.request.type |= radeon_populate_vbl_request_type(crtc);
+    vbl.request.sequence = 1;
+    vbl.request.signal = (unsigned long)event;
+
+    if (drmWaitVBlank(info->dri2.drm_fd, &vbl)) {
+	free(event);
+	return FALSE;
+    }
+
+    pPriv->present_event = event;
+    return TRUE;
+}
+
+static Bool
+RADEONAllocPresentPixmap(ScrnInfoPtr pScrn, RADEONPortPrivPtr pPriv,
+			 int w, int h, int depth)
+{
+    ScreenPtr pScreen = pScrn->pScreen;
+    RADEONInfoPtr info = RADEONPTR(pScrn);
+    PixmapPtr pPix = pPriv->present_pixmap;
+
+    if (pPix && pPix->drawable.width == w && pPix->drawable.height == h &&
+	pPix->drawable.depth == depth)
+	return TRUE;
+
+    if (pPix)
+	(*pScreen->DestroyPixmap)(pPix);
+
+    pPix = (*pScreen->CreatePixmap)(pScreen, w, h, depth, 0);
+    pPriv->present_pixmap = pPix;
+    if (!pPix)
+	return FALSE;
+
+    info->exa_force_create = TRUE;
+    exaMoveInPixmap(pPix);
+    info->exa_force_create = FALSE;
+
+    if (!radeon_get_pixmap_bo(pPix)) {
+	(*pScreen->DestroyPixmap)(pPix);
+	pPriv->present_pixmap = NULL;
+	return FALSE;
+    }
+
+    return TRUE;
+}
+
+/*
+ * XV_VSYNC 2: render the frame right away into a pixmap covering the clip
+ * extents, then copy it into place when the next vblank event arrives.
+ * Nothing in the command stream waits for the scanline.  A frame that
+ * arrives before the previous one was presented replaces it.
+ */
+static Bool
+RADEONRenderVideoForVblank(ScrnInfoPtr pScrn, RADEONPortPrivPtr pPriv)
+{
+    ScreenPtr pScreen = pScrn->pScreen;
+    RADEONInfoPtr info = RADEONPTR(pScrn);
+    PixmapPtr pPixmap = pPriv->pPixmap;
+    DrawablePtr pDraw = pPriv->pDraw;
+    BoxRec extents;
+    xf86CrtcPtr crtc;
+    int vsync = pPriv->vsync;
+
+    if (!info->drmmode_inited || pDraw->type != DRAWABLE_WINDOW ||
+	!REGION_NOTEMPTY(pScreen, &pPriv->clip))
+	return FALSE;
+
+    crtc = RADEONTexturedVideoCrtc(pScrn, pPriv);
+    if (!crtc || !radeon_crtc_is_enabled(crtc))
+	return FALSE;
+
+    extents = *REGION_EXTENTS(pScreen, &pPriv->clip);
+    if (!RADEONAllocPresentPixmap(pScrn, pPriv,
+				  extents.x2 - extents.x1,
+				  extents.y2 - extents.y1,
+				  pPixmap->drawable.depth))
+	return FALSE;
+
+    REGION_COPY(pScreen, &pPriv->present_clip, &pPriv->clip);
+    pPriv->present_drawable = pDraw->id;
+    pPriv->present_serial = pDraw->serialNumber;
+    pPriv->present_x = extents.x1;
+    pPriv->present_y = extents.y1;
+
+    pPriv->pPixmap = pPriv->present_pixmap;
+    pPriv->pDraw = &pPriv->present_pixmap->drawable;
+    pPriv->drw_x -= extents.x1;
+    pPriv->drw_y -= extents.y1;
+    pPriv->vsync = RADEON_XV_VSYNC_OFF;
+    REGION_TRANSLATE(pScreen, &pPriv->clip, -extents.x1, -extents.y1);
+
+    RADEONDrawTexturedVideo(pScrn, pPriv);
+
+    REGION_TRANSLATE(pScreen, &pPriv->clip, extents.x1, extents.y1);
+    pPriv->vsync = vsync;
+    pPriv->drw_x += extents.x1;
+    pPriv->drw_y += extents.y1;
+    pPriv->pDraw = pDraw;
+    pPriv->pPixmap = pPixmap;
+
+    if (!pPriv->present_event && !RADEONQueueVideoVblank(pScrn, pPriv, crtc)) {
+	/* no vblank event, show it right away */
+	RADEONPresentTexturedVideo(pScrn, pPriv);
+    }
+
+    return TRUE;
+}
+
+static void
+RADEONDisplayTexturedVideoPort(ScrnInfoPtr pScrn, RADEONPortPrivPtr pPriv)
+{
+    if (pPriv->vsync == RADEON_XV_VSYNC_VBLANK &&
+	RADEONRenderVideoForVblank(pScrn, pPriv))
+	return;
+
+    RADEONDrawTexturedVideo(pScrn, pPriv);
+}
+
+/*
+ * Wait for the scanout to leave the rows pPriv is about to draw to, right
+ * before it draws. In batch mode the ports of a group share the wait of
+ * the group's first port, which covers all their rows; the others only
+ * need their own if the CS was submitted since.
+ */
+void
+RADEONTexturedVideoWaitVLine(ScrnInfoPtr pScrn, RADEONPortPrivPtr pPriv,
+			     PixmapPtr pPixmap)
+{
+    RADEONInfoPtr info = RADEONPTR(pScrn);
+    RADEONPortPrivPtr pLeader = NULL;
+    xf86CrtcPtr crtc;
+    int y1 = pPriv->drw_y, y2 = pPriv->drw_y + pPriv->dst_h;
+
+    if (pPriv->vline_leader >= 0)
+	pLeader = (RADEONPortPrivPtr)info->textured_adaptor->pPortPrivates[0].ptr +
+	    pPriv->vline_leader;
+
+    if (pLeader == pPriv) {
+	y1 = pPriv->vline_y1;
+	y2 = pPriv->vline_y2;
+    } else if (pLeader && pLeader->vline_emitted &&
+	       pLeader->vline_cs == info->cs_serial)
+	return;
+
+    crtc = RADEONTexturedVideoCrtc(pScrn, pPriv);
+    if (!crtc)
+	return;
+
+    if (IS_EVERGREEN_3D)
+	evergreen_cp_wait_vline_sync(pScrn, pPixmap, crtc,
+				     y1 - crtc->y, y2 - crtc->y);
+    else if (IS_R600_3D)
+	r600_cp_wait_vline_sync(pScrn, pPixmap, crtc,
+				y1 - crtc->y, y2 - crtc->y);
+    else
+	RADEONWaitForVLine(pScrn, pPixmap, crtc,
+			   y1 - crtc->y, y2 - crtc->y);
+
+    if (pLeader == pPriv) {
+	pPriv->vline_emitted = TRUE;
+	pPriv->vline_cs = info->cs_serial;
+    }
+}
+
+/*
+ * Group the pending ports that scan out on the same crtc into the same
+ * pixmap. The first port of a group waits for the union of the rows of
+ * the whole group, see RADEONTexturedVideoWaitVLine.
+ */
+static void
+RADEONBatchVLine(ScrnInfoPtr pScrn, RADEONPortPrivPtr pPortPriv, int nPorts)
+{
+    int i, j;
+
+    for (i = 0; i < nPorts; i++) {
+	RADEONPortPrivPtr pPriv = &pPortPriv[i];
+	xf86CrtcPtr crtc;
+
+	if (!pPriv->pending || pPriv->vsync != RADEON_XV_VSYNC_VLINE ||
+	    pPriv->vline_leader >= 0)
+	    continue;
+
+	crtc = RADEONTexturedVideoCrtc(pScrn, pPriv);
+	if (!crtc)
+	    continue;
+
+	pPriv->vline_leader = i;
+	pPriv->vline_y1 = pPriv->drw_y;
+	pPriv->vline_y2 = pPriv->drw_y + pPriv->dst_h;
+	pPriv->vline_emitted = FALSE;
+
+	for (j = i + 1; j < nPorts; j++) {
+	    RADEONPortPrivPtr pOther = &pPortPriv[j];
+
+	    if (!pOther->pending || pOther->vsync != RADEON_XV_VSYNC_VLINE ||
+		pOther->vline_leader >= 0 ||
+		pOther->pPixmap != pPriv->pPixmap ||
+		RADEONTexturedVideoCrtc(pScrn, pOther) != crtc)
+		continue;
+
+	    pPriv->vline_y1 = MIN(pPriv->vline_y1, pOther->drw_y);
+	    pPriv->vline_y2 = MAX(pPriv->vline_y2,
+				  pOther->drw_y + pOther->dst_h);
+	    pOther->vline_leader = i;
+	}
+    }
+}
+
+/*
+ * Draw every frame queued since the last block handler back to back in
+ * the current command stream, so there is one submission rather than one
+ * per frame. Each port still sets up its own shaders and constants; what
+ * is shared is the default 3D state, emitted once per CS, and the vline
+ * waits of ports on the same crtc.
+ */
+void
+RADEONFlushTexturedVideo(ScrnInfoPtr pScrn)
+{
+    RADEONInfoPtr info = RADEONPTR(pScrn);
+    RADEONPortPrivPtr pPortPriv;
+    int i, nPorts;
+
+    if (!info->textured_adaptor)
+	return;
+
+    nPorts = info->textured_adaptor->nPorts;
+    pPortPriv = info->textured_adaptor->pPortPrivates[0].ptr;
+
+    for (i = 0; i < nPorts; i++)
+	if (pPortPriv[i].pending)
+	    break;
+    if (i == nPorts)
+	return;
+
+    RADEONBatchVLine(pScrn, pPortPriv, nPorts);
+
+    for (i = 0; i < nPorts; i++) {
+	if (pPortPriv[i].pending)
+	    RADEONDisplayTexturedVideoPort(pScrn, &pPortPriv[i]);
+    }
+
+    /* only now, the later ports of a group look at their leader */
+    for (i = 0; i < nPorts; i++) {
+	if (pPortPriv[i].pending)
+	    RADEONCancelTexturedVideo(pScrn, &pPortPriv[i]);
+    }
+}
+
 /* client libraries expect an encoding */
 static XF86VideoEncodingRec DummyEncoding[1] =
 {
@@ -510,7 +1645,7 @@ static XF86VideoFormatRec Formats[NUM_FORMATS] =
 
 static XF86AttributeRec Attributes[NUM_ATTRIBUTES+1] =
 {
-    {XvSettable | XvGettable, 0, 1, "XV_VSYNC"},
+    {XvSettable | XvGettable, 0, 2, "XV_VSYNC"},
     {XvSettable | XvGettable, -1, 1, "XV_CRTC"},
     {0, 0, 0, NULL}
 };
@@ -519,12 +1654,12 @@ static XF86AttributeRec Attributes[NUM_ATTRIBUTES+1] =
 
 static XF86AttributeRec Attributes_r200[NUM_ATTRIBUTES_R200+1] =
 {
-    {XvSettable | XvGettable, 0, 1, "XV_VSYNC"},
+    {XvSettable | XvGettable, 0, 2, "XV_VSYNC"},
     {XvSettable | XvGettable, -1000, 1000, "XV_BRIGHTNESS"},
     {XvSettable | XvGettable, -1000, 1000, "XV_CONTRAST"},
     {XvSettable | XvGettable, -1000, 1000, "XV_SATURATION"},
     {XvSettable | XvGettable, -1000, 1000, "XV_HUE"},
-    {XvSettable | XvGettable, 0, 1, "XV_COLORSPACE"},
+    {XvSettable | XvGettable, 0, RADEON_VIDEO_NUM_TRANSFORMS - 1, "XV_COLORSPACE"},
     {XvSettable | XvGettable, -1, 1, "XV_CRTC"},
     {0, 0, 0, NULL}
 };
@@ -534,13 +1669,13 @@ static XF86AttributeRec Attributes_r200[NUM_ATTRIBUTES_R200+1] =
 static XF86AttributeRec Attributes_r300[NUM_ATTRIBUTES_R300+1] =
 {
     {XvSettable | XvGettable, 0, 2, "XV_BICUBIC"},
-    {XvSettable | XvGettable, 0, 1, "XV_VSYNC"},
+    {XvSettable | XvGettable, 0, 2, "XV_VSYNC"},
     {XvSettable | XvGettable, -1000, 1000, "XV_BRIGHTNESS"},
     {XvSettable | XvGettable, -1000, 1000, "XV_CONTRAST"},
     {XvSettable | XvGettable, -1000, 1000, "XV_SATURATION"},
     {XvSettable | XvGettable, -1000, 1000, "XV_HUE"},
     {XvSettable | XvGettable, 100, 10000, "XV_GAMMA"},
-    {XvSettable | XvGettable, 0, 1, "XV_COLORSPACE"},
+    {XvSettable | XvGettable, 0, RADEON_VIDEO_NUM_TRANSFORMS - 1, "XV_COLORSPACE"},
     {XvSettable | XvGettable, -1, 1, "XV_CRTC"},
     {0, 0, 0, NULL}
 };
@@ -550,38 +1685,42 @@ static XF86AttributeRec Attributes_r300[NUM_ATTRIBUTES_R300+1] =
 static XF86AttributeRec Attributes_r500[NUM_ATTRIBUTES_R500+1] =
 {
     {XvSettable | XvGettable, 0, 2, "XV_BICUBIC"},
-    {XvSettable | XvGettable, 0, 1, "XV_VSYNC"},
+    {XvSettable | XvGettable, 0, 2, "XV_VSYNC"},
     {XvSettable | XvGettable, -1000, 1000, "XV_BRIGHTNESS"},
     {XvSettable | XvGettable, -1000, 1000, "XV_CONTRAST"},
     {XvSettable | XvGettable, -1000, 1000, "XV_SATURATION"},
     {XvSettable | XvGettable, -1000, 1000, "XV_HUE"},
-    {XvSettable | XvGettable, 0, 1, "XV_COLORSPACE"},
+    {XvSettable | XvGettable, 0, RADEON_VIDEO_NUM_TRANSFORMS - 1, "XV_COLORSPACE"},
     {XvSettable | XvGettable, -1, 1, "XV_CRTC"},
     {0, 0, 0, NULL}
 };
 
-#define NUM_ATTRIBUTES_R600 7
+#define NUM_ATTRIBUTES_R600 9
 
 static XF86AttributeRec Attributes_r600[NUM_ATTRIBUTES_R600+1] =
 {
-    {XvSettable | XvGettable, 0, 1, "XV_VSYNC"},
+    {XvSettable | XvGettable, 0, 2, "XV_BICUBIC"},
+    {XvSettable | XvGettable, 0, 2, "XV_VSYNC"},
     {XvSettable | XvGettable, -1000, 1000, "XV_BRIGHTNESS"},
     {XvSettable | XvGettable, -1000, 1000, "XV_CONTRAST"},
     {XvSettable | XvGettable, -1000, 1000, "XV_SATURATION"},
     {XvSettable | XvGettable, -1000, 1000, "XV_HUE"},
-    {XvSettable | XvGettable, 0, 1, "XV_COLORSPACE"},
+    {XvSettable | XvGettable, 100, 10000, "XV_GAMMA"},
+    {XvSettable | XvGettable, 0, RADEON_VIDEO_NUM_TRANSFORMS - 1, "XV_COLORSPACE"},
     {XvSettable | XvGettable, -1, 1, "XV_CRTC"},
     {0, 0, 0, NULL}
 };
 
 static XF86AttributeRec Attributes_eg[NUM_ATTRIBUTES_R600+1] =
 {
-    {XvSettable | XvGettable, 0, 1, "XV_VSYNC"},
+    {XvSettable | XvGettable, 0, 2, "XV_BICUBIC"},
+    {XvSettable | XvGettable, 0, 2, "XV_VSYNC"},
     {XvSettable | XvGettable, -1000, 1000, "XV_BRIGHTNESS"},
     {XvSettable | XvGettable, -1000, 1000, "XV_CONTRAST"},
     {XvSettable | XvGettable, -1000, 1000, "XV_SATURATION"},
     {XvSettable | XvGettable, -1000, 1000, "XV_HUE"},
-    {XvSettable | XvGettable, 0, 1, "XV_COLORSPACE"},
+    {XvSettable | XvGettable, 100, 10000, "XV_GAMMA"},
+    {XvSettable | XvGettable, 0, RADEON_VIDEO_NUM_TRANSFORMS - 1, "XV_COLORSPACE"},
     {XvSettable | XvGettable, -1, 5, "XV_CRTC"},
     {0, 0, 0, NULL}
 };
@@ -602,6 +1741,19 @@ static XF86ImageRec Images[NUM_IMAGES] =
     XVIMAGE_UYVY
 };
 
+#define NUM_IMAGES_R600 7
+
+static XF86ImageRec Images_r600[NUM_IMAGES_R600] =
+{
+    XVIMAGE_YUY2,
+    XVIMAGE_YV12,
+    XVIMAGE_I420,
+    XVIMAGE_UYVY,
+    XVIMAGE_NV12,
+    XVIMAGE_P010,
+    XVIMAGE_XVMC
+};
+
 int
 RADEONGetTexPortAttribute(ScrnInfoPtr  pScrn,
 		       Atom	    attribute,
@@ -655,10 +1807,12 @@ RADEONSetTexPortAttribute(ScrnInfoPtr  pScrn,
 
     RADEON_SYNC(info, pScrn);
 
+    RADEONInvalidateImageBands(pPriv);
+
     if (attribute == xvBicubic)
 	pPriv->bicubic_state = ClipValue (value, 0, 2);
     else if (attribute == xvVSync)
-	pPriv->vsync = ClipValue (value, 0, 1);
+	pPriv->vsync = ClipValue (value, RADEON_XV_VSYNC_OFF, RADEON_XV_VSYNC_VBLANK);
     else if (attribute == xvBrightness)
 	pPriv->brightness = ClipValue (value, -1000, 1000);
     else if (attribute == xvContrast)
@@ -670,7 +1824,7 @@ RADEONSetTexPortAttribute(ScrnInfoPtr  pScrn,
     else if (attribute == xvGamma)
 	pPriv->gamma = ClipValue (value, 100, 10000);
     else if(attribute == xvColorspace)
-	pPriv->transform_index = ClipValue (value, 0, 1);
+	pPriv->transform_index = ClipValue (value, 0, RADEON_VIDEO_NUM_TRANSFORMS - 1);
     else if(attribute == xvCRTC) {
 	xf86CrtcConfigPtr   xf86_config = XF86_CRTC_CONFIG_PTR(pScrn);
 	if ((value < -1) || (value > xf86_config->num_crtc))
@@ -688,6 +1842,7 @@ RADEONSetTexPortAttribute(ScrnInfoPtr  pScrn,
 Bool radeon_load_bicubic_texture(ScrnInfoPtr pScrn)
 {
     RADEONInfoPtr    info = RADEONPTR(pScrn);
+    uint8_t *bicubic_addr;
     int ret;
     /* Bicubic filter loading */
     ret = radeon_allocate_video_bo(pScrn,
@@ -698,24 +1853,20 @@ Bool radeon_load_bicubic_texture(ScrnInfoPtr pScrn)
 	return FALSE;
 
     /* Upload bicubic filter tex */
-    if (info->ChipFamily < CHIP_FAMILY_R600) {
-	uint8_t *bicubic_addr;
-	int ret;
-	ret = radeon_bo_map(info->bicubic_bo, 1);
-	if (ret)
-	    return FALSE;
+    ret = radeon_bo_map(info->bicubic_bo, 1);
+    if (ret)
+	return FALSE;
 
-	bicubic_addr = info->bicubic_bo->ptr;
+    bicubic_addr = info->bicubic_bo->ptr;
 
-	RADEONCopySwap(bicubic_addr, (uint8_t *)bicubic_tex_512, 1024,
+    RADEONCopySwap(bicubic_addr, (uint8_t *)bicubic_tex_512, 1024,
 #if X_BYTE_ORDER == X_BIG_ENDIAN
-		       RADEON_HOST_DATA_SWAP_16BIT
+		   RADEON_HOST_DATA_SWAP_16BIT
 #else
-		       RADEON_HOST_DATA_SWAP_NONE
+		   RADEON_HOST_DATA_SWAP_NONE
 #endif
 );
-	radeon_bo_unmap(info->bicubic_bo);
-    }
+    radeon_bo_unmap(info->bicubic_bo);
     return TRUE;
 }
 
@@ -791,6 +1942,23 @@ RADEONQueryImageAttributes(
 	if(offsets) offsets[2] = size;
 	size += tmp;
 	break;
+    case FOURCC_NV12:
+    case FOURCC_P010:
+	/* interleaved UV rows have the same length as the luma rows, which
+	 * only holds for an even number of 2x2 subsampled chroma samples */
+	*w = RADEON_ALIGN(*w, 2);
+	*h = RADEON_ALIGN(*h, 2);
+	size = (id == FOURCC_P010) ? *w << 1 : RADEON_ALIGN(*w, 4);
+	if(pitches) pitches[0] = pitches[1] = size;
+	tmp = size * (*h >> 1);
+	size *= *h;
+	if(offsets) offsets[1] = size;
+	size += tmp;
+	break;
+    case FOURCC_XVMC:
+	size = sizeof(RADEONXvMCCommandRec);
+	if(pitches) pitches[0] = size;
+	break;
     case FOURCC_RGBA32:
 	size = *w << 2;
 	if(pitches) pitches[0] = size;
@@ -884,8 +2052,13 @@ RADEONSetupImageTexturedVideo(ScreenPtr pScreen)
 	adapt->pAttributes = Attributes;
 	adapt->nAttributes = NUM_ATTRIBUTES;
     }
-    adapt->pImages = Images;
-    adapt->nImages = NUM_IMAGES;
+    if (IS_EVERGREEN_3D || IS_R600_3D) {
+	adapt->pImages = Images_r600;
+	adapt->nImages = NUM_IMAGES_R600;
+    } else {
+	adapt->pImages = Images;
+	adapt->nImages = NUM_IMAGES;
+    }
     adapt->PutVideo = NULL;
     adapt->PutStill = NULL;
     adapt->GetVideo = NULL;
@@ -903,7 +2076,7 @@ RADEONSetupImageTexturedVideo(ScreenPtr pScreen)
 
 	pPriv->textured = TRUE;
 	pPriv->bicubic_state = BICUBIC_OFF;
-	pPriv->vsync = TRUE;
+	pPriv->vsync = RADEON_XV_VSYNC_VLINE;
 	pPriv->brightness = 0;
 	pPriv->contrast = 0;
 	pPriv->saturation = 0;
@@ -911,17 +2084,22 @@ RADEONSetupImageTexturedVideo(ScreenPtr pScreen)
 	pPriv->gamma = 1000;
 	pPriv->transform_index = 0;
 	pPriv->desired_crtc = NULL;
+	pPriv->dma_buffer = -1;
+	pPriv->tiled_buffer = -1;
+	pPriv->vline_leader = -1;
 
 	/* gotta uninit this someplace, XXX: shouldn't be necessary for textured */
 	REGION_NULL(pScreen, &pPriv->clip);
+	REGION_NULL(pScreen, &pPriv->present_clip);
 	adapt->pPortPrivates[i].ptr = (pointer) (pPriv);
     }
 
-    if (IS_R500_3D || IS_R300_3D)
+    if (IS_R500_3D || IS_R300_3D || IS_R600_3D)
 	radeon_load_bicubic_texture(pScrn);
 
     info->xv_max_width = adapt->pEncodings->width;
     info->xv_max_height = adapt->pEncodings->height;
+    info->textured_adaptor = adapt;
 
     return adapt;
 }
@@ -66,7 +66,8 @@ RADEONPrepareTexturedVideo(ScrnInfoPtr pScrn, RADEONPortPrivPtr pPriv)
 	radeon_cs_space_add_persistent_bo(info->cs, info->bicubic_bo, RADEON_GEM_DOMAIN_GTT | RADEON_GEM_DOMAIN_VRAM, 0);
 
     driver_priv = exaGetPixmapDriverPrivate(pPixmap);
-    radeon_cs_space_add_persistent_bo(info->cs, driver_priv->bo, 0, RADEON_GEM_DOMAIN_VRAM);
+    radeon_cs_space_add_persistent_bo(info->cs, driver_priv->bo, 0,
+				      radeon_pixmap_write_domain(pPixmap));
 
     ret = radeon_cs_space_check(info->cs);
     if (ret) {
@@ -264,22 +265,8 @@ RADEONPrepareTexturedVideo(ScrnInfoPtr pScrn, RADEONPortPrivPtr pPriv)
 					   (scissor_h << RADEON_RE_HEIGHT_SHIFT)));
     ADVANCE_RING();
 
-    if (pPriv->vsync) {
-	xf86CrtcPtr crtc;
-	if (pPriv->desired_crtc)
-	    crtc = pPriv->desired_crtc;
-	else
-	    crtc = radeon_pick_best_crtc(pScrn, FALSE,
-					 pPriv->drw_x,
-					 pPriv->drw_x + pPriv->dst_w,
-					 pPriv->drw_y,
-					 pPriv->drw_y + pPriv->dst_h);
-	if (crtc)
-	    RADEONWaitForVLine(pScrn, pPixmap,
-				 crtc,
-				 pPriv->drw_y - crtc->y,
-				 (pPriv->drw_y - crtc->y) + pPriv->dst_h);
-    }
+    if (pPriv->vsync)
+	RADEONTexturedVideoWaitVLine(pScrn, pPriv, pPixmap);
 
     return TRUE;
 }
@@ -436,7 +423,8 @@ R200PrepareTexturedVideo(ScrnInfoPtr pScrn, RADEONPortPrivPtr pPriv)
 	radeon_cs_space_add_persistent_bo(info->cs, info->bicubic_bo, RADEON_GEM_DOMAIN_GTT | RADEON_GEM_DOMAIN_VRAM, 0);
 
     driver_priv = exaGetPixmapDriverPrivate(pPixmap);
-    radeon_cs_space_add_persistent_bo(info->cs, driver_priv->bo, 0, RADEON_GEM_DOMAIN_VRAM);
+    radeon_cs_space_add_persistent_bo(info->cs, driver_priv->bo, 0,
+				      radeon_pixmap_write_domain(pPixmap));
 
     ret = radeon_cs_space_check(info->cs);
     if (ret) {
@@ -808,22 +796,8 @@ R200PrepareTexturedVideo(ScrnInfoPtr pScrn, RADEONPortPrivPtr pPriv)
 					   (scissor_h << RADEON_RE_HEIGHT_SHIFT)));
     ADVANCE_RING();
 
-    if (pPriv->vsync) {
-	xf86CrtcPtr crtc;
-	if (pPriv->desired_crtc)
-	    crtc = pPriv->desired_crtc;
-	else
-	    crtc = radeon_pick_best_crtc(pScrn, FALSE,
-					 pPriv->drw_x,
-					 pPriv->drw_x + pPriv->dst_w,
-					 pPriv->drw_y,
-					 pPriv->drw_y + pPriv->dst_h);
-	if (crtc)
-	    RADEONWaitForVLine(pScrn, pPixmap,
-				 crtc,
-				 pPriv->drw_y - crtc->y,
-				 (pPriv->drw_y - crtc->y) + pPriv->dst_h);
-    }
+    if (pPriv->vsync)
+	RADEONTexturedVideoWaitVLine(pScrn, pPriv, pPixmap);
 
     return TRUE;
 }
@@ -961,7 +935,8 @@ R300PrepareTexturedVideo(ScrnInfoPtr pScrn, RADEONPortPrivPtr pPriv)
 	radeon_cs_space_add_persistent_bo(info->cs, info->bicubic_bo, RADEON_GEM_DOMAIN_GTT | RADEON_GEM_DOMAIN_VRAM, 0);
 
     driver_priv = exaGetPixmapDriverPrivate(pPixmap);
-    radeon_cs_space_add_persistent_bo(info->cs, driver_priv->bo, 0, RADEON_GEM_DOMAIN_VRAM);
+    radeon_cs_space_add_persistent_bo(info->cs, driver_priv->bo, 0,
+				      radeon_pixmap_write_domain(pPixmap));
 
     ret = radeon_cs_space_check(info->cs);
     if (ret) {
@@ -1646,34 +1621,11 @@ R300PrepareTexturedVideo(ScrnInfoPtr pScrn, RADEONPortPrivPtr pPriv)
 	 * temp = MAD(uco, yuv.uuuu, temp)
 	 * result = MAD(vco, yuv.vvvv, temp)
 	 */
-	/* TODO: don't recalc consts always */
-	const float Loff = -0.0627;
-	const float Coff = -0.502;
-	float uvcosf, uvsinf;
-	float yco;
-	float uco[3], vco[3], off[3];
-	float bright, cont, gamma;
-	int ref = pPriv->transform_index;
+	const float *csc = RADEONTexturedVideoCSC(pPriv);
+	const float *off = &csc[0], *uco = &csc[4], *vco = &csc[8];
+	float yco = csc[3], gamma = csc[7];
 	Bool needgamma = FALSE;
 
-	cont = RTFContrast(pPriv->contrast);
-	bright = RTFBrightness(pPriv->brightness);
-	gamma = (float)pPriv->gamma / 1000.0;
-	uvcosf = RTFSaturation(pPriv->saturation) * cos(RTFHue(pPriv->hue));
-	uvsinf = RTFSaturation(pPriv->saturation) * sin(RTFHue(pPriv->hue));
-	/* overlay video also does pre-gamma contrast/sat adjust, should we? */
-
-	yco = trans[ref].RefLuma * cont;
-	uco[0] = -trans[ref].RefRCr * uvsinf;
-	uco[1] = trans[ref].RefGCb * uvcosf - trans[ref].RefGCr * uvsinf;
-	uco[2] = trans[ref].RefBCb * uvcosf;
-	vco[0] = trans[ref].RefRCr * uvcosf;
-	vco[1] = trans[ref].RefGCb * uvsinf + trans[ref].RefGCr * uvcosf;
-	vco[2] = trans[ref].RefBCb * uvsinf;
-	off[0] = Loff * yco + Coff * (uco[0] + vco[0]) + bright;
-	off[1] = Loff * yco + Coff * (uco[1] + vco[1]) + bright;
-	off[2] = Loff * yco + Coff * (uco[2] + vco[2]) + bright;
-
 	if (gamma != 1.0) {
 	    needgamma = TRUE;
 	    /* note: gamma correction is out = in ^ gamma;
@@ -2160,22 +2112,8 @@ R300PrepareTexturedVideo(ScrnInfoPtr pScrn, RADEONPortPrivPtr pPriv)
     OUT_RING_REG(R300_VAP_VTX_SIZE, pPriv->vtx_count);
     ADVANCE_RING();
 
-    if (pPriv->vsync) {
-	xf86CrtcPtr crtc;
-	if (pPriv->desired_crtc)
-	    crtc = pPriv->desired_crtc;
-	else
-	    crtc = radeon_pick_best_crtc(pScrn, FALSE,
-					 pPriv->drw_x,
-					 pPriv->drw_x + pPriv->dst_w,
-					 pPriv->drw_y,
-					 pPriv->drw_y + pPriv->dst_h);
-	if (crtc)
-	    RADEONWaitForVLine(pScrn, pPixmap,
-			       crtc,
-			       pPriv->drw_y - crtc->y,
-			       (pPriv->drw_y - crtc->y) + pPriv->dst_h);
-    }
+    if (pPriv->vsync)
+	RADEONTexturedVideoWaitVLine(pScrn, pPriv, pPixmap);
 
     return TRUE;
 }
@@ -2379,7 +2317,8 @@ R500PrepareTexturedVideo(ScrnInfoPtr pScrn, RADEONPortPrivPtr pPriv)
 	radeon_cs_space_add_persistent_bo(info->cs, info->bicubic_bo, RADEON_GEM_DOMAIN_GTT | RADEON_GEM_DOMAIN_VRAM, 0);
     
     driver_priv = exaGetPixmapDriverPrivate(pPixmap);
-    radeon_cs_space_add_persistent_bo(info->cs, driver_priv->bo, 0, RADEON_GEM_DOMAIN_VRAM);
+    radeon_cs_space_add_persistent_bo(info->cs, driver_priv->bo, 0,
+				      radeon_pixmap_write_domain(pPixmap));
 
     ret = radeon_cs_space_check(info->cs);
     if (ret) {
@@ -3240,32 +3179,9 @@ R500PrepareTexturedVideo(ScrnInfoPtr pScrn, RADEONPortPrivPtr pPriv)
 	 * temp = MAD(uco, yuv.uuuu, temp)
 	 * result = MAD(vco, yuv.vvvv, temp)
 	 */
-	/* TODO: don't recalc consts always */
-	const float Loff = -0.0627;
-	const float Coff = -0.502;
-	float uvcosf, uvsinf;
-	float yco;
-	float uco[3], vco[3], off[3];
-	float bright, cont, gamma;
-	int ref = pPriv->transform_index;
-
-	cont = RTFContrast(pPriv->contrast);
-	bright = RTFBrightness(pPriv->brightness);
-	gamma = (float)pPriv->gamma / 1000.0;
-	uvcosf = RTFSaturation(pPriv->saturation) * cos(RTFHue(pPriv->hue));
-	uvsinf = RTFSaturation(pPriv->saturation) * sin(RTFHue(pPriv->hue));
-	/* overlay video also does pre-gamma contrast/sat adjust, should we? */
-
-	yco = trans[ref].RefLuma * cont;
-	uco[0] = -trans[ref].RefRCr * uvsinf;
-	uco[1] = trans[ref].RefGCb * uvcosf - trans[ref].RefGCr * uvsinf;
-	uco[2] = trans[ref].RefBCb * uvcosf;
-	vco[0] = trans[ref].RefRCr * uvcosf;
-	vco[1] = trans[ref].RefGCb * uvsinf + trans[ref].RefGCr * uvcosf;
-	vco[2] = trans[ref].RefBCb * uvsinf;
-	off[0] = Loff * yco + Coff * (uco[0] + vco[0]) + bright;
-	off[1] = Loff * yco + Coff * (uco[1] + vco[1]) + bright;
-	off[2] = Loff * yco + Coff * (uco[2] + vco[2]) + bright;
+	const float *csc = RADEONTexturedVideoCSC(pPriv);
+	const float *off = &csc[0], *uco = &csc[4], *vco = &csc[8];
+	float yco = csc[3], gamma = csc[7];
 
 	//XXX gamma
 
@@ -3713,22 +3629,8 @@ R500PrepareTexturedVideo(ScrnInfoPtr pScrn, RADEONPortPrivPtr pPriv)
     OUT_RING_REG(R300_VAP_VTX_SIZE, pPriv->vtx_count);
     ADVANCE_RING();
 
-    if (pPriv->vsync) {
-	xf86CrtcPtr crtc;
-	if (pPriv->desired_crtc)
-	    crtc = pPriv->desired_crtc;
-	else
-	    crtc = radeon_pick_best_crtc(pScrn, FALSE,
-					 pPriv->drw_x,
-					 pPriv->drw_x + pPriv->dst_w,
-					 pPriv->drw_y,
-					 pPriv->drw_y + pPriv->dst_h);
-	if (crtc)
-	    RADEONWaitForVLine(pScrn, pPixmap,
-			       crtc,
-			       pPriv->drw_y - crtc->y,
-			       (pPriv->drw_y - crtc->y) + pPriv->dst_h);
-    }
+    if (pPriv->vsync)
+	RADEONTexturedVideoWaitVLine(pScrn, pPriv, pPixmap);
 
     return TRUE;
 }
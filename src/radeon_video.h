@@ -12,6 +12,142 @@
 
 #define ClipValue(v,min,max) ((v) < (min) ? (min) : (v) > (max) ? (max) : (v))
 
+/* Mapped upload buffers per textured port, used round robin */
+#define RADEON_VIDEO_STAGING_BUFFERS 3
+
+/* Source lines hashed together for change detection in textured video */
+#define RADEON_VIDEO_BAND_LINES 16
+/* Frames with nearly every band changed before hashing is skipped, and how
+ * often it is then still done to notice the content going static */
+#define RADEON_VIDEO_HASH_BACKOFF 4
+#define RADEON_VIDEO_HASH_PROBE 16
+
+/* XV_VSYNC values for textured video */
+#define RADEON_XV_VSYNC_OFF	0
+#define RADEON_XV_VSYNC_VLINE	1	/* CP waits for the scanline */
+#define RADEON_XV_VSYNC_VBLANK	2	/* copied into place on a vblank event */
+
+/* XV_COLORSPACE values: BT.601, BT.709, BT.2020 */
+#define RADEON_VIDEO_NUM_TRANSFORMS 3
+
+/* Port attributes the cached colour conversion constants depend on */
+#define RADEON_VIDEO_CSC_KEYS 6
+
+/* Semi-planar formats, not provided by older fourcc.h */
+#ifndef FOURCC_NV12
+#define FOURCC_NV12 0x3231564e
+#endif
+#ifndef FOURCC_P010
+#define FOURCC_P010 0x30313050
+#endif
+
+#define XVIMAGE_NV12 \
+   { \
+	FOURCC_NV12, \
+	XvYUV, \
+	LSBFirst, \
+	{'N','V','1','2', \
+	  0x00,0x00,0x00,0x10,0x80,0x00,0x00,0xAA,0x00,0x38,0x9B,0x71}, \
+	12, \
+	XvPlanar, \
+	2, \
+	0, 0, 0, 0, \
+	8, 8, 8, \
+	1, 2, 2, \
+	1, 2, 2, \
+	{'Y','U','V', \
+	  0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0}, \
+	XvTopToBottom \
+   }
+
+#define XVIMAGE_P010 \
+   { \
+	FOURCC_P010, \
+	XvYUV, \
+	LSBFirst, \
+	{'P','0','1','0', \
+	  0x00,0x00,0x00,0x10,0x80,0x00,0x00,0xAA,0x00,0x38,0x9B,0x71}, \
+	24, \
+	XvPlanar, \
+	2, \
+	0, 0, 0, 0, \
+	16, 16, 16, \
+	1, 2, 2, \
+	1, 2, 2, \
+	{'Y','U','V', \
+	  0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0}, \
+	XvTopToBottom \
+   }
+
+/*
+ * XvMC surfaces are shown by an XvPutImage of FOURCC_XVMC whose data is a
+ * RADEONXvMCCommandRec naming the surface.
+ */
+#define FOURCC_XVMC (('C' << 24) + ('M' << 16) + ('V' << 8) + 'X')
+
+#define XVIMAGE_XVMC \
+   { \
+	FOURCC_XVMC, \
+	XvYUV, \
+	LSBFirst, \
+	{'X','V','M','C', \
+	  0x00,0x00,0x00,0x10,0x80,0x00,0x00,0xAA,0x00,0x38,0x9B,0x71}, \
+	12, \
+	XvPlanar, \
+	3, \
+	0, 0, 0, 0, \
+	8, 8, 8, \
+	1, 2, 2, \
+	1, 2, 2, \
+	{'Y','U','V', \
+	  0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0}, \
+	XvTopToBottom \
+   }
+
+typedef struct {
+    CARD32 surface_id;		/* XID of the XvMC surface */
+} RADEONXvMCCommandRec, *RADEONXvMCCommandPtr;
+
+/*
+ * Context flag a client sets to get its surfaces backed by shared BOs.
+ * Contexts without it get no private data and no BOs, like before.
+ */
+#define RADEON_XVMC_SHARED_SURFACES	(1 << 16)
+
+/* private data returned to the XvMC client for contexts and surfaces */
+#define RADEON_XVMC_CONTEXT_CHIP	0	/* RADEONChipFamily */
+#define RADEON_XVMC_CONTEXT_PRIV	1
+
+#define RADEON_XVMC_SURFACE_NAME	0	/* GEM name of the BO */
+#define RADEON_XVMC_SURFACE_SIZE	1
+#define RADEON_XVMC_SURFACE_PITCH	2	/* luma, chroma is half aligned */
+#define RADEON_XVMC_SURFACE_U_OFFSET	3
+#define RADEON_XVMC_SURFACE_V_OFFSET	4
+#define RADEON_XVMC_SURFACE_PRIV	5
+
+/* XvMC surface, a planar 4:2:0 frame in a BO shared with the client */
+typedef struct radeon_xvmc_surface {
+    struct radeon_xvmc_surface *next;
+    XID id;
+    XvMCContextPtr context;	/* the surface was created in */
+    struct radeon_bo *bo;
+    int width, height;
+    int pitch, size;
+    int planeu_offset, planev_offset;
+} RADEONXvMCSurfaceRec, *RADEONXvMCSurfacePtr;
+
+/* A planar video plane the port keeps tiled in VRAM */
+typedef struct {
+    struct radeon_bo *bo;
+    struct radeon_surface surface;
+    uint32_t tiling;
+    int pitch;			/* bytes, 8 bit texels */
+    int w, h;
+} RADEONVideoPlaneRec, *RADEONVideoPlanePtr;
+
+/* Clip boxes beyond which every texel is fetched often enough to tile */
+#define RADEON_VIDEO_TILED_MIN_BOXES 4
+
 /* Xvideo port struct */
 typedef struct {
    uint32_t	 transform_index;
@@ -48,6 +184,7 @@ typedef struct {
     PixmapPtr pPixmap;
 
     uint32_t src_pitch;
+    uint32_t src_pitch2;	/* chroma planes of planar formats */
     uint8_t *src_addr;
 
     int id;
@@ -60,9 +197,72 @@ typedef struct {
     int vtx_count;
     int hw_align;
 
-    struct radeon_bo *src_bo[2];
+    struct radeon_bo *src_bo[RADEON_VIDEO_STAGING_BUFFERS];
+    struct radeon_bo *xvmc_bo;	/* XvMC surface drawn instead, referenced */
+    struct radeon_bo *dma_bo;	/* VRAM copy made by the async DMA engine */
+    int dma_buffer;		/* upload buffer dma_bo holds, or -1 */
+
+    /* TexturedVideoTiling: Y, U and V blitted into tiled VRAM */
+    RADEONVideoPlaneRec planes[3];
+    int tiled_buffer;		/* upload buffer the planes hold, or -1 */
+
+    /* partial upload tracking */
+    uint64_t *band_hash;
+    uint32_t *band_gen;		/* frame generation a band last changed */
+    int num_bands;
+    int band_top, band_nlines;	/* visible lines the bands describe */
+    uint32_t frame_gen;
+    uint32_t buffer_gen[RADEON_VIDEO_STAGING_BUFFERS];
+    int busy_frames;		/* frames in a row with nearly all bands changed */
+    unsigned long draw_serial;
+    Bool displayed;
+
+    /* cached colour conversion constants */
+    float csc[12];
+    int csc_key[RADEON_VIDEO_CSC_KEYS];
+    Bool csc_valid;
+
+    /* XV_VSYNC 2: frames rendered ahead, copied into place at vblank */
+    PixmapPtr present_pixmap;
+    RegionRec present_clip;	/* screen coordinates */
+    XID present_drawable;
+    unsigned long present_serial;	/* of the drawable's clip at render time */
+    int present_x, present_y;	/* screen origin of present_pixmap */
+    struct radeon_video_vblank_event *present_event;
+
+    /* deferred to the block handler in batch mode */
+    Bool pending;
+    int vline_leader;		/* port whose vline wait covers us, or -1 */
+    int vline_y1, vline_y2;	/* rows the wait covers, if we lead */
+    Bool vline_emitted;		/* the leader's wait is in the CS ... */
+    unsigned int vline_cs;	/* ... with this cs_serial */
+    PixmapPtr pending_pixmap;	/* referenced while pending */
 } RADEONPortPrivRec, *RADEONPortPrivPtr;
 
+/* Whether the current frame is sampled from the tiled planes */
+static inline Bool
+RADEONVideoTiled(RADEONPortPrivPtr pPriv)
+{
+    return !pPriv->xvmc_bo && pPriv->tiled_buffer >= 0 &&
+	pPriv->tiled_buffer == pPriv->currentBuffer;
+}
+
+/* Buffer the textured video samples from */
+static inline struct radeon_bo *
+RADEONVideoSourceBO(RADEONPortPrivPtr pPriv)
+{
+    if (pPriv->xvmc_bo)
+	return pPriv->xvmc_bo;
+
+    if (RADEONVideoTiled(pPriv))
+	return pPriv->planes[0].bo;
+
+    if (pPriv->dma_bo && pPriv->dma_buffer == pPriv->currentBuffer)
+	return pPriv->dma_bo;
+
+    return pPriv->src_bo[pPriv->currentBuffer];
+}
+
 /* Reference color space transform data */
 typedef struct tagREF_TRANSFORM
 {
@@ -87,6 +287,10 @@ RADEONSetupImageTexturedVideo(ScreenPtr pScreen);
 XF86MCAdaptorPtr
 RADEONCreateAdaptorXvMC(ScreenPtr pScreen, char *xv_adaptor_name);
 
+RADEONXvMCSurfacePtr
+RADEONLookupXvMCSurface(ScrnInfoPtr pScrn, void *port, DrawablePtr pDraw,
+			XID id);
+
 void
 RADEONCopyData(ScrnInfoPtr pScrn,
 	       unsigned char *src, unsigned char *dst,
@@ -100,6 +304,13 @@ RADEONCopyMungedData(ScrnInfoPtr pScrn,
 		     unsigned int srcPitch, unsigned int srcPitch2,
 		     unsigned int dstPitch, unsigned int h, unsigned int w);
 
+const float *
+RADEONTexturedVideoCSC(RADEONPortPrivPtr pPriv);
+
+void
+RADEONTexturedVideoWaitVLine(ScrnInfoPtr pScrn, RADEONPortPrivPtr pPriv,
+			     PixmapPtr pPixmap);
+
 Bool radeon_crtc_is_enabled(xf86CrtcPtr crtc);
 uint32_t radeon_get_interpolated_vblanks(xf86CrtcPtr crtc);
 
@@ -30,8 +30,11 @@
 #endif
 
 #include <xf86.h>
+#include "radeon.h"
 #include "radeon_video.h"
+#include "radeon_bo_gem.h"
 #include "compat-api.h"
+#include "xf86xvpriv.h"
 
 #include <X11/extensions/Xv.h>
 #include <X11/extensions/XvMC.h>
@@ -104,6 +107,188 @@ static XF86ImagePtr subpictures[] =
 	(XF86ImagePtr)&ai44_subpicture
 };
 
+/*
+ * Surfaces are laid out like the textured video upload buffers, so a frame
+ * decoded into one can be drawn by the textured video path as it is.
+ */
+static void
+RADEONXvMCSurfaceLayout(ScrnInfoPtr pScrn, RADEONXvMCSurfacePtr surface)
+{
+	int align = drmmode_get_base_align(pScrn, 2, 0);
+	int h_align = drmmode_get_height_align(pScrn, 0);
+	int height = RADEON_ALIGN(surface->height, h_align);
+	int chroma_height = RADEON_ALIGN((height + 1) >> 1, h_align);
+	int pitch2;
+
+	surface->pitch = RADEON_ALIGN(surface->width, align);
+	pitch2 = RADEON_ALIGN(surface->pitch >> 1, align);
+
+	surface->planeu_offset = RADEON_ALIGN(surface->pitch * height, align);
+	surface->planev_offset = RADEON_ALIGN(surface->planeu_offset +
+					      pitch2 * chroma_height, align);
+	surface->size = RADEON_ALIGN(surface->planev_offset +
+				     pitch2 * chroma_height, align);
+}
+
+/*
+ * Find the surface named by a FOURCC_XVMC put on port.  Only surfaces of a
+ * context on that port are shown, and only in drawables of the client that
+ * created the surface.
+ */
+RADEONXvMCSurfacePtr
+RADEONLookupXvMCSurface(ScrnInfoPtr pScrn, void *port, DrawablePtr pDraw,
+			XID id)
+{
+	RADEONInfoPtr info = RADEONPTR(pScrn);
+	RADEONXvMCSurfacePtr surface;
+	XvPortRecPrivatePtr portPriv;
+
+	for (surface = info->xvmc_surfaces; surface; surface = surface->next)
+	{
+		if (surface->id == id)
+			break;
+	}
+
+	if (!surface)
+		return NULL;
+
+	portPriv = surface->context->port_priv;
+	if (!portPriv || portPriv->DevPriv.ptr != port)
+		return NULL;
+
+	if (CLIENT_ID(surface->id) != CLIENT_ID(surface->context->context_id) ||
+	    CLIENT_ID(surface->id) != CLIENT_ID(pDraw->id))
+		return NULL;
+
+	return surface;
+}
+
+static int
+RADEONXvMCCreateContext(ScrnInfoPtr pScrn, XvMCContextPtr pContext,
+			int *num_priv, CARD32 **priv)
+{
+	RADEONInfoPtr info = RADEONPTR(pScrn);
+
+	*num_priv = 0;
+	*priv = NULL;
+
+	if (!(pContext->flags & RADEON_XVMC_SHARED_SURFACES))
+		return Success;
+
+	*priv = calloc(RADEON_XVMC_CONTEXT_PRIV, sizeof(CARD32));
+	if (!*priv)
+		return BadAlloc;
+
+	(*priv)[RADEON_XVMC_CONTEXT_CHIP] = info->ChipFamily;
+	*num_priv = RADEON_XVMC_CONTEXT_PRIV;
+
+	return Success;
+}
+
+static void
+RADEONXvMCDestroyContext(ScrnInfoPtr pScrn, XvMCContextPtr pContext)
+{
+}
+
+static int
+RADEONXvMCCreateSurface(ScrnInfoPtr pScrn, XvMCSurfacePtr pSurf,
+			int *num_priv, CARD32 **priv)
+{
+	RADEONInfoPtr info = RADEONPTR(pScrn);
+	RADEONXvMCSurfacePtr surface;
+	uint32_t name;
+
+	*num_priv = 0;
+	*priv = NULL;
+	pSurf->driver_priv = NULL;
+
+	/* clients that don't share surfaces never touch a BO */
+	if (!(pSurf->context->flags & RADEON_XVMC_SHARED_SURFACES))
+		return Success;
+
+	surface = calloc(1, sizeof(RADEONXvMCSurfaceRec));
+	if (!surface)
+		return BadAlloc;
+
+	surface->id = pSurf->surface_id;
+	surface->context = pSurf->context;
+	surface->width = RADEON_ALIGN(pSurf->context->width, 2);
+	surface->height = RADEON_ALIGN(pSurf->context->height, 2);
+	RADEONXvMCSurfaceLayout(pScrn, surface);
+
+	surface->bo = radeon_bo_open(info->bufmgr, 0, surface->size, 0,
+				     RADEON_GEM_DOMAIN_VRAM, 0);
+	if (!surface->bo)
+		goto fail;
+
+	if (radeon_gem_get_kernel_name(surface->bo, &name))
+		goto fail;
+
+	*priv = calloc(RADEON_XVMC_SURFACE_PRIV, sizeof(CARD32));
+	if (!*priv)
+		goto fail;
+
+	(*priv)[RADEON_XVMC_SURFACE_NAME] = name;
+	(*priv)[RADEON_XVMC_SURFACE_SIZE] = surface->size;
+	(*priv)[RADEON_XVMC_SURFACE_PITCH] = surface->pitch;
+	(*priv)[RADEON_XVMC_SURFACE_U_OFFSET] = surface->planeu_offset;
+	(*priv)[RADEON_XVMC_SURFACE_V_OFFSET] = surface->planev_offset;
+	*num_priv = RADEON_XVMC_SURFACE_PRIV;
+
+	surface->next = info->xvmc_surfaces;
+	info->xvmc_surfaces = surface;
+	pSurf->driver_priv = surface;
+
+	return Success;
+
+fail:
+	if (surface->bo)
+		radeon_bo_unref(surface->bo);
+	free(surface);
+	return BadAlloc;
+}
+
+static void
+RADEONXvMCDestroySurface(ScrnInfoPtr pScrn, XvMCSurfacePtr pSurf)
+{
+	RADEONInfoPtr info = RADEONPTR(pScrn);
+	RADEONXvMCSurfacePtr surface = pSurf->driver_priv;
+	RADEONXvMCSurfacePtr *prev;
+
+	if (!surface)
+		return;
+
+	for (prev = &info->xvmc_surfaces; *prev; prev = &(*prev)->next)
+	{
+		if (*prev == surface)
+		{
+			*prev = surface->next;
+			break;
+		}
+	}
+
+	/* a port still showing it holds its own reference */
+	radeon_bo_unref(surface->bo);
+	free(surface);
+	pSurf->driver_priv = NULL;
+}
+
+/* subpictures are blended by the client into the surface */
+static int
+RADEONXvMCCreateSubpicture(ScrnInfoPtr pScrn, XvMCSubpicturePtr pSubp,
+			   int *num_priv, CARD32 **priv)
+{
+	*num_priv = 0;
+	*priv = NULL;
+
+	return Success;
+}
+
+static void
+RADEONXvMCDestroySubpicture(ScrnInfoPtr pScrn, XvMCSubpicturePtr pSubp)
+{
+}
+
 static XF86MCAdaptorRec adaptor_template =
 {
 	"",
@@ -111,12 +296,12 @@ static XF86MCAdaptorRec adaptor_template =
 	surfaces,
 	3,
 	subpictures,
-	(xf86XvMCCreateContextProcPtr)NULL,
-	(xf86XvMCDestroyContextProcPtr)NULL,
-	(xf86XvMCCreateSurfaceProcPtr)NULL,
-	(xf86XvMCDestroySurfaceProcPtr)NULL,
-	(xf86XvMCCreateSubpictureProcPtr)NULL,
-	(xf86XvMCDestroySubpictureProcPtr)NULL
+	RADEONXvMCCreateContext,
+	RADEONXvMCDestroyContext,
+	RADEONXvMCCreateSurface,
+	RADEONXvMCDestroySurface,
+	RADEONXvMCCreateSubpicture,
+	RADEONXvMCDestroySubpicture
 };
 
 XF86MCAdaptorPtr
@@ -124,10 +309,12 @@ RADEONCreateAdaptorXvMC(ScreenPtr pScreen, char *xv_adaptor_name)
 {
 	XF86MCAdaptorPtr	adaptor;
 	ScrnInfoPtr		pScrn;
+	RADEONInfoPtr		info;
 
 	assert(pScreen);
 
 	pScrn = xf86ScreenToScrn(pScreen);
+	info = RADEONPTR(pScrn);
 	adaptor = xf86XvMCCreateAdaptorRec();
 
 	if (!adaptor)
@@ -139,6 +326,17 @@ RADEONCreateAdaptorXvMC(ScreenPtr pScreen, char *xv_adaptor_name)
 	*adaptor = adaptor_template;
 	adaptor->name = xv_adaptor_name;
 
+	/* surfaces are only shared through GEM names */
+	if (!info->dri2.enabled || !IS_R600_3D)
+	{
+		adaptor->CreateContext = NULL;
+		adaptor->DestroyContext = NULL;
+		adaptor->CreateSurface = NULL;
+		adaptor->DestroySurface = NULL;
+		adaptor->CreateSubpicture = NULL;
+		adaptor->DestroySubpicture = NULL;
+	}
+
 	xf86DrvMsg(pScrn->scrnIndex, X_INFO, "[XvMC] Associated with %s.\n", adaptor->name);
 
 	return adaptor;
@@ -0,0 +1,240 @@
+/*
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice (including the next
+ * paragraph) shall be included in all copies or substantial portions of the
+ * Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * Feed synthetic vblank event streams through the vblank timing model and
+ * check what it learns and predicts.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "drmmode_vblank_model.h"
+
+static int failures;
+
+#define CHECK(cond) do {						\
+    if (!(cond)) {							\
+	fprintf(stderr, "%s:%d: %s: check failed: %s\n",		\
+		__FILE__, __LINE__, __func__, #cond);			\
+	failures++;							\
+    }									\
+} while (0)
+
+#define PERIOD_60HZ	16666667ULL
+#define PERIOD_75HZ	13333333ULL
+
+/* Kernel timestamp of vblank seq, in microseconds like the real events */
+static CARD64
+vblank_ust(CARD64 base, uint32_t base_seq, uint32_t seq, CARD64 period_ns)
+{
+    return base + ((CARD64)(uint32_t)(seq - base_seq) * period_ns + 500) / 1000;
+}
+
+static CARD64
+diff(CARD64 a, CARD64 b)
+{
+    return a > b ? a - b : b - a;
+}
+
+/* Deliver every vblank in [first, last) of a stream starting at base */
+static void
+feed(drmmode_vblank_model_ptr model, CARD64 base, uint32_t base_seq,
+     uint32_t first, uint32_t last, uint32_t step, CARD64 period_ns)
+{
+    uint32_t seq;
+
+    for (seq = first; seq != last; seq += step)
+	drmmode_vblank_model_sample(model, seq,
+				    vblank_ust(base, base_seq, seq, period_ns));
+}
+
+static void
+test_steady(void)
+{
+    drmmode_vblank_model_rec model;
+    CARD64 base = 5000000, ust, now;
+    uint32_t seq;
+
+    drmmode_vblank_model_reset(&model, 0);
+
+    /* Not enough samples yet */
+    feed(&model, base, 100, 100, 102, 1, PERIOD_60HZ);
+    now = vblank_ust(base, 100, 101, PERIOD_60HZ) + 8000;
+    CHECK(!drmmode_vblank_model_predict(&model, now, &seq, &ust));
+
+    feed(&model, base, 100, 102, 200, 1, PERIOD_60HZ);
+    CHECK(diff(model.period_ns, PERIOD_60HZ) < 1000);
+
+    /* Middle of the frame after the anchor and ten frames later */
+    now = vblank_ust(base, 100, 199, PERIOD_60HZ) + 8000;
+    CHECK(drmmode_vblank_model_predict(&model, now, &seq, &ust));
+    CHECK(seq == 199);
+    CHECK(diff(ust, vblank_ust(base, 100, 199, PERIOD_60HZ)) <= 1);
+
+    now = vblank_ust(base, 100, 209, PERIOD_60HZ) + 8000;
+    CHECK(drmmode_vblank_model_predict(&model, now, &seq, &ust));
+    CHECK(seq == 209);
+    CHECK(diff(ust, vblank_ust(base, 100, 209, PERIOD_60HZ)) <= 5);
+
+    /* Too close to a vblank boundary, the kernel has to answer */
+    now = vblank_ust(base, 100, 210, PERIOD_60HZ) + 100;
+    CHECK(!drmmode_vblank_model_predict(&model, now, &seq, &ust));
+    now = vblank_ust(base, 100, 210, PERIOD_60HZ) - 100;
+    CHECK(!drmmode_vblank_model_predict(&model, now, &seq, &ust));
+
+    /* Too far past the anchor */
+    now = vblank_ust(base, 100, 199, PERIOD_60HZ) + 2000000;
+    CHECK(!drmmode_vblank_model_predict(&model, now, &seq, &ust));
+
+    /* Before the anchor */
+    CHECK(!drmmode_vblank_model_predict(&model, base, &seq, &ust));
+}
+
+static void
+test_missed_vblanks(void)
+{
+    drmmode_vblank_model_rec model;
+    CARD64 base = 1000000, ust, now;
+    uint32_t seq;
+
+    drmmode_vblank_model_reset(&model, 0);
+    feed(&model, base, 0, 1, 6, 1, PERIOD_60HZ);
+
+    /* Only every 3rd, then every 20th vblank is observed */
+    feed(&model, base, 0, 6, 60, 3, PERIOD_60HZ);
+    CHECK(model.samples >= 4);
+    feed(&model, base, 0, 60, 260, 20, PERIOD_60HZ);
+    CHECK(model.samples >= 4);
+    CHECK(diff(model.period_ns, PERIOD_60HZ) < 100);
+
+    /* One long gap, e.g. nothing waited for vblanks for a while */
+    drmmode_vblank_model_sample(&model, 1000,
+				vblank_ust(base, 0, 1000, PERIOD_60HZ));
+    CHECK(model.samples >= 4);
+    CHECK(model.last_seq == 1000);
+
+    now = vblank_ust(base, 0, 1030, PERIOD_60HZ) + 5000;
+    CHECK(drmmode_vblank_model_predict(&model, now, &seq, &ust));
+    CHECK(seq == 1030);
+    CHECK(diff(ust, vblank_ust(base, 0, 1030, PERIOD_60HZ)) <= 2);
+
+    /* Stale and duplicate events don't move the anchor */
+    drmmode_vblank_model_sample(&model, 990,
+				vblank_ust(base, 0, 990, PERIOD_60HZ));
+    drmmode_vblank_model_sample(&model, 1000,
+				vblank_ust(base, 0, 1000, PERIOD_60HZ));
+    CHECK(model.last_seq == 1000);
+
+    /* Failed events carry no timestamp */
+    drmmode_vblank_model_sample(&model, 1001, 0);
+    CHECK(model.last_seq == 1000);
+}
+
+static void
+test_mode_change(void)
+{
+    drmmode_vblank_model_rec model;
+    CARD64 base = 2000000, base2, ust, now;
+    uint32_t seq;
+
+    drmmode_vblank_model_reset(&model, PERIOD_60HZ);
+    feed(&model, base, 0, 1, 50, 1, PERIOD_60HZ);
+    CHECK(model.samples >= 4);
+
+    /* The CRTC switches to 75Hz without a modeset going through us */
+    base2 = vblank_ust(base, 0, 49, PERIOD_60HZ);
+    feed(&model, base2, 49, 50, 51, 1, PERIOD_75HZ);
+    CHECK(model.samples == 0);
+    now = vblank_ust(base2, 49, 50, PERIOD_75HZ) + 6000;
+    CHECK(!drmmode_vblank_model_predict(&model, now, &seq, &ust));
+
+    feed(&model, base2, 49, 51, 120, 1, PERIOD_75HZ);
+    CHECK(model.samples >= 4);
+    CHECK(diff(model.period_ns, PERIOD_75HZ) < 1000);
+    now = vblank_ust(base2, 49, 125, PERIOD_75HZ) + 6000;
+    CHECK(drmmode_vblank_model_predict(&model, now, &seq, &ust));
+    CHECK(seq == 125);
+    CHECK(diff(ust, vblank_ust(base2, 49, 125, PERIOD_75HZ)) <= 5);
+
+    /* A modeset resets the model to the new nominal period */
+    drmmode_vblank_model_reset(&model, PERIOD_60HZ);
+    CHECK(model.period_ns == PERIOD_60HZ);
+    CHECK(!drmmode_vblank_model_predict(&model, now, &seq, &ust));
+
+    /* The kernel counter may restart after a modeset */
+    base = now + 100000;
+    feed(&model, base, 3, 3, 10, 1, PERIOD_60HZ);
+    now = vblank_ust(base, 3, 12, PERIOD_60HZ) + 8000;
+    CHECK(drmmode_vblank_model_predict(&model, now, &seq, &ust));
+    CHECK(seq == 12);
+
+    /* A timestamp going backwards drops confidence */
+    drmmode_vblank_model_sample(&model, 20, base - 1000);
+    CHECK(model.samples == 0);
+}
+
+static void
+test_wrap_and_extrapolation(void)
+{
+    drmmode_vblank_model_rec model;
+    CARD64 base = 3000000, ust, now;
+    uint32_t seq, first = 0xfffffff0;
+
+    drmmode_vblank_model_reset(&model, 0);
+    feed(&model, base, first, first, first + 16, 1, PERIOD_60HZ);
+    CHECK(model.samples >= 4);
+    CHECK(model.last_seq == 0xffffffff);
+
+    feed(&model, base, first, 0, 8, 1, PERIOD_60HZ);
+    CHECK(model.samples >= 4);
+    CHECK(model.last_seq == 7);
+
+    now = vblank_ust(base, first, 12, PERIOD_60HZ) + 8000;
+    CHECK(drmmode_vblank_model_predict(&model, now, &seq, &ust));
+    CHECK(seq == 12);
+
+    /* DPMS off: extrapolate regardless of confidence. The period is only
+     * known to within a few dozen ns, which adds up over ten seconds.
+     */
+    model.samples = 0;
+    now = vblank_ust(base, first, 7 + 600, PERIOD_60HZ) + 8000;
+    CHECK(drmmode_vblank_model_seq(&model, now) == 7 + 600);
+    CHECK(drmmode_vblank_model_seq(&model, base) == 7);
+    CHECK(diff(drmmode_vblank_model_ust(&model, 7 + 600),
+	       vblank_ust(base, first, 7 + 600, PERIOD_60HZ)) <= 100);
+    CHECK(diff(drmmode_vblank_model_ust(&model, 0xfffffff8),
+	       vblank_ust(base, first, 0xfffffff8, PERIOD_60HZ)) <= 2);
+}
+
+int
+main(void)
+{
+    test_steady();
+    test_missed_vblanks();
+    test_mode_change();
+    test_wrap_and_extrapolation();
+
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}